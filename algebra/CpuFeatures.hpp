@@ -0,0 +1,192 @@
+#ifndef CPU_FEATURES_HPP
+#define CPU_FEATURES_HPP
+
+#include "MatrixEnum.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	#define LITO_SIMD_X86
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#include <cpuid.h>
+	#endif
+#endif
+
+namespace lito {
+
+	struct CpuFeatures {
+		bool sse2;
+		bool avx;
+		bool avx2;
+		bool fma;
+		bool f16c;
+		bool avx512f;
+		bool avx512bf16;
+		bool osAvx;
+		bool osAvx512;
+	};
+
+	inline void cpuid(uint leaf, uint subleaf, uint registers[4]);
+	inline unsigned long long extendedControlRegister();
+	inline CpuFeatures detectCpuFeatures();
+	inline const CpuFeatures& cpuFeatures();
+	inline SimdLevel detectedSimdLevel();
+	inline SimdLevel& simdLevelSetting();
+	inline SimdLevel simdLevel();
+	inline void setSimdLevel(SimdLevel level);
+
+
+
+	/*! cpuid
+	* Execute the cpuid instruction
+	* uint leaf: Leaf asked
+	* uint subleaf: Subleaf asked
+	* uint registers[4]: Values of eax, ebx, ecx and edx, zeros out of x86
+	*/
+	inline void cpuid(uint leaf, uint subleaf, uint registers[4])
+	{
+		registers[0] = registers[1] = registers[2] = registers[3] = 0;
+
+#if defined(LITO_SIMD_X86) && defined(_MSC_VER)
+		int values[4];
+
+		__cpuidex(values, int(leaf), int(subleaf));
+		for (uint i = 0; i < 4; i++)
+			registers[i] = uint(values[i]);
+#elif defined(LITO_SIMD_X86)
+		if (leaf <= __get_cpuid_max(leaf & 0x80000000u, nullptr))
+			__cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#else
+		(void)leaf;
+		(void)subleaf;
+#endif
+	}
+
+	/*! extendedControlRegister
+	* Read the XCR0 register, that tells which register states the OS saves
+	* return: The value of XCR0, zero when it is not available
+	*/
+	inline unsigned long long extendedControlRegister()
+	{
+#if defined(LITO_SIMD_X86) && defined(_MSC_VER)
+		return _xgetbv(0);
+#elif defined(LITO_SIMD_X86)
+		uint eax, edx;
+
+		__asm__ volatile ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+		return (static_cast<unsigned long long>(edx) << 32) | eax;
+#else
+		return 0;
+#endif
+	}
+
+	/*! detectCpuFeatures
+	* Detect the instruction sets available in the processor and enabled by the OS
+	* return: The features detected
+	*/
+	inline CpuFeatures detectCpuFeatures()
+	{
+		CpuFeatures features = { false, false, false, false, false, false, false, false, false };
+		uint registers[4];
+
+		cpuid(0, 0, registers);
+		uint maxLeaf = registers[0];
+
+		if (maxLeaf < 1)
+			return features;
+
+		cpuid(1, 0, registers);
+		features.sse2 = (registers[3] & (1u << 26)) != 0;
+		features.fma  = (registers[2] & (1u << 12)) != 0;
+		features.avx  = (registers[2] & (1u << 28)) != 0;
+		features.f16c = (registers[2] & (1u << 29)) != 0;
+
+		if ((registers[2] & (1u << 27)) != 0)
+		{
+			unsigned long long xcr0 = extendedControlRegister();
+
+			features.osAvx    = (xcr0 & 0x06) == 0x06;
+			features.osAvx512 = (xcr0 & 0xE6) == 0xE6;
+		}
+
+		if (maxLeaf >= 7)
+		{
+			cpuid(7, 0, registers);
+			features.avx2    = (registers[1] & (1u << 5 )) != 0;
+			features.avx512f = (registers[1] & (1u << 16)) != 0;
+
+			// The subleaf 1 has the extensions added later, as the BF16 conversions
+			if (registers[0] >= 1)
+			{
+				cpuid(7, 1, registers);
+				features.avx512bf16 = (registers[0] & (1u << 5)) != 0;
+			}
+		}
+
+		return features;
+	}
+
+	/*! cpuFeatures
+	* Get the features of the processor, detected once
+	* return: The features detected
+	*/
+	inline const CpuFeatures& cpuFeatures()
+	{
+		static const CpuFeatures features = detectCpuFeatures();
+
+		return features;
+	}
+
+	/*! detectedSimdLevel
+	* Get the widest SIMD level usable in this processor
+	* return: The SIMD level
+	*/
+	inline SimdLevel detectedSimdLevel()
+	{
+		const CpuFeatures& features = cpuFeatures();
+
+		if (features.avx512f && features.avx2 && features.fma && features.osAvx512)
+			return SimdLevel::AVX512;
+		else if (features.avx2 && features.fma && features.osAvx)
+			return SimdLevel::AVX2;
+		else if (features.sse2)
+			return SimdLevel::SSE2;
+
+		return SimdLevel::SCALAR;
+	}
+
+	/*! simdLevelSetting
+	* Storage of the SIMD level used by the kernels
+	* return: The SIMD level used
+	*/
+	inline SimdLevel& simdLevelSetting()
+	{
+		static SimdLevel level = detectedSimdLevel();
+
+		return level;
+	}
+
+	/*! simdLevel
+	* Get the SIMD level used by the kernels
+	* return: The SIMD level used
+	*/
+	inline SimdLevel simdLevel()
+	{
+		return simdLevelSetting();
+	}
+
+	/*! setSimdLevel
+	* Choose the SIMD level used by the kernels, limited to the detected one
+	* Must be called before the kernels are used by other threads
+	* SimdLevel level: The SIMD level wanted
+	*/
+	inline void setSimdLevel(SimdLevel level)
+	{
+		SimdLevel detected = detectedSimdLevel();
+
+		simdLevelSetting() = (static_cast<int>(level) < static_cast<int>(detected)) ? level : detected;
+	}
+
+}
+
+#endif
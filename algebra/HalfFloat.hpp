@@ -0,0 +1,490 @@
+#ifndef HALF_FLOAT_HPP
+#define HALF_FLOAT_HPP
+
+#include <cstdint>
+#include <cstring>
+#include "CpuFeatures.hpp"
+#include "SimdKernels.hpp"
+
+#if defined(LITO_SIMD_X86) && ((defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 10) || (defined(__clang__) && __clang_major__ >= 9))
+	#define LITO_SIMD_BF16
+#endif
+
+namespace lito {
+
+	/*! half
+	* IEEE 754 binary16 value for storage: 1 sign bit, 5 exponent bits and 10 mantissa bits (3 decimal digits up to 65504)
+	* The arithmetic is done in float by the conversion, the results are rounded to the nearest even when stored
+	*/
+	class half {
+	public:
+		half() = default;
+		half(float value);
+
+		operator float() const;
+
+		half& operator += (float value);
+		half& operator -= (float value);
+		half& operator *= (float value);
+		half& operator /= (float value);
+
+		static half fromBits(uint16_t bits);
+		uint16_t getBits() const;
+
+	private:
+		uint16_t _bits;
+	};
+
+	/*! bfloat16
+	* Brain floating point value for storage: the 16 upper bits of a float, 8 exponent bits and 7 mantissa bits
+	* Keeps the range of float with 2 decimal digits, the arithmetic is done in float by the conversion
+	*/
+	class bfloat16 {
+	public:
+		bfloat16() = default;
+		bfloat16(float value);
+
+		operator float() const;
+
+		bfloat16& operator += (float value);
+		bfloat16& operator -= (float value);
+		bfloat16& operator *= (float value);
+		bfloat16& operator /= (float value);
+
+		static bfloat16 fromBits(uint16_t bits);
+		uint16_t getBits() const;
+
+	private:
+		uint16_t _bits;
+	};
+
+	/*! HalfKernels
+	* Table of the bulk conversions between a 16 bits type S and float
+	* toFloat: y = x converted to float
+	* fromFloat: y = x rounded to the nearest even S
+	*/
+	template <typename S>
+	struct HalfKernels {
+		void (*toFloat)(uint n, const S* x, float* y);
+		void (*fromFloat)(uint n, const float* x, S* y);
+	};
+
+	inline uint16_t floatToHalfBits(float value);
+	inline float halfBitsToFloat(uint16_t bits);
+	inline uint16_t floatToBfloat16Bits(float value);
+	inline float bfloat16BitsToFloat(uint16_t bits);
+
+	template <typename S> const HalfKernels<S>& halfKernels();
+	template <typename T, typename U> void convertValues(uint n, const T* x, U* y);
+	inline void convertValues(uint n, const half* x, float* y);
+	inline void convertValues(uint n, const float* x, half* y);
+	inline void convertValues(uint n, const bfloat16* x, float* y);
+	inline void convertValues(uint n, const float* x, bfloat16* y);
+
+
+
+	/*! half
+	* Initialize the value rounding a float to the nearest even half
+	* float value: The value, beyond 65504 it becomes infinity
+	*/
+	inline half::half(float value)
+		: _bits(floatToHalfBits(value))
+	{}
+
+	/*! operator float
+	* Convert the value to float, exactly
+	* return: The value
+	*/
+	inline half::operator float() const
+	{
+		return halfBitsToFloat(_bits);
+	}
+
+	inline half& half::operator += (float value) { return *this = half(float(*this) + value); }
+	inline half& half::operator -= (float value) { return *this = half(float(*this) - value); }
+	inline half& half::operator *= (float value) { return *this = half(float(*this) * value); }
+	inline half& half::operator /= (float value) { return *this = half(float(*this) / value); }
+
+	/*! fromBits
+	* Create a value from its binary16 representation
+	* uint16_t bits: The representation
+	* return: The value
+	*/
+	inline half half::fromBits(uint16_t bits)
+	{
+		half value;
+
+		value._bits = bits;
+		return value;
+	}
+
+	/*! getBits
+	* Get the binary16 representation of the value
+	* return: The representation
+	*/
+	inline uint16_t half::getBits() const
+	{
+		return _bits;
+	}
+
+	/*! bfloat16
+	* Initialize the value rounding a float to the nearest even bfloat16
+	* float value: The value
+	*/
+	inline bfloat16::bfloat16(float value)
+		: _bits(floatToBfloat16Bits(value))
+	{}
+
+	/*! operator float
+	* Convert the value to float, exactly
+	* return: The value
+	*/
+	inline bfloat16::operator float() const
+	{
+		return bfloat16BitsToFloat(_bits);
+	}
+
+	inline bfloat16& bfloat16::operator += (float value) { return *this = bfloat16(float(*this) + value); }
+	inline bfloat16& bfloat16::operator -= (float value) { return *this = bfloat16(float(*this) - value); }
+	inline bfloat16& bfloat16::operator *= (float value) { return *this = bfloat16(float(*this) * value); }
+	inline bfloat16& bfloat16::operator /= (float value) { return *this = bfloat16(float(*this) / value); }
+
+	/*! fromBits
+	* Create a value from its representation, the upper half of a float
+	* uint16_t bits: The representation
+	* return: The value
+	*/
+	inline bfloat16 bfloat16::fromBits(uint16_t bits)
+	{
+		bfloat16 value;
+
+		value._bits = bits;
+		return value;
+	}
+
+	/*! getBits
+	* Get the representation of the value, the upper half of a float
+	* return: The representation
+	*/
+	inline uint16_t bfloat16::getBits() const
+	{
+		return _bits;
+	}
+
+	/*! floatToHalfBits
+	* Round a float to the nearest even binary16, the subnormals are kept and the NaN stay NaN
+	* float value: The value
+	* return: The binary16 representation
+	*/
+	inline uint16_t floatToHalfBits(float value)
+	{
+		uint32_t bits;
+
+		std::memcpy(&bits, &value, sizeof(float));
+
+		const uint32_t sign = (bits >> 16) & 0x8000u;
+		const uint32_t absolute = bits & 0x7FFFFFFFu;
+
+		if (absolute > 0x7F800000u)
+			return uint16_t(sign | 0x7E00u | ((absolute >> 13) & 0x3FFu));
+		else if (absolute >= 0x477FF000u)
+			return uint16_t(sign | 0x7C00u);
+		else if (absolute < 0x33000000u)
+			return uint16_t(sign);
+		else if (absolute < 0x38800000u)
+		{
+			// Below 2^-14 the result is subnormal, the mantissa with its implicit bit is shifted to units of 2^-24
+			const uint32_t shift = 126 - (absolute >> 23);
+			const uint32_t mantissa = (absolute & 0x7FFFFFu) | 0x800000u;
+			const uint32_t rest = mantissa & ((1u << shift) - 1);
+			const uint32_t halfway = 1u << (shift - 1);
+			uint32_t result = mantissa >> shift;
+
+			if (rest > halfway || (rest == halfway && (result & 1u) != 0))
+				result++;
+
+			return uint16_t(sign | result);
+		}
+
+		const uint32_t rest = absolute & 0x1FFFu;
+		uint32_t result = (absolute - 0x38000000u) >> 13;
+
+		// A carry of the rounding goes to the exponent, up to infinity
+		if (rest > 0x1000u || (rest == 0x1000u && (result & 1u) != 0))
+			result++;
+
+		return uint16_t(sign | result);
+	}
+
+	/*! halfBitsToFloat
+	* Convert a binary16 to float, exactly
+	* uint16_t bits: The binary16 representation
+	* return: The value
+	*/
+	inline float halfBitsToFloat(uint16_t bits)
+	{
+		const uint32_t sign = uint32_t(bits & 0x8000u) << 16;
+		uint32_t exponent = (bits >> 10) & 0x1Fu;
+		uint32_t mantissa = bits & 0x3FFu;
+		uint32_t result;
+		float value;
+
+		if (exponent == 0x1Fu)
+			result = sign | 0x7F800000u | (mantissa << 13);
+		else if (exponent != 0)
+			result = sign | ((exponent + 112) << 23) | (mantissa << 13);
+		else if (mantissa == 0)
+			result = sign;
+		else
+		{
+			// Subnormal, normalized to the exponent of float
+			exponent = 113;
+
+			while ((mantissa & 0x400u) == 0)
+			{
+				mantissa <<= 1;
+				exponent--;
+			}
+
+			result = sign | (exponent << 23) | ((mantissa & 0x3FFu) << 13);
+		}
+
+		std::memcpy(&value, &result, sizeof(float));
+		return value;
+	}
+
+	/*! floatToBfloat16Bits
+	* Round a float to the nearest even bfloat16, the NaN stay NaN
+	* float value: The value
+	* return: The bfloat16 representation
+	*/
+	inline uint16_t floatToBfloat16Bits(float value)
+	{
+		uint32_t bits;
+
+		std::memcpy(&bits, &value, sizeof(float));
+
+		if ((bits & 0x7FFFFFFFu) > 0x7F800000u)
+			return uint16_t((bits >> 16) | 0x40u);
+
+		return uint16_t((bits + 0x7FFFu + ((bits >> 16) & 1u)) >> 16);
+	}
+
+	/*! bfloat16BitsToFloat
+	* Convert a bfloat16 to float, exactly
+	* uint16_t bits: The bfloat16 representation
+	* return: The value
+	*/
+	inline float bfloat16BitsToFloat(uint16_t bits)
+	{
+		const uint32_t result = uint32_t(bits) << 16;
+		float value;
+
+		std::memcpy(&value, &result, sizeof(float));
+		return value;
+	}
+
+	/*! scalarToFloat
+	* Convert values of a 16 bits type to float one by one
+	* uint n: Quantities of values
+	* S* x: The values
+	* float* y: Receives the converted values
+	*/
+	template <typename S>
+	void scalarToFloat(uint n, const S* x, float* y)
+	{
+		for (uint i = 0; i < n; i++)
+			y[i] = float(x[i]);
+	}
+
+	/*! scalarFromFloat
+	* Round floats to a 16 bits type one by one
+	* uint n: Quantities of values
+	* float* x: The values
+	* S* y: Receives the rounded values
+	*/
+	template <typename S>
+	void scalarFromFloat(uint n, const float* x, S* y)
+	{
+		for (uint i = 0; i < n; i++)
+			y[i] = S(x[i]);
+	}
+
+#ifdef LITO_SIMD_X86
+
+	/*===============================================================================================================================*/
+	/* F16C                                                                                                                          */
+	/*===============================================================================================================================*/
+
+	LITO_SIMD_TARGET("avx,f16c")
+	inline void f16cToFloat(uint n, const half* x, float* y)
+	{
+		uint i = 0;
+
+		for (; i + 8 <= n; i += 8)
+			_mm256_storeu_ps(y + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i))));
+		for (; i < n; i++)
+			y[i] = float(x[i]);
+	}
+
+	LITO_SIMD_TARGET("avx,f16c")
+	inline void f16cFromFloat(uint n, const float* x, half* y)
+	{
+		uint i = 0;
+
+		for (; i + 8 <= n; i += 8)
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(y + i), _mm256_cvtps_ph(_mm256_loadu_ps(x + i), _MM_FROUND_TO_NEAREST_INT));
+		for (; i < n; i++)
+			y[i] = half(x[i]);
+	}
+
+	/*===============================================================================================================================*/
+	/* AVX2                                                                                                                          */
+	/*===============================================================================================================================*/
+
+	LITO_SIMD_TARGET("avx2")
+	inline void avx2ToFloat(uint n, const bfloat16* x, float* y)
+	{
+		uint i = 0;
+
+		for (; i + 8 <= n; i += 8)
+		{
+			__m256i bits = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i)));
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(y + i), _mm256_slli_epi32(bits, 16));
+		}
+		for (; i < n; i++)
+			y[i] = float(x[i]);
+	}
+
+	LITO_SIMD_TARGET("avx2")
+	inline __m256i avx2RoundBfloat16(__m256 value)
+	{
+		const __m256i bits = _mm256_castps_si256(value);
+		const __m256i odd = _mm256_and_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(1));
+		const __m256i rounded = _mm256_add_epi32(bits, _mm256_add_epi32(odd, _mm256_set1_epi32(0x7FFF)));
+		const __m256i quiet = _mm256_or_si256(bits, _mm256_set1_epi32(0x400000));
+		const __m256i nan = _mm256_castps_si256(_mm256_cmp_ps(value, value, _CMP_UNORD_Q));
+
+		return _mm256_srli_epi32(_mm256_blendv_epi8(rounded, quiet, nan), 16);
+	}
+
+	LITO_SIMD_TARGET("avx2")
+	inline void avx2FromFloat(uint n, const float* x, bfloat16* y)
+	{
+		uint i = 0;
+
+		for (; i + 16 <= n; i += 16)
+		{
+			// The pack works inside each 128 bits lane, the permutation puts the 16 values in order
+			__m256i packed = _mm256_packus_epi32(avx2RoundBfloat16(_mm256_loadu_ps(x + i)), avx2RoundBfloat16(_mm256_loadu_ps(x + i + 8)));
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(y + i), _mm256_permute4x64_epi64(packed, 0xD8));
+		}
+		for (; i < n; i++)
+			y[i] = bfloat16(x[i]);
+	}
+
+#ifdef LITO_SIMD_BF16
+
+	/*===============================================================================================================================*/
+	/* AVX-512 BF16                                                                                                                  */
+	/*===============================================================================================================================*/
+
+	LITO_SIMD_TARGET("avx512f,avx512bf16")
+	inline void avx512FromFloat(uint n, const float* x, bfloat16* y)
+	{
+		uint i = 0;
+
+		for (; i + 16 <= n; i += 16)
+		{
+			__m256bh packed = _mm512_cvtneps_pbh(_mm512_loadu_ps(x + i));
+
+			std::memcpy(static_cast<void*>(y + i), &packed, sizeof(packed));
+		}
+		for (; i < n; i++)
+			y[i] = bfloat16(x[i]);
+	}
+
+#endif
+
+#endif
+
+	/*! halfKernels
+	* Get the conversions of half, by F16C when the processor has it and the SIMD level in use is at least AVX2
+	* return: The table of conversions
+	*/
+	template <>
+	inline const HalfKernels<half>& halfKernels<half>()
+	{
+#ifdef LITO_SIMD_X86
+		static const HalfKernels<half> kernels[] = {
+			{ scalarToFloat<half>, scalarFromFloat<half> },
+			{ f16cToFloat, f16cFromFloat }
+		};
+
+		return kernels[(static_cast<int>(simdLevel()) >= static_cast<int>(SimdLevel::AVX2) && cpuFeatures().f16c) ? 1 : 0];
+#else
+		static const HalfKernels<half> kernels = { scalarToFloat<half>, scalarFromFloat<half> };
+
+		return kernels;
+#endif
+	}
+
+	/*! halfKernels
+	* Get the conversions of bfloat16 of the SIMD level in use, the rounding by AVX-512 BF16 when the processor has it
+	* The AVX-512 BF16 instruction treats the subnormal floats as zeros
+	* return: The table of conversions
+	*/
+	template <>
+	inline const HalfKernels<bfloat16>& halfKernels<bfloat16>()
+	{
+#ifdef LITO_SIMD_X86
+		static const HalfKernels<bfloat16> kernels[] = {
+			{ scalarToFloat<bfloat16>, scalarFromFloat<bfloat16> },
+			{ avx2ToFloat, avx2FromFloat },
+#ifdef LITO_SIMD_BF16
+			{ avx2ToFloat, avx512FromFloat }
+#else
+			{ avx2ToFloat, avx2FromFloat }
+#endif
+		};
+
+		if (simdLevel() == SimdLevel::AVX512 && cpuFeatures().avx512bf16)
+			return kernels[2];
+
+		return kernels[(static_cast<int>(simdLevel()) >= static_cast<int>(SimdLevel::AVX2)) ? 1 : 0];
+#else
+		static const HalfKernels<bfloat16> kernels = { scalarToFloat<bfloat16>, scalarFromFloat<bfloat16> };
+
+		return kernels;
+#endif
+	}
+
+	/*! convertValues
+	* Convert values to another type one by one
+	* uint n: Quantities of values
+	* T* x: The values
+	* U* y: Receives the converted values
+	*/
+	template <typename T, typename U>
+	void convertValues(uint n, const T* x, U* y)
+	{
+		for (uint i = 0; i < n; i++)
+			y[i] = U(x[i]);
+	}
+
+	/*! convertValues
+	* Convert values between half or bfloat16 and float by the bulk conversions
+	* uint n: Quantities of values
+	* x: The values
+	* y: Receives the converted values
+	*/
+	inline void convertValues(uint n, const half* x, float* y) { halfKernels<half>().toFloat(n, x, y); }
+	inline void convertValues(uint n, const float* x, half* y) { halfKernels<half>().fromFloat(n, x, y); }
+	inline void convertValues(uint n, const bfloat16* x, float* y) { halfKernels<bfloat16>().toFloat(n, x, y); }
+	inline void convertValues(uint n, const float* x, bfloat16* y) { halfKernels<bfloat16>().fromFloat(n, x, y); }
+
+}
+
+#endif
@@ -0,0 +1,602 @@
+#ifndef ITERATIVE_SOLVERS_HPP
+#define ITERATIVE_SOLVERS_HPP
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "Matrix.hpp"
+#include "MatrixGemv.hpp"
+#include "SparseMatrix.hpp"
+#include "Preconditioners.hpp"
+
+namespace lito {
+
+	/*! IterativeSettings
+	* Stop criteria of the iterative solvers
+	* uint maxIterations: Maximum quantities of iterations (products by A)
+	* T tolerance: The solver stops when ||b - A * x|| <= tolerance * ||b||
+	* uint restart: Iterations of GMRES before it restarts, the memory used is restart + 1 vectors
+	* T absoluteTolerance: The solver also stops when ||b - A * x|| <= absoluteTolerance
+	*/
+	template <typename T>
+	struct IterativeSettings {
+		IterativeSettings(uint maxIterations = 1000, T tolerance = T(1e-8), uint restart = 30, T absoluteTolerance = T(0))
+			: maxIterations(maxIterations)
+			, tolerance(tolerance)
+			, restart(restart)
+			, absoluteTolerance(absoluteTolerance)
+		{}
+
+		uint maxIterations;
+		T tolerance;
+		uint restart;
+		T absoluteTolerance;
+	};
+
+	/*! IterativeStatistics
+	* Result of an iterative solver
+	* uint iterations: Iterations done
+	* T residual: Last ||b - A * x|| / ||b|| of the solver (updated by recurrence, not recalculated)
+	* bool converged: If the tolerance was reached, false when maxIterations ended or the method broke down
+	*/
+	template <typename T>
+	struct IterativeStatistics {
+		uint iterations;
+		T residual;
+		bool converged;
+	};
+
+	template <typename O, typename T, typename P> IterativeStatistics<T> solveCG(const O& A, const Matrix<T>& b, Matrix<T>& x, const P& preconditioner, const IterativeSettings<T>& settings = IterativeSettings<T>());
+	template <typename O, typename T> IterativeStatistics<T> solveCG(const O& A, const Matrix<T>& b, Matrix<T>& x, const IterativeSettings<T>& settings = IterativeSettings<T>());
+	template <typename O, typename T, typename P> IterativeStatistics<T> solveBiCGSTAB(const O& A, const Matrix<T>& b, Matrix<T>& x, const P& preconditioner, const IterativeSettings<T>& settings = IterativeSettings<T>());
+	template <typename O, typename T> IterativeStatistics<T> solveBiCGSTAB(const O& A, const Matrix<T>& b, Matrix<T>& x, const IterativeSettings<T>& settings = IterativeSettings<T>());
+	template <typename O, typename T, typename P> IterativeStatistics<T> solveGMRES(const O& A, const Matrix<T>& b, Matrix<T>& x, const P& preconditioner, const IterativeSettings<T>& settings = IterativeSettings<T>());
+	template <typename O, typename T> IterativeStatistics<T> solveGMRES(const O& A, const Matrix<T>& b, Matrix<T>& x, const IterativeSettings<T>& settings = IterativeSettings<T>());
+
+	template <typename O, typename T> void applyOperator(const O& A, const Matrix<T>& vectorX, Matrix<T>& vectorY);
+	template <typename T> void applyOperator(const Matrix<T>& A, const Matrix<T>& vectorX, Matrix<T>& vectorY);
+	template <typename T> T vectorDot(const Matrix<T>& vectorX, const Matrix<T>& vectorY);
+	template <typename T> T vectorNorm(const Matrix<T>& vectorX);
+	template <typename T> void vectorAxpy(const T& alpha, const Matrix<T>& vectorX, Matrix<T>& vectorY);
+	template <typename T> void vectorXpby(const Matrix<T>& vectorX, const T& beta, Matrix<T>& vectorY);
+	template <typename T> void vectorScale(const T& alpha, Matrix<T>& vectorX);
+	template <typename T> void iterativeStart(uint n, const Matrix<T>& b, Matrix<T>& x);
+
+
+
+	/*! solveCG
+	* Solve A * x = b by the preconditioned conjugate gradient, A and the preconditioner symmetric positive definite
+	* O A: The operator A, with apply(x, y) calculating y = A * x, or a Matrix
+	* Matrix<T> b: The vector b
+	* Matrix<T> x: The initial guess, receives the solution; zero is used when its size is not the size of b
+	* P preconditioner: The preconditioner, with apply(r, z) calculating z = M^-1 * r
+	* IterativeSettings<T> settings: The stop criteria
+	* return: The iterations, the residual and if the method converged
+	*/
+	template <typename O, typename T, typename P>
+	IterativeStatistics<T> solveCG(const O& A, const Matrix<T>& b, Matrix<T>& x, const P& preconditioner, const IterativeSettings<T>& settings)
+	{
+		uint n = b.getRows();
+		IterativeStatistics<T> statistics = { 0, T(0), true };
+
+		iterativeStart(n, b, x);
+
+		const T normB = vectorNorm(b);
+
+		if (normB == T(0))
+		{
+			x = Matrix<T>(n, 1);
+			return statistics;
+		}
+
+		const T stop = std::max(settings.tolerance * normB, settings.absoluteTolerance);
+		Matrix<T> vectorR(n, 1), vectorZ(n, 1), vectorP(n, 1), vectorQ(n, 1);
+
+		applyOperator(A, x, vectorR);
+		vectorXpby(b, T(-1), vectorR);
+
+		T normR = vectorNorm(vectorR);
+		statistics.residual = normR / normB;
+
+		if (normR <= stop)
+			return statistics;
+
+		preconditioner.apply(vectorR, vectorZ);
+		vectorP = vectorZ;
+
+		T rz = vectorDot(vectorR, vectorZ);
+
+		while (statistics.iterations < settings.maxIterations)
+		{
+			applyOperator(A, vectorP, vectorQ);
+
+			const T pq = vectorDot(vectorP, vectorQ);
+
+			if (pq == T(0) || rz == T(0))
+				break;
+
+			const T alpha = rz / pq;
+
+			vectorAxpy(alpha, vectorP, x);
+			vectorAxpy(-alpha, vectorQ, vectorR);
+			statistics.iterations++;
+
+			normR = vectorNorm(vectorR);
+			statistics.residual = normR / normB;
+
+			if (normR <= stop)
+				return statistics;
+
+			preconditioner.apply(vectorR, vectorZ);
+
+			const T rzNew = vectorDot(vectorR, vectorZ);
+
+			vectorXpby(vectorZ, rzNew / rz, vectorP);
+			rz = rzNew;
+		}
+
+		statistics.converged = false;
+
+		return statistics;
+	}
+
+	/*! solveCG
+	* Solve A * x = b by the conjugate gradient without preconditioner, A symmetric positive definite
+	* O A: The operator A, with apply(x, y) calculating y = A * x, or a Matrix
+	* Matrix<T> b: The vector b
+	* Matrix<T> x: The initial guess, receives the solution; zero is used when its size is not the size of b
+	* IterativeSettings<T> settings: The stop criteria
+	* return: The iterations, the residual and if the method converged
+	*/
+	template <typename O, typename T>
+	IterativeStatistics<T> solveCG(const O& A, const Matrix<T>& b, Matrix<T>& x, const IterativeSettings<T>& settings)
+	{
+		return solveCG(A, b, x, IdentityPreconditioner<T>(), settings);
+	}
+
+	/*! solveBiCGSTAB
+	* Solve A * x = b by the stabilized biconjugate gradient with right preconditioning, A any square matrix
+	* Each iteration does two products by A and two by the preconditioner
+	* O A: The operator A, with apply(x, y) calculating y = A * x, or a Matrix
+	* Matrix<T> b: The vector b
+	* Matrix<T> x: The initial guess, receives the solution; zero is used when its size is not the size of b
+	* P preconditioner: The preconditioner, with apply(r, z) calculating z = M^-1 * r
+	* IterativeSettings<T> settings: The stop criteria
+	* return: The iterations, the residual and if the method converged
+	*/
+	template <typename O, typename T, typename P>
+	IterativeStatistics<T> solveBiCGSTAB(const O& A, const Matrix<T>& b, Matrix<T>& x, const P& preconditioner, const IterativeSettings<T>& settings)
+	{
+		uint n = b.getRows();
+		IterativeStatistics<T> statistics = { 0, T(0), true };
+
+		iterativeStart(n, b, x);
+
+		const T normB = vectorNorm(b);
+
+		if (normB == T(0))
+		{
+			x = Matrix<T>(n, 1);
+			return statistics;
+		}
+
+		const T stop = std::max(settings.tolerance * normB, settings.absoluteTolerance);
+		Matrix<T> vectorR(n, 1), vectorShadow(n, 1), vectorP(n, 1), vectorV(n, 1);
+		Matrix<T> vectorPHat(n, 1), vectorS(n, 1), vectorSHat(n, 1), vectorT(n, 1);
+
+		applyOperator(A, x, vectorR);
+		vectorXpby(b, T(-1), vectorR);
+
+		T normR = vectorNorm(vectorR);
+		statistics.residual = normR / normB;
+
+		if (normR <= stop)
+			return statistics;
+
+		vectorShadow = vectorR;
+
+		T rho = T(1), alpha = T(1), omega = T(1);
+
+		while (statistics.iterations < settings.maxIterations)
+		{
+			const T rhoNew = vectorDot(vectorShadow, vectorR);
+
+			if (rhoNew == T(0) || omega == T(0))
+				break;
+
+			const T beta = (rhoNew / rho) * (alpha / omega);
+
+			vectorAxpy(-omega, vectorV, vectorP);
+			vectorXpby(vectorR, beta, vectorP);
+
+			preconditioner.apply(vectorP, vectorPHat);
+			applyOperator(A, vectorPHat, vectorV);
+
+			const T shadowV = vectorDot(vectorShadow, vectorV);
+
+			if (shadowV == T(0))
+				break;
+
+			alpha = rhoNew / shadowV;
+			rho = rhoNew;
+
+			vectorS = vectorR;
+			vectorAxpy(-alpha, vectorV, vectorS);
+			statistics.iterations++;
+
+			normR = vectorNorm(vectorS);
+
+			if (normR <= stop)
+			{
+				vectorAxpy(alpha, vectorPHat, x);
+				statistics.residual = normR / normB;
+				return statistics;
+			}
+
+			preconditioner.apply(vectorS, vectorSHat);
+			applyOperator(A, vectorSHat, vectorT);
+
+			const T tt = vectorDot(vectorT, vectorT);
+
+			omega = (tt == T(0)) ? T(0) : vectorDot(vectorT, vectorS) / tt;
+
+			vectorAxpy(alpha, vectorPHat, x);
+			vectorAxpy(omega, vectorSHat, x);
+
+			vectorR = vectorS;
+			vectorAxpy(-omega, vectorT, vectorR);
+
+			normR = vectorNorm(vectorR);
+			statistics.residual = normR / normB;
+
+			if (normR <= stop)
+				return statistics;
+		}
+
+		statistics.converged = false;
+
+		return statistics;
+	}
+
+	/*! solveBiCGSTAB
+	* Solve A * x = b by the stabilized biconjugate gradient without preconditioner
+	* O A: The operator A, with apply(x, y) calculating y = A * x, or a Matrix
+	* Matrix<T> b: The vector b
+	* Matrix<T> x: The initial guess, receives the solution; zero is used when its size is not the size of b
+	* IterativeSettings<T> settings: The stop criteria
+	* return: The iterations, the residual and if the method converged
+	*/
+	template <typename O, typename T>
+	IterativeStatistics<T> solveBiCGSTAB(const O& A, const Matrix<T>& b, Matrix<T>& x, const IterativeSettings<T>& settings)
+	{
+		return solveBiCGSTAB(A, b, x, IdentityPreconditioner<T>(), settings);
+	}
+
+	/*! solveGMRES
+	* Solve A * x = b by GMRES restarted after settings.restart iterations, with right preconditioning, A any square matrix
+	* The Arnoldi basis is orthogonalized by modified Gram-Schmidt and the least squares of the Hessenberg matrix
+	* are solved by Givens rotations, that give the residual at each iteration without calculating x
+	* O A: The operator A, with apply(x, y) calculating y = A * x, or a Matrix
+	* Matrix<T> b: The vector b
+	* Matrix<T> x: The initial guess, receives the solution; zero is used when its size is not the size of b
+	* P preconditioner: The preconditioner, with apply(r, z) calculating z = M^-1 * r
+	* IterativeSettings<T> settings: The stop criteria
+	* return: The iterations, the residual and if the method converged
+	*/
+	template <typename O, typename T, typename P>
+	IterativeStatistics<T> solveGMRES(const O& A, const Matrix<T>& b, Matrix<T>& x, const P& preconditioner, const IterativeSettings<T>& settings)
+	{
+		uint n = b.getRows();
+		IterativeStatistics<T> statistics = { 0, T(0), true };
+
+		iterativeStart(n, b, x);
+
+		const T normB = vectorNorm(b);
+
+		if (normB == T(0))
+		{
+			x = Matrix<T>(n, 1);
+			return statistics;
+		}
+
+		const T stop = std::max(settings.tolerance * normB, settings.absoluteTolerance);
+		const uint m = std::max(settings.restart, 1u);
+		std::vector<Matrix<T>> basis(m + 1, Matrix<T>(n, 1));
+		Matrix<T> hessenberg(m + 1, m);
+		std::vector<T> cosines(m), sines(m), g(m + 1);
+		Matrix<T> vectorR(n, 1), vectorZ(n, 1);
+
+		while (true)
+		{
+			applyOperator(A, x, vectorR);
+			vectorXpby(b, T(-1), vectorR);
+
+			T normR = vectorNorm(vectorR);
+			statistics.residual = normR / normB;
+
+			if (normR <= stop)
+				return statistics;
+
+			if (statistics.iterations >= settings.maxIterations)
+				break;
+
+			basis[0] = vectorR;
+			vectorScale(T(1) / normR, basis[0]);
+			std::fill(g.begin(), g.end(), T(0));
+			g[0] = normR;
+
+			uint j = 0;
+			bool breakdown = false;
+
+			while (j < m && statistics.iterations < settings.maxIterations)
+			{
+				preconditioner.apply(basis[j], vectorZ);
+				applyOperator(A, vectorZ, basis[j + 1]);
+
+				for (uint i = 0; i <= j; i++)
+				{
+					const T h = vectorDot(basis[j + 1], basis[i]);
+
+					hessenberg.row(i)[j] = h;
+					vectorAxpy(-h, basis[i], basis[j + 1]);
+				}
+
+				const T normW = vectorNorm(basis[j + 1]);
+
+				hessenberg.row(j + 1)[j] = normW;
+
+				if (normW != T(0))
+					vectorScale(T(1) / normW, basis[j + 1]);
+
+				for (uint i = 0; i < j; i++)
+				{
+					const T upper = hessenberg.row(i)[j];
+					const T lower = hessenberg.row(i + 1)[j];
+
+					hessenberg.row(i)[j] = cosines[i] * upper + sines[i] * lower;
+					hessenberg.row(i + 1)[j] = -sines[i] * upper + cosines[i] * lower;
+				}
+
+				const T diagonal = hessenberg.row(j)[j];
+				const T radius = std::sqrt(diagonal * diagonal + normW * normW);
+
+				if (radius == T(0))
+				{
+					breakdown = true;
+					break;
+				}
+
+				cosines[j] = diagonal / radius;
+				sines[j] = normW / radius;
+				hessenberg.row(j)[j] = radius;
+				hessenberg.row(j + 1)[j] = T(0);
+				g[j + 1] = -sines[j] * g[j];
+				g[j] = cosines[j] * g[j];
+
+				j++;
+				statistics.iterations++;
+				statistics.residual = std::abs(g[j]) / normB;
+
+				if (std::abs(g[j]) <= stop || normW == T(0))
+					break;
+			}
+
+			for (uint i = j; i-- > 0;)
+			{
+				T value = g[i];
+
+				for (uint c = i + 1; c < j; c++)
+					value -= hessenberg.row(i)[c] * g[c];
+
+				g[i] = value / hessenberg.row(i)[i];
+			}
+
+			vectorR = Matrix<T>(n, 1);
+
+			for (uint i = 0; i < j; i++)
+				vectorAxpy(g[i], basis[i], vectorR);
+
+			preconditioner.apply(vectorR, vectorZ);
+			vectorAxpy(T(1), vectorZ, x);
+
+			if (breakdown)
+				break;
+		}
+
+		statistics.converged = false;
+
+		return statistics;
+	}
+
+	/*! solveGMRES
+	* Solve A * x = b by restarted GMRES without preconditioner
+	* O A: The operator A, with apply(x, y) calculating y = A * x, or a Matrix
+	* Matrix<T> b: The vector b
+	* Matrix<T> x: The initial guess, receives the solution; zero is used when its size is not the size of b
+	* IterativeSettings<T> settings: The stop criteria
+	* return: The iterations, the residual and if the method converged
+	*/
+	template <typename O, typename T>
+	IterativeStatistics<T> solveGMRES(const O& A, const Matrix<T>& b, Matrix<T>& x, const IterativeSettings<T>& settings)
+	{
+		return solveGMRES(A, b, x, IdentityPreconditioner<T>(), settings);
+	}
+
+	/*! applyOperator
+	* Calculate y = A * x by the apply of the operator
+	* O A: The operator
+	* Matrix<T> vectorX: The vector x
+	* Matrix<T> vectorY: Receives the vector y
+	*/
+	template <typename O, typename T>
+	void applyOperator(const O& A, const Matrix<T>& vectorX, Matrix<T>& vectorY)
+	{
+		A.apply(vectorX, vectorY);
+	}
+
+	/*! applyOperator
+	* Calculate y = A * x for a dense matrix by the SIMD gemv kernel, see gemvKernel
+	* Matrix<T> A: The matrix
+	* Matrix<T> vectorX: The vector x
+	* Matrix<T> vectorY: Receives the vector y
+	*/
+	template <typename T>
+	void applyOperator(const Matrix<T>& A, const Matrix<T>& vectorX, Matrix<T>& vectorY)
+	{
+		if (A.getColumns() != vectorX.getRows() || vectorX.getColumns() != 1)
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, A.getRows(), A.getColumns(), vectorX.getRows(), vectorX.getColumns(), '*'));
+
+		if (vectorY.getRows() != A.getRows() || vectorY.getColumns() != 1)
+			vectorY.resize(A.getRows(), 1);
+
+		gemvKernel(A.getRows(), A.getColumns(), T(1), A.data(), A.getStride(), 1, vectorX.data(), vectorX.getStride(), T(0), vectorY.data(), vectorY.getStride());
+	}
+
+	/*! vectorDot
+	* Calculate x . y of two column vectors
+	* The sum is split in a fixed quantities of blocks, so the result does not depend on the threads
+	* Matrix<T> vectorX: The vector x
+	* Matrix<T> vectorY: The vector y, same size of x
+	* return: The dot product
+	*/
+	template <typename T>
+	T vectorDot(const Matrix<T>& vectorX, const Matrix<T>& vectorY)
+	{
+		const uint n = vectorX.getRows();
+		const uint blocks = 64;
+		const size_t strideX = vectorX.getStride(), strideY = vectorY.getStride();
+		const T* dataX = vectorX.data();
+		const T* dataY = vectorY.data();
+		T partials[blocks];
+
+		parallelFor(0, blocks, 2.0 * n, [&](uint from, uint to)
+		{
+			for (uint block = from; block < to; block++)
+			{
+				const uint begin = uint((size_t(n) * block) / blocks);
+				const uint end = uint((size_t(n) * (block + 1)) / blocks);
+				T value = T(0);
+
+				if (strideX == 1 && strideY == 1)
+				{
+					for (uint i = begin; i < end; i++)
+						value += dataX[i] * dataY[i];
+				}
+				else
+				{
+					for (uint i = begin; i < end; i++)
+						value += dataX[i * strideX] * dataY[i * strideY];
+				}
+
+				partials[block] = value;
+			}
+		});
+
+		T result = T(0);
+
+		for (uint block = 0; block < blocks; block++)
+			result += partials[block];
+
+		return result;
+	}
+
+	/*! vectorNorm
+	* Calculate the euclidean norm of a column vector
+	* Matrix<T> vectorX: The vector x
+	* return: The norm
+	*/
+	template <typename T>
+	T vectorNorm(const Matrix<T>& vectorX)
+	{
+		return std::sqrt(vectorDot(vectorX, vectorX));
+	}
+
+	/*! vectorAxpy
+	* Calculate y = alpha * x + y of two column vectors
+	* T alpha: Value multiplied to x
+	* Matrix<T> vectorX: The vector x
+	* Matrix<T> vectorY: The vector y, same size of x
+	*/
+	template <typename T>
+	void vectorAxpy(const T& alpha, const Matrix<T>& vectorX, Matrix<T>& vectorY)
+	{
+		const size_t strideX = vectorX.getStride(), strideY = vectorY.getStride();
+		const T* dataX = vectorX.data();
+		T* dataY = vectorY.data();
+
+		parallelFor(0, vectorX.getRows(), 2.0 * vectorX.getRows(), [&](uint from, uint to)
+		{
+			if (strideX == 1 && strideY == 1)
+				simdKernels<T>().axpy(to - from, alpha, dataX + from, dataY + from);
+			else
+				for (uint i = from; i < to; i++)
+					dataY[i * strideY] += alpha * dataX[i * strideX];
+		});
+	}
+
+	/*! vectorXpby
+	* Calculate y = x + beta * y of two column vectors
+	* Matrix<T> vectorX: The vector x
+	* T beta: Value multiplied to y
+	* Matrix<T> vectorY: The vector y, same size of x
+	*/
+	template <typename T>
+	void vectorXpby(const Matrix<T>& vectorX, const T& beta, Matrix<T>& vectorY)
+	{
+		const size_t strideX = vectorX.getStride(), strideY = vectorY.getStride();
+		const T* dataX = vectorX.data();
+		T* dataY = vectorY.data();
+
+		parallelFor(0, vectorX.getRows(), 2.0 * vectorX.getRows(), [&](uint from, uint to)
+		{
+			if (strideX == 1 && strideY == 1)
+			{
+				simdKernels<T>().scale(to - from, beta, dataY + from);
+				simdKernels<T>().axpy(to - from, T(1), dataX + from, dataY + from);
+			}
+			else
+				for (uint i = from; i < to; i++)
+					dataY[i * strideY] = dataX[i * strideX] + beta * dataY[i * strideY];
+		});
+	}
+
+	/*! vectorScale
+	* Calculate x = alpha * x of a column vector
+	* T alpha: Value multiplied to x
+	* Matrix<T> vectorX: The vector x
+	*/
+	template <typename T>
+	void vectorScale(const T& alpha, Matrix<T>& vectorX)
+	{
+		const size_t strideX = vectorX.getStride();
+		T* dataX = vectorX.data();
+
+		parallelFor(0, vectorX.getRows(), double(vectorX.getRows()), [&](uint from, uint to)
+		{
+			if (strideX == 1)
+				simdKernels<T>().scale(to - from, alpha, dataX + from);
+			else
+				for (uint i = from; i < to; i++)
+					dataX[i * strideX] *= alpha;
+		});
+	}
+
+	/*! iterativeStart
+	* Check the sizes of an iterative solve and start x with zero when it has not the size of b
+	* uint n: Size of A
+	* Matrix<T> b: The vector b
+	* Matrix<T> x: The initial guess
+	*/
+	template <typename T>
+	void iterativeStart(uint n, const Matrix<T>& b, Matrix<T>& x)
+	{
+		if (b.getColumns() != 1)
+			throw(MatrixException(MatrixExceptionType::INVALID_SIZE, b.getRows(), b.getColumns()));
+
+		if (x.getRows() != n || x.getColumns() != 1)
+			x = Matrix<T>(n, 1);
+	}
+
+}
+
+#endif
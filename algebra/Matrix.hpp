@@ -5,81 +5,94 @@
 #include <cstdint>
 #include <cstring>
 #include <algorithm>
+#include <utility>
+#include <new>
 #include "MatrixEnum.hpp"
+#include "MatrixException.hpp"
+#include "MatrixFixed.hpp"
+#include "MatrixAllocator.hpp"
+#include "MatrixGemm.hpp"
+#include "MatrixTranspose.hpp"
+#include "SimdKernels.hpp"
 
 namespace lito{
-	class MatrixException : public std::exception
-	{
-	public:
-		MatrixException (MatrixExceptionType exceptionType, uint rowFirst = 0, uint columnFirst = 0, uint rowSecond = 0, uint columnSecond = 0, char operation = ' ')
-			: _exceptionType(exceptionType)
-			, _rowFirst(rowFirst)
-			, _columnFirst(columnFirst)
-			, _rowSecond(rowSecond)
-			, _columnSecond(columnSecond)
-			, _operation(operation)
-		{}
-
-		void showExeception ()
-		{
-			switch (_exceptionType)
-			{
-			case MatrixExceptionType::INVALID_ACCESS:
-				std::cerr <<    "Invalid access for matrix( " << _rowFirst  << ", " << _columnFirst
-					      << " ):  possition accessed was ( " << _rowSecond << ", " << _columnSecond << " )!" << std::endl;
-				break;
-			case MatrixExceptionType::INVALID_SIZE:
-				std::cerr << "Invalid size: " << "( " << _rowFirst << ", " << _columnFirst << " )!" << std::endl;
-				break;
-			case MatrixExceptionType::INCOMPATIBLE_SIZES:
-				std::cerr << "Invalid sizes for " << _operation
-					      <<    " operation: M1( " << _rowFirst  << ", " << _columnFirst  << " ) "
-					      << _operation << " M2( " << _rowSecond << ", " << _columnSecond << " )!" << std::endl;
-				break;
-			case MatrixExceptionType::MATRIX_NOT_INITIALIZED:
-				std::cerr << "Matrix not initialized!" << std::endl;
-				break;
-			}
-		}
 
-	private:
-		MatrixExceptionType _exceptionType;
-		uint _rowFirst;
-		uint _columnFirst;
-		uint _rowSecond;
-		uint _columnSecond;
-		char _operation;
-	};
+	template <typename E> class MatrixExpression;
+	template <typename T> class MatrixReference;
 
+	/*! Matrix
+	* Matrix with the sizes known at run time, stored in a storage given by a MatrixAllocator
+	*/
 	template <typename T>
-	class Matrix {
+	class Matrix<T, 0, 0> {
 	public:
 		Matrix();
-		Matrix(uint rows, uint columns, const MatrixType& type = MatrixType::ZEROS);
+		explicit Matrix(MatrixAllocator* allocator);
+		Matrix(uint rows, uint columns, const MatrixType& type = MatrixType::ZEROS, MatrixAllocator* allocator = nullptr);
 		Matrix(uint rows, uint columns, const T* data);
 		Matrix(const Matrix<T>& copyMatrix);
+		Matrix(Matrix<T>&& moveMatrix) noexcept;
+		template <typename E> Matrix(const MatrixExpression<E>& expression);
+		template <uint R, uint C> Matrix(const Matrix<T, R, C>& fixedMatrix);
 		~Matrix();
 
 		Matrix<T>& resize(uint rows, uint columns);
 		
 		T& operator () (const uint& line, const uint& column);
 		const T& operator () (const uint& line, const uint& column) const;
+		T& at (const uint& line, const uint& column);
+		const T& at (const uint& line, const uint& column) const;
+
+		T* row (const uint& line);
+		const T* row (const uint& line) const;
+		T* data ();
+		const T* data () const;
 
 		const uint& getRows() const;
 		const uint& getColumns() const;
+		const uint& getStride() const;
+		const size_t& getCapacity() const;
+		MatrixAllocator* getAllocator() const;
 	
 		Matrix<T>& operator = (const Matrix<T>& rec);
-
-		Matrix<T> operator + (const Matrix<T>& sum) const;
-		Matrix<T> operator - (const Matrix<T>& sub) const;
+		Matrix<T>& operator = (Matrix<T>&& rec) noexcept;
+		template <typename E> Matrix<T>& operator = (const MatrixExpression<E>& expression);
+
+		Matrix<T> operator + (const Matrix<T>& sum) const &;
+		Matrix<T> operator + (const Matrix<T>& sum) &&;
+		Matrix<T> operator + (Matrix<T>&& sum) const &;
+		Matrix<T> operator + (Matrix<T>&& sum) &&;
+		Matrix<T> operator - (const Matrix<T>& sub) const &;
+		Matrix<T> operator - (const Matrix<T>& sub) &&;
+		Matrix<T> operator - (Matrix<T>&& sub) const &;
+		Matrix<T> operator - (Matrix<T>&& sub) &&;
 		Matrix<T> operator * (const Matrix<T>& mul) const;
-		Matrix<T> mul (const Matrix<T>& mul) const;
+		Matrix<T> mul (const Matrix<T>& mul) const &;
+		Matrix<T> mul (const Matrix<T>& mul) &&;
+		Matrix<T> mul (Matrix<T>&& mul) const &;
+		Matrix<T> mul (Matrix<T>&& mul) &&;
 	
-		Matrix<T> operator + (const T& sum) const;
-		Matrix<T> operator - (const T& sub) const;
-		Matrix<T> operator * (const T& mul) const;
+		Matrix<T> operator + (const T& sum) const &;
+		Matrix<T> operator + (const T& sum) &&;
+		Matrix<T> operator - (const T& sub) const &;
+		Matrix<T> operator - (const T& sub) &&;
+		Matrix<T> operator * (const T& mul) const &;
+		Matrix<T> operator * (const T& mul) &&;
 
-		Matrix<T> transpose () const;
+		Matrix<T>& operator += (const Matrix<T>& sum);
+		Matrix<T>& operator -= (const Matrix<T>& sub);
+		Matrix<T>& operator *= (const Matrix<T>& mul);
+		Matrix<T>& mulAssign (const Matrix<T>& mul);
+
+		Matrix<T>& operator += (const T& sum);
+		Matrix<T>& operator -= (const T& sub);
+		Matrix<T>& operator *= (const T& mul);
+
+		template <typename E> Matrix<T>& operator += (const MatrixExpression<E>& expression);
+		template <typename E> Matrix<T>& operator -= (const MatrixExpression<E>& expression);
+
+		Matrix<T> transpose () const &;
+		Matrix<T> transpose () &&;
 
 		Matrix<T>& elementarOperationSumLines(const uint &lineMult, const uint &lineSum, const T &constMult = T(1));
 		Matrix<T>& elementarOperationMultLine(const uint &line, const T &constMult = T(1));
@@ -87,11 +100,21 @@ namespace lito{
 		Matrix<T>& elementarOperationSwitchColumns(const uint& column1, const uint& column2);
 
 		template <typename _T> friend Matrix<_T> operator + (const Matrix<_T>& sum);
+		template <typename _T> friend Matrix<_T> operator + (Matrix<_T>&& sum);
 		template <typename _T> friend Matrix<_T> operator - (const Matrix<_T>& sub);
+		template <typename _T> friend Matrix<_T> operator - (Matrix<_T>&& sub);
 
 		template <typename _T> friend Matrix<_T> operator + (const _T& sum, const Matrix<_T>& mat);
+		template <typename _T> friend Matrix<_T> operator + (const _T& sum, Matrix<_T>&& mat);
 		template <typename _T> friend Matrix<_T> operator - (const _T& sub, const Matrix<_T>& mat);
+		template <typename _T> friend Matrix<_T> operator - (const _T& sub, Matrix<_T>&& mat);
 		template <typename _T> friend Matrix<_T> operator * (const _T& mul, const Matrix<_T>& mat);
+		template <typename _T> friend Matrix<_T> operator * (const _T& mul, Matrix<_T>&& mat);
+
+		template <typename _T> friend class MatrixReference;
+
+		template <typename _T>
+		friend void gemm(const _T& alpha, const Matrix<_T>& A, const Matrix<_T>& B, const _T& beta, Matrix<_T>& C);
 
 		template <typename _T>
 		friend Matrix<_T> matMul(const Matrix<_T>& matrix1, const Matrix<_T>& matrix2);
@@ -99,11 +122,20 @@ namespace lito{
 		friend std::ostream& operator << (std::ostream& out, const Matrix<_T>& mat);
 
 	private:
+		static uint strideFor(uint columns, const MatrixAllocator* allocator);
+		void release();
+		void copyValues(const Matrix<T>& other);
+		template <typename F> void forEachSpan(const Matrix<T>& other, const F& func);
+
 		uint _rows;
 		uint _columns;
+		uint _stride;
+		size_t _capacity;
 		T* _data;
+		MatrixAllocator* _allocator;
 	};
 	template <typename T> std::ostream& operator << (std::ostream& out, const Matrix<T>& mat);
+	template <typename T> void gemm(const T& alpha, const Matrix<T>& A, const Matrix<T>& B, const T& beta, Matrix<T>& C);
 	
 
 
@@ -112,9 +144,21 @@ namespace lito{
 	*/
 	template <typename T>
 	Matrix<T>::Matrix()
+		: Matrix(nullptr)
+	{}
+
+	/*! Matrix
+	* Initialize an empty matrix with the storage given by an allocator
+	* MatrixAllocator* allocator: The allocator, nullptr for matrixAllocator()
+	*/
+	template <typename T>
+	Matrix<T>::Matrix(MatrixAllocator* allocator)
 		: _rows(0)
 		, _columns(0)
+		, _stride(0)
+		, _capacity(0)
 		, _data(nullptr)
+		, _allocator((allocator != nullptr) ? allocator : matrixAllocator())
 	{}
 
 	/*! Matrix
@@ -122,27 +166,33 @@ namespace lito{
 	* uint rows: Quantities of rows
 	* uint columns: Quantities of columns
 	* MatrixType: The type of matrix (ones, zeros or identity)
+	* MatrixAllocator* allocator: The allocator, nullptr for matrixAllocator()
 	*/
 	template <typename T>
-	Matrix<T>::Matrix(uint rows, uint columns, const MatrixType& type)
-		: Matrix()
+	Matrix<T>::Matrix(uint rows, uint columns, const MatrixType& type, MatrixAllocator* allocator)
+		: Matrix(allocator)
 	{
 		resize(rows, columns);
 
 		if (_data != nullptr) {
-			switch (type)
+			for (uint i = 0; i < _rows; i++)
 			{
-			case MatrixType::IDENTITY:
-				for (uint i = 0; i < _rows; i++)
-					for (uint j = 0; j < _columns; j++)
-						_data[j + (_columns * i)] = (i == j) ? T(1) : T(0);
-				break;
-			case MatrixType::ZEROS:
-				std::fill(_data, _data + (_rows * _columns), T(0));
-				break;
-			case MatrixType::ONES:
-				std::fill(_data, _data + (_rows * _columns), T(1));
-				break;
+				T* line = _data + (size_t(_stride) * i);
+
+				switch (type)
+				{
+				case MatrixType::IDENTITY:
+					std::fill(line, line + _columns, T(0));
+					if (i < _columns)
+						line[i] = T(1);
+					break;
+				case MatrixType::ZEROS:
+					std::fill(line, line + _columns, T(0));
+					break;
+				case MatrixType::ONES:
+					std::fill(line, line + _columns, T(1));
+					break;
+				}
 			}
 		}
 	}
@@ -151,7 +201,7 @@ namespace lito{
 	* Initialize the matrix with a array
 	* uint rows: Quantities of rows
 	* uint columns: Quantities of columns
-	* T*: The array to be copied
+	* T*: The array to be copied, stored line after line without padding
 	*/
 	template <typename T>
 	Matrix<T>::Matrix(uint rows, uint columns, const T* data)
@@ -159,20 +209,55 @@ namespace lito{
 	{
 		resize(rows, columns);
 
-		std::copy(data, data + (_rows * _columns), _data);
+		for (uint i = 0; i < _rows; i++)
+			std::copy(data + (size_t(_columns) * i), data + (size_t(_columns) * (i + 1)), _data + (size_t(_stride) * i));
 	}
 
 	/*! Matrix
-	* Initialize the matrix as copy of another matrix
+	* Initialize the matrix as copy of another matrix, with the same allocator
 	* Matrix<T> copyMatrix: The matrix to be copied
 	*/
 	template <typename T>
 	Matrix<T>::Matrix(const Matrix<T>& copyMatrix)
-		: Matrix()
+		: Matrix(copyMatrix._allocator)
 	{
 		resize(copyMatrix._rows, copyMatrix._columns);
+		copyValues(copyMatrix);
+	}
+
+	/*! Matrix
+	* Initialize the matrix taking the storage and the allocator of another matrix
+	* Matrix<T> moveMatrix: The matrix to be moved, left empty
+	*/
+	template <typename T>
+	Matrix<T>::Matrix(Matrix<T>&& moveMatrix) noexcept
+		: _rows(moveMatrix._rows)
+		, _columns(moveMatrix._columns)
+		, _stride(moveMatrix._stride)
+		, _capacity(moveMatrix._capacity)
+		, _data(moveMatrix._data)
+		, _allocator(moveMatrix._allocator)
+	{
+		moveMatrix._rows = 0;
+		moveMatrix._columns = 0;
+		moveMatrix._stride = 0;
+		moveMatrix._capacity = 0;
+		moveMatrix._data = nullptr;
+	}
+
+	/*! Matrix
+	* Initialize the matrix as copy of a matrix with the sizes known at compile time
+	* Matrix<T, R, C> fixedMatrix: The matrix to be copied
+	*/
+	template <typename T>
+	template <uint R, uint C>
+	Matrix<T>::Matrix(const Matrix<T, R, C>& fixedMatrix)
+		: Matrix()
+	{
+		resize(R, C);
 
-		memcpy(_data, copyMatrix._data, sizeof(T) * (_rows * _columns));
+		for (uint i = 0; i < _rows; i++)
+			std::copy(fixedMatrix.data() + (size_t(C) * i), fixedMatrix.data() + (size_t(C) * (i + 1)), _data + (size_t(_stride) * i));
 	}
 
 	/*! ~Matrix
@@ -181,12 +266,14 @@ namespace lito{
 	template <typename T>
 	Matrix<T>::~Matrix()
 	{
-		if (_data != nullptr)
-			delete [] _data;
+		release();
 	}
 
 	/*! resize
 	* Resize the quantites of rows or columns of the matrix
+	* The storage is kept when its capacity is enough, otherwise a new one is allocated,
+	* an empty shape releases it
+	* The values are not kept, the padding of the rows is filled with zeros
 	* uint rows: New quantities of rows
 	* uint columns: New quantities of columns
 	* return: The matrix resized
@@ -194,22 +281,134 @@ namespace lito{
 	template <typename T>
 	Matrix<T>& Matrix<T>::resize(uint rows, uint columns)
 	{
-			_rows = rows;
-			_columns = columns;
+		uint stride = strideFor(columns, _allocator);
+		size_t size = (rows > 0 && columns > 0) ? size_t(rows) * stride : 0;
+
+		if (size == 0)
+		{
+			release();
+		}
+		else if (size > _capacity)
+		{
+			release();
+
+			_data = static_cast<T*>(_allocator->allocate(sizeof(T) * size, _allocator->getAlignment()));
+			_capacity = size;
+
+			for (size_t i = 0; i < size; i++)
+				new (_data + i) T;
+		}
 
-			if (_data != nullptr)
-				delete[] _data;
+		_rows = rows;
+		_columns = columns;
+		_stride = stride;
 
-			if (_rows > 0 && _columns > 0)
-				_data = new T[_rows * _columns];
-			else
-				_data = nullptr;
+		if (size > 0 && stride != columns)
+			for (uint i = 0; i < rows; i++)
+				std::fill(_data + (size_t(stride) * i) + columns, _data + (size_t(stride) * (i + 1)), T(0));
 
 		return *this;
 	}
+
+	/*! strideFor
+	* Calculate the distance between two rows for the allocator
+	* With row padding each row takes a multiple of the alignment of the allocator
+	* uint columns: Quantities of columns
+	* MatrixAllocator* allocator: The allocator
+	* return: The distance between two rows
+	*/
+	template <typename T>
+	uint Matrix<T>::strideFor(uint columns, const MatrixAllocator* allocator)
+	{
+		size_t alignment = allocator->getAlignment();
+
+		if (!allocator->getRowPadding() || columns == 0 || alignment % sizeof(T) != 0)
+			return columns;
+
+		return uint((((size_t(columns) * sizeof(T)) + alignment - 1) / alignment) * (alignment / sizeof(T)));
+	}
+
+	/*! release
+	* Destroy the values and give the storage back to the allocator
+	*/
+	template <typename T>
+	void Matrix<T>::release()
+	{
+		if (_data != nullptr)
+		{
+			for (size_t i = 0; i < _capacity; i++)
+				_data[i].~T();
+
+			_allocator->deallocate(_data, sizeof(T) * _capacity, _allocator->getAlignment());
+		}
+
+		_rows = 0;
+		_columns = 0;
+		_stride = 0;
+		_capacity = 0;
+		_data = nullptr;
+	}
+
+	/*! copyValues
+	* Copy the values of a matrix with the same shape
+	* Matrix<T> other: The matrix to be copied
+	*/
+	template <typename T>
+	void Matrix<T>::copyValues(const Matrix<T>& other)
+	{
+		if (_stride == other._stride)
+			std::copy(other._data, other._data + (size_t(_rows) * _stride), _data);
+		else
+			for (uint i = 0; i < _rows; i++)
+				std::copy(other._data + (size_t(other._stride) * i), other._data + (size_t(other._stride) * i) + _columns, _data + (size_t(_stride) * i));
+	}
+
+	/*! forEachSpan
+	* Call func over the values of this matrix and of a matrix with the same shape
+	* With the same stride the padding is included and consecutive rows are joined into spans
+	* of up to 2^32 - 1 values, otherwise each row is a span
+	* Matrix<T> other: The other matrix
+	* F func: Function called as func(data, otherData, count) for each span
+	*/
+	template <typename T>
+	template <typename F>
+	void Matrix<T>::forEachSpan(const Matrix<T>& other, const F& func)
+	{
+		T* data = _data;
+		const T* otherData = other._data;
+		uint columns = _columns;
+		uint stride = _stride;
+		uint otherStride = other._stride;
+
+		if (stride == otherStride)
+		{
+			// The chunks are of rows, so the counts fit in uint whatever the size of the storage
+			uint lines = std::max(1u, uint(-1) / std::max(stride, 1u));
+
+			parallelFor(0, _rows, double(_rows) * _columns, [=](uint from, uint to)
+			{
+				for (uint i = from, count; i < to; i += count)
+				{
+					size_t offset = size_t(stride) * i;
+
+					count = std::min(lines, to - i);
+					func(data + offset, otherData + offset, stride * count);
+				}
+			});
+		}
+		else
+		{
+			parallelFor(0, _rows, double(_rows) * _columns, [=](uint from, uint to)
+			{
+				for (uint i = from; i < to; i++)
+					func(data + (size_t(stride) * i), otherData + (size_t(otherStride) * i), columns);
+			});
+		}
+	}
 	
 	/*! operator ()
 	* Get the value of specific line and column
+	* Checked only when LITO_MATRIX_CHECK_BOUNDS is on
 	* uint line: Indice of the line
 	* uint column: Indice of the column
 	* return: The value of specific line and column
@@ -217,14 +416,17 @@ namespace lito{
 	template <typename T>
 	T& Matrix<T>::operator () (const uint& line, const uint& column)
 	{
-		if (line < 0 || line >= _rows || column < 0 || column > _columns)
+#if LITO_MATRIX_CHECK_BOUNDS
+		if (line >= _rows || column >= _columns)
 			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, _rows, _columns, line, column));
+#endif
 
-		return _data[column + (_columns * line)];
+		return _data[column + (size_t(_stride) * line)];
 	}
 
 	/*! operator ()
 	* Get the value of specific line and column
+	* Checked only when LITO_MATRIX_CHECK_BOUNDS is on
 	* uint line: Indice of the line
 	* uint column: Indice of the column
 	* return: The value of specific line and column
@@ -232,10 +434,96 @@ namespace lito{
 	template <typename T>
 	const T& Matrix<T>::operator () (const uint& line, const uint& column) const
 	{
-		if (line < 0 || line >= _rows || column < 0 || column >= _columns)
+#if LITO_MATRIX_CHECK_BOUNDS
+		if (line >= _rows || column >= _columns)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, _rows, _columns, line, column));
+#endif
+
+		return _data[column + (size_t(_stride) * line)];
+	}
+
+	/*! at
+	* Get the value of specific line and column, always checked
+	* uint line: Indice of the line
+	* uint column: Indice of the column
+	* return: The value of specific line and column
+	*/
+	template <typename T>
+	T& Matrix<T>::at (const uint& line, const uint& column)
+	{
+		if (line >= _rows || column >= _columns)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, _rows, _columns, line, column));
+
+		return _data[column + (size_t(_stride) * line)];
+	}
+
+	/*! at
+	* Get the value of specific line and column, always checked
+	* uint line: Indice of the line
+	* uint column: Indice of the column
+	* return: The value of specific line and column
+	*/
+	template <typename T>
+	const T& Matrix<T>::at (const uint& line, const uint& column) const
+	{
+		if (line >= _rows || column >= _columns)
 			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, _rows, _columns, line, column));
 
-		return _data[column + (_columns * line)];
+		return _data[column + (size_t(_stride) * line)];
+	}
+
+	/*! row
+	* Get the first value of a line, the getColumns() values of the line follow it
+	* Checked only when LITO_MATRIX_CHECK_BOUNDS is on
+	* uint line: Indice of the line
+	* return: Pointer to the line
+	*/
+	template <typename T>
+	T* Matrix<T>::row (const uint& line)
+	{
+#if LITO_MATRIX_CHECK_BOUNDS
+		if (line >= _rows)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, _rows, _columns, line, 0));
+#endif
+
+		return _data + (size_t(_stride) * line);
+	}
+
+	/*! row
+	* Get the first value of a line, the getColumns() values of the line follow it
+	* Checked only when LITO_MATRIX_CHECK_BOUNDS is on
+	* uint line: Indice of the line
+	* return: Pointer to the line
+	*/
+	template <typename T>
+	const T* Matrix<T>::row (const uint& line) const
+	{
+#if LITO_MATRIX_CHECK_BOUNDS
+		if (line >= _rows)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, _rows, _columns, line, 0));
+#endif
+
+		return _data + (size_t(_stride) * line);
+	}
+
+	/*! data
+	* Get the values of the matrix, stored line after line getStride() values apart
+	* return: Pointer to the first value, nullptr when not initialized
+	*/
+	template <typename T>
+	T* Matrix<T>::data ()
+	{
+		return _data;
+	}
+
+	/*! data
+	* Get the values of the matrix, stored line after line getStride() values apart
+	* return: Pointer to the first value, nullptr when not initialized
+	*/
+	template <typename T>
+	const T* Matrix<T>::data () const
+	{
+		return _data;
 	}
 
 	/*! getRows
@@ -262,8 +550,38 @@ namespace lito{
 		return _columns;
 	}
 	
+	/*! getStride
+	* Get the distance between two rows of the storage
+	* return: The distance, getColumns() when the rows are not padded
+	*/
+	template <typename T>
+	const uint& Matrix<T>::getStride() const
+	{
+		return _stride;
+	}
+
+	/*! getCapacity
+	* Get the quantities of values the storage holds, resize keeps the storage up to it
+	* return: The capacity
+	*/
+	template <typename T>
+	const size_t& Matrix<T>::getCapacity() const
+	{
+		return _capacity;
+	}
+
+	/*! getAllocator
+	* Get the allocator of the storage
+	* return: The allocator
+	*/
+	template <typename T>
+	MatrixAllocator* Matrix<T>::getAllocator() const
+	{
+		return _allocator;
+	}
+	
 	/*! operator =
-	* Copy the matrix
+	* Copy the matrix, the allocator and the storage of this matrix are kept when possible
 	* Matrix<T> rec: The matrix to be copied
 	* return: The matrix modified
 	*/
@@ -273,8 +591,36 @@ namespace lito{
 		if (this != &rec)
 		{
 			resize(rec._rows, rec._columns);
+			copyValues(rec);
+		}
+
+		return *this;
+	}
 
-			memcpy(_data, rec._data, sizeof(T) * (_rows * _columns));
+	/*! operator =
+	* Take the storage and the allocator of another matrix
+	* Matrix<T> rec: The matrix to be moved, left empty
+	* return: The matrix modified
+	*/
+	template <typename T>
+	Matrix<T>& Matrix<T>::operator = (Matrix<T>&& rec) noexcept
+	{
+		if (this != &rec)
+		{
+			release();
+
+			_rows = rec._rows;
+			_columns = rec._columns;
+			_stride = rec._stride;
+			_capacity = rec._capacity;
+			_data = rec._data;
+			_allocator = rec._allocator;
+
+			rec._rows = 0;
+			rec._columns = 0;
+			rec._stride = 0;
+			rec._capacity = 0;
+			rec._data = nullptr;
 		}
 
 		return *this;
@@ -286,21 +632,49 @@ namespace lito{
 	* return: The sum of the matrices
 	*/
 	template <typename T>
-	Matrix<T> Matrix<T>::operator + (const Matrix<T>& sum) const
+	Matrix<T> Matrix<T>::operator + (const Matrix<T>& sum) const &
 	{
-		if (_rows != sum._rows || _columns != sum._columns)
-			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, _rows, _columns, sum._rows, sum._columns, '+'));
-		else if (_data == nullptr)
-			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+		Matrix<T> newMatrix(*this);
+
+		newMatrix += sum;
 
-		Matrix<T> newMatrix(_rows, _columns);
-	
-		for (uint i = 0; i < _rows; i++)
-			for (uint j = 0; j < _columns; j++)
-				newMatrix(i, j) = (*this)(i, j) + sum(i, j);
-		
 		return newMatrix;
 	}
+
+	/*! operator +
+	* Sum the matrices reusing the storage of this expiring matrix
+	* Matrix<T> sum: Matrix to be added
+	* return: The sum of the matrices
+	*/
+	template <typename T>
+	Matrix<T> Matrix<T>::operator + (const Matrix<T>& sum) &&
+	{
+		*this += sum;
+
+		return std::move(*this);
+	}
+
+	/*! operator +
+	* Sum the matrices reusing the storage of the expiring matrix sum
+	* Matrix<T> sum: Matrix to be added
+	* return: The sum of the matrices
+	*/
+	template <typename T>
+	Matrix<T> Matrix<T>::operator + (Matrix<T>&& sum) const &
+	{
+		return std::move(sum) + *this;
+	}
+
+	/*! operator +
+	* Sum the matrices reusing the storage of this expiring matrix
+	* Matrix<T> sum: Matrix to be added
+	* return: The sum of the matrices
+	*/
+	template <typename T>
+	Matrix<T> Matrix<T>::operator + (Matrix<T>&& sum) &&
+	{
+		return std::move(*this) + sum;
+	}
 	
 	/*! operator -
 	* Subtract the matrices
@@ -308,72 +682,134 @@ namespace lito{
 	* return: The subtract of the matrices
 	*/
 	template <typename T>
-	Matrix<T> Matrix<T>::operator - (const Matrix<T>& sub) const
+	Matrix<T> Matrix<T>::operator - (const Matrix<T>& sub) const &
+	{
+		Matrix<T> newMatrix(*this);
+
+		newMatrix -= sub;
+
+		return newMatrix;
+	}
+
+	/*! operator -
+	* Subtract the matrices reusing the storage of this expiring matrix
+	* Matrix<T> sub: Matrix to be subtracted
+	* return: The subtract of the matrices
+	*/
+	template <typename T>
+	Matrix<T> Matrix<T>::operator - (const Matrix<T>& sub) &&
+	{
+		*this -= sub;
+
+		return std::move(*this);
+	}
+
+	/*! operator -
+	* Subtract the matrices reusing the storage of the expiring matrix sub
+	* Matrix<T> sub: Matrix to be subtracted
+	* return: The subtract of the matrices
+	*/
+	template <typename T>
+	Matrix<T> Matrix<T>::operator - (Matrix<T>&& sub) const &
 	{
 		if (_rows != sub._rows || _columns != sub._columns)
 			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, _rows, _columns, sub._rows, sub._columns, '-'));
 		else if (_data == nullptr)
 			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
 
-		Matrix<T> newMatrix(_rows, _columns);
-	
 		for (uint i = 0; i < _rows; i++)
+		{
+			const T* line = _data + (size_t(_stride) * i);
+			T* lineSub = sub._data + (size_t(sub._stride) * i);
+
 			for (uint j = 0; j < _columns; j++)
-				newMatrix(i, j) = (*this)(i, j) - sub(i, j);
-	
-		return newMatrix;
+				lineSub[j] = line[j] - lineSub[j];
+		}
+
+		return std::move(sub);
+	}
+
+	/*! operator -
+	* Subtract the matrices reusing the storage of this expiring matrix
+	* Matrix<T> sub: Matrix to be subtracted
+	* return: The subtract of the matrices
+	*/
+	template <typename T>
+	Matrix<T> Matrix<T>::operator - (Matrix<T>&& sub) &&
+	{
+		return std::move(*this) - sub;
 	}
 	
 	/*! operator *
 	* Matrices multiplication
 	* Matrix<T> mul: Matrix to multiply
-	* return: The matrix of multiplication of the matrices
+	* return: The matrix of multiplication of the matrices, with the allocator of this matrix
 	*/
 	template <typename T>
 	Matrix<T> Matrix<T>::operator * (const Matrix<T>& mul) const
 	{
 		if (_columns != mul._rows)
 			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, _rows, _columns, mul._rows, mul._columns, 'X'));
-		else if (_data == nullptr || _data == nullptr)
+		else if (_data == nullptr || mul._data == nullptr)
 			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
 
-		Matrix<T> newMatrix(_rows, mul._columns);
+		Matrix<T> newMatrix(_allocator);
 
-		for (uint i = 0; i < _rows; i++)
-		{
-			for (uint j = 0; j < mul._columns; j++)
-			{
-				for (uint k = 0; k < _columns; k++)
-				{
-					newMatrix(i, j) += (*this)(i, k) * mul(k, j);
-				}
-			}
-		}
+		newMatrix.resize(_rows, mul._columns);
+		gemmKernel(_rows, mul._columns, _columns, T(1), _data, _stride, 1, mul._data, mul._stride, 1, T(0), newMatrix._data, newMatrix._stride);
 
 		return newMatrix;
 	}
 
-	/*! operator *
+	/*! mul
 	* Multiply the matrices value to value
 	* Matrix<T> mul: Matrix to be multiplied
 	* return: The multiplication of the matrices
 	*/
 	template <typename T>
-	Matrix<T> Matrix<T>::mul (const Matrix<T>& mul) const
+	Matrix<T> Matrix<T>::mul (const Matrix<T>& mul) const &
 	{
-		if (_rows != mul._rows || _columns != mul._columns)
-			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, _rows, _columns, mul._rows, mul._columns, '*'));
-		else if (_data == nullptr)
-			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+		Matrix<T> newMatrix(*this);
 
-		Matrix<T> newMatrix(_rows, _columns);
-
-		for (uint i = 0; i < _rows; i++)
-			for (uint j = 0; j < _columns; j++)
-				newMatrix(i, j) = (*this)(i, j) * mul(i, j);
+		newMatrix.mulAssign(mul);
 
 		return newMatrix;
 	}
+
+	/*! mul
+	* Multiply the matrices value to value reusing the storage of this expiring matrix
+	* Matrix<T> mul: Matrix to be multiplied
+	* return: The multiplication of the matrices
+	*/
+	template <typename T>
+	Matrix<T> Matrix<T>::mul (const Matrix<T>& mul) &&
+	{
+		mulAssign(mul);
+
+		return std::move(*this);
+	}
+
+	/*! mul
+	* Multiply the matrices value to value reusing the storage of the expiring matrix mul
+	* Matrix<T> mul: Matrix to be multiplied
+	* return: The multiplication of the matrices
+	*/
+	template <typename T>
+	Matrix<T> Matrix<T>::mul (Matrix<T>&& mul) const &
+	{
+		return std::move(mul).mul(*this);
+	}
+
+	/*! mul
+	* Multiply the matrices value to value reusing the storage of this expiring matrix
+	* Matrix<T> mul: Matrix to be multiplied
+	* return: The multiplication of the matrices
+	*/
+	template <typename T>
+	Matrix<T> Matrix<T>::mul (Matrix<T>&& mul) &&
+	{
+		return std::move(*this).mul(mul);
+	}
 	
 	/*! operator +
 	* Sum the matrix with matrix identity multiplied to sum value
@@ -381,18 +817,27 @@ namespace lito{
 	* return: The sum of the matrix with matrix identity multiplied to sum value
 	*/
 	template <typename T>
-	Matrix<T> Matrix<T>::operator + (const T& sum) const
+	Matrix<T> Matrix<T>::operator + (const T& sum) const &
 	{
-		if (_data == nullptr)
-			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+		Matrix<T> newMatrix(*this);
 
-		Matrix<T> newMatrix(_rows, _columns, _data);
-	
-		for (uint i = 0; i < std::min(_rows, _columns); i++)
-				newMatrix(i, i) += sum;
+		newMatrix += sum;
 	
 		return newMatrix;
 	}
+
+	/*! operator +
+	* Sum the matrix with matrix identity multiplied to sum value reusing the storage of this expiring matrix
+	* T sum: Value to be multiplied to matrix identity
+	* return: The sum of the matrix with matrix identity multiplied to sum value
+	*/
+	template <typename T>
+	Matrix<T> Matrix<T>::operator + (const T& sum) &&
+	{
+		*this += sum;
+
+		return std::move(*this);
+	}
 	
 	/*! operator -
 	* Subtract the matrix with matrix identity multiplied to sub value
@@ -400,18 +845,27 @@ namespace lito{
 	* return: The subtraction of the matrix with matrix identity multiplied to sub value
 	*/
 	template <typename T>
-	Matrix<T> Matrix<T>::operator - (const T& sub) const
+	Matrix<T> Matrix<T>::operator - (const T& sub) const &
 	{
-		if (_data == nullptr)
-			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+		Matrix<T> newMatrix(*this);
 
-		Matrix<T> newMatrix(_rows, _columns, _data);
-	
-		for (uint i = 0; i < std::min(_rows, _columns); i++)
-			newMatrix(i, i) -= sub;
+		newMatrix -= sub;
 	
 		return newMatrix;
 	}
+
+	/*! operator -
+	* Subtract the matrix with matrix identity multiplied to sub value reusing the storage of this expiring matrix
+	* T sub: Value to be multiplied to matrix identity
+	* return: The subtraction of the matrix with matrix identity multiplied to sub value
+	*/
+	template <typename T>
+	Matrix<T> Matrix<T>::operator - (const T& sub) &&
+	{
+		*this -= sub;
+
+		return std::move(*this);
+	}
 	
 	/*! operator *
 	* Multiply the matrix with mul value
@@ -419,36 +873,227 @@ namespace lito{
 	* return: The multiplication of the matrix with mul value
 	*/
 	template <typename T>
-	Matrix<T> Matrix<T>::operator * (const T& mul) const
+	Matrix<T> Matrix<T>::operator * (const T& mul) const &
+	{
+		Matrix<T> newMatrix(*this);
+
+		newMatrix *= mul;
+	
+		return newMatrix;
+	}
+
+	/*! operator *
+	* Multiply the matrix with mul value reusing the storage of this expiring matrix
+	* T mul: Value to be multiplied
+	* return: The multiplication of the matrix with mul value
+	*/
+	template <typename T>
+	Matrix<T> Matrix<T>::operator * (const T& mul) &&
+	{
+		*this *= mul;
+
+		return std::move(*this);
+	}
+
+	/*! operator +=
+	* Sum the matrix sum into this matrix
+	* Matrix<T> sum: Matrix to be added
+	* return: The matrix modified
+	*/
+	template <typename T>
+	Matrix<T>& Matrix<T>::operator += (const Matrix<T>& sum)
+	{
+		if (_rows != sum._rows || _columns != sum._columns)
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, _rows, _columns, sum._rows, sum._columns, '+'));
+		else if (_data == nullptr)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+
+		forEachSpan(sum, [](T* data, const T* other, uint count)
+		{
+			simdKernels<T>().axpy(count, T(1), other, data);
+		});
+
+		return *this;
+	}
+
+	/*! operator -=
+	* Subtract the matrix sub from this matrix
+	* Matrix<T> sub: Matrix to be subtracted
+	* return: The matrix modified
+	*/
+	template <typename T>
+	Matrix<T>& Matrix<T>::operator -= (const Matrix<T>& sub)
+	{
+		if (_rows != sub._rows || _columns != sub._columns)
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, _rows, _columns, sub._rows, sub._columns, '-'));
+		else if (_data == nullptr)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+
+		forEachSpan(sub, [](T* data, const T* other, uint count)
+		{
+			simdKernels<T>().axpy(count, T(-1), other, data);
+		});
+
+		return *this;
+	}
+
+	/*! operator *=
+	* Multiply this matrix by the matrix mul
+	* Matrix<T> mul: Matrix to multiply
+	* return: The matrix modified
+	*/
+	template <typename T>
+	Matrix<T>& Matrix<T>::operator *= (const Matrix<T>& mul)
+	{
+		*this = (*this) * mul;
+
+		return *this;
+	}
+
+	/*! mulAssign
+	* Multiply this matrix by the matrix mul value to value
+	* Matrix<T> mul: Matrix to be multiplied
+	* return: The matrix modified
+	*/
+	template <typename T>
+	Matrix<T>& Matrix<T>::mulAssign (const Matrix<T>& mul)
+	{
+		if (_rows != mul._rows || _columns != mul._columns)
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, _rows, _columns, mul._rows, mul._columns, '*'));
+		else if (_data == nullptr)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+
+		forEachSpan(mul, [](T* data, const T* other, uint count)
+		{
+			simdKernels<T>().mul(count, other, data);
+		});
+
+		return *this;
+	}
+
+	/*! operator +=
+	* Sum the matrix identity multiplied to sum value into this matrix
+	* T sum: Value to be multiplied to matrix identity
+	* return: The matrix modified
+	*/
+	template <typename T>
+	Matrix<T>& Matrix<T>::operator += (const T& sum)
 	{
 		if (_data == nullptr)
 			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
 
-		Matrix<T> newMatrix(_rows, _columns, _data);
-	
-		for (uint i = 0; i < _rows; i++)
-			for (uint j = 0; j < _columns; j++)
-				newMatrix(i, j) *= mul;
-	
+		for (uint i = 0; i < std::min(_rows, _columns); i++)
+			_data[i + (size_t(_stride) * i)] += sum;
+
+		return *this;
+	}
+
+	/*! operator -=
+	* Subtract the matrix identity multiplied to sub value from this matrix
+	* T sub: Value to be multiplied to matrix identity
+	* return: The matrix modified
+	*/
+	template <typename T>
+	Matrix<T>& Matrix<T>::operator -= (const T& sub)
+	{
+		if (_data == nullptr)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+
+		for (uint i = 0; i < std::min(_rows, _columns); i++)
+			_data[i + (size_t(_stride) * i)] -= sub;
+
+		return *this;
+	}
+
+	/*! operator *=
+	* Multiply this matrix by mul value
+	* T mul: Value to be multiplied
+	* return: The matrix modified
+	*/
+	template <typename T>
+	Matrix<T>& Matrix<T>::operator *= (const T& mul)
+	{
+		if (_data == nullptr)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+
+		T* data = _data;
+		T value = mul;
+		uint stride = _stride;
+		uint lines = std::max(1u, uint(-1) / std::max(stride, 1u));
+
+		// The padding of the rows is scaled too, so consecutive rows are a single span
+		parallelFor(0, _rows, double(_rows) * _columns, [=](uint from, uint to)
+		{
+			for (uint i = from, count; i < to; i += count)
+			{
+				count = std::min(lines, to - i);
+				simdKernels<T>().scale(stride * count, value, data + (size_t(stride) * i));
+			}
+		});
+
+		return *this;
+	}
+
+	/*! transpose
+	* Transpose the matrix by tiles, see transposeKernel
+	* return: The mtrix transposed
+	*/
+	template <typename T>
+	Matrix<T> Matrix<T>::transpose() const &
+	{
+		Matrix<T> newMatrix(_allocator);
+
+		newMatrix.resize(_columns, _rows);
+		transposeKernel(_rows, _columns, _data, _stride, newMatrix._data, newMatrix._stride);
+
 		return newMatrix;
 	}
 
 	/*! transpose
-	* Transpose the matrix
+	* Transpose the matrix reusing the storage of this expiring matrix
+	* Vectors without padding only swap their shape, square matrices swap their tiles in place and
+	* the other matrices follow the cycles of the permutation (see transposeInPlace); padded rows are
+	* packed before and spread to the new stride after, so no copy of the matrix is ever made,
+	* unless the capacity is not enough for the new padding
 	* return: The mtrix transposed
 	*/
 	template <typename T>
-	Matrix<T> Matrix<T>::transpose() const
+	Matrix<T> Matrix<T>::transpose() &&
 	{
-		Matrix<T> newMatrix(_columns, _rows);
+		uint stride = strideFor(_rows, _allocator);
 
-		for (uint i = 0; i < _columns; i++)
+		if ((_rows == 1 || _columns == 1) && _stride == _columns && stride == _rows)
+		{
+			std::swap(_rows, _columns);
+			_stride = _columns;
+		}
+		else if (_rows == _columns)
 		{
-			for (uint j = 0; j < _rows; j++)
-				newMatrix(i, j) = (*this)(j, i);
+			transposeSquareInPlace(_rows, _data, _stride);
 		}
+		else if (size_t(_columns) * stride <= _capacity)
+		{
+			for (uint i = 1; _stride != _columns && i < _rows; i++)
+				std::move(_data + (size_t(_stride) * i), _data + (size_t(_stride) * i) + _columns, _data + (size_t(_columns) * i));
 
-		return newMatrix;
+			transposeInPlace(_rows, _columns, _data);
+			std::swap(_rows, _columns);
+			_stride = stride;
+
+			for (uint i = _rows; stride != _columns && i-- > 0;)
+			{
+				T* line = _data + (size_t(_columns) * i);
+
+				std::move_backward(line, line + _columns, _data + (size_t(stride) * i) + _columns);
+				std::fill(_data + (size_t(stride) * i) + _columns, _data + (size_t(stride) * (i + 1)), T(0));
+			}
+		}
+		else
+		{
+			return static_cast<const Matrix<T>&>(*this).transpose();
+		}
+
+		return std::move(*this);
 	}
 
 	/*! elementarOperationSumLines
@@ -464,8 +1109,10 @@ namespace lito{
 		if (_data == nullptr)
 			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
 
-		for (uint i = 0; i < _columns; i++)
-			(*this)(lineSum, i) += constMult * (*this)(lineMult, i);
+		if (lineMult >= _rows || lineSum >= _rows)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, _rows, _columns, std::max(lineMult, lineSum), 0));
+
+		simdKernels<T>().axpy(_columns, constMult, row(lineMult), row(lineSum));
 
 		return *this;
 	}
@@ -482,8 +1129,10 @@ namespace lito{
 		if (_data == nullptr)
 			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
 
-		for (uint i = 0; i < _columns; i++)
-			(*this)(line, i) *= constMult;
+		if (line >= _rows)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, _rows, _columns, line, 0));
+
+		simdKernels<T>().scale(_columns, constMult, row(line));
 
 		return *this;
 	}
@@ -497,14 +1146,11 @@ namespace lito{
 	template <typename T>
 	Matrix<T>& Matrix<T>::elementarOperationSwitchLines(const uint& line1, const uint& line2)
 	{
-		T aux;
+		if (line1 >= _rows || line2 >= _rows)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, _rows, _columns, std::max(line1, line2), 0));
 
-		for (uint i = 0; i < _columns; i++)
-		{
-			aux = (*this)(line1, i);
-			(*this)(line1, i) = (*this)(line2, i);
-			(*this)(line2, i) = aux;
-		}
+		if (line1 != line2)
+			std::swap_ranges(row(line1), row(line1) + _columns, row(line2));
 
 		return *this;
 	}
@@ -518,14 +1164,11 @@ namespace lito{
 	template <typename T>
 	Matrix<T>& Matrix<T>::elementarOperationSwitchColumns(const uint& column1, const uint& column2)
 	{
-		T aux;
+		if (column1 >= _columns || column2 >= _columns)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, _rows, _columns, 0, std::max(column1, column2)));
 
 		for (uint i = 0; i < _rows; i++)
-		{
-			aux = (*this)(i, column1);
-			(*this)(i, column1) = (*this)(i, column2);
-			(*this)(i, column2) = aux;
-		}
+			std::swap(row(i)[column1], row(i)[column2]);
 
 		return *this;
 	}
@@ -544,6 +1187,20 @@ namespace lito{
 		return mat;
 	}
 
+	/*! operator +
+	* The matrix multiplied to +1 reusing the storage of the expiring matrix
+	* Matrix<T> mat: Matrix to be multiplied
+	* return: The matrix multiplied to +1
+	*/
+	template <typename T>
+	Matrix<T> operator + (Matrix<T>&& mat)
+	{
+		if (mat._data == nullptr)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+
+		return std::move(mat);
+	}
+
 	/*! operator -
 	* The matrix multiplied to -1
 	* Matrix<T> mat: Matrix to be multiplied
@@ -551,16 +1208,25 @@ namespace lito{
 	*/
 	template <typename T>
 	Matrix<T> operator - (const Matrix<T>& mat)
+	{
+		return -Matrix<T>(mat);
+	}
+
+	/*! operator -
+	* The matrix multiplied to -1 reusing the storage of the expiring matrix
+	* Matrix<T> mat: Matrix to be multiplied
+	* return: The matrix multiplied to -1
+	*/
+	template <typename T>
+	Matrix<T> operator - (Matrix<T>&& mat)
 	{
 		if (mat._data == nullptr)
 			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
 
-		Matrix<T> newMatrix(mat._rows, mat._columns, mat._data);
-
-		for (uint i = 0; i < mat._rows * mat._columns; i++)
-			newMatrix._data[i] = -newMatrix._data[i];
+		for (size_t i = 0; i < size_t(mat._rows) * mat._stride; i++)
+			mat._data[i] = -mat._data[i];
 
-		return newMatrix;
+		return std::move(mat);
 	}
 
 	/*! operator +
@@ -571,16 +1237,26 @@ namespace lito{
 	*/
 	template <typename T>
 	Matrix<T> operator + (const T& sum, const Matrix<T>& mat)
+	{
+		return sum + Matrix<T>(mat);
+	}
+
+	/*! operator +
+	* Sum the matrix identity multiplied to sum value with matrix mat reusing the storage of the expiring matrix
+	* T sum: Value to be multiplied to matrix identity
+	* Matrix<T> mat: Matrix to add
+	* return: The sum the matrix identity multiplied to sum value with matrix mat
+	*/
+	template <typename T>
+	Matrix<T> operator + (const T& sum, Matrix<T>&& mat)
 	{
 		if (mat._data == nullptr)
 			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
 
-		Matrix<T> newMatrix(mat._rows, mat._columns, mat._data);
+		for (uint i = 0; i < std::min(mat._rows, mat._columns); i++)
+			mat._data[i + (size_t(mat._stride) * i)] = sum + mat._data[i + (size_t(mat._stride) * i)];
 
-		for (uint i = 0; i < std::min(newMatrix._rows, newMatrix._columns); i++)
-			newMatrix(i, i) = sum + newMatrix(i, i);
-
-		return newMatrix;
+		return std::move(mat);
 	}
 
 	/*! operator -
@@ -591,16 +1267,26 @@ namespace lito{
 	*/
 	template <typename T>
 	Matrix<T> operator - (const T& sub, const Matrix<T>& mat)
+	{
+		return sub - Matrix<T>(mat);
+	}
+
+	/*! operator -
+	* Subtract the matrix identity multiplied to sub value with matrix mat reusing the storage of the expiring matrix
+	* T sub: Value to be multiplied to matrix identity
+	* Matrix<T> mat: Matrix to subtract
+	* return: The subtraction of the matrix identity multiplied to sub value with matrix mat
+	*/
+	template <typename T>
+	Matrix<T> operator - (const T& sub, Matrix<T>&& mat)
 	{
 		if (mat._data == nullptr)
 			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
 
-		Matrix<T> newMatrix(mat._rows, mat._columns, mat._data);
-
-		for (uint i = 0; i < std::min(newMatrix._rows, newMatrix._columns); i++)
-			newMatrix(i, i) = sub - newMatrix(i, i);
+		for (uint i = 0; i < std::min(mat._rows, mat._columns); i++)
+			mat._data[i + (size_t(mat._stride) * i)] = sub - mat._data[i + (size_t(mat._stride) * i)];
 
-		return newMatrix;
+		return std::move(mat);
 	}
 
 	/*! operator *
@@ -611,19 +1297,61 @@ namespace lito{
 	*/
 	template <typename T>
 	Matrix<T> operator * (const T& mul, const Matrix<T>& mat)
+	{
+		return mul * Matrix<T>(mat);
+	}
+
+	/*! operator *
+	* Multiply the mul value to matrix mat reusing the storage of the expiring matrix
+	* T mul: Value to be multiplied
+	* Matrix<T> mat: Matrix to be multiplied
+	* return: The multiplication of the mul value to matrix
+	*/
+	template <typename T>
+	Matrix<T> operator * (const T& mul, Matrix<T>&& mat)
 	{
 		if (mat._data == nullptr)
 			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
 
-		Matrix<T> newMatrix(mat._rows, mat._columns, mat._data);
+		mat *= mul;
 
-		for (uint i = 0; i < newMatrix._rows; i++)
-			for (uint j = 0; j < newMatrix._columns; j++)
-				newMatrix(i, j) = mul * newMatrix(i, j);
-
-		return newMatrix;
+		return std::move(mat);
 	}
 	
+	/*! gemm
+	* Calculate C = alpha * A * B + beta * C writing into the existing matrix C
+	* T alpha: Value multiplied to A * B
+	* Matrix<T> A: Matrix to multiply
+	* Matrix<T> B: Matrix to multiply
+	* T beta: Value multiplied to C
+	* Matrix<T> C: Matrix of the result, a matrix not initialized is resized keeping its allocator
+	*/
+	template <typename T>
+	void gemm(const T& alpha, const Matrix<T>& A, const Matrix<T>& B, const T& beta, Matrix<T>& C)
+	{
+		if (A._columns != B._rows)
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, A._rows, A._columns, B._rows, B._columns, 'X'));
+		else if (A._data == nullptr || B._data == nullptr)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+
+		if (C._data == nullptr)
+			C = Matrix<T>(A._rows, B._columns, MatrixType::ZEROS, C._allocator);
+		else if (C._rows != A._rows || C._columns != B._columns)
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, A._rows, B._columns, C._rows, C._columns, '='));
+
+		if (&C == &A || &C == &B)
+		{
+			Matrix<T> newMatrix(C);
+
+			gemmKernel(A._rows, B._columns, A._columns, alpha, A._data, A._stride, 1, B._data, B._stride, 1, beta, newMatrix._data, newMatrix._stride);
+			C = std::move(newMatrix);
+		}
+		else
+		{
+			gemmKernel(A._rows, B._columns, A._columns, alpha, A._data, A._stride, 1, B._data, B._stride, 1, beta, C._data, C._stride);
+		}
+	}
+
 	/*! operator <<
 	* Shows the matrix in console
 	* ostream out: Output stream
@@ -633,7 +1361,7 @@ namespace lito{
 	template <typename T>
 	std::ostream& operator << (std::ostream& out, const Matrix<T>& mat)
 	{
-		out << std::endl;
+		out << '\n';
 		
 		if (mat._rows * mat._columns == 0)
 		{
@@ -643,18 +1371,34 @@ namespace lito{
 		{
 			for (uint i = 0; i < mat._rows; i++)
 			{
-				out << "[ " << mat(i, 0);
+				const T* row = mat.row(i);
+
+				out << "[ " << row[0];
 				for (uint j = 1; j < mat._columns; j++)
 				{
-					out << ", " << mat(i, j);
+					out << ", " << row[j];
 				}
-				out << " ]" << std::endl;
+				out << " ]\n";
 			}
 		}
 
 		return out;
 	}
 
+	/*! Matrix
+	* Initialize the matrix with the sizes known at compile time as copy of a matrix with the same sizes
+	* Matrix<T> mat: The matrix to be copied
+	*/
+	template <typename T, uint R, uint C>
+	Matrix<T, R, C>::Matrix(const Matrix<T>& mat)
+	{
+		if (mat.getRows() != R || mat.getColumns() != C)
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, R, C, mat.getRows(), mat.getColumns(), '='));
+
+		for (uint i = 0; i < R; i++)
+			std::copy(mat.row(i), mat.row(i) + C, _data + (C * i));
+	}
+
 }
 
 #endif
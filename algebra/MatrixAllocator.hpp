@@ -0,0 +1,349 @@
+#ifndef MATRIX_ALLOCATOR_HPP
+#define MATRIX_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "MatrixEnum.hpp"
+
+namespace lito {
+
+	/*! MatrixAllocator
+	* Source of the storage of the matrices
+	* Derive from it to give the matrices an arena, huge pages or any other memory
+	* The allocator must outlive every matrix using it
+	*/
+	class MatrixAllocator {
+	public:
+		virtual ~MatrixAllocator() {}
+
+		virtual void* allocate(size_t bytes, size_t alignment) = 0;
+		virtual void deallocate(void* data, size_t bytes, size_t alignment) = 0;
+
+		virtual size_t getAlignment() const;
+		virtual bool getRowPadding() const;
+	};
+
+	/*! AlignedAllocator
+	* Allocator of the heap with the start of the storage aligned
+	* With row padding each row is stored in a multiple of the alignment, so every row starts aligned
+	*/
+	class AlignedAllocator : public MatrixAllocator {
+	public:
+		AlignedAllocator(size_t alignment = 64, bool rowPadding = false);
+
+		void* allocate(size_t bytes, size_t alignment) override;
+		void deallocate(void* data, size_t bytes, size_t alignment) override;
+
+		size_t getAlignment() const override;
+		bool getRowPadding() const override;
+
+	private:
+		size_t _alignment;
+		bool _rowPadding;
+	};
+
+	/*! PoolAllocator
+	* Allocator that keeps the released storages in lists of the thread by size class
+	* The sizes are rounded up to powers of two, so temporaries of close sizes reuse the same storages
+	* Storages bigger than the largest class or aligned over 64 bytes go straight to the heap
+	*/
+	class PoolAllocator : public MatrixAllocator {
+	public:
+		static const uint CLASSES = 20;
+		static const size_t MIN_BYTES = 64;
+
+		PoolAllocator(bool rowPadding = false, size_t cacheBytes = size_t(64) << 20);
+
+		void* allocate(size_t bytes, size_t alignment) override;
+		void deallocate(void* data, size_t bytes, size_t alignment) override;
+
+		bool getRowPadding() const override;
+
+	private:
+		struct Cache {
+			std::vector<void*> blocks[CLASSES];
+			size_t bytes = 0;
+
+			~Cache();
+		};
+
+		static Cache& cache();
+		static bool& cacheFinished();
+		static uint sizeClass(size_t bytes, size_t alignment);
+
+		bool _rowPadding;
+		size_t _cacheBytes;
+	};
+
+	inline void* alignedAllocate(size_t bytes, size_t alignment);
+	inline void alignedDeallocate(void* data);
+
+	inline MatrixAllocator*& matrixAllocatorSetting();
+	inline MatrixAllocator* matrixAllocator();
+	inline void setMatrixAllocator(MatrixAllocator* allocator);
+
+
+
+	/*! getAlignment
+	* Get the alignment of the start of the storage
+	* return: The alignment in bytes, a power of two
+	*/
+	inline size_t MatrixAllocator::getAlignment() const
+	{
+		return 64;
+	}
+
+	/*! getRowPadding
+	* Tell if the rows of the matrices are padded to start aligned
+	* return: If the rows are padded
+	*/
+	inline bool MatrixAllocator::getRowPadding() const
+	{
+		return false;
+	}
+
+	/*! AlignedAllocator
+	* Initialize the allocator
+	* size_t alignment: Alignment in bytes, a power of two
+	* bool rowPadding: If the rows of the matrices are padded to start aligned
+	*/
+	inline AlignedAllocator::AlignedAllocator(size_t alignment, bool rowPadding)
+		: _alignment(alignment)
+		, _rowPadding(rowPadding)
+	{}
+
+	/*! allocate
+	* Allocate an aligned storage
+	* size_t bytes: Size of the storage
+	* size_t alignment: Alignment in bytes, a power of two
+	* return: The storage, throws std::bad_alloc when there is no memory
+	*/
+	inline void* AlignedAllocator::allocate(size_t bytes, size_t alignment)
+	{
+		return alignedAllocate(bytes, alignment);
+	}
+
+	/*! deallocate
+	* Release a storage given by allocate
+	* void* data: The storage
+	* size_t bytes: Size of the storage
+	* size_t alignment: Alignment of the storage
+	*/
+	inline void AlignedAllocator::deallocate(void* data, size_t, size_t)
+	{
+		alignedDeallocate(data);
+	}
+
+	/*! getAlignment
+	* Get the alignment of the start of the storage
+	* return: The alignment in bytes
+	*/
+	inline size_t AlignedAllocator::getAlignment() const
+	{
+		return _alignment;
+	}
+
+	/*! getRowPadding
+	* Tell if the rows of the matrices are padded to start aligned
+	* return: If the rows are padded
+	*/
+	inline bool AlignedAllocator::getRowPadding() const
+	{
+		return _rowPadding;
+	}
+
+	/*! PoolAllocator
+	* Initialize the allocator, the storages are aligned to 64 bytes
+	* bool rowPadding: If the rows of the matrices are padded to start aligned
+	* size_t cacheBytes: Maximum bytes kept in the lists of each thread
+	*/
+	inline PoolAllocator::PoolAllocator(bool rowPadding, size_t cacheBytes)
+		: _rowPadding(rowPadding)
+		, _cacheBytes(cacheBytes)
+	{}
+
+	/*! allocate
+	* Take a storage of the size class from the list of the thread, or allocate a new one
+	* size_t bytes: Size of the storage
+	* size_t alignment: Alignment in bytes, a power of two
+	* return: The storage, throws std::bad_alloc when there is no memory
+	*/
+	inline void* PoolAllocator::allocate(size_t bytes, size_t alignment)
+	{
+		uint id = sizeClass(bytes, alignment);
+
+		if (id == CLASSES)
+			return alignedAllocate(bytes, alignment);
+		else if (cacheFinished())
+			return alignedAllocate(MIN_BYTES << id, MIN_BYTES);
+
+		std::vector<void*>& blocks = cache().blocks[id];
+
+		if (blocks.empty())
+			return alignedAllocate(MIN_BYTES << id, MIN_BYTES);
+
+		void* data = blocks.back();
+
+		blocks.pop_back();
+		cache().bytes -= MIN_BYTES << id;
+
+		return data;
+	}
+
+	/*! deallocate
+	* Keep the storage in the list of the thread, or release it when the lists are full
+	* The storage may have been allocated by another thread
+	* void* data: The storage
+	* size_t bytes: Size of the storage
+	* size_t alignment: Alignment of the storage
+	*/
+	inline void PoolAllocator::deallocate(void* data, size_t bytes, size_t alignment)
+	{
+		uint id = sizeClass(bytes, alignment);
+
+		if (id == CLASSES || cacheFinished() || cache().bytes + (MIN_BYTES << id) > _cacheBytes)
+		{
+			alignedDeallocate(data);
+			return;
+		}
+
+		cache().blocks[id].push_back(data);
+		cache().bytes += MIN_BYTES << id;
+	}
+
+	/*! getRowPadding
+	* Tell if the rows of the matrices are padded to start aligned
+	* return: If the rows are padded
+	*/
+	inline bool PoolAllocator::getRowPadding() const
+	{
+		return _rowPadding;
+	}
+
+	/*! ~Cache
+	* Release the storages kept when the thread finishes
+	*/
+	inline PoolAllocator::Cache::~Cache()
+	{
+		cacheFinished() = true;
+
+		for (uint id = 0; id < CLASSES; id++)
+			for (void* data : blocks[id])
+				alignedDeallocate(data);
+	}
+
+	/*! cache
+	* Get the lists of storages of the calling thread, shared by all the pools
+	* return: The lists
+	*/
+	inline PoolAllocator::Cache& PoolAllocator::cache()
+	{
+		static thread_local Cache threadCache;
+
+		return threadCache;
+	}
+
+	/*! cacheFinished
+	* Tell if the lists of the calling thread were already destroyed,
+	* so the matrices destroyed after them (static ones) use the heap directly
+	* return: The flag of the thread
+	*/
+	inline bool& PoolAllocator::cacheFinished()
+	{
+		static thread_local bool finished = false;
+
+		return finished;
+	}
+
+	/*! sizeClass
+	* Get the size class of a storage, the class id holds MIN_BYTES << id bytes
+	* size_t bytes: Size of the storage
+	* size_t alignment: Alignment of the storage
+	* return: The class, CLASSES when the storage is not pooled
+	*/
+	inline uint PoolAllocator::sizeClass(size_t bytes, size_t alignment)
+	{
+		if (alignment > MIN_BYTES)
+			return CLASSES;
+
+		uint id = 0;
+
+		while (id < CLASSES && (MIN_BYTES << id) < bytes)
+			id++;
+
+		return id;
+	}
+
+	/*! alignedAllocate
+	* Allocate a storage of the heap with the start aligned
+	* The pointer returned by malloc is kept just before the aligned start
+	* size_t bytes: Size of the storage
+	* size_t alignment: Alignment in bytes, a power of two
+	* return: The storage, throws std::bad_alloc when there is no memory
+	*/
+	inline void* alignedAllocate(size_t bytes, size_t alignment)
+	{
+		alignment = (alignment < sizeof(void*)) ? sizeof(void*) : alignment;
+
+		void* block = std::malloc(bytes + alignment + sizeof(void*));
+
+		if (block == nullptr)
+			throw std::bad_alloc();
+
+		uintptr_t start = (reinterpret_cast<uintptr_t>(block) + sizeof(void*) + alignment - 1) & ~uintptr_t(alignment - 1);
+		void* data = reinterpret_cast<void*>(start);
+
+		reinterpret_cast<void**>(data)[-1] = block;
+
+		return data;
+	}
+
+	/*! alignedDeallocate
+	* Release a storage given by alignedAllocate
+	* void* data: The storage, may be nullptr
+	*/
+	inline void alignedDeallocate(void* data)
+	{
+		if (data != nullptr)
+			std::free(reinterpret_cast<void**>(data)[-1]);
+	}
+
+	/*! matrixAllocatorSetting
+	* Storage of the allocator used by the new matrices
+	* return: The allocator, nullptr for the default one
+	*/
+	inline MatrixAllocator*& matrixAllocatorSetting()
+	{
+		static MatrixAllocator* allocator = nullptr;
+
+		return allocator;
+	}
+
+	/*! matrixAllocator
+	* Get the allocator used by the matrices created without one
+	* The default one aligns to 64 bytes without row padding
+	* return: The allocator
+	*/
+	inline MatrixAllocator* matrixAllocator()
+	{
+		static AlignedAllocator defaultAllocator;
+
+		return (matrixAllocatorSetting() != nullptr) ? matrixAllocatorSetting() : &defaultAllocator;
+	}
+
+	/*! setMatrixAllocator
+	* Choose the allocator used by the matrices created without one
+	* Must be called before the matrices are used by other threads
+	* MatrixAllocator* allocator: The allocator, nullptr for the default one
+	*/
+	inline void setMatrixAllocator(MatrixAllocator* allocator)
+	{
+		matrixAllocatorSetting() = allocator;
+	}
+
+}
+
+#endif
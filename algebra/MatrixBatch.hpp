@@ -0,0 +1,759 @@
+#ifndef MATRIX_BATCH_HPP
+#define MATRIX_BATCH_HPP
+
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include "MatrixException.hpp"
+#include "SimdKernels.hpp"
+#include "ThreadPool.hpp"
+
+#if defined(__GNUC__) || defined(__clang__)
+	#define LITO_SIMD_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+	#define LITO_SIMD_INLINE __forceinline
+#else
+	#define LITO_SIMD_INLINE inline
+#endif
+
+namespace lito {
+
+	/*! MatrixBatch
+	* Many small matrices of the same size stored as structure of arrays:
+	* the value (line, column) of all the matrices is contiguous in the plane line * C + column,
+	* so one SIMD register holds the same value of 4 to 16 matrices
+	* The planes are padded to 16 values, the matrix i of the batch has its values at plane(e)[i]
+	*/
+	template <typename T, uint R, uint C>
+	class MatrixBatch {
+	public:
+		MatrixBatch(uint count = 0);
+
+		const uint& getCount() const;
+		size_t getStride() const;
+
+		T* plane(uint element);
+		const T* plane(uint element) const;
+
+		T& at(uint index, uint line, uint column);
+		const T& at(uint index, uint line, uint column) const;
+
+		template <class M> void set(uint index, const M& matrix);
+		template <class M> M get(uint index) const;
+
+	private:
+		uint _count;
+		size_t _stride;
+		std::vector<T> _values;
+	};
+
+	/*! BatchKernels
+	* Table of the kernels of the batches of small systems, each one works on the matrices [begin, end)
+	* of planes with stride values between them, and marks the singular matrices in singular
+	* invert3, invert4: inverse = a^-1 of 3x3 and 4x4 matrices, zeros for the singular matrices
+	* solve3, solve4: x = a^-1 * b of 3x3 and 4x4 matrices, zeros for the singular matrices
+	*/
+	template <typename T>
+	struct BatchKernels {
+		void (*invert3)(uint begin, uint end, size_t stride, const T* a, T* inverse, uint8_t* singular, T error);
+		void (*invert4)(uint begin, uint end, size_t stride, const T* a, T* inverse, uint8_t* singular, T error);
+		void (*solve3)(uint begin, uint end, size_t stride, const T* a, const T* b, T* x, uint8_t* singular, T error);
+		void (*solve4)(uint begin, uint end, size_t stride, const T* a, const T* b, T* x, uint8_t* singular, T error);
+	};
+
+	template <typename T> const BatchKernels<T>& batchKernels();
+
+	template <typename T, uint N> std::vector<uint8_t> batchInvert(const MatrixBatch<T, N, N>& a, MatrixBatch<T, N, N>& inverse, const T error = T(0));
+	template <typename T, uint N> std::vector<uint8_t> batchSolve(const MatrixBatch<T, N, N>& a, const MatrixBatch<T, N, 1>& b, MatrixBatch<T, N, 1>& x, const T error = T(0));
+
+
+
+	/*! MatrixBatch
+	* Initialize a batch of matrices with zeros
+	* uint count: Quantities of matrices
+	*/
+	template <typename T, uint R, uint C>
+	MatrixBatch<T, R, C>::MatrixBatch(uint count)
+		: _count(count)
+		, _stride((size_t(count) + 15) & ~size_t(15))
+		, _values(_stride * R * C, T(0))
+	{}
+
+	/*! getCount
+	* Get the quantities of matrices
+	* return: The quantities of matrices
+	*/
+	template <typename T, uint R, uint C>
+	const uint& MatrixBatch<T, R, C>::getCount() const
+	{
+		return _count;
+	}
+
+	/*! getStride
+	* Get the distance between two planes
+	* return: The distance, in values
+	*/
+	template <typename T, uint R, uint C>
+	size_t MatrixBatch<T, R, C>::getStride() const
+	{
+		return _stride;
+	}
+
+	/*! plane
+	* Get the values of one position of all the matrices
+	* uint element: The position, line * C + column
+	* return: The values, one per matrix
+	*/
+	template <typename T, uint R, uint C>
+	T* MatrixBatch<T, R, C>::plane(uint element)
+	{
+		return _values.data() + (_stride * element);
+	}
+
+	/*! plane
+	* Get the values of one position of all the matrices
+	* uint element: The position, line * C + column
+	* return: The values, one per matrix
+	*/
+	template <typename T, uint R, uint C>
+	const T* MatrixBatch<T, R, C>::plane(uint element) const
+	{
+		return _values.data() + (_stride * element);
+	}
+
+	/*! at
+	* Access a value of a matrix of the batch
+	* uint index: The matrix
+	* uint line: Line of the value
+	* uint column: Column of the value
+	* return: The value
+	*/
+	template <typename T, uint R, uint C>
+	T& MatrixBatch<T, R, C>::at(uint index, uint line, uint column)
+	{
+		if (index >= _count || line >= R || column >= C)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, R, C, line, column));
+
+		return _values[(_stride * ((line * C) + column)) + index];
+	}
+
+	/*! at
+	* Access a value of a matrix of the batch
+	* uint index: The matrix
+	* uint line: Line of the value
+	* uint column: Column of the value
+	* return: The value
+	*/
+	template <typename T, uint R, uint C>
+	const T& MatrixBatch<T, R, C>::at(uint index, uint line, uint column) const
+	{
+		if (index >= _count || line >= R || column >= C)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, R, C, line, column));
+
+		return _values[(_stride * ((line * C) + column)) + index];
+	}
+
+	/*! set
+	* Copy a row major matrix, as Matriz_3 or Matriz_4, to the batch
+	* uint index: The matrix of the batch
+	* M matrix: The matrix, with operator [] over its R * C values
+	*/
+	template <typename T, uint R, uint C>
+	template <class M>
+	void MatrixBatch<T, R, C>::set(uint index, const M& matrix)
+	{
+		if (index >= _count)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, R, C, index, 0));
+
+		for (uint e = 0; e < R * C; e++)
+			_values[(_stride * e) + index] = matrix[e];
+	}
+
+	/*! get
+	* Copy a matrix of the batch to a row major matrix, as Matriz_3 or Matriz_4
+	* uint index: The matrix of the batch
+	* return: The matrix
+	*/
+	template <typename T, uint R, uint C>
+	template <class M>
+	M MatrixBatch<T, R, C>::get(uint index) const
+	{
+		if (index >= _count)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, R, C, index, 0));
+
+		M matrix;
+
+		for (uint e = 0; e < R * C; e++)
+			matrix[e] = _values[(_stride * e) + index];
+
+		return matrix;
+	}
+
+	/*! batchInvert
+	* Invert each matrix of a batch of 3x3 or 4x4 matrices by the adjugate matrix, many matrices per SIMD instruction
+	* A singular matrix does not throw, it is marked in the result and its inverse is zeros
+	* MatrixBatch<T, N, N> a: The matrices
+	* MatrixBatch<T, N, N> inverse: Receives the inverses, resized to the count of a when needed
+	* T error: A matrix is singular when the absolute value of its determinant is not greater than error
+	* return: One flag per matrix, 1 when it is singular
+	*/
+	template <typename T, uint N>
+	std::vector<uint8_t> batchInvert(const MatrixBatch<T, N, N>& a, MatrixBatch<T, N, N>& inverse, const T error)
+	{
+		static_assert(N == 3 || N == 4, "batchInvert works with 3x3 and 4x4 matrices");
+
+		uint count = a.getCount();
+		std::vector<uint8_t> singular(count, 0);
+
+		if (inverse.getCount() != count)
+			inverse = MatrixBatch<T, N, N>(count);
+
+		const BatchKernels<T>& kernels = batchKernels<T>();
+		const uint groups = (count + 15) / 16;
+
+		parallelFor(0, groups, (N == 3) ? 40.0 * count : 120.0 * count, [&](uint from, uint to)
+		{
+			uint begin = from * 16;
+			uint end = std::min(to * 16, count);
+
+			if (N == 3)
+				kernels.invert3(begin, end, a.getStride(), a.plane(0), inverse.plane(0), singular.data(), error);
+			else
+				kernels.invert4(begin, end, a.getStride(), a.plane(0), inverse.plane(0), singular.data(), error);
+		});
+
+		return singular;
+	}
+
+	/*! batchSolve
+	* Solve each system a * x = b of a batch of 3x3 or 4x4 systems by the adjugate matrix, many systems per SIMD instruction
+	* A singular matrix does not throw, it is marked in the result and its solution is zeros
+	* MatrixBatch<T, N, N> a: The matrices
+	* MatrixBatch<T, N, 1> b: The vectors, one per matrix
+	* MatrixBatch<T, N, 1> x: Receives the solutions, resized to the count of a when needed
+	* T error: A matrix is singular when the absolute value of its determinant is not greater than error
+	* return: One flag per system, 1 when its matrix is singular
+	*/
+	template <typename T, uint N>
+	std::vector<uint8_t> batchSolve(const MatrixBatch<T, N, N>& a, const MatrixBatch<T, N, 1>& b, MatrixBatch<T, N, 1>& x, const T error)
+	{
+		static_assert(N == 3 || N == 4, "batchSolve works with 3x3 and 4x4 matrices");
+
+		uint count = a.getCount();
+
+		if (b.getCount() != count)
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, count, N * N, b.getCount(), N, '*'));
+
+		std::vector<uint8_t> singular(count, 0);
+
+		if (x.getCount() != count)
+			x = MatrixBatch<T, N, 1>(count);
+
+		const BatchKernels<T>& kernels = batchKernels<T>();
+		const uint groups = (count + 15) / 16;
+
+		parallelFor(0, groups, (N == 3) ? 50.0 * count : 140.0 * count, [&](uint from, uint to)
+		{
+			uint begin = from * 16;
+			uint end = std::min(to * 16, count);
+
+			if (N == 3)
+				kernels.solve3(begin, end, a.getStride(), a.plane(0), b.plane(0), x.plane(0), singular.data(), error);
+			else
+				kernels.solve4(begin, end, a.getStride(), a.plane(0), b.plane(0), x.plane(0), singular.data(), error);
+		});
+
+		return singular;
+	}
+
+
+	/*===============================================================================================================================*/
+	/* Lanes                                                                                                                         */
+	/*===============================================================================================================================*/
+
+	/*! ScalarLanes
+	* Operations over one value, used for the types without SIMD and for the matrices after the last full register
+	* Every Lanes type gives:
+	* width: Quantities of matrices per register
+	* load, store: Read and write width contiguous values
+	* mul: a * b, mulAdd: a * b + c, negMulAdd: c - a * b, mulSub: a * b - c * d
+	* reciprocal: 1 / det, with zero and singular[lane] = 1 where |det| is not greater than error or is NaN
+	*/
+	template <typename T>
+	struct ScalarLanes {
+		typedef T Pack;
+		static const uint width = 1;
+
+		static inline Pack load(const T* p) { return *p; }
+		static inline void store(T* p, Pack a) { *p = a; }
+		static inline Pack mul(Pack a, Pack b) { return a * b; }
+		static inline Pack mulAdd(Pack a, Pack b, Pack c) { return (a * b) + c; }
+		static inline Pack negMulAdd(Pack a, Pack b, Pack c) { return c - (a * b); }
+		static inline Pack mulSub(Pack a, Pack b, Pack c, Pack d) { return (a * b) - (c * d); }
+
+		static inline Pack reciprocal(Pack det, T error, uint8_t* singular)
+		{
+			bool isSingular = !(std::abs(det) > error);
+
+			*singular = isSingular ? 1 : 0;
+
+			return isSingular ? T(0) : T(1) / det;
+		}
+	};
+
+#ifdef LITO_SIMD_X86
+
+	struct Sse2FloatLanes {
+		typedef __m128 Pack;
+		static const uint width = 4;
+
+		LITO_SIMD_TARGET("sse2") static inline Pack load(const float* p) { return _mm_loadu_ps(p); }
+		LITO_SIMD_TARGET("sse2") static inline void store(float* p, Pack a) { _mm_storeu_ps(p, a); }
+		LITO_SIMD_TARGET("sse2") static inline Pack mul(Pack a, Pack b) { return _mm_mul_ps(a, b); }
+		LITO_SIMD_TARGET("sse2") static inline Pack mulAdd(Pack a, Pack b, Pack c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+		LITO_SIMD_TARGET("sse2") static inline Pack negMulAdd(Pack a, Pack b, Pack c) { return _mm_sub_ps(c, _mm_mul_ps(a, b)); }
+		LITO_SIMD_TARGET("sse2") static inline Pack mulSub(Pack a, Pack b, Pack c, Pack d) { return _mm_sub_ps(_mm_mul_ps(a, b), _mm_mul_ps(c, d)); }
+
+		LITO_SIMD_TARGET("sse2") static inline Pack reciprocal(Pack det, float error, uint8_t* singular)
+		{
+			__m128 mask = _mm_cmpngt_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), det), _mm_set1_ps(error));
+			int bits = _mm_movemask_ps(mask);
+
+			for (uint l = 0; l < width; l++)
+				singular[l] = uint8_t((bits >> l) & 1);
+
+			return _mm_andnot_ps(mask, _mm_div_ps(_mm_set1_ps(1.0f), det));
+		}
+	};
+
+	struct Sse2DoubleLanes {
+		typedef __m128d Pack;
+		static const uint width = 2;
+
+		LITO_SIMD_TARGET("sse2") static inline Pack load(const double* p) { return _mm_loadu_pd(p); }
+		LITO_SIMD_TARGET("sse2") static inline void store(double* p, Pack a) { _mm_storeu_pd(p, a); }
+		LITO_SIMD_TARGET("sse2") static inline Pack mul(Pack a, Pack b) { return _mm_mul_pd(a, b); }
+		LITO_SIMD_TARGET("sse2") static inline Pack mulAdd(Pack a, Pack b, Pack c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+		LITO_SIMD_TARGET("sse2") static inline Pack negMulAdd(Pack a, Pack b, Pack c) { return _mm_sub_pd(c, _mm_mul_pd(a, b)); }
+		LITO_SIMD_TARGET("sse2") static inline Pack mulSub(Pack a, Pack b, Pack c, Pack d) { return _mm_sub_pd(_mm_mul_pd(a, b), _mm_mul_pd(c, d)); }
+
+		LITO_SIMD_TARGET("sse2") static inline Pack reciprocal(Pack det, double error, uint8_t* singular)
+		{
+			__m128d mask = _mm_cmpngt_pd(_mm_andnot_pd(_mm_set1_pd(-0.0), det), _mm_set1_pd(error));
+			int bits = _mm_movemask_pd(mask);
+
+			for (uint l = 0; l < width; l++)
+				singular[l] = uint8_t((bits >> l) & 1);
+
+			return _mm_andnot_pd(mask, _mm_div_pd(_mm_set1_pd(1.0), det));
+		}
+	};
+
+	struct Avx2FloatLanes {
+		typedef __m256 Pack;
+		static const uint width = 8;
+
+		LITO_SIMD_TARGET("avx2,fma") static inline Pack load(const float* p) { return _mm256_loadu_ps(p); }
+		LITO_SIMD_TARGET("avx2,fma") static inline void store(float* p, Pack a) { _mm256_storeu_ps(p, a); }
+		LITO_SIMD_TARGET("avx2,fma") static inline Pack mul(Pack a, Pack b) { return _mm256_mul_ps(a, b); }
+		LITO_SIMD_TARGET("avx2,fma") static inline Pack mulAdd(Pack a, Pack b, Pack c) { return _mm256_fmadd_ps(a, b, c); }
+		LITO_SIMD_TARGET("avx2,fma") static inline Pack negMulAdd(Pack a, Pack b, Pack c) { return _mm256_fnmadd_ps(a, b, c); }
+		LITO_SIMD_TARGET("avx2,fma") static inline Pack mulSub(Pack a, Pack b, Pack c, Pack d) { return _mm256_fmsub_ps(a, b, _mm256_mul_ps(c, d)); }
+
+		LITO_SIMD_TARGET("avx2,fma") static inline Pack reciprocal(Pack det, float error, uint8_t* singular)
+		{
+			__m256 mask = _mm256_cmp_ps(_mm256_andnot_ps(_mm256_set1_ps(-0.0f), det), _mm256_set1_ps(error), _CMP_NGT_UQ);
+			int bits = _mm256_movemask_ps(mask);
+
+			for (uint l = 0; l < width; l++)
+				singular[l] = uint8_t((bits >> l) & 1);
+
+			return _mm256_andnot_ps(mask, _mm256_div_ps(_mm256_set1_ps(1.0f), det));
+		}
+	};
+
+	struct Avx2DoubleLanes {
+		typedef __m256d Pack;
+		static const uint width = 4;
+
+		LITO_SIMD_TARGET("avx2,fma") static inline Pack load(const double* p) { return _mm256_loadu_pd(p); }
+		LITO_SIMD_TARGET("avx2,fma") static inline void store(double* p, Pack a) { _mm256_storeu_pd(p, a); }
+		LITO_SIMD_TARGET("avx2,fma") static inline Pack mul(Pack a, Pack b) { return _mm256_mul_pd(a, b); }
+		LITO_SIMD_TARGET("avx2,fma") static inline Pack mulAdd(Pack a, Pack b, Pack c) { return _mm256_fmadd_pd(a, b, c); }
+		LITO_SIMD_TARGET("avx2,fma") static inline Pack negMulAdd(Pack a, Pack b, Pack c) { return _mm256_fnmadd_pd(a, b, c); }
+		LITO_SIMD_TARGET("avx2,fma") static inline Pack mulSub(Pack a, Pack b, Pack c, Pack d) { return _mm256_fmsub_pd(a, b, _mm256_mul_pd(c, d)); }
+
+		LITO_SIMD_TARGET("avx2,fma") static inline Pack reciprocal(Pack det, double error, uint8_t* singular)
+		{
+			__m256d mask = _mm256_cmp_pd(_mm256_andnot_pd(_mm256_set1_pd(-0.0), det), _mm256_set1_pd(error), _CMP_NGT_UQ);
+			int bits = _mm256_movemask_pd(mask);
+
+			for (uint l = 0; l < width; l++)
+				singular[l] = uint8_t((bits >> l) & 1);
+
+			return _mm256_andnot_pd(mask, _mm256_div_pd(_mm256_set1_pd(1.0), det));
+		}
+	};
+
+	struct Avx512FloatLanes {
+		typedef __m512 Pack;
+		static const uint width = 16;
+
+		LITO_SIMD_TARGET("avx512f") static inline Pack load(const float* p) { return _mm512_loadu_ps(p); }
+		LITO_SIMD_TARGET("avx512f") static inline void store(float* p, Pack a) { _mm512_storeu_ps(p, a); }
+		LITO_SIMD_TARGET("avx512f") static inline Pack mul(Pack a, Pack b) { return _mm512_mul_ps(a, b); }
+		LITO_SIMD_TARGET("avx512f") static inline Pack mulAdd(Pack a, Pack b, Pack c) { return _mm512_fmadd_ps(a, b, c); }
+		LITO_SIMD_TARGET("avx512f") static inline Pack negMulAdd(Pack a, Pack b, Pack c) { return _mm512_fnmadd_ps(a, b, c); }
+		LITO_SIMD_TARGET("avx512f") static inline Pack mulSub(Pack a, Pack b, Pack c, Pack d) { return _mm512_fmsub_ps(a, b, _mm512_mul_ps(c, d)); }
+
+		LITO_SIMD_TARGET("avx512f") static inline Pack reciprocal(Pack det, float error, uint8_t* singular)
+		{
+			__mmask16 mask = _mm512_cmp_ps_mask(_mm512_abs_ps(det), _mm512_set1_ps(error), _CMP_NGT_UQ);
+
+			for (uint l = 0; l < width; l++)
+				singular[l] = uint8_t((mask >> l) & 1);
+
+			return _mm512_maskz_div_ps(__mmask16(~mask), _mm512_set1_ps(1.0f), det);
+		}
+	};
+
+	struct Avx512DoubleLanes {
+		typedef __m512d Pack;
+		static const uint width = 8;
+
+		LITO_SIMD_TARGET("avx512f") static inline Pack load(const double* p) { return _mm512_loadu_pd(p); }
+		LITO_SIMD_TARGET("avx512f") static inline void store(double* p, Pack a) { _mm512_storeu_pd(p, a); }
+		LITO_SIMD_TARGET("avx512f") static inline Pack mul(Pack a, Pack b) { return _mm512_mul_pd(a, b); }
+		LITO_SIMD_TARGET("avx512f") static inline Pack mulAdd(Pack a, Pack b, Pack c) { return _mm512_fmadd_pd(a, b, c); }
+		LITO_SIMD_TARGET("avx512f") static inline Pack negMulAdd(Pack a, Pack b, Pack c) { return _mm512_fnmadd_pd(a, b, c); }
+		LITO_SIMD_TARGET("avx512f") static inline Pack mulSub(Pack a, Pack b, Pack c, Pack d) { return _mm512_fmsub_pd(a, b, _mm512_mul_pd(c, d)); }
+
+		LITO_SIMD_TARGET("avx512f") static inline Pack reciprocal(Pack det, double error, uint8_t* singular)
+		{
+			__mmask8 mask = _mm512_cmp_pd_mask(_mm512_abs_pd(det), _mm512_set1_pd(error), _CMP_NGT_UQ);
+
+			for (uint l = 0; l < width; l++)
+				singular[l] = uint8_t((mask >> l) & 1);
+
+			return _mm512_maskz_div_pd(__mmask8(~mask), _mm512_set1_pd(1.0), det);
+		}
+	};
+
+#endif
+
+	/*===============================================================================================================================*/
+	/* Kernels                                                                                                                       */
+	/*===============================================================================================================================*/
+
+	// The kernels below are always inlined in the functions compiled for each instruction set,
+	// so the warnings about the ABI of vectors passed to code without that instruction set do not apply
+#if defined(__GNUC__) && !defined(__clang__)
+	#pragma GCC diagnostic push
+	#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+	/*! batchAdjugate
+	* Calculate the adjugate (transposed cofactors) of width 3x3 matrices
+	* Pack m[9]: The matrices, row major
+	* Pack adjugate[9]: Receives the adjugates, row major
+	* Pack det: Receives the determinants
+	*/
+	template <typename L>
+	LITO_SIMD_INLINE void batchAdjugate(const typename L::Pack (&m)[9], typename L::Pack (&adjugate)[9], typename L::Pack& det)
+	{
+		// [ 0 1 2 ]
+		// [ 3 4 5 ]
+		// [ 6 7 8 ]
+
+		adjugate[0] = L::mulSub(m[4], m[8], m[5], m[7]);
+		adjugate[3] = L::mulSub(m[5], m[6], m[3], m[8]);
+		adjugate[6] = L::mulSub(m[3], m[7], m[4], m[6]);
+		adjugate[1] = L::mulSub(m[2], m[7], m[1], m[8]);
+		adjugate[4] = L::mulSub(m[0], m[8], m[2], m[6]);
+		adjugate[7] = L::mulSub(m[1], m[6], m[0], m[7]);
+		adjugate[2] = L::mulSub(m[1], m[5], m[2], m[4]);
+		adjugate[5] = L::mulSub(m[2], m[3], m[0], m[5]);
+		adjugate[8] = L::mulSub(m[0], m[4], m[1], m[3]);
+
+		det = L::mulAdd(m[0], adjugate[0], L::mulAdd(m[1], adjugate[3], L::mul(m[2], adjugate[6])));
+	}
+
+	/*! batchAdjugate
+	* Calculate the adjugate (transposed cofactors) of width 4x4 matrices by the 2x2 determinants
+	* of the first two lines (s) and of the last two lines (c)
+	* Pack m[16]: The matrices, row major
+	* Pack adjugate[16]: Receives the adjugates, row major
+	* Pack det: Receives the determinants
+	*/
+	template <typename L>
+	LITO_SIMD_INLINE void batchAdjugate(const typename L::Pack (&m)[16], typename L::Pack (&adjugate)[16], typename L::Pack& det)
+	{
+		// [ 0  1  2  3  ]
+		// [ 4  5  6  7  ]
+		// [ 8  9  10 11 ]
+		// [ 12 13 14 15 ]
+
+		typename L::Pack s0 = L::mulSub(m[0], m[5], m[4], m[1]);
+		typename L::Pack s1 = L::mulSub(m[0], m[6], m[4], m[2]);
+		typename L::Pack s2 = L::mulSub(m[0], m[7], m[4], m[3]);
+		typename L::Pack s3 = L::mulSub(m[1], m[6], m[5], m[2]);
+		typename L::Pack s4 = L::mulSub(m[1], m[7], m[5], m[3]);
+		typename L::Pack s5 = L::mulSub(m[2], m[7], m[6], m[3]);
+
+		typename L::Pack c0 = L::mulSub(m[8 ], m[13], m[12], m[9 ]);
+		typename L::Pack c1 = L::mulSub(m[8 ], m[14], m[12], m[10]);
+		typename L::Pack c2 = L::mulSub(m[8 ], m[15], m[12], m[11]);
+		typename L::Pack c3 = L::mulSub(m[9 ], m[14], m[13], m[10]);
+		typename L::Pack c4 = L::mulSub(m[9 ], m[15], m[13], m[11]);
+		typename L::Pack c5 = L::mulSub(m[10], m[15], m[14], m[11]);
+
+		adjugate[0 ] = L::mulAdd(m[5 ], c5, L::mulSub(m[7 ], c3, m[6 ], c4));
+		adjugate[1 ] = L::negMulAdd(m[3 ], c3, L::mulSub(m[2 ], c4, m[1 ], c5));
+		adjugate[2 ] = L::mulAdd(m[13], s5, L::mulSub(m[15], s3, m[14], s4));
+		adjugate[3 ] = L::negMulAdd(m[11], s3, L::mulSub(m[10], s4, m[9 ], s5));
+		adjugate[4 ] = L::negMulAdd(m[7 ], c1, L::mulSub(m[6 ], c2, m[4 ], c5));
+		adjugate[5 ] = L::mulAdd(m[0 ], c5, L::mulSub(m[3 ], c1, m[2 ], c2));
+		adjugate[6 ] = L::negMulAdd(m[15], s1, L::mulSub(m[14], s2, m[12], s5));
+		adjugate[7 ] = L::mulAdd(m[8 ], s5, L::mulSub(m[11], s1, m[10], s2));
+		adjugate[8 ] = L::mulAdd(m[4 ], c4, L::mulSub(m[7 ], c0, m[5 ], c2));
+		adjugate[9 ] = L::negMulAdd(m[3 ], c0, L::mulSub(m[1 ], c2, m[0 ], c4));
+		adjugate[10] = L::mulAdd(m[12], s4, L::mulSub(m[15], s0, m[13], s2));
+		adjugate[11] = L::negMulAdd(m[11], s0, L::mulSub(m[9 ], s2, m[8 ], s4));
+		adjugate[12] = L::negMulAdd(m[6 ], c0, L::mulSub(m[5 ], c1, m[4 ], c3));
+		adjugate[13] = L::mulAdd(m[0 ], c3, L::mulSub(m[2 ], c0, m[1 ], c1));
+		adjugate[14] = L::negMulAdd(m[14], s0, L::mulSub(m[13], s1, m[12], s3));
+		adjugate[15] = L::mulAdd(m[8 ], s3, L::mulSub(m[10], s0, m[9 ], s1));
+
+		det = L::mulAdd(s0, c5, L::negMulAdd(s1, c4, L::mulAdd(s2, c3, L::mulAdd(s3, c2, L::mulSub(s5, c0, s4, c1)))));
+	}
+
+	/*! batchInvertLanes
+	* Invert the NxN matrices [begin, end) of the planes, width matrices at a time
+	* uint begin: First matrix
+	* uint end: Matrix after the last
+	* size_t stride: Distance between two planes
+	* T* a: Planes of the matrices
+	* T* inverse: Planes of the inverses, may be a
+	* uint8_t* singular: Flags of the matrices, 1 when singular
+	* T error: Maximum absolute value of a singular determinant
+	* return: The first matrix not inverted, when end - begin is not a multiple of width
+	*/
+	template <typename L, uint N, typename T>
+	LITO_SIMD_INLINE uint batchInvertLanes(uint begin, uint end, size_t stride, const T* a, T* inverse, uint8_t* singular, T error)
+	{
+		uint i = begin;
+
+		for (; i + L::width <= end; i += L::width)
+		{
+			typename L::Pack m[N * N], adjugate[N * N];
+
+			for (uint e = 0; e < N * N; e++)
+				m[e] = L::load(a + (stride * e) + i);
+
+			typename L::Pack det;
+
+			batchAdjugate<L>(m, adjugate, det);
+
+			typename L::Pack scale = L::reciprocal(det, error, singular + i);
+
+			for (uint e = 0; e < N * N; e++)
+				L::store(inverse + (stride * e) + i, L::mul(adjugate[e], scale));
+		}
+
+		return i;
+	}
+
+	/*! batchSolveLanes
+	* Solve the NxN systems [begin, end) of the planes, width systems at a time
+	* uint begin: First system
+	* uint end: System after the last
+	* size_t stride: Distance between two planes
+	* T* a: Planes of the matrices
+	* T* b: Planes of the vectors b
+	* T* x: Planes of the solutions, may be b
+	* uint8_t* singular: Flags of the systems, 1 when singular
+	* T error: Maximum absolute value of a singular determinant
+	* return: The first system not solved, when end - begin is not a multiple of width
+	*/
+	template <typename L, uint N, typename T>
+	LITO_SIMD_INLINE uint batchSolveLanes(uint begin, uint end, size_t stride, const T* a, const T* b, T* x, uint8_t* singular, T error)
+	{
+		uint i = begin;
+
+		for (; i + L::width <= end; i += L::width)
+		{
+			typename L::Pack m[N * N], adjugate[N * N], vectorB[N];
+
+			for (uint e = 0; e < N * N; e++)
+				m[e] = L::load(a + (stride * e) + i);
+			for (uint e = 0; e < N; e++)
+				vectorB[e] = L::load(b + (stride * e) + i);
+
+			typename L::Pack det;
+
+			batchAdjugate<L>(m, adjugate, det);
+
+			typename L::Pack scale = L::reciprocal(det, error, singular + i);
+
+			for (uint l = 0; l < N; l++)
+			{
+				typename L::Pack value = L::mul(adjugate[l * N], vectorB[0]);
+
+				for (uint c = 1; c < N; c++)
+					value = L::mulAdd(adjugate[(l * N) + c], vectorB[c], value);
+
+				L::store(x + (stride * l) + i, L::mul(value, scale));
+			}
+		}
+
+		return i;
+	}
+
+	/*! batchInvertRange
+	* Invert the NxN matrices [begin, end) of the planes by the lanes L, and the matrices after the last full register one by one
+	*/
+	template <typename L, uint N, typename T>
+	LITO_SIMD_INLINE void batchInvertRange(uint begin, uint end, size_t stride, const T* a, T* inverse, uint8_t* singular, T error)
+	{
+		begin = batchInvertLanes<L, N>(begin, end, stride, a, inverse, singular, error);
+		batchInvertLanes<ScalarLanes<T>, N>(begin, end, stride, a, inverse, singular, error);
+	}
+
+	/*! batchSolveRange
+	* Solve the NxN systems [begin, end) of the planes by the lanes L, and the systems after the last full register one by one
+	*/
+	template <typename L, uint N, typename T>
+	LITO_SIMD_INLINE void batchSolveRange(uint begin, uint end, size_t stride, const T* a, const T* b, T* x, uint8_t* singular, T error)
+	{
+		begin = batchSolveLanes<L, N>(begin, end, stride, a, b, x, singular, error);
+		batchSolveLanes<ScalarLanes<T>, N>(begin, end, stride, a, b, x, singular, error);
+	}
+
+	template <typename T>
+	void scalarBatchInvert3(uint begin, uint end, size_t stride, const T* a, T* inverse, uint8_t* singular, T error)
+	{
+		batchInvertLanes<ScalarLanes<T>, 3>(begin, end, stride, a, inverse, singular, error);
+	}
+
+	template <typename T>
+	void scalarBatchInvert4(uint begin, uint end, size_t stride, const T* a, T* inverse, uint8_t* singular, T error)
+	{
+		batchInvertLanes<ScalarLanes<T>, 4>(begin, end, stride, a, inverse, singular, error);
+	}
+
+	template <typename T>
+	void scalarBatchSolve3(uint begin, uint end, size_t stride, const T* a, const T* b, T* x, uint8_t* singular, T error)
+	{
+		batchSolveLanes<ScalarLanes<T>, 3>(begin, end, stride, a, b, x, singular, error);
+	}
+
+	template <typename T>
+	void scalarBatchSolve4(uint begin, uint end, size_t stride, const T* a, const T* b, T* x, uint8_t* singular, T error)
+	{
+		batchSolveLanes<ScalarLanes<T>, 4>(begin, end, stride, a, b, x, singular, error);
+	}
+
+#ifdef LITO_SIMD_X86
+
+	/*! LITO_BATCH_KERNELS
+	* Declare the kernels prefixBatchInvert3, prefixBatchInvert4, prefixBatchSolve3 and prefixBatchSolve4 of one type,
+	* compiled for the instruction set isa with the lanes given
+	*/
+	#define LITO_BATCH_KERNELS(prefix, isa, lanes, T)                                                                                   \
+		LITO_SIMD_TARGET(isa)                                                                                                           \
+		inline void prefix##BatchInvert3(uint begin, uint end, size_t stride, const T* a, T* inverse, uint8_t* singular, T error)      \
+		{                                                                                                                               \
+			batchInvertRange<lanes, 3>(begin, end, stride, a, inverse, singular, error);                                                \
+		}                                                                                                                               \
+		LITO_SIMD_TARGET(isa)                                                                                                           \
+		inline void prefix##BatchInvert4(uint begin, uint end, size_t stride, const T* a, T* inverse, uint8_t* singular, T error)      \
+		{                                                                                                                               \
+			batchInvertRange<lanes, 4>(begin, end, stride, a, inverse, singular, error);                                                \
+		}                                                                                                                               \
+		LITO_SIMD_TARGET(isa)                                                                                                           \
+		inline void prefix##BatchSolve3(uint begin, uint end, size_t stride, const T* a, const T* b, T* x, uint8_t* singular, T error) \
+		{                                                                                                                               \
+			batchSolveRange<lanes, 3>(begin, end, stride, a, b, x, singular, error);                                                    \
+		}                                                                                                                               \
+		LITO_SIMD_TARGET(isa)                                                                                                           \
+		inline void prefix##BatchSolve4(uint begin, uint end, size_t stride, const T* a, const T* b, T* x, uint8_t* singular, T error) \
+		{                                                                                                                               \
+			batchSolveRange<lanes, 4>(begin, end, stride, a, b, x, singular, error);                                                    \
+		}
+
+	LITO_BATCH_KERNELS(sse2, "sse2", Sse2FloatLanes, float)
+	LITO_BATCH_KERNELS(sse2, "sse2", Sse2DoubleLanes, double)
+	LITO_BATCH_KERNELS(avx2, "avx2,fma", Avx2FloatLanes, float)
+	LITO_BATCH_KERNELS(avx2, "avx2,fma", Avx2DoubleLanes, double)
+	LITO_BATCH_KERNELS(avx512, "avx512f", Avx512FloatLanes, float)
+	LITO_BATCH_KERNELS(avx512, "avx512f", Avx512DoubleLanes, double)
+
+	#undef LITO_BATCH_KERNELS
+
+#endif
+
+#if defined(__GNUC__) && !defined(__clang__)
+	#pragma GCC diagnostic pop
+#endif
+
+	/*! batchKernels
+	* Get the batch kernels for types without SIMD versions
+	* return: The table of kernels
+	*/
+	template <typename T>
+	const BatchKernels<T>& batchKernels()
+	{
+		static const BatchKernels<T> kernels = { scalarBatchInvert3<T>, scalarBatchInvert4<T>, scalarBatchSolve3<T>, scalarBatchSolve4<T> };
+
+		return kernels;
+	}
+
+	/*! batchKernels
+	* Get the float batch kernels of the SIMD level in use
+	* return: The table of kernels
+	*/
+	template <>
+	inline const BatchKernels<float>& batchKernels<float>()
+	{
+#ifdef LITO_SIMD_X86
+		static const BatchKernels<float> kernels[] = {
+			{ scalarBatchInvert3<float>, scalarBatchInvert4<float>, scalarBatchSolve3<float>, scalarBatchSolve4<float> },
+			{ sse2BatchInvert3, sse2BatchInvert4, sse2BatchSolve3, sse2BatchSolve4 },
+			{ avx2BatchInvert3, avx2BatchInvert4, avx2BatchSolve3, avx2BatchSolve4 },
+			{ avx512BatchInvert3, avx512BatchInvert4, avx512BatchSolve3, avx512BatchSolve4 }
+		};
+
+		return kernels[static_cast<int>(simdLevel())];
+#else
+		static const BatchKernels<float> kernels = { scalarBatchInvert3<float>, scalarBatchInvert4<float>, scalarBatchSolve3<float>, scalarBatchSolve4<float> };
+
+		return kernels;
+#endif
+	}
+
+	/*! batchKernels
+	* Get the double batch kernels of the SIMD level in use
+	* return: The table of kernels
+	*/
+	template <>
+	inline const BatchKernels<double>& batchKernels<double>()
+	{
+#ifdef LITO_SIMD_X86
+		static const BatchKernels<double> kernels[] = {
+			{ scalarBatchInvert3<double>, scalarBatchInvert4<double>, scalarBatchSolve3<double>, scalarBatchSolve4<double> },
+			{ sse2BatchInvert3, sse2BatchInvert4, sse2BatchSolve3, sse2BatchSolve4 },
+			{ avx2BatchInvert3, avx2BatchInvert4, avx2BatchSolve3, avx2BatchSolve4 },
+			{ avx512BatchInvert3, avx512BatchInvert4, avx512BatchSolve3, avx512BatchSolve4 }
+		};
+
+		return kernels[static_cast<int>(simdLevel())];
+#else
+		static const BatchKernels<double> kernels = { scalarBatchInvert3<double>, scalarBatchInvert4<double>, scalarBatchSolve3<double>, scalarBatchSolve4<double> };
+
+		return kernels;
+#endif
+	}
+
+}
+
+#endif
@@ -0,0 +1,338 @@
+#ifndef MATRIX_BLAS_HPP
+#define MATRIX_BLAS_HPP
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include "MatrixEnum.hpp"
+
+// System BLAS and LAPACK: set by the LITO_ALGEBRA_USE_BLAS option of CMake when a CBLAS or a LAPACKE is found,
+// LITO_ALGEBRA_MKL when they are the headers of MKL
+#ifndef LITO_ALGEBRA_CBLAS
+	#define LITO_ALGEBRA_CBLAS 0
+#endif
+#ifndef LITO_ALGEBRA_LAPACKE
+	#define LITO_ALGEBRA_LAPACKE 0
+#endif
+#ifndef LITO_ALGEBRA_MKL
+	#define LITO_ALGEBRA_MKL 0
+#endif
+
+// OpenBLAS declares a global bfloat16 in its headers, which would make lito::bfloat16 ambiguous where the
+// namespace is used: the name is given to another type while the headers are included
+#define bfloat16 lito_blas_bfloat16
+
+#if LITO_ALGEBRA_CBLAS
+	#if LITO_ALGEBRA_MKL
+		#include <mkl_cblas.h>
+	#else
+		#include <cblas.h>
+	#endif
+#endif
+#if LITO_ALGEBRA_LAPACKE
+	#if LITO_ALGEBRA_MKL
+		#include <mkl_lapacke.h>
+	#else
+		#include <lapacke.h>
+	#endif
+#endif
+
+#undef bfloat16
+
+namespace lito {
+
+	template <typename T> bool blasGemm(uint m, uint n, uint k, const T& alpha, const T* A, uint rowStrideA, uint columnStrideA, const T* B, uint rowStrideB, uint columnStrideB, const T& beta, T* C, uint rowStrideC);
+	template <typename T> bool blasTrsm(MatrixSide side, MatrixTriangle triangle, MatrixDiagonal diagonal, uint m, uint n, const T& alpha, const T* A, uint rowStrideA, uint columnStrideA, T* B, uint rowStrideB);
+	template <typename T> bool blasTrsv(uint n, MatrixTriangle triangle, MatrixDiagonal diagonal, const T* A, uint rowStrideA, uint columnStrideA, T* x, uint strideX);
+	template <typename T> bool lapackGetrf(uint n, T* A, uint rowStrideA, uint* pivots);
+	template <typename T> bool lapackPotrf(uint n, T* A, uint rowStrideA, bool& positiveDefinite);
+	template <typename T> bool lapackGeqrf(uint m, uint n, T* A, uint rowStrideA, T* tau);
+
+
+
+	/*! blasGemm
+	* Calculate C = alpha * A * B + beta * C by the system BLAS, with the arguments of gemmKernel
+	* Only float and double with the CBLAS backend are forwarded
+	* return: If the product was done, false when the caller must use the built-in kernel
+	*/
+	template <typename T>
+	bool blasGemm(uint, uint, uint, const T&, const T*, uint, uint, const T*, uint, uint, const T&, T*, uint)
+	{
+		return false;
+	}
+
+	/*! blasTrsm
+	* Solve A * X = alpha * B or X * A = alpha * B by the system BLAS, with the arguments of trsmKernel
+	* Only float and double with the CBLAS backend are forwarded
+	* return: If the system was solved, false when the caller must use the built-in kernel
+	*/
+	template <typename T>
+	bool blasTrsm(MatrixSide, MatrixTriangle, MatrixDiagonal, uint, uint, const T&, const T*, uint, uint, T*, uint)
+	{
+		return false;
+	}
+
+	/*! blasTrsv
+	* Solve A * x = b by the system BLAS, with the arguments of trsvKernel
+	* Only float and double with the CBLAS backend are forwarded
+	* return: If the system was solved, false when the caller must use the built-in kernel
+	*/
+	template <typename T>
+	bool blasTrsv(uint, MatrixTriangle, MatrixDiagonal, const T*, uint, uint, T*, uint)
+	{
+		return false;
+	}
+
+	/*! lapackGetrf
+	* Calculate P * A = L * U with partial pivoting by the system LAPACK, in the layout of luFactor
+	* Only float and double with the LAPACKE backend are forwarded
+	* uint n: Quantities of rows and columns of A
+	* T* A: First value of the square matrix A, replaced by L below the diagonal and U on and above it
+	* uint rowStrideA: Distance between two rows of A
+	* uint* pivots: Receives the n pivots, the line swapped with line i is pivots[i]
+	* return: If A was factorized, false when the caller must use the built-in factorization
+	*/
+	template <typename T>
+	bool lapackGetrf(uint, T*, uint, uint*)
+	{
+		return false;
+	}
+
+	/*! lapackPotrf
+	* Calculate A = Ut * U by the system LAPACK, in the layout of choleskyFactor
+	* Only float and double with the LAPACKE backend are forwarded
+	* uint n: Quantities of rows and columns of A
+	* T* A: First value of the symmetric matrix A, its upper triangle is replaced by U and the lower one is not changed
+	* uint rowStrideA: Distance between two rows of A
+	* bool positiveDefinite: Receives false when a pivot was not positive, the factorization stops there
+	* return: If A was factorized, false when the caller must use the built-in factorization
+	*/
+	template <typename T>
+	bool lapackPotrf(uint, T*, uint, bool&)
+	{
+		return false;
+	}
+
+	/*! lapackGeqrf
+	* Calculate A = Q * R by Householder reflectors by the system LAPACK, in the layout of qrFactor:
+	* R on and above the diagonal and the reflectors, with a first value of one, below it
+	* Only float and double with the LAPACKE backend are forwarded
+	* uint m: Quantities of rows of A
+	* uint n: Quantities of columns of A
+	* T* A: First value of A, replaced by the factors
+	* uint rowStrideA: Distance between two rows of A
+	* T* tau: Receives the min(m, n) scales of the reflectors, H = I - tau * v * vt
+	* return: If A was factorized, false when the caller must use the built-in factorization
+	*/
+	template <typename T>
+	bool lapackGeqrf(uint, uint, T*, uint, T*)
+	{
+		return false;
+	}
+
+#if LITO_ALGEBRA_CBLAS
+	/*! blasLayout
+	* Describe a strided matrix to the row major CBLAS: contiguous rows are passed as they are,
+	* contiguous columns as the transposed of a row major matrix
+	* uint rows: Quantities of rows
+	* uint columns: Quantities of columns
+	* uint rowStride: Distance between two rows
+	* uint columnStride: Distance between two columns
+	* CBLAS_TRANSPOSE transpose: Receives CblasNoTrans or CblasTrans
+	* int leading: Receives the leading dimension
+	* return: If CBLAS can read the matrix, false when neither dimension is contiguous
+	*/
+	inline bool blasLayout(uint rows, uint columns, uint rowStride, uint columnStride, CBLAS_TRANSPOSE& transpose, int& leading)
+	{
+		if (columnStride == 1 && (rows <= 1 || rowStride >= columns))
+		{
+			transpose = CblasNoTrans;
+			leading = int(std::max(std::max(rowStride, columns), 1u));
+			return true;
+		}
+		else if (rowStride == 1 && (columns <= 1 || columnStride >= rows))
+		{
+			transpose = CblasTrans;
+			leading = int(std::max(std::max(columnStride, rows), 1u));
+			return true;
+		}
+
+		return false;
+	}
+
+	/*! blasTriangle
+	* Describe a strided triangular matrix to the row major CBLAS, a transposed upper triangle is a lower one
+	* uint n: Quantities of rows and columns
+	* MatrixTriangle triangle: LOWER or UPPER
+	* uint rowStride: Distance between two rows
+	* uint columnStride: Distance between two columns
+	* CBLAS_UPLO uplo: Receives the triangle of the matrix as CBLAS reads it
+	* CBLAS_TRANSPOSE transpose: Receives CblasNoTrans or CblasTrans
+	* int leading: Receives the leading dimension
+	* return: If CBLAS can read the matrix
+	*/
+	inline bool blasTriangle(uint n, MatrixTriangle triangle, uint rowStride, uint columnStride, CBLAS_UPLO& uplo, CBLAS_TRANSPOSE& transpose, int& leading)
+	{
+		if (!blasLayout(n, n, rowStride, columnStride, transpose, leading))
+			return false;
+
+		bool lower = (triangle == MatrixTriangle::LOWER) == (transpose == CblasNoTrans);
+		uplo = lower ? CblasLower : CblasUpper;
+
+		return true;
+	}
+
+	inline bool blasGemm(uint m, uint n, uint k, const float& alpha, const float* A, uint rowStrideA, uint columnStrideA, const float* B, uint rowStrideB, uint columnStrideB, const float& beta, float* C, uint rowStrideC)
+	{
+		CBLAS_TRANSPOSE transposeA, transposeB;
+		int leadingA, leadingB;
+
+		if (!blasLayout(m, k, rowStrideA, columnStrideA, transposeA, leadingA) || !blasLayout(k, n, rowStrideB, columnStrideB, transposeB, leadingB) || (m > 1 && rowStrideC < n))
+			return false;
+
+		cblas_sgemm(CblasRowMajor, transposeA, transposeB, int(m), int(n), int(k), alpha, A, leadingA, B, leadingB, beta, C, int(std::max(std::max(rowStrideC, n), 1u)));
+
+		return true;
+	}
+
+	inline bool blasGemm(uint m, uint n, uint k, const double& alpha, const double* A, uint rowStrideA, uint columnStrideA, const double* B, uint rowStrideB, uint columnStrideB, const double& beta, double* C, uint rowStrideC)
+	{
+		CBLAS_TRANSPOSE transposeA, transposeB;
+		int leadingA, leadingB;
+
+		if (!blasLayout(m, k, rowStrideA, columnStrideA, transposeA, leadingA) || !blasLayout(k, n, rowStrideB, columnStrideB, transposeB, leadingB) || (m > 1 && rowStrideC < n))
+			return false;
+
+		cblas_dgemm(CblasRowMajor, transposeA, transposeB, int(m), int(n), int(k), alpha, A, leadingA, B, leadingB, beta, C, int(std::max(std::max(rowStrideC, n), 1u)));
+
+		return true;
+	}
+
+	inline bool blasTrsm(MatrixSide side, MatrixTriangle triangle, MatrixDiagonal diagonal, uint m, uint n, const float& alpha, const float* A, uint rowStrideA, uint columnStrideA, float* B, uint rowStrideB)
+	{
+		CBLAS_UPLO uplo;
+		CBLAS_TRANSPOSE transpose;
+		int leading;
+
+		if (!blasTriangle((side == MatrixSide::LEFT) ? m : n, triangle, rowStrideA, columnStrideA, uplo, transpose, leading) || (m > 1 && rowStrideB < n))
+			return false;
+
+		cblas_strsm(CblasRowMajor, (side == MatrixSide::LEFT) ? CblasLeft : CblasRight, uplo, transpose, (diagonal == MatrixDiagonal::UNIT) ? CblasUnit : CblasNonUnit,
+			int(m), int(n), alpha, A, leading, B, int(std::max(std::max(rowStrideB, n), 1u)));
+
+		return true;
+	}
+
+	inline bool blasTrsm(MatrixSide side, MatrixTriangle triangle, MatrixDiagonal diagonal, uint m, uint n, const double& alpha, const double* A, uint rowStrideA, uint columnStrideA, double* B, uint rowStrideB)
+	{
+		CBLAS_UPLO uplo;
+		CBLAS_TRANSPOSE transpose;
+		int leading;
+
+		if (!blasTriangle((side == MatrixSide::LEFT) ? m : n, triangle, rowStrideA, columnStrideA, uplo, transpose, leading) || (m > 1 && rowStrideB < n))
+			return false;
+
+		cblas_dtrsm(CblasRowMajor, (side == MatrixSide::LEFT) ? CblasLeft : CblasRight, uplo, transpose, (diagonal == MatrixDiagonal::UNIT) ? CblasUnit : CblasNonUnit,
+			int(m), int(n), alpha, A, leading, B, int(std::max(std::max(rowStrideB, n), 1u)));
+
+		return true;
+	}
+
+	inline bool blasTrsv(uint n, MatrixTriangle triangle, MatrixDiagonal diagonal, const float* A, uint rowStrideA, uint columnStrideA, float* x, uint strideX)
+	{
+		CBLAS_UPLO uplo;
+		CBLAS_TRANSPOSE transpose;
+		int leading;
+
+		if (!blasTriangle(n, triangle, rowStrideA, columnStrideA, uplo, transpose, leading) || strideX == 0)
+			return false;
+
+		cblas_strsv(CblasRowMajor, uplo, transpose, (diagonal == MatrixDiagonal::UNIT) ? CblasUnit : CblasNonUnit, int(n), A, leading, x, int(strideX));
+
+		return true;
+	}
+
+	inline bool blasTrsv(uint n, MatrixTriangle triangle, MatrixDiagonal diagonal, const double* A, uint rowStrideA, uint columnStrideA, double* x, uint strideX)
+	{
+		CBLAS_UPLO uplo;
+		CBLAS_TRANSPOSE transpose;
+		int leading;
+
+		if (!blasTriangle(n, triangle, rowStrideA, columnStrideA, uplo, transpose, leading) || strideX == 0)
+			return false;
+
+		cblas_dtrsv(CblasRowMajor, uplo, transpose, (diagonal == MatrixDiagonal::UNIT) ? CblasUnit : CblasNonUnit, int(n), A, leading, x, int(strideX));
+
+		return true;
+	}
+#endif
+
+#if LITO_ALGEBRA_LAPACKE
+	/*! lapackPivots
+	* Convert the one based pivots of LAPACK to the pivots of luFactor
+	* uint n: Quantities of pivots
+	* lapack_int ipiv: The pivots of LAPACK
+	* uint* pivots: Receives the pivots
+	*/
+	inline void lapackPivots(uint n, const std::vector<lapack_int>& ipiv, uint* pivots)
+	{
+		for (uint i = 0; i < n; i++)
+			pivots[i] = uint(ipiv[i] - 1);
+	}
+
+	inline bool lapackGetrf(uint n, float* A, uint rowStrideA, uint* pivots)
+	{
+		std::vector<lapack_int> ipiv(n);
+
+		if (LAPACKE_sgetrf(LAPACK_ROW_MAJOR, lapack_int(n), lapack_int(n), A, lapack_int(std::max(rowStrideA, 1u)), ipiv.data()) < 0)
+			return false;
+
+		lapackPivots(n, ipiv, pivots);
+
+		return true;
+	}
+
+	inline bool lapackGetrf(uint n, double* A, uint rowStrideA, uint* pivots)
+	{
+		std::vector<lapack_int> ipiv(n);
+
+		if (LAPACKE_dgetrf(LAPACK_ROW_MAJOR, lapack_int(n), lapack_int(n), A, lapack_int(std::max(rowStrideA, 1u)), ipiv.data()) < 0)
+			return false;
+
+		lapackPivots(n, ipiv, pivots);
+
+		return true;
+	}
+
+	inline bool lapackPotrf(uint n, float* A, uint rowStrideA, bool& positiveDefinite)
+	{
+		lapack_int info = LAPACKE_spotrf(LAPACK_ROW_MAJOR, 'U', lapack_int(n), A, lapack_int(std::max(rowStrideA, 1u)));
+
+		positiveDefinite = (info == 0);
+
+		return info >= 0;
+	}
+
+	inline bool lapackPotrf(uint n, double* A, uint rowStrideA, bool& positiveDefinite)
+	{
+		lapack_int info = LAPACKE_dpotrf(LAPACK_ROW_MAJOR, 'U', lapack_int(n), A, lapack_int(std::max(rowStrideA, 1u)));
+
+		positiveDefinite = (info == 0);
+
+		return info >= 0;
+	}
+
+	inline bool lapackGeqrf(uint m, uint n, float* A, uint rowStrideA, float* tau)
+	{
+		return LAPACKE_sgeqrf(LAPACK_ROW_MAJOR, lapack_int(m), lapack_int(n), A, lapack_int(std::max(rowStrideA, 1u)), tau) >= 0;
+	}
+
+	inline bool lapackGeqrf(uint m, uint n, double* A, uint rowStrideA, double* tau)
+	{
+		return LAPACKE_dgeqrf(LAPACK_ROW_MAJOR, lapack_int(m), lapack_int(n), A, lapack_int(std::max(rowStrideA, 1u)), tau) >= 0;
+	}
+#endif
+
+}
+
+#endif
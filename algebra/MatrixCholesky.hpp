@@ -0,0 +1,903 @@
+#ifndef MATRIX_CHOLESKY_HPP
+#define MATRIX_CHOLESKY_HPP
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "Matrix.hpp"
+#include "MatrixExpression.hpp"
+#include "MatrixTrsm.hpp"
+
+namespace lito {
+
+	/*! CholeskyBlocking
+	* Size of the blocks used by the Cholesky and LDLt factorizations
+	* NB: Lines of each diagonal block, also the depth of the GEMM of the trailing matrix update
+	* Matrices with fewer than 2 * NB rows are factorized without blocks
+	*/
+	template <typename T>
+	struct CholeskyBlocking {
+		static const uint NB = 128;
+	};
+
+	/*! CholeskyFactorization
+	* Factorization A = L * Lt of a symmetric positive definite matrix, computed once and used for many systems
+	* The matrices are row major, so L is kept transposed: U = Lt in the upper triangle, A = Ut * U
+	*/
+	template <typename T>
+	class CholeskyFactorization {
+	public:
+		CholeskyFactorization();
+		CholeskyFactorization(Matrix<T>&& u, bool positiveDefinite);
+
+		const Matrix<T>& getU() const;
+		const uint& getSize() const;
+		bool isPositiveDefinite() const;
+
+		Matrix<T> solve(const Matrix<T>& vectorB) const;
+		Matrix<T> solveMany(const Matrix<T>& matrixB) const;
+		Matrix<T>& solveInPlace(Matrix<T>& matrixB) const;
+		T determinant() const;
+		Matrix<T> inverse() const;
+
+		CholeskyFactorization<T>& update(const Matrix<T>& matrixX);
+		CholeskyFactorization<T>& downdate(const Matrix<T>& matrixX);
+
+	private:
+		void check(const Matrix<T>& matrixB) const;
+		void rankUpdate(const Matrix<T>& matrixX, T sign);
+
+		Matrix<T> _u;
+		bool _positiveDefinite;
+	};
+
+	/*! LDLFactorization
+	* Factorization A = L * D * Lt of a symmetric matrix without pivoting, L with unit diagonal and D diagonal
+	* L is kept transposed, U = Lt above the diagonal (its unit diagonal is not stored) and D on it
+	*/
+	template <typename T>
+	class LDLFactorization {
+	public:
+		LDLFactorization();
+		LDLFactorization(Matrix<T>&& du, bool singular);
+
+		const Matrix<T>& getDU() const;
+		const uint& getSize() const;
+		bool isSingular() const;
+		bool isPositiveDefinite() const;
+
+		Matrix<T> solve(const Matrix<T>& vectorB) const;
+		Matrix<T> solveMany(const Matrix<T>& matrixB) const;
+		Matrix<T>& solveInPlace(Matrix<T>& matrixB) const;
+		T determinant() const;
+		Matrix<T> inverse() const;
+
+		LDLFactorization<T>& update(const Matrix<T>& matrixX);
+		LDLFactorization<T>& downdate(const Matrix<T>& matrixX);
+
+	private:
+		void check(const Matrix<T>& matrixB) const;
+		void substitute(Matrix<T>& matrixB, uint columnBegin, uint columnEnd) const;
+		void rankUpdate(const Matrix<T>& matrixX, T sign);
+
+		Matrix<T> _du;
+		bool _singular;
+	};
+
+	template <typename T> bool choleskyFactorBlock(Matrix<T>& M, uint k, uint kb, const T error);
+	template <typename T> void choleskySolveLines(Matrix<T>& M, uint k, uint kb, uint columnBegin, uint columnEnd);
+	template <typename T> bool ldlFactorBlock(Matrix<T>& M, uint k, uint kb, const T error);
+	template <typename T> void ldlSolveLines(Matrix<T>& M, Matrix<T>& W, uint k, uint kb, uint columnBegin, uint columnEnd);
+	template <typename T> void symmetricUpdate(Matrix<T>& M, uint k, uint kb, const T* W, uint rowStrideW);
+	template <typename T> void clearLower(Matrix<T>& M);
+
+	template <typename T> CholeskyFactorization<T> choleskyFactor(Matrix<T>&& M, const T error = T(0));
+	template <typename T> CholeskyFactorization<T> choleskyFactor(const Matrix<T>& M, const T error = T(0));
+	template <typename T> LDLFactorization<T> ldlFactor(Matrix<T>&& M, const T error = T(0));
+	template <typename T> LDLFactorization<T> ldlFactor(const Matrix<T>& M, const T error = T(0));
+	template <typename E> CholeskyFactorization<typename E::ValueType> choleskyFactor(const MatrixExpression<E>& M, const typename E::ValueType error = 0);
+	template <typename E> LDLFactorization<typename E::ValueType> ldlFactor(const MatrixExpression<E>& M, const typename E::ValueType error = 0);
+
+
+
+	/*! CholeskyFactorization
+	* Initialize an empty factorization
+	*/
+	template <typename T>
+	CholeskyFactorization<T>::CholeskyFactorization()
+		: _positiveDefinite(false)
+	{}
+
+	/*! CholeskyFactorization
+	* Initialize the factorization with its parts, as computed by choleskyFactor
+	* Matrix<T> u: U = Lt on and above the diagonal, zeros below it
+	* bool positiveDefinite: If every pivot was positive
+	*/
+	template <typename T>
+	CholeskyFactorization<T>::CholeskyFactorization(Matrix<T>&& u, bool positiveDefinite)
+		: _u(std::move(u))
+		, _positiveDefinite(positiveDefinite)
+	{}
+
+	/*! getU
+	* Get U = Lt, with A = Ut * U
+	* return: The factor
+	*/
+	template <typename T>
+	const Matrix<T>& CholeskyFactorization<T>::getU() const
+	{
+		return _u;
+	}
+
+	/*! getSize
+	* Get the quantities of rows (and columns) of the matrix factorized
+	* return: The size
+	*/
+	template <typename T>
+	const uint& CholeskyFactorization<T>::getSize() const
+	{
+		return _u.getRows();
+	}
+
+	/*! isPositiveDefinite
+	* Tell if the matrix is positive definite, otherwise the factorization stopped at the first pivot
+	* not positive and the caller must use other method, as luFactor
+	* return: If the matrix is positive definite
+	*/
+	template <typename T>
+	bool CholeskyFactorization<T>::isPositiveDefinite() const
+	{
+		return _positiveDefinite;
+	}
+
+	/*! solve
+	* Solve the system Ax=b
+	* Matrix<T> vectorB: The vector b, or a matrix with one b per column
+	* return: The vector x
+	*/
+	template <typename T>
+	Matrix<T> CholeskyFactorization<T>::solve(const Matrix<T>& vectorB) const
+	{
+		Matrix<T> vectorX(vectorB);
+
+		return std::move(solveInPlace(vectorX));
+	}
+
+	/*! solveMany
+	* Solve the systems AX=B, one system per column of B
+	* Matrix<T> matrixB: The matrix B
+	* return: The matrix X
+	*/
+	template <typename T>
+	Matrix<T> CholeskyFactorization<T>::solveMany(const Matrix<T>& matrixB) const
+	{
+		Matrix<T> matrixX(matrixB);
+
+		return std::move(solveInPlace(matrixX));
+	}
+
+	/*! solveInPlace
+	* Solve the systems AX=B writing X over B
+	* Ut and U are applied by the blocked triangular solve trsmKernel, Ut read as U with the strides switched
+	* With the PARALLEL policy the columns of B are split among the threads
+	* Matrix<T> matrixB: The matrix B, replaced by X
+	* return: The matrix X
+	*/
+	template <typename T>
+	Matrix<T>& CholeskyFactorization<T>::solveInPlace(Matrix<T>& matrixB) const
+	{
+		check(matrixB);
+
+		uint n = getSize();
+		uint columns = matrixB.getColumns();
+
+		trsmKernel(MatrixSide::LEFT, MatrixTriangle::LOWER, MatrixDiagonal::NON_UNIT, n, columns, T(1), _u.data(), 1, _u.getStride(), matrixB.data(), matrixB.getStride());
+		trsmKernel(MatrixSide::LEFT, MatrixTriangle::UPPER, MatrixDiagonal::NON_UNIT, n, columns, T(1), _u.data(), _u.getStride(), 1, matrixB.data(), matrixB.getStride());
+
+		return matrixB;
+	}
+
+	/*! determinant
+	* Calculate the determinant of A, the square of the product of the diagonal of U
+	* return: The determinant
+	*/
+	template <typename T>
+	T CholeskyFactorization<T>::determinant() const
+	{
+		if (_u.getRows() == 0)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+		else if (!_positiveDefinite)
+			throw(MatrixException(MatrixExceptionType::NOT_POSITIVE_DEFINITE));
+
+		T deter = T(1);
+
+		for (uint i = 0; i < getSize(); i++)
+			deter *= _u.row(i)[i] * _u.row(i)[i];
+
+		return deter;
+	}
+
+	/*! inverse
+	* Calculate the inverse of A solving AX=I
+	* return: The inverse
+	*/
+	template <typename T>
+	Matrix<T> CholeskyFactorization<T>::inverse() const
+	{
+		return solveMany(Matrix<T>(getSize(), getSize(), MatrixType::IDENTITY));
+	}
+
+	/*! update
+	* Change the factorization of A to the factorization of A + X * Xt, in O(n^2) per column of X
+	* Matrix<T> matrixX: The matrix X, n x k
+	* return: The factorization updated
+	*/
+	template <typename T>
+	CholeskyFactorization<T>& CholeskyFactorization<T>::update(const Matrix<T>& matrixX)
+	{
+		rankUpdate(matrixX, T(1));
+
+		return *this;
+	}
+
+	/*! downdate
+	* Change the factorization of A to the factorization of A - X * Xt, in O(n^2) per column of X
+	* When A - X * Xt is not positive definite, throws NOT_POSITIVE_DEFINITE and the factorization is lost
+	* Matrix<T> matrixX: The matrix X, n x k
+	* return: The factorization downdated
+	*/
+	template <typename T>
+	CholeskyFactorization<T>& CholeskyFactorization<T>::downdate(const Matrix<T>& matrixX)
+	{
+		rankUpdate(matrixX, T(-1));
+
+		return *this;
+	}
+
+	/*! check
+	* Check if the systems with B can be solved
+	* Matrix<T> matrixB: The matrix B
+	*/
+	template <typename T>
+	void CholeskyFactorization<T>::check(const Matrix<T>& matrixB) const
+	{
+		if (_u.getRows() == 0 || matrixB.getRows() * matrixB.getColumns() == 0)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+		else if (matrixB.getRows() != getSize())
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, getSize(), getSize(), matrixB.getRows(), matrixB.getColumns(), 'X'));
+		else if (!_positiveDefinite)
+			throw(MatrixException(MatrixExceptionType::NOT_POSITIVE_DEFINITE));
+	}
+
+	/*! rankUpdate
+	* Change the factorization to the one of A + sign * X * Xt, one column of X at a time
+	* Each column rotates the lines of U, as the rows of U are the columns of L
+	* Matrix<T> matrixX: The matrix X, n x k
+	* T sign: 1 to update, -1 to downdate
+	*/
+	template <typename T>
+	void CholeskyFactorization<T>::rankUpdate(const Matrix<T>& matrixX, T sign)
+	{
+		if (_u.getRows() == 0 || matrixX.getRows() * matrixX.getColumns() == 0)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+		else if (matrixX.getRows() != getSize())
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, getSize(), getSize(), matrixX.getRows(), matrixX.getColumns(), 'X'));
+		else if (!_positiveDefinite)
+			throw(MatrixException(MatrixExceptionType::NOT_POSITIVE_DEFINITE));
+
+		uint n = getSize();
+		std::vector<T> vectorX(n);
+
+		for (uint c = 0; c < matrixX.getColumns(); c++)
+		{
+			for (uint i = 0; i < n; i++)
+				vectorX[i] = matrixX.row(i)[c];
+
+			for (uint j = 0; j < n; j++)
+			{
+				T* lineU = _u.row(j);
+				T valueSquare = (lineU[j] * lineU[j]) + (sign * vectorX[j] * vectorX[j]);
+
+				if (!(valueSquare > T(0)))
+				{
+					_positiveDefinite = false;
+					throw(MatrixException(MatrixExceptionType::NOT_POSITIVE_DEFINITE));
+				}
+
+				T value = T(std::sqrt(valueSquare));
+				T cosine = value / lineU[j];
+				T sine = vectorX[j] / lineU[j];
+				uint count = n - j - 1;
+
+				lineU[j] = value;
+
+				simdKernels<T>().axpy(count, sign * sine, vectorX.data() + j + 1, lineU + j + 1);
+				simdKernels<T>().scale(count, T(1) / cosine, lineU + j + 1);
+				simdKernels<T>().scale(count, cosine, vectorX.data() + j + 1);
+				simdKernels<T>().axpy(count, -sine, lineU + j + 1, vectorX.data() + j + 1);
+			}
+		}
+	}
+
+	/*! LDLFactorization
+	* Initialize an empty factorization
+	*/
+	template <typename T>
+	LDLFactorization<T>::LDLFactorization()
+		: _singular(true)
+	{}
+
+	/*! LDLFactorization
+	* Initialize the factorization with its parts, as computed by ldlFactor
+	* Matrix<T> du: D on the diagonal, U = Lt above it and zeros below it
+	* bool singular: If a value of D was zero
+	*/
+	template <typename T>
+	LDLFactorization<T>::LDLFactorization(Matrix<T>&& du, bool singular)
+		: _du(std::move(du))
+		, _singular(singular)
+	{}
+
+	/*! getDU
+	* Get D on the diagonal and U = Lt above it (its unit diagonal is not stored), with A = Ut * D * U
+	* return: The factors
+	*/
+	template <typename T>
+	const Matrix<T>& LDLFactorization<T>::getDU() const
+	{
+		return _du;
+	}
+
+	/*! getSize
+	* Get the quantities of rows (and columns) of the matrix factorized
+	* return: The size
+	*/
+	template <typename T>
+	const uint& LDLFactorization<T>::getSize() const
+	{
+		return _du.getRows();
+	}
+
+	/*! isSingular
+	* Tell if a value of D was zero, then the factorization stopped there and the systems can not be solved
+	* return: If the matrix is singular
+	*/
+	template <typename T>
+	bool LDLFactorization<T>::isSingular() const
+	{
+		return _singular;
+	}
+
+	/*! isPositiveDefinite
+	* Tell if the matrix is positive definite, every value of D positive
+	* return: If the matrix is positive definite
+	*/
+	template <typename T>
+	bool LDLFactorization<T>::isPositiveDefinite() const
+	{
+		if (_singular)
+			return false;
+
+		for (uint i = 0; i < getSize(); i++)
+			if (!(_du.row(i)[i] > T(0)))
+				return false;
+
+		return true;
+	}
+
+	/*! solve
+	* Solve the system Ax=b
+	* Matrix<T> vectorB: The vector b, or a matrix with one b per column
+	* return: The vector x
+	*/
+	template <typename T>
+	Matrix<T> LDLFactorization<T>::solve(const Matrix<T>& vectorB) const
+	{
+		Matrix<T> vectorX(vectorB);
+
+		return std::move(solveInPlace(vectorX));
+	}
+
+	/*! solveMany
+	* Solve the systems AX=B, one system per column of B
+	* Matrix<T> matrixB: The matrix B
+	* return: The matrix X
+	*/
+	template <typename T>
+	Matrix<T> LDLFactorization<T>::solveMany(const Matrix<T>& matrixB) const
+	{
+		Matrix<T> matrixX(matrixB);
+
+		return std::move(solveInPlace(matrixX));
+	}
+
+	/*! solveInPlace
+	* Solve the systems AX=B writing X over B
+	* With the PARALLEL policy the columns of B are split among the threads
+	* Matrix<T> matrixB: The matrix B, replaced by X
+	* return: The matrix X
+	*/
+	template <typename T>
+	Matrix<T>& LDLFactorization<T>::solveInPlace(Matrix<T>& matrixB) const
+	{
+		check(matrixB);
+
+		uint n = getSize();
+
+		parallelFor(0, matrixB.getColumns(), double(n) * n * matrixB.getColumns(), [&](uint from, uint to)
+		{
+			substitute(matrixB, from, to);
+		});
+
+		return matrixB;
+	}
+
+	/*! determinant
+	* Calculate the determinant of A, the product of D
+	* return: The determinant, zero when singular
+	*/
+	template <typename T>
+	T LDLFactorization<T>::determinant() const
+	{
+		if (_du.getRows() == 0)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+
+		if (_singular)
+			return T(0);
+
+		T deter = T(1);
+
+		for (uint i = 0; i < getSize(); i++)
+			deter *= _du.row(i)[i];
+
+		return deter;
+	}
+
+	/*! inverse
+	* Calculate the inverse of A solving AX=I
+	* return: The inverse
+	*/
+	template <typename T>
+	Matrix<T> LDLFactorization<T>::inverse() const
+	{
+		return solveMany(Matrix<T>(getSize(), getSize(), MatrixType::IDENTITY));
+	}
+
+	/*! update
+	* Change the factorization of A to the factorization of A + X * Xt, in O(n^2) per column of X
+	* Matrix<T> matrixX: The matrix X, n x k
+	* return: The factorization updated
+	*/
+	template <typename T>
+	LDLFactorization<T>& LDLFactorization<T>::update(const Matrix<T>& matrixX)
+	{
+		rankUpdate(matrixX, T(1));
+
+		return *this;
+	}
+
+	/*! downdate
+	* Change the factorization of A to the factorization of A - X * Xt, in O(n^2) per column of X
+	* When a value of D becomes zero, throws SINGULAR_MATRIX and the factorization is lost
+	* Matrix<T> matrixX: The matrix X, n x k
+	* return: The factorization downdated
+	*/
+	template <typename T>
+	LDLFactorization<T>& LDLFactorization<T>::downdate(const Matrix<T>& matrixX)
+	{
+		rankUpdate(matrixX, T(-1));
+
+		return *this;
+	}
+
+	/*! check
+	* Check if the systems with B can be solved
+	* Matrix<T> matrixB: The matrix B
+	*/
+	template <typename T>
+	void LDLFactorization<T>::check(const Matrix<T>& matrixB) const
+	{
+		if (_du.getRows() == 0 || matrixB.getRows() * matrixB.getColumns() == 0)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+		else if (matrixB.getRows() != getSize())
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, getSize(), getSize(), matrixB.getRows(), matrixB.getColumns(), 'X'));
+		else if (_singular)
+			throw(MatrixException(MatrixExceptionType::SINGULAR_MATRIX));
+	}
+
+	/*! substitute
+	* Solve Ut * Z = B, then D * Y = Z and then U * X = Y on a range of columns of B
+	* Matrix<T> matrixB: The matrix B, replaced by X
+	* uint columnBegin: First column
+	* uint columnEnd: Column after the last
+	*/
+	template <typename T>
+	void LDLFactorization<T>::substitute(Matrix<T>& matrixB, uint columnBegin, uint columnEnd) const
+	{
+		uint n = getSize();
+		uint count = columnEnd - columnBegin;
+
+		for (uint j = 0; j < n; j++)
+		{
+			const T* lineU = _du.row(j);
+			const T* lineB = matrixB.row(j) + columnBegin;
+
+			for (uint i = j + 1; i < n; i++)
+				if (lineU[i] != T(0))
+					simdKernels<T>().axpy(count, -lineU[i], lineB, matrixB.row(i) + columnBegin);
+		}
+
+		for (uint i = n; i-- > 0;)
+		{
+			const T* lineU = _du.row(i);
+			T* lineB = matrixB.row(i) + columnBegin;
+
+			simdKernels<T>().scale(count, T(1) / lineU[i], lineB);
+
+			for (uint j = i + 1; j < n; j++)
+				if (lineU[j] != T(0))
+					simdKernels<T>().axpy(count, -lineU[j], matrixB.row(j) + columnBegin, lineB);
+		}
+	}
+
+	/*! rankUpdate
+	* Change the factorization to the one of A + sign * X * Xt, one column of X at a time
+	* Matrix<T> matrixX: The matrix X, n x k
+	* T sign: 1 to update, -1 to downdate
+	*/
+	template <typename T>
+	void LDLFactorization<T>::rankUpdate(const Matrix<T>& matrixX, T sign)
+	{
+		if (_du.getRows() == 0 || matrixX.getRows() * matrixX.getColumns() == 0)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+		else if (matrixX.getRows() != getSize())
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, getSize(), getSize(), matrixX.getRows(), matrixX.getColumns(), 'X'));
+		else if (_singular)
+			throw(MatrixException(MatrixExceptionType::SINGULAR_MATRIX));
+
+		uint n = getSize();
+		std::vector<T> vectorX(n);
+
+		for (uint c = 0; c < matrixX.getColumns(); c++)
+		{
+			T alpha = sign;
+
+			for (uint i = 0; i < n; i++)
+				vectorX[i] = matrixX.row(i)[c];
+
+			for (uint j = 0; j < n; j++)
+			{
+				T* lineU = _du.row(j);
+				T value = vectorX[j];
+				T diagonal = lineU[j] + (alpha * value * value);
+
+				if (diagonal == T(0))
+				{
+					_singular = true;
+					throw(MatrixException(MatrixExceptionType::SINGULAR_MATRIX));
+				}
+
+				T beta = (value * alpha) / diagonal;
+				uint count = n - j - 1;
+
+				alpha = (lineU[j] * alpha) / diagonal;
+				lineU[j] = diagonal;
+
+				simdKernels<T>().axpy(count, -value, lineU + j + 1, vectorX.data() + j + 1);
+				simdKernels<T>().axpy(count, beta, vectorX.data() + j + 1, lineU + j + 1);
+			}
+		}
+	}
+
+	/*! choleskyFactorBlock
+	* Factorize the diagonal block [k, k + kb) by the lines of U, each line scaled by the root of its pivot
+	* and subtracted from the lines below it
+	* Matrix<T> M: The matrix in factorization, the lines before k are already factorized
+	* uint k: First line (and column) of the block
+	* uint kb: Quantities of lines of the block
+	* T error: Pivots up to error mark the matrix as not positive definite
+	* return: If every pivot was positive
+	*/
+	template <typename T>
+	bool choleskyFactorBlock(Matrix<T>& M, uint k, uint kb, const T error)
+	{
+		uint end = k + kb;
+
+		for (uint j = k; j < end; j++)
+		{
+			T* lineJ = M.row(j);
+
+			if (!(lineJ[j] > error))
+				return false;
+
+			lineJ[j] = T(std::sqrt(lineJ[j]));
+			simdKernels<T>().scale(end - j - 1, T(1) / lineJ[j], lineJ + j + 1);
+
+			// The lines below the pivot are independent, so they are updated in parallel
+			parallelFor(j + 1, end, double(end - j - 1) * (end - j - 1), [&](uint from, uint to)
+			{
+				for (uint i = from; i < to; i++)
+					if (lineJ[i] != T(0))
+						simdKernels<T>().axpy(end - i, -lineJ[i], lineJ + i, M.row(i) + i);
+			});
+		}
+
+		return true;
+	}
+
+	/*! choleskySolveLines
+	* Calculate the lines of U right of a diagonal block, solving U11t * U12 = A12
+	* Matrix<T> M: The matrix in factorization
+	* uint k: First line (and column) of the block
+	* uint kb: Quantities of lines of the block
+	* uint columnBegin: First column
+	* uint columnEnd: Column after the last
+	*/
+	template <typename T>
+	void choleskySolveLines(Matrix<T>& M, uint k, uint kb, uint columnBegin, uint columnEnd)
+	{
+		// Each column only depends on itself, so the columns are solved in parallel
+		parallelFor(columnBegin, columnEnd, double(kb) * kb * (columnEnd - columnBegin), [&](uint from, uint to)
+		{
+			for (uint j = k; j < k + kb; j++)
+			{
+				const T* lineU = M.row(j);
+				T* lineJ = M.row(j) + from;
+
+				simdKernels<T>().scale(to - from, T(1) / lineU[j], lineJ);
+
+				for (uint i = j + 1; i < k + kb; i++)
+					if (lineU[i] != T(0))
+						simdKernels<T>().axpy(to - from, -lineU[i], lineJ, M.row(i) + from);
+			}
+		});
+	}
+
+	/*! ldlFactorBlock
+	* Factorize the diagonal block [k, k + kb) by the lines of U, each line subtracted from the lines below it
+	* and then divided by its value of D
+	* Matrix<T> M: The matrix in factorization, the lines before k are already factorized
+	* uint k: First line (and column) of the block
+	* uint kb: Quantities of lines of the block
+	* T error: Values of D with absolute value up to error mark the matrix as singular
+	* return: If every value of D was not zero
+	*/
+	template <typename T>
+	bool ldlFactorBlock(Matrix<T>& M, uint k, uint kb, const T error)
+	{
+		uint end = k + kb;
+
+		for (uint j = k; j < end; j++)
+		{
+			T* lineJ = M.row(j);
+
+			if (!(T(std::abs(lineJ[j])) > error))
+				return false;
+
+			const T diagonalInverse = T(1) / lineJ[j];
+
+			// The lines below the pivot are independent, so they are updated in parallel
+			parallelFor(j + 1, end, double(end - j - 1) * (end - j - 1), [&](uint from, uint to)
+			{
+				for (uint i = from; i < to; i++)
+					if (lineJ[i] != T(0))
+						simdKernels<T>().axpy(end - i, -lineJ[i] * diagonalInverse, lineJ + i, M.row(i) + i);
+			});
+
+			simdKernels<T>().scale(end - j - 1, diagonalInverse, lineJ + j + 1);
+		}
+
+		return true;
+	}
+
+	/*! ldlSolveLines
+	* Calculate the lines of U right of a diagonal block, solving U11t * W12 = A12 and U12 = D1^-1 * W12
+	* W12 = D1 * U12 is kept for the trailing matrix update
+	* Matrix<T> M: The matrix in factorization
+	* Matrix<T> W: Receives W12, its column 0 is the column columnBegin of M
+	* uint k: First line (and column) of the block
+	* uint kb: Quantities of lines of the block
+	* uint columnBegin: First column
+	* uint columnEnd: Column after the last
+	*/
+	template <typename T>
+	void ldlSolveLines(Matrix<T>& M, Matrix<T>& W, uint k, uint kb, uint columnBegin, uint columnEnd)
+	{
+		// Each column only depends on itself, so the columns are solved in parallel
+		parallelFor(columnBegin, columnEnd, double(kb) * kb * (columnEnd - columnBegin), [&](uint from, uint to)
+		{
+			for (uint j = k; j < k + kb; j++)
+			{
+				const T* lineU = M.row(j);
+				T* lineJ = M.row(j) + from;
+
+				for (uint i = j + 1; i < k + kb; i++)
+					if (lineU[i] != T(0))
+						simdKernels<T>().axpy(to - from, -lineU[i], lineJ, M.row(i) + from);
+
+				std::copy(lineJ, lineJ + (to - from), W.row(j - k) + (from - columnBegin));
+				simdKernels<T>().scale(to - from, T(1) / lineU[j], lineJ);
+			}
+		});
+	}
+
+	/*! symmetricUpdate
+	* Update the upper triangle of the trailing matrix, A22 = A22 - U12t * W12, by the GEMM kernel
+	* The trailing matrix is split in strips of NB lines, each strip only from the diagonal to the right
+	* Matrix<T> M: The matrix in factorization
+	* uint k: First line (and column) of the diagonal block
+	* uint kb: Quantities of lines of the block
+	* T* W: First value of W12, U12 for Cholesky and D1 * U12 for LDLt
+	* uint rowStrideW: Distance between two rows of W
+	*/
+	template <typename T>
+	void symmetricUpdate(Matrix<T>& M, uint k, uint kb, const T* W, uint rowStrideW)
+	{
+		const uint NB = CholeskyBlocking<T>::NB;
+		uint n = M.getRows();
+		uint next = k + kb;
+
+		for (uint ib = next; ib < n; ib += NB)
+		{
+			uint ibb = std::min(NB, n - ib);
+
+			gemmKernel(ibb, n - ib, kb, T(-1),
+			           M.row(k) + ib, 1, M.getStride(),
+			           W + (ib - next), rowStrideW, 1,
+			           T(1), M.row(ib) + ib, M.getStride());
+		}
+	}
+
+	/*! clearLower
+	* Set zero below the diagonal, where the blocked factorizations leave partial values
+	* Matrix<T> M: The matrix
+	*/
+	template <typename T>
+	void clearLower(Matrix<T>& M)
+	{
+		for (uint i = 1; i < M.getRows(); i++)
+			std::fill(M.row(i), M.row(i) + std::min(i, M.getColumns()), T(0));
+	}
+
+	/*! choleskyFactor
+	* Calculate A = Ut * U, U = Lt, by blocks in the storage of the matrix
+	* Only the upper triangle of A is read, as A must be symmetric
+	* Big matrices are factorized by diagonal blocks of NB lines: after each block the lines of U right of it
+	* are solved and the upper triangle of the trailing matrix is updated by the GEMM kernel
+	* The factorization stops at the first pivot not positive, so it is also a cheap check:
+	* when isPositiveDefinite() is false the caller can use luFactor
+	* When the build has a system LAPACKE, float and double matrices are factorized by it
+	* Matrix<T> M: The symmetric matrix A, its storage is taken by the factorization
+	* T error: Pivots up to error mark the matrix as not positive definite
+	* return: The factorization
+	*/
+	template <typename T>
+	CholeskyFactorization<T> choleskyFactor(Matrix<T>&& M, const T error)
+	{
+		if (M.getRows() * M.getColumns() == 0)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+		else if (M.getRows() != M.getColumns())
+			throw(MatrixException(MatrixExceptionType::INVALID_SIZE, M.getRows(), M.getColumns()));
+
+		uint n = M.getRows();
+		uint nb = (n < 2 * CholeskyBlocking<T>::NB) ? n : CholeskyBlocking<T>::NB;
+		bool positiveDefinite = true;
+
+		// A system LAPACK stops only at pivots not positive, the pivots up to error are checked here
+		if (lapackPotrf(n, M.data(), M.getStride(), positiveDefinite))
+		{
+			for (uint i = 0; i < n && positiveDefinite; i++)
+				positiveDefinite = M.row(i)[i] * M.row(i)[i] > error;
+		}
+		else
+		{
+			for (uint k = 0; k < n && positiveDefinite; k += nb)
+			{
+				uint kb = std::min(nb, n - k);
+
+				positiveDefinite = choleskyFactorBlock(M, k, kb, error);
+
+				if (positiveDefinite && k + kb < n)
+				{
+					choleskySolveLines(M, k, kb, k + kb, n);
+					symmetricUpdate(M, k, kb, M.row(k) + k + kb, M.getStride());
+				}
+			}
+		}
+
+		clearLower(M);
+
+		return CholeskyFactorization<T>(std::move(M), positiveDefinite);
+	}
+
+	/*! choleskyFactor
+	* Calculate A = Ut * U, U = Lt, by blocks on a copy of the matrix
+	* Matrix<T> M: The symmetric matrix A
+	* T error: Pivots up to error mark the matrix as not positive definite
+	* return: The factorization
+	*/
+	template <typename T>
+	CholeskyFactorization<T> choleskyFactor(const Matrix<T>& M, const T error)
+	{
+		return choleskyFactor(Matrix<T>(M), error);
+	}
+
+	/*! ldlFactor
+	* Calculate A = Ut * D * U, U = Lt, by blocks in the storage of the matrix, without pivoting
+	* Only the upper triangle of A is read, as A must be symmetric
+	* Big matrices are factorized by diagonal blocks of NB lines, as choleskyFactor, with no square roots
+	* Matrix<T> M: The symmetric matrix A, its storage is taken by the factorization
+	* T error: Values of D with absolute value up to error mark the matrix as singular
+	* return: The factorization
+	*/
+	template <typename T>
+	LDLFactorization<T> ldlFactor(Matrix<T>&& M, const T error)
+	{
+		if (M.getRows() * M.getColumns() == 0)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+		else if (M.getRows() != M.getColumns())
+			throw(MatrixException(MatrixExceptionType::INVALID_SIZE, M.getRows(), M.getColumns()));
+
+		uint n = M.getRows();
+		uint nb = (n < 2 * CholeskyBlocking<T>::NB) ? n : CholeskyBlocking<T>::NB;
+		bool singular = false;
+		Matrix<T> W;
+
+		for (uint k = 0; k < n && !singular; k += nb)
+		{
+			uint kb = std::min(nb, n - k);
+
+			singular = !ldlFactorBlock(M, k, kb, error);
+
+			if (!singular && k + kb < n)
+			{
+				W.resize(kb, n - k - kb);
+				ldlSolveLines(M, W, k, kb, k + kb, n);
+				symmetricUpdate(M, k, kb, W.data(), W.getStride());
+			}
+		}
+
+		clearLower(M);
+
+		return LDLFactorization<T>(std::move(M), singular);
+	}
+
+	/*! ldlFactor
+	* Calculate A = Ut * D * U, U = Lt, by blocks on a copy of the matrix, without pivoting
+	* Matrix<T> M: The symmetric matrix A
+	* T error: Values of D with absolute value up to error mark the matrix as singular
+	* return: The factorization
+	*/
+	template <typename T>
+	LDLFactorization<T> ldlFactor(const Matrix<T>& M, const T error)
+	{
+		return ldlFactor(Matrix<T>(M), error);
+	}
+
+	/*! choleskyFactor
+	* Calculate A = Ut * U of an expression or a view, evaluated once into the factorization
+	* MatrixExpression<E> M: The symmetric matrix A
+	* T error: Pivots up to error mark the matrix as not positive definite
+	* return: The factorization
+	*/
+	template <typename E>
+	CholeskyFactorization<typename E::ValueType> choleskyFactor(const MatrixExpression<E>& M, const typename E::ValueType error)
+	{
+		return choleskyFactor(Matrix<typename E::ValueType>(M), error);
+	}
+
+	/*! ldlFactor
+	* Calculate A = Ut * D * U of an expression or a view, evaluated once into the factorization
+	* MatrixExpression<E> M: The symmetric matrix A
+	* T error: Values of D with absolute value up to error mark the matrix as singular
+	* return: The factorization
+	*/
+	template <typename E>
+	LDLFactorization<typename E::ValueType> ldlFactor(const MatrixExpression<E>& M, const typename E::ValueType error)
+	{
+		return ldlFactor(Matrix<typename E::ValueType>(M), error);
+	}
+
+}
+
+#endif
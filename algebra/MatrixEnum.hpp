@@ -7,7 +7,15 @@ namespace lito {
 
 	enum class MatrixType { IDENTITY, ZEROS, ONES };
 	enum class Ori_transf { xy, yz, zx };
-	enum class MatrixExceptionType { INVALID_ACCESS, INVALID_SIZE, INCOMPATIBLE_SIZES, MATRIX_NOT_INITIALIZED };
+	enum class MatrixExceptionType { INVALID_ACCESS, INVALID_SIZE, INCOMPATIBLE_SIZES, MATRIX_NOT_INITIALIZED, SINGULAR_MATRIX, NOT_POSITIVE_DEFINITE, FILE_ERROR, INVALID_FILE_FORMAT };
+	enum class SimdLevel { SCALAR, SSE2, AVX2, AVX512 };
+	enum class ExecutionPolicy { SEQUENTIAL, PARALLEL };
+	enum class GaussMethod { REDUCTION, LU, MIXED };
+	enum class SparseFormat { CSR, CSC };
+	enum class MatrixTriangle { LOWER, UPPER };
+	enum class MatrixDiagonal { NON_UNIT, UNIT };
+	enum class MatrixSide { LEFT, RIGHT };
+	enum class MatrixFileType { FLOAT32 = 1, FLOAT64 = 2, INT32 = 3, INT64 = 4, FLOAT16 = 5, BFLOAT16 = 6 };
 
 }
 
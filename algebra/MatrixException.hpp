@@ -0,0 +1,98 @@
+#ifndef MATRIX_EXCEPTION_HPP
+#define MATRIX_EXCEPTION_HPP
+
+#include <iostream>
+#include <exception>
+#include "MatrixEnum.hpp"
+
+// Checks of operator () and row(): on by default in debug builds, off when NDEBUG is defined
+#ifndef LITO_MATRIX_CHECK_BOUNDS
+	#ifdef NDEBUG
+		#define LITO_MATRIX_CHECK_BOUNDS 0
+	#else
+		#define LITO_MATRIX_CHECK_BOUNDS 1
+	#endif
+#endif
+
+namespace lito {
+
+	class MatrixException : public std::exception
+	{
+	public:
+		MatrixException (MatrixExceptionType exceptionType, uint rowFirst = 0, uint columnFirst = 0, uint rowSecond = 0, uint columnSecond = 0, char operation = ' ')
+			: _exceptionType(exceptionType)
+			, _rowFirst(rowFirst)
+			, _columnFirst(columnFirst)
+			, _rowSecond(rowSecond)
+			, _columnSecond(columnSecond)
+			, _operation(operation)
+		{}
+
+		MatrixExceptionType getType () const
+		{
+			return _exceptionType;
+		}
+
+		const char* what () const noexcept override
+		{
+			switch (_exceptionType)
+			{
+			case MatrixExceptionType::INVALID_ACCESS:         return "Invalid access for matrix";
+			case MatrixExceptionType::INVALID_SIZE:           return "Invalid size";
+			case MatrixExceptionType::INCOMPATIBLE_SIZES:     return "Invalid sizes for operation";
+			case MatrixExceptionType::MATRIX_NOT_INITIALIZED: return "Matrix not initialized";
+			case MatrixExceptionType::SINGULAR_MATRIX:        return "There is no inverse for the matrix";
+			case MatrixExceptionType::NOT_POSITIVE_DEFINITE:  return "The matrix is not positive definite";
+			case MatrixExceptionType::FILE_ERROR:             return "Error reading or writing the matrix file";
+			case MatrixExceptionType::INVALID_FILE_FORMAT:    return "The file is not a matrix file of this type";
+			}
+
+			return "Matrix exception";
+		}
+
+		void showExeception () const
+		{
+			switch (_exceptionType)
+			{
+			case MatrixExceptionType::INVALID_ACCESS:
+				std::cerr <<    "Invalid access for matrix( " << _rowFirst  << ", " << _columnFirst
+					      << " ):  possition accessed was ( " << _rowSecond << ", " << _columnSecond << " )!" << std::endl;
+				break;
+			case MatrixExceptionType::INVALID_SIZE:
+				std::cerr << "Invalid size: " << "( " << _rowFirst << ", " << _columnFirst << " )!" << std::endl;
+				break;
+			case MatrixExceptionType::INCOMPATIBLE_SIZES:
+				std::cerr << "Invalid sizes for " << _operation
+					      <<    " operation: M1( " << _rowFirst  << ", " << _columnFirst  << " ) "
+					      << _operation << " M2( " << _rowSecond << ", " << _columnSecond << " )!" << std::endl;
+				break;
+			case MatrixExceptionType::MATRIX_NOT_INITIALIZED:
+				std::cerr << "Matrix not initialized!" << std::endl;
+				break;
+			case MatrixExceptionType::SINGULAR_MATRIX:
+				std::cerr << "There is no inverse for the matrix!" << std::endl;
+				break;
+			case MatrixExceptionType::NOT_POSITIVE_DEFINITE:
+				std::cerr << "The matrix is not positive definite!" << std::endl;
+				break;
+			case MatrixExceptionType::FILE_ERROR:
+				std::cerr << "Error reading or writing the matrix file!" << std::endl;
+				break;
+			case MatrixExceptionType::INVALID_FILE_FORMAT:
+				std::cerr << "The file is not a matrix file of this type!" << std::endl;
+				break;
+			}
+		}
+
+	private:
+		MatrixExceptionType _exceptionType;
+		uint _rowFirst;
+		uint _columnFirst;
+		uint _rowSecond;
+		uint _columnSecond;
+		char _operation;
+	};
+
+}
+
+#endif
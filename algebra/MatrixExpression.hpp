@@ -0,0 +1,468 @@
+#ifndef MATRIX_EXPRESSION_HPP
+#define MATRIX_EXPRESSION_HPP
+
+#include "Matrix.hpp"
+
+namespace lito {
+
+	/*! MatrixExpression
+	* Base of the lazy elementwise expressions over Matrix<T>
+	* The expressions hold references to the matrices used, so they must be
+	* evaluated (assigned to a Matrix) before those matrices are destroyed
+	* Each expression tells by reads(...) if it reads a destination at positions other than the one evaluated,
+	* so the assignments know when to evaluate it apart
+	*/
+	template <typename E>
+	class MatrixExpression {
+	public:
+		const E& self() const { return static_cast<const E&>(*this); }
+
+		uint getRows() const { return self().getRows(); }
+		uint getColumns() const { return self().getColumns(); }
+	};
+
+	template <typename T>
+	class MatrixReference : public MatrixExpression<MatrixReference<T>> {
+	public:
+		typedef T ValueType;
+
+		MatrixReference(const Matrix<T>& mat);
+
+		uint getRows() const { return _rows; }
+		uint getColumns() const { return _columns; }
+		T operator () (const uint& line, const uint& column) const { return _data[column + (size_t(_stride) * line)]; }
+		bool reads(const T* data, uint rows, uint columns, uint rowStride, uint columnStride) const;
+
+	private:
+		uint _rows;
+		uint _columns;
+		uint _stride;
+		const T* _data;
+	};
+
+	template <typename L, typename R, typename Op>
+	class MatrixBinaryExpression : public MatrixExpression<MatrixBinaryExpression<L, R, Op>> {
+	public:
+		typedef typename L::ValueType ValueType;
+
+		MatrixBinaryExpression(const L& left, const R& right);
+
+		uint getRows() const { return _left.getRows(); }
+		uint getColumns() const { return _left.getColumns(); }
+		ValueType operator () (const uint& line, const uint& column) const { return Op::apply(_left(line, column), _right(line, column)); }
+		bool reads(const ValueType* data, uint rows, uint columns, uint rowStride, uint columnStride) const { return _left.reads(data, rows, columns, rowStride, columnStride) || _right.reads(data, rows, columns, rowStride, columnStride); }
+
+	private:
+		L _left;
+		R _right;
+	};
+
+	template <typename E>
+	class MatrixScalarExpression : public MatrixExpression<MatrixScalarExpression<E>> {
+	public:
+		typedef typename E::ValueType ValueType;
+
+		MatrixScalarExpression(const E& expression, const ValueType& mul)
+			: _expression(expression)
+			, _mul(mul)
+		{}
+
+		uint getRows() const { return _expression.getRows(); }
+		uint getColumns() const { return _expression.getColumns(); }
+		ValueType operator () (const uint& line, const uint& column) const { return _expression(line, column) * _mul; }
+		bool reads(const ValueType* data, uint rows, uint columns, uint rowStride, uint columnStride) const { return _expression.reads(data, rows, columns, rowStride, columnStride); }
+
+	private:
+		E _expression;
+		ValueType _mul;
+	};
+
+	template <typename E>
+	class MatrixNegateExpression : public MatrixExpression<MatrixNegateExpression<E>> {
+	public:
+		typedef typename E::ValueType ValueType;
+
+		MatrixNegateExpression(const E& expression)
+			: _expression(expression)
+		{}
+
+		uint getRows() const { return _expression.getRows(); }
+		uint getColumns() const { return _expression.getColumns(); }
+		ValueType operator () (const uint& line, const uint& column) const { return -_expression(line, column); }
+		bool reads(const ValueType* data, uint rows, uint columns, uint rowStride, uint columnStride) const { return _expression.reads(data, rows, columns, rowStride, columnStride); }
+
+	private:
+		E _expression;
+	};
+
+	struct ExpressionSum { static const char symbol = '+'; template <typename T> static T apply(const T& a, const T& b) { return a + b; } };
+	struct ExpressionSub { static const char symbol = '-'; template <typename T> static T apply(const T& a, const T& b) { return a - b; } };
+	struct ExpressionMul { static const char symbol = '*'; template <typename T> static T apply(const T& a, const T& b) { return a * b; } };
+
+	template <typename T> MatrixReference<T> lazy(const Matrix<T>& mat);
+	template <typename T> bool expressionReads(const T* source, uint sourceRows, uint sourceColumns, uint sourceRowStride, uint sourceColumnStride, const T* data, uint rows, uint columns, uint rowStride, uint columnStride);
+
+	template <typename L, typename R> MatrixBinaryExpression<L, R, ExpressionSum> operator + (const MatrixExpression<L>& sum1, const MatrixExpression<R>& sum2);
+	template <typename L, typename R> MatrixBinaryExpression<L, R, ExpressionSub> operator - (const MatrixExpression<L>& sub1, const MatrixExpression<R>& sub2);
+	template <typename L, typename R> MatrixBinaryExpression<L, R, ExpressionMul> mul (const MatrixExpression<L>& mul1, const MatrixExpression<R>& mul2);
+
+	template <typename L, typename T> MatrixBinaryExpression<L, MatrixReference<T>, ExpressionSum> operator + (const MatrixExpression<L>& sum1, const Matrix<T>& sum2);
+	template <typename L, typename T> MatrixBinaryExpression<L, MatrixReference<T>, ExpressionSub> operator - (const MatrixExpression<L>& sub1, const Matrix<T>& sub2);
+	template <typename L, typename T> MatrixBinaryExpression<L, MatrixReference<T>, ExpressionMul> mul (const MatrixExpression<L>& mul1, const Matrix<T>& mul2);
+	template <typename T, typename R> MatrixBinaryExpression<MatrixReference<T>, R, ExpressionSum> operator + (const Matrix<T>& sum1, const MatrixExpression<R>& sum2);
+	template <typename T, typename R> MatrixBinaryExpression<MatrixReference<T>, R, ExpressionSub> operator - (const Matrix<T>& sub1, const MatrixExpression<R>& sub2);
+	template <typename T, typename R> MatrixBinaryExpression<MatrixReference<T>, R, ExpressionMul> mul (const Matrix<T>& mul1, const MatrixExpression<R>& mul2);
+
+	template <typename E> MatrixScalarExpression<E> operator * (const MatrixExpression<E>& expression, const typename E::ValueType& mul);
+	template <typename E> MatrixScalarExpression<E> operator * (const typename E::ValueType& mul, const MatrixExpression<E>& expression);
+	template <typename E> MatrixNegateExpression<E> operator - (const MatrixExpression<E>& expression);
+
+
+
+	/*! MatrixReference
+	* Leaf of the expressions, refers to the data of a matrix
+	* Matrix<T> mat: The matrix referred
+	*/
+	template <typename T>
+	MatrixReference<T>::MatrixReference(const Matrix<T>& mat)
+		: _rows(mat._rows)
+		, _columns(mat._columns)
+		, _stride(mat._stride)
+		, _data(mat._data)
+	{
+		if (_data == nullptr)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+	}
+
+	/*! reads
+	* Tell if the matrix referred is read at positions of a destination other than the one evaluated
+	* T* data: Value (0, 0) of the destination
+	* uint rows: Quantities of rows of the destination
+	* uint columns: Quantities of columns of the destination
+	* uint rowStride: Distance between two rows of the destination
+	* uint columnStride: Distance between two columns of the destination
+	* return: If the destination must not be written while the expression is evaluated
+	*/
+	template <typename T>
+	bool MatrixReference<T>::reads(const T* data, uint rows, uint columns, uint rowStride, uint columnStride) const
+	{
+		return expressionReads(_data, _rows, _columns, _stride, 1u, data, rows, columns, rowStride, columnStride);
+	}
+
+	/*! MatrixBinaryExpression
+	* Node of the expressions that combines two expressions value to value
+	* The sizes are checked here, when the expression is built
+	* L left: The left expression
+	* R right: The right expression
+	*/
+	template <typename L, typename R, typename Op>
+	MatrixBinaryExpression<L, R, Op>::MatrixBinaryExpression(const L& left, const R& right)
+		: _left(left)
+		, _right(right)
+	{
+		if (_left.getRows() != _right.getRows() || _left.getColumns() != _right.getColumns())
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, _left.getRows(), _left.getColumns(), _right.getRows(), _right.getColumns(), Op::symbol));
+	}
+
+	/*! Matrix
+	* Initialize the matrix evaluating an expression in a single pass
+	* MatrixExpression<E> expression: The expression to be evaluated
+	*/
+	template <typename T>
+	template <typename E>
+	Matrix<T>::Matrix(const MatrixExpression<E>& expression)
+		: Matrix()
+	{
+		resize(expression.getRows(), expression.getColumns());
+
+		const E& exp = expression.self();
+
+		for (uint i = 0; i < _rows; i++)
+		{
+			T* line = _data + (size_t(_stride) * i);
+
+			for (uint j = 0; j < _columns; j++)
+				line[j] = exp(i, j);
+		}
+	}
+
+	/*! operator =
+	* Evaluate an expression into the matrix in a single pass
+	* An expression that reads this matrix at other positions (a transpose or a block of it),
+	* or that changes its sizes, is evaluated into a new storage that is then moved in
+	* MatrixExpression<E> expression: The expression to be evaluated
+	* return: The matrix modified
+	*/
+	template <typename T>
+	template <typename E>
+	Matrix<T>& Matrix<T>::operator = (const MatrixExpression<E>& expression)
+	{
+		const E& exp = expression.self();
+
+		if (_data != nullptr && exp.reads(_data, _rows, _columns, _stride, 1))
+		{
+			Matrix<T> newMatrix(_allocator);
+
+			newMatrix = expression;
+
+			return *this = std::move(newMatrix);
+		}
+
+		if (_rows != expression.getRows() || _columns != expression.getColumns())
+			resize(expression.getRows(), expression.getColumns());
+
+		for (uint i = 0; i < _rows; i++)
+		{
+			T* line = _data + (size_t(_stride) * i);
+
+			for (uint j = 0; j < _columns; j++)
+				line[j] = exp(i, j);
+		}
+
+		return *this;
+	}
+
+	/*! operator +=
+	* Sum an expression into the matrix in a single pass
+	* An expression that reads this matrix at other positions is evaluated apart first
+	* MatrixExpression<E> expression: The expression to be added
+	* return: The matrix modified
+	*/
+	template <typename T>
+	template <typename E>
+	Matrix<T>& Matrix<T>::operator += (const MatrixExpression<E>& expression)
+	{
+		if (_rows != expression.getRows() || _columns != expression.getColumns())
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, _rows, _columns, expression.getRows(), expression.getColumns(), '+'));
+		else if (_data == nullptr)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+
+		const E& exp = expression.self();
+
+		if (exp.reads(_data, _rows, _columns, _stride, 1))
+			return *this += Matrix<T>(expression);
+
+		for (uint i = 0; i < _rows; i++)
+		{
+			T* line = _data + (size_t(_stride) * i);
+
+			for (uint j = 0; j < _columns; j++)
+				line[j] += exp(i, j);
+		}
+
+		return *this;
+	}
+
+	/*! operator -=
+	* Subtract an expression from the matrix in a single pass
+	* An expression that reads this matrix at other positions is evaluated apart first
+	* MatrixExpression<E> expression: The expression to be subtracted
+	* return: The matrix modified
+	*/
+	template <typename T>
+	template <typename E>
+	Matrix<T>& Matrix<T>::operator -= (const MatrixExpression<E>& expression)
+	{
+		if (_rows != expression.getRows() || _columns != expression.getColumns())
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, _rows, _columns, expression.getRows(), expression.getColumns(), '-'));
+		else if (_data == nullptr)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+
+		const E& exp = expression.self();
+
+		if (exp.reads(_data, _rows, _columns, _stride, 1))
+			return *this -= Matrix<T>(expression);
+
+		for (uint i = 0; i < _rows; i++)
+		{
+			T* line = _data + (size_t(_stride) * i);
+
+			for (uint j = 0; j < _columns; j++)
+				line[j] -= exp(i, j);
+		}
+
+		return *this;
+	}
+
+	/*! lazy
+	* Start a lazy expression with the matrix
+	* Matrix<T> mat: The matrix referred
+	* return: The expression referring to mat
+	*/
+	template <typename T>
+	MatrixReference<T> lazy(const Matrix<T>& mat)
+	{
+		return MatrixReference<T>(mat);
+	}
+
+	/*! expressionReads
+	* Tell if a leaf of an expression reads positions of a destination other than the one evaluated
+	* A leaf with the layout of the destination reads each position just before it is written, so it is safe;
+	* any other leaf is unsafe when the address ranges from its first to its last value overlap
+	* T* source: Value (0, 0) of the leaf
+	* uint sourceRows, sourceColumns, sourceRowStride, sourceColumnStride: Sizes and strides of the leaf
+	* T* data: Value (0, 0) of the destination
+	* uint rows, columns, rowStride, columnStride: Sizes and strides of the destination
+	* return: If the destination must not be written while the leaf is read
+	*/
+	template <typename T>
+	bool expressionReads(const T* source, uint sourceRows, uint sourceColumns, uint sourceRowStride, uint sourceColumnStride, const T* data, uint rows, uint columns, uint rowStride, uint columnStride)
+	{
+		if (sourceRows == 0 || sourceColumns == 0 || rows == 0 || columns == 0)
+			return false;
+
+		if (source == data && sourceRows == rows && sourceColumns == columns && (sourceRowStride == rowStride || rows == 1) && (sourceColumnStride == columnStride || columns == 1))
+			return false;
+
+		const T* sourceEnd = source + (size_t(sourceRows - 1) * sourceRowStride) + (size_t(sourceColumns - 1) * sourceColumnStride);
+		const T* end = data + (size_t(rows - 1) * rowStride) + (size_t(columns - 1) * columnStride);
+
+		return !(sourceEnd < data || end < source);
+	}
+
+	/*! operator +
+	* Build the lazy sum of the expressions
+	* MatrixExpression<L> sum1: Expression to be added
+	* MatrixExpression<R> sum2: Expression to be added
+	* return: The expression of the sum
+	*/
+	template <typename L, typename R>
+	MatrixBinaryExpression<L, R, ExpressionSum> operator + (const MatrixExpression<L>& sum1, const MatrixExpression<R>& sum2)
+	{
+		return MatrixBinaryExpression<L, R, ExpressionSum>(sum1.self(), sum2.self());
+	}
+
+	/*! operator -
+	* Build the lazy subtraction of the expressions
+	* MatrixExpression<L> sub1: Expression to be subtracted
+	* MatrixExpression<R> sub2: Expression to subtract
+	* return: The expression of the subtraction
+	*/
+	template <typename L, typename R>
+	MatrixBinaryExpression<L, R, ExpressionSub> operator - (const MatrixExpression<L>& sub1, const MatrixExpression<R>& sub2)
+	{
+		return MatrixBinaryExpression<L, R, ExpressionSub>(sub1.self(), sub2.self());
+	}
+
+	/*! mul
+	* Build the lazy multiplication value to value of the expressions
+	* MatrixExpression<L> mul1: Expression to be multiplied
+	* MatrixExpression<R> mul2: Expression to be multiplied
+	* return: The expression of the multiplication
+	*/
+	template <typename L, typename R>
+	MatrixBinaryExpression<L, R, ExpressionMul> mul (const MatrixExpression<L>& mul1, const MatrixExpression<R>& mul2)
+	{
+		return MatrixBinaryExpression<L, R, ExpressionMul>(mul1.self(), mul2.self());
+	}
+
+	/*! operator +
+	* Build the lazy sum of the expression with a matrix
+	* MatrixExpression<L> sum1: Expression to be added
+	* Matrix<T> sum2: Matrix to be added
+	* return: The expression of the sum
+	*/
+	template <typename L, typename T>
+	MatrixBinaryExpression<L, MatrixReference<T>, ExpressionSum> operator + (const MatrixExpression<L>& sum1, const Matrix<T>& sum2)
+	{
+		return MatrixBinaryExpression<L, MatrixReference<T>, ExpressionSum>(sum1.self(), lazy(sum2));
+	}
+
+	/*! operator -
+	* Build the lazy subtraction of the expression with a matrix
+	* MatrixExpression<L> sub1: Expression to be subtracted
+	* Matrix<T> sub2: Matrix to subtract
+	* return: The expression of the subtraction
+	*/
+	template <typename L, typename T>
+	MatrixBinaryExpression<L, MatrixReference<T>, ExpressionSub> operator - (const MatrixExpression<L>& sub1, const Matrix<T>& sub2)
+	{
+		return MatrixBinaryExpression<L, MatrixReference<T>, ExpressionSub>(sub1.self(), lazy(sub2));
+	}
+
+	/*! mul
+	* Build the lazy multiplication value to value of the expression with a matrix
+	* MatrixExpression<L> mul1: Expression to be multiplied
+	* Matrix<T> mul2: Matrix to be multiplied
+	* return: The expression of the multiplication
+	*/
+	template <typename L, typename T>
+	MatrixBinaryExpression<L, MatrixReference<T>, ExpressionMul> mul (const MatrixExpression<L>& mul1, const Matrix<T>& mul2)
+	{
+		return MatrixBinaryExpression<L, MatrixReference<T>, ExpressionMul>(mul1.self(), lazy(mul2));
+	}
+
+	/*! operator +
+	* Build the lazy sum of a matrix with the expression
+	* Matrix<T> sum1: Matrix to be added
+	* MatrixExpression<R> sum2: Expression to be added
+	* return: The expression of the sum
+	*/
+	template <typename T, typename R>
+	MatrixBinaryExpression<MatrixReference<T>, R, ExpressionSum> operator + (const Matrix<T>& sum1, const MatrixExpression<R>& sum2)
+	{
+		return MatrixBinaryExpression<MatrixReference<T>, R, ExpressionSum>(lazy(sum1), sum2.self());
+	}
+
+	/*! operator -
+	* Build the lazy subtraction of a matrix with the expression
+	* Matrix<T> sub1: Matrix to be subtracted
+	* MatrixExpression<R> sub2: Expression to subtract
+	* return: The expression of the subtraction
+	*/
+	template <typename T, typename R>
+	MatrixBinaryExpression<MatrixReference<T>, R, ExpressionSub> operator - (const Matrix<T>& sub1, const MatrixExpression<R>& sub2)
+	{
+		return MatrixBinaryExpression<MatrixReference<T>, R, ExpressionSub>(lazy(sub1), sub2.self());
+	}
+
+	/*! mul
+	* Build the lazy multiplication value to value of a matrix with the expression
+	* Matrix<T> mul1: Matrix to be multiplied
+	* MatrixExpression<R> mul2: Expression to be multiplied
+	* return: The expression of the multiplication
+	*/
+	template <typename T, typename R>
+	MatrixBinaryExpression<MatrixReference<T>, R, ExpressionMul> mul (const Matrix<T>& mul1, const MatrixExpression<R>& mul2)
+	{
+		return MatrixBinaryExpression<MatrixReference<T>, R, ExpressionMul>(lazy(mul1), mul2.self());
+	}
+
+	/*! operator *
+	* Build the lazy multiplication of the expression with mul value
+	* MatrixExpression<E> expression: Expression to be multiplied
+	* T mul: Value to be multiplied
+	* return: The expression of the multiplication
+	*/
+	template <typename E>
+	MatrixScalarExpression<E> operator * (const MatrixExpression<E>& expression, const typename E::ValueType& mul)
+	{
+		return MatrixScalarExpression<E>(expression.self(), mul);
+	}
+
+	/*! operator *
+	* Build the lazy multiplication of the mul value with the expression
+	* T mul: Value to be multiplied
+	* MatrixExpression<E> expression: Expression to be multiplied
+	* return: The expression of the multiplication
+	*/
+	template <typename E>
+	MatrixScalarExpression<E> operator * (const typename E::ValueType& mul, const MatrixExpression<E>& expression)
+	{
+		return MatrixScalarExpression<E>(expression.self(), mul);
+	}
+
+	/*! operator -
+	* Build the lazy expression multiplied to -1
+	* MatrixExpression<E> expression: Expression to be multiplied
+	* return: The expression multiplied to -1
+	*/
+	template <typename E>
+	MatrixNegateExpression<E> operator - (const MatrixExpression<E>& expression)
+	{
+		return MatrixNegateExpression<E>(expression.self());
+	}
+
+}
+
+#endif
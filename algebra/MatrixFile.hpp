@@ -0,0 +1,675 @@
+#ifndef MATRIX_FILE_HPP
+#define MATRIX_FILE_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <utility>
+
+#ifdef _WIN32
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+	#include <sys/stat.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+#include "Matrix.hpp"
+#include "MatrixView.hpp"
+#include "HalfFloat.hpp"
+
+namespace lito {
+
+	/*! MatrixFileHeader
+	* Header of the binary matrix files, the first 64 bytes of the file
+	* The payload starts at payloadOffset, a multiple of 64, with the rows stored stride values apart
+	* The fields and the values are stored in the byte order of the writer: endianness holds 0x01020304,
+	* so a reader with the other byte order sees 0x04030201
+	*/
+	struct MatrixFileHeader {
+		char magic[8];
+		uint32_t version;
+		uint32_t type;
+		uint32_t endianness;
+		uint32_t valueSize;
+		uint64_t rows;
+		uint64_t columns;
+		uint64_t stride;
+		uint64_t payloadOffset;
+		uint64_t reserved;
+	};
+
+	static_assert(sizeof(MatrixFileHeader) == 64, "The header of the matrix files must take 64 bytes");
+
+	const char MATRIX_FILE_MAGIC[8] = { 'L', 'I', 'T', 'O', 'M', 'A', 'T', '\0' };
+	const uint32_t MATRIX_FILE_VERSION = 1;
+	const uint32_t MATRIX_FILE_ENDIANNESS = 0x01020304;
+	const uint64_t MATRIX_FILE_ALIGNMENT = 64;
+
+	/*! MatrixFileTraits
+	* Type stored in the header for each value type, only these types can be stored
+	*/
+	template <typename T> struct MatrixFileTraits;
+	template <> struct MatrixFileTraits<float> { static const MatrixFileType type = MatrixFileType::FLOAT32; };
+	template <> struct MatrixFileTraits<double> { static const MatrixFileType type = MatrixFileType::FLOAT64; };
+	template <> struct MatrixFileTraits<int32_t> { static const MatrixFileType type = MatrixFileType::INT32; };
+	template <> struct MatrixFileTraits<int64_t> { static const MatrixFileType type = MatrixFileType::INT64; };
+	template <> struct MatrixFileTraits<half> { static const MatrixFileType type = MatrixFileType::FLOAT16; };
+	template <> struct MatrixFileTraits<bfloat16> { static const MatrixFileType type = MatrixFileType::BFLOAT16; };
+
+	/*! MatrixFileWriter
+	* Writes a matrix file line by line, so matrices bigger than the memory can be stored by parts
+	* The header is written when the file is opened and close() checks that all the rows were written
+	*/
+	template <typename T>
+	class MatrixFileWriter {
+	public:
+		MatrixFileWriter(const std::string& path, uint rows, uint columns, bool rowPadding = false);
+		MatrixFileWriter(const MatrixFileWriter<T>&) = delete;
+		MatrixFileWriter<T>& operator = (const MatrixFileWriter<T>&) = delete;
+		~MatrixFileWriter();
+
+		void write(const ConstMatrixView<T>& lines);
+		void close();
+
+		const uint& getRows() const;
+		const uint& getColumns() const;
+		const uint& getWrittenRows() const;
+
+	private:
+		std::FILE* _file;
+		uint _rows;
+		uint _columns;
+		uint _stride;
+		uint _writtenRows;
+		std::vector<T> _line;
+	};
+
+	/*! MappedMatrix
+	* Matrix file mapped in memory, read only
+	* The values are read straight from the page cache when they are used, nothing is copied on load,
+	* and view() gives them to every function that takes a ConstMatrixView
+	* The file must have the type T and the byte order of the machine, see loadMatrix for the others
+	*/
+	template <typename T>
+	class MappedMatrix {
+	public:
+		MappedMatrix();
+		explicit MappedMatrix(const std::string& path);
+		MappedMatrix(const MappedMatrix<T>&) = delete;
+		MappedMatrix(MappedMatrix<T>&& moveMatrix) noexcept;
+		MappedMatrix<T>& operator = (const MappedMatrix<T>&) = delete;
+		MappedMatrix<T>& operator = (MappedMatrix<T>&& moveMatrix) noexcept;
+		~MappedMatrix();
+
+		ConstMatrixView<T> view() const;
+
+		const uint& getRows() const;
+		const uint& getColumns() const;
+		const uint& getStride() const;
+		const T* data() const;
+
+	private:
+		void unmap();
+
+		uint _rows;
+		uint _columns;
+		uint _stride;
+		const T* _data;
+		void* _mapping;
+		size_t _size;
+	};
+
+	template <typename T> void saveMatrix(const std::string& path, const ConstMatrixView<T>& mat, bool rowPadding = false);
+	template <typename T> Matrix<T> loadMatrix(const std::string& path);
+	template <typename T> bool checkMatrixFileHeader(MatrixFileHeader& header, uint64_t fileSize);
+	template <typename U> U swapBytes(U value);
+
+
+
+	/*! MatrixFileWriter
+	* Create the file and write its header
+	* std::string path: Path of the file, replaced if it exists
+	* uint rows: Quantities of rows that will be written
+	* uint columns: Quantities of columns
+	* bool rowPadding: Store each row in a multiple of 64 bytes, so the rows of the mapped file start aligned
+	*/
+	template <typename T>
+	MatrixFileWriter<T>::MatrixFileWriter(const std::string& path, uint rows, uint columns, bool rowPadding)
+		: _file(std::fopen(path.c_str(), "wb"))
+		, _rows(rows)
+		, _columns(columns)
+		, _stride(columns)
+		, _writtenRows(0)
+	{
+		if (_file == nullptr)
+			throw(MatrixException(MatrixExceptionType::FILE_ERROR));
+
+		if (rowPadding && columns > 0 && MATRIX_FILE_ALIGNMENT % sizeof(T) == 0)
+			_stride = uint(((size_t(columns) * sizeof(T) + MATRIX_FILE_ALIGNMENT - 1) / MATRIX_FILE_ALIGNMENT) * (MATRIX_FILE_ALIGNMENT / sizeof(T)));
+
+		_line.assign(_stride, T(0));
+
+		MatrixFileHeader header;
+
+		std::memset(&header, 0, sizeof(header));
+		std::memcpy(header.magic, MATRIX_FILE_MAGIC, sizeof(header.magic));
+		header.version = MATRIX_FILE_VERSION;
+		header.type = uint32_t(MatrixFileTraits<T>::type);
+		header.endianness = MATRIX_FILE_ENDIANNESS;
+		header.valueSize = uint32_t(sizeof(T));
+		// Rows without values are stored as no rows, the readers refuse rows of stride zero
+		header.rows = (_stride > 0) ? rows : 0;
+		header.columns = columns;
+		header.stride = _stride;
+		header.payloadOffset = MATRIX_FILE_ALIGNMENT;
+
+		std::setvbuf(_file, nullptr, _IOFBF, size_t(1) << 20);
+
+		if (std::fwrite(&header, sizeof(header), 1, _file) != 1)
+		{
+			std::fclose(_file);
+			_file = nullptr;
+			throw(MatrixException(MatrixExceptionType::FILE_ERROR));
+		}
+	}
+
+	/*! ~MatrixFileWriter
+	* Close the file if close() was not called; errors are not reported here
+	*/
+	template <typename T>
+	MatrixFileWriter<T>::~MatrixFileWriter()
+	{
+		if (_file != nullptr)
+			std::fclose(_file);
+	}
+
+	/*! write
+	* Append lines to the file
+	* ConstMatrixView<T> lines: The next lines of the matrix, with its columns
+	*/
+	template <typename T>
+	void MatrixFileWriter<T>::write(const ConstMatrixView<T>& lines)
+	{
+		if (_file == nullptr)
+			throw(MatrixException(MatrixExceptionType::FILE_ERROR));
+		else if (lines.getColumns() != _columns || size_t(_writtenRows) + lines.getRows() > _rows)
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, _rows - _writtenRows, _columns, lines.getRows(), lines.getColumns(), '='));
+
+		if (lines.getRows() == 0 || _stride == 0)
+		{
+			_writtenRows += lines.getRows();
+			return;
+		}
+
+		bool written = true;
+
+		if (_stride == _columns && lines.getColumnStride() == 1 && lines.getRowStride() == _stride)
+		{
+			written = std::fwrite(lines.data(), sizeof(T) * _stride, lines.getRows(), _file) == lines.getRows();
+		}
+		else
+		{
+			for (uint i = 0; written && i < lines.getRows(); i++)
+			{
+				for (uint j = 0; j < _columns; j++)
+					_line[j] = lines(i, j);
+
+				written = std::fwrite(_line.data(), sizeof(T) * _stride, 1, _file) == 1;
+			}
+		}
+
+		if (!written)
+			throw(MatrixException(MatrixExceptionType::FILE_ERROR));
+
+		_writtenRows += lines.getRows();
+	}
+
+	/*! close
+	* Flush and close the file
+	* Throws INCOMPATIBLE_SIZES when not all the rows were written, the file is left incomplete
+	*/
+	template <typename T>
+	void MatrixFileWriter<T>::close()
+	{
+		if (_file == nullptr)
+			return;
+
+		bool closed = std::fclose(_file) == 0;
+
+		_file = nullptr;
+
+		if (!closed)
+			throw(MatrixException(MatrixExceptionType::FILE_ERROR));
+		else if (_writtenRows != _rows)
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, _rows, _columns, _writtenRows, _columns, '='));
+	}
+
+	/*! getRows
+	* Get the quantities of rows of the file
+	* return: The quantities of rows
+	*/
+	template <typename T>
+	const uint& MatrixFileWriter<T>::getRows() const
+	{
+		return _rows;
+	}
+
+	/*! getColumns
+	* Get the quantities of columns of the file
+	* return: The quantities of columns
+	*/
+	template <typename T>
+	const uint& MatrixFileWriter<T>::getColumns() const
+	{
+		return _columns;
+	}
+
+	/*! getWrittenRows
+	* Get the quantities of rows already written
+	* return: The quantities of rows
+	*/
+	template <typename T>
+	const uint& MatrixFileWriter<T>::getWrittenRows() const
+	{
+		return _writtenRows;
+	}
+
+	/*! MappedMatrix
+	* Initialize an empty matrix, with no file
+	*/
+	template <typename T>
+	MappedMatrix<T>::MappedMatrix()
+		: _rows(0)
+		, _columns(0)
+		, _stride(0)
+		, _data(nullptr)
+		, _mapping(nullptr)
+		, _size(0)
+	{}
+
+	/*! MappedMatrix
+	* Map a matrix file in memory
+	* std::string path: Path of the file
+	*/
+	template <typename T>
+	MappedMatrix<T>::MappedMatrix(const std::string& path)
+		: MappedMatrix()
+	{
+#ifdef _WIN32
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		LARGE_INTEGER fileSize;
+
+		if (file == INVALID_HANDLE_VALUE)
+			throw(MatrixException(MatrixExceptionType::FILE_ERROR));
+
+		if (!GetFileSizeEx(file, &fileSize) || uint64_t(fileSize.QuadPart) < sizeof(MatrixFileHeader))
+		{
+			CloseHandle(file);
+			throw(MatrixException(MatrixExceptionType::INVALID_FILE_FORMAT));
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+		CloseHandle(file);
+
+		if (mapping == nullptr)
+			throw(MatrixException(MatrixExceptionType::FILE_ERROR));
+
+		_mapping = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		_size = size_t(fileSize.QuadPart);
+
+		CloseHandle(mapping);
+
+		if (_mapping == nullptr)
+			throw(MatrixException(MatrixExceptionType::FILE_ERROR));
+#else
+		int file = open(path.c_str(), O_RDONLY);
+		struct stat status;
+
+		if (file < 0)
+			throw(MatrixException(MatrixExceptionType::FILE_ERROR));
+
+		if (fstat(file, &status) != 0 || uint64_t(status.st_size) < sizeof(MatrixFileHeader))
+		{
+			::close(file);
+			throw(MatrixException(MatrixExceptionType::INVALID_FILE_FORMAT));
+		}
+
+		void* mapping = mmap(nullptr, size_t(status.st_size), PROT_READ, MAP_SHARED, file, 0);
+
+		::close(file);
+
+		if (mapping == MAP_FAILED)
+			throw(MatrixException(MatrixExceptionType::FILE_ERROR));
+
+		_mapping = mapping;
+		_size = size_t(status.st_size);
+#endif
+
+		MatrixFileHeader header;
+
+		std::memcpy(&header, _mapping, sizeof(header));
+
+		if (!checkMatrixFileHeader<T>(header, _size) || header.endianness != MATRIX_FILE_ENDIANNESS)
+		{
+			unmap();
+			throw(MatrixException(MatrixExceptionType::INVALID_FILE_FORMAT));
+		}
+
+		_rows = uint(header.rows);
+		_columns = uint(header.columns);
+		_stride = uint(header.stride);
+		_data = reinterpret_cast<const T*>(static_cast<const char*>(_mapping) + header.payloadOffset);
+	}
+
+	/*! MappedMatrix
+	* Initialize the matrix taking the mapping of another one
+	* MappedMatrix<T> moveMatrix: The matrix to be moved, left empty
+	*/
+	template <typename T>
+	MappedMatrix<T>::MappedMatrix(MappedMatrix<T>&& moveMatrix) noexcept
+		: _rows(moveMatrix._rows)
+		, _columns(moveMatrix._columns)
+		, _stride(moveMatrix._stride)
+		, _data(moveMatrix._data)
+		, _mapping(moveMatrix._mapping)
+		, _size(moveMatrix._size)
+	{
+		moveMatrix._mapping = nullptr;
+		moveMatrix.unmap();
+	}
+
+	/*! operator =
+	* Take the mapping of another matrix, releasing the current one
+	* MappedMatrix<T> moveMatrix: The matrix to be moved, left empty
+	* return: The matrix modified
+	*/
+	template <typename T>
+	MappedMatrix<T>& MappedMatrix<T>::operator = (MappedMatrix<T>&& moveMatrix) noexcept
+	{
+		if (this != &moveMatrix)
+		{
+			unmap();
+			std::swap(_rows, moveMatrix._rows);
+			std::swap(_columns, moveMatrix._columns);
+			std::swap(_stride, moveMatrix._stride);
+			std::swap(_data, moveMatrix._data);
+			std::swap(_mapping, moveMatrix._mapping);
+			std::swap(_size, moveMatrix._size);
+		}
+
+		return *this;
+	}
+
+	/*! ~MappedMatrix
+	* Release the mapping, the views of the matrix become invalid
+	*/
+	template <typename T>
+	MappedMatrix<T>::~MappedMatrix()
+	{
+		unmap();
+	}
+
+	/*! view
+	* View the values of the file
+	* return: The view, valid while the matrix lives
+	*/
+	template <typename T>
+	ConstMatrixView<T> MappedMatrix<T>::view() const
+	{
+		return ConstMatrixView<T>(_rows, _columns, _data, _stride);
+	}
+
+	/*! getRows
+	* Get the quantities of rows
+	* return: The quantities of rows
+	*/
+	template <typename T>
+	const uint& MappedMatrix<T>::getRows() const
+	{
+		return _rows;
+	}
+
+	/*! getColumns
+	* Get the quantities of columns
+	* return: The quantities of columns
+	*/
+	template <typename T>
+	const uint& MappedMatrix<T>::getColumns() const
+	{
+		return _columns;
+	}
+
+	/*! getStride
+	* Get the distance between two rows
+	* return: The distance, in values
+	*/
+	template <typename T>
+	const uint& MappedMatrix<T>::getStride() const
+	{
+		return _stride;
+	}
+
+	/*! data
+	* Get the value (0, 0)
+	* return: Pointer to the value
+	*/
+	template <typename T>
+	const T* MappedMatrix<T>::data() const
+	{
+		return _data;
+	}
+
+	/*! unmap
+	* Release the mapping and leave the matrix empty
+	*/
+	template <typename T>
+	void MappedMatrix<T>::unmap()
+	{
+		if (_mapping != nullptr)
+		{
+#ifdef _WIN32
+			UnmapViewOfFile(_mapping);
+#else
+			munmap(_mapping, _size);
+#endif
+		}
+
+		_rows = 0;
+		_columns = 0;
+		_stride = 0;
+		_data = nullptr;
+		_mapping = nullptr;
+		_size = 0;
+	}
+
+	/*! saveMatrix
+	* Write a matrix, a view or a part of another matrix to a file
+	* std::string path: Path of the file, replaced if it exists
+	* ConstMatrixView<T> mat: The values
+	* bool rowPadding: Store each row in a multiple of 64 bytes
+	*/
+	template <typename T>
+	void saveMatrix(const std::string& path, const ConstMatrixView<T>& mat, bool rowPadding)
+	{
+		MatrixFileWriter<T> writer(path, mat.getRows(), mat.getColumns(), rowPadding);
+
+		writer.write(mat);
+		writer.close();
+	}
+
+	/*! loadMatrix
+	* Read a matrix file to a new matrix, in any byte order
+	* A regular file is checked against its length and read into the matrix allocated from the header;
+	* a stream of unknown length (a pipe) is read row by row into a buffer that grows with the values read,
+	* so a header bigger than the stream fails at its end and never allocates what it promises
+	* std::string path: Path of the file
+	* return: The matrix
+	*/
+	template <typename T>
+	Matrix<T> loadMatrix(const std::string& path)
+	{
+		std::FILE* file = std::fopen(path.c_str(), "rb");
+		MatrixFileHeader header;
+		uint64_t fileSize = 0;
+
+		if (file == nullptr)
+			throw(MatrixException(MatrixExceptionType::FILE_ERROR));
+
+		// The header is checked against the real length, so a truncated file is refused before the matrix is allocated
+#ifdef _WIN32
+		struct _stat64 status;
+
+		if (_fstat64(_fileno(file), &status) != 0)
+#else
+		struct stat status;
+
+		if (fstat(fileno(file), &status) != 0)
+#endif
+		{
+			std::fclose(file);
+			throw(MatrixException(MatrixExceptionType::FILE_ERROR));
+		}
+
+#ifdef _WIN32
+		fileSize = ((status.st_mode & _S_IFMT) == _S_IFREG) ? uint64_t(status.st_size) : uint64_t(-1);
+#else
+		fileSize = S_ISREG(status.st_mode) ? uint64_t(status.st_size) : uint64_t(-1);
+#endif
+
+		std::setvbuf(file, nullptr, _IOFBF, size_t(1) << 20);
+
+		if (std::fread(&header, sizeof(header), 1, file) != 1 || !checkMatrixFileHeader<T>(header, fileSize))
+		{
+			std::fclose(file);
+			throw(MatrixException(MatrixExceptionType::INVALID_FILE_FORMAT));
+		}
+
+		Matrix<T> newMatrix;
+		const bool swapped = header.endianness != MATRIX_FILE_ENDIANNESS;
+		const bool streamed = fileSize == uint64_t(-1);
+		const uint rows = uint(header.rows);
+		const uint columns = uint(header.columns);
+		std::vector<T> line(size_t(std::min(header.stride, uint64_t(1) << 16)));
+		std::vector<T> values;
+		bool read = true;
+
+		if (!streamed)
+			newMatrix.resize(rows, columns);
+
+		for (uint64_t skip = sizeof(header); read && skip < header.payloadOffset; skip++)
+			read = std::fgetc(file) != EOF;
+
+		// The rows are read by parts of at most 65536 values, so a long row of a stream is not allocated at once
+		for (uint i = 0; read && i < rows; i++)
+		{
+			for (uint64_t j = 0; read && j < header.stride; j += line.size())
+			{
+				size_t count = size_t(std::min(uint64_t(line.size()), header.stride - j));
+				size_t used = (j < columns) ? size_t(std::min(uint64_t(count), columns - j)) : 0;
+
+				read = std::fread(line.data(), sizeof(T), count, file) == count;
+
+				for (size_t k = 0; read && k < used; k++)
+				{
+					T value = swapped ? swapBytes(line[k]) : line[k];
+
+					if (streamed)
+						values.push_back(value);
+					else
+						newMatrix.row(i)[j + k] = value;
+				}
+			}
+		}
+
+		std::fclose(file);
+
+		if (!read)
+			throw(MatrixException(MatrixExceptionType::INVALID_FILE_FORMAT));
+
+		if (streamed)
+		{
+			newMatrix.resize(rows, columns);
+
+			for (uint i = 0; i < newMatrix.getRows() && columns > 0; i++)
+				std::copy(values.data() + (size_t(columns) * i), values.data() + (size_t(columns) * (i + 1)), newMatrix.row(i));
+		}
+
+		return newMatrix;
+	}
+
+	/*! checkMatrixFileHeader
+	* Check that a header describes a matrix of values T that fits in the file, bringing it to the byte order of the machine
+	* The endianness field is kept as read, so the caller knows if the values must be swapped
+	* MatrixFileHeader header: The header read, modified
+	* uint64_t fileSize: Bytes of the file, -1 when unknown
+	* return: If the header is valid
+	*/
+	template <typename T>
+	bool checkMatrixFileHeader(MatrixFileHeader& header, uint64_t fileSize)
+	{
+		if (std::memcmp(header.magic, MATRIX_FILE_MAGIC, sizeof(header.magic)) != 0)
+			return false;
+
+		if (header.endianness == swapBytes(MATRIX_FILE_ENDIANNESS))
+		{
+			header.version = swapBytes(header.version);
+			header.type = swapBytes(header.type);
+			header.valueSize = swapBytes(header.valueSize);
+			header.rows = swapBytes(header.rows);
+			header.columns = swapBytes(header.columns);
+			header.stride = swapBytes(header.stride);
+			header.payloadOffset = swapBytes(header.payloadOffset);
+		}
+		else if (header.endianness != MATRIX_FILE_ENDIANNESS)
+		{
+			return false;
+		}
+
+		const uint64_t maxSize = uint64_t(uint(-1));
+
+		if (header.version == 0 || header.version > MATRIX_FILE_VERSION || header.type != uint32_t(MatrixFileTraits<T>::type) || header.valueSize != sizeof(T))
+			return false;
+		else if (header.rows > maxSize || header.columns > maxSize || header.stride > maxSize || header.stride < header.columns)
+			return false;
+		else if (header.stride == 0 && header.rows != 0)
+			return false;
+		else if (header.payloadOffset < sizeof(MatrixFileHeader) || header.payloadOffset % MATRIX_FILE_ALIGNMENT != 0)
+			return false;
+
+		// The length of a stream is not known, its reader stops at the end of the values instead
+		if (fileSize == uint64_t(-1) || header.stride == 0)
+			return fileSize >= header.payloadOffset;
+
+		return fileSize >= header.payloadOffset && (fileSize - header.payloadOffset) / header.valueSize / header.stride >= header.rows;
+	}
+
+	/*! swapBytes
+	* Reverse the byte order of a value
+	* U value: The value
+	* return: The value with the bytes reversed
+	*/
+	template <typename U>
+	U swapBytes(U value)
+	{
+		unsigned char bytes[sizeof(U)];
+
+		std::memcpy(bytes, &value, sizeof(U));
+		std::reverse(bytes, bytes + sizeof(U));
+		std::memcpy(&value, bytes, sizeof(U));
+
+		return value;
+	}
+
+}
+
+#endif
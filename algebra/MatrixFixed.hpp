@@ -0,0 +1,935 @@
+#ifndef MATRIX_FIXED_HPP
+#define MATRIX_FIXED_HPP
+
+#include <iostream>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+#include "MatrixEnum.hpp"
+#include "MatrixException.hpp"
+
+namespace lito {
+
+	// Matrix<T> (R = C = 0) has the sizes known at run time and is defined in Matrix.hpp
+	template <typename T, uint R = 0, uint C = 0> class Matrix;
+
+	template <uint... I> using IndexSequence = std::integer_sequence<uint, I...>;
+	template <uint N> using MakeIndexSequence = std::make_integer_sequence<uint, N>;
+
+	/*! Matrix
+	* Matrix with the sizes known at compile time, stored in the object without allocation
+	* The operators are unrolled over the values at compile time and can be used in constant expressions
+	*/
+	template <typename T, uint R, uint C>
+	class Matrix {
+	public:
+		typedef T ValueType;
+
+		constexpr Matrix();
+		constexpr Matrix(const MatrixType& type);
+		template <typename... V, typename = typename std::enable_if<sizeof...(V) + 1 == R * C>::type>
+		constexpr Matrix(const T& value, const V&... values);
+		explicit Matrix(const T* data);
+		explicit Matrix(const Matrix<T>& mat);
+
+		constexpr T& operator () (const uint& line, const uint& column);
+		constexpr const T& operator () (const uint& line, const uint& column) const;
+		constexpr T& at (const uint& line, const uint& column);
+		constexpr const T& at (const uint& line, const uint& column) const;
+
+		constexpr T* row (const uint& line);
+		constexpr const T* row (const uint& line) const;
+		constexpr T* data ();
+		constexpr const T* data () const;
+
+		static constexpr uint getRows();
+		static constexpr uint getColumns();
+
+		constexpr Matrix<T, R, C> operator + (const Matrix<T, R, C>& sum) const;
+		constexpr Matrix<T, R, C> operator - (const Matrix<T, R, C>& sub) const;
+		template <uint K> constexpr Matrix<T, R, K> operator * (const Matrix<T, C, K>& mul) const;
+		constexpr Matrix<T, R, C> mul (const Matrix<T, R, C>& mul) const;
+
+		constexpr Matrix<T, R, C> operator + (const T& sum) const;
+		constexpr Matrix<T, R, C> operator - (const T& sub) const;
+		constexpr Matrix<T, R, C> operator * (const T& mul) const;
+
+		constexpr Matrix<T, R, C>& operator += (const Matrix<T, R, C>& sum);
+		constexpr Matrix<T, R, C>& operator -= (const Matrix<T, R, C>& sub);
+		constexpr Matrix<T, R, C>& operator *= (const Matrix<T, C, C>& mul);
+		constexpr Matrix<T, R, C>& mulAssign (const Matrix<T, R, C>& mul);
+
+		constexpr Matrix<T, R, C>& operator += (const T& sum);
+		constexpr Matrix<T, R, C>& operator -= (const T& sub);
+		constexpr Matrix<T, R, C>& operator *= (const T& mul);
+
+		constexpr Matrix<T, C, R> transpose () const;
+
+		template <typename _T, uint _R, uint _C> friend class Matrix;
+
+	private:
+		template <uint... I> constexpr Matrix<T, R, C> sum (const Matrix<T, R, C>& sum, IndexSequence<I...>) const;
+		template <uint... I> constexpr Matrix<T, R, C> sub (const Matrix<T, R, C>& sub, IndexSequence<I...>) const;
+		template <uint... I> constexpr Matrix<T, R, C> mul (const Matrix<T, R, C>& mul, IndexSequence<I...>) const;
+		template <uint... I> constexpr Matrix<T, R, C> sumDiagonal (const T& sum, IndexSequence<I...>) const;
+		template <uint... I> constexpr Matrix<T, R, C> scale (const T& mul, IndexSequence<I...>) const;
+		template <uint... I> constexpr Matrix<T, C, R> transpose (IndexSequence<I...>) const;
+		template <uint K, uint... I> constexpr Matrix<T, R, K> product (const Matrix<T, C, K>& mul, IndexSequence<I...>) const;
+		template <uint K, uint... P> static constexpr T dot (const T* line, const T* column, IndexSequence<P...>);
+
+		T _data[R * C];
+	};
+
+	template <typename T> constexpr T fixedSum(const T& value);
+	template <typename T, typename... V> constexpr T fixedSum(const T& value1, const T& value2, const V&... values);
+
+	template <typename T, uint R, uint C> constexpr Matrix<T, R, C> operator + (const Matrix<T, R, C>& mat);
+	template <typename T, uint R, uint C> constexpr Matrix<T, R, C> operator - (const Matrix<T, R, C>& mat);
+	template <typename T, uint R, uint C> constexpr Matrix<T, R, C> operator + (const T& sum, const Matrix<T, R, C>& mat);
+	template <typename T, uint R, uint C> constexpr Matrix<T, R, C> operator - (const T& sub, const Matrix<T, R, C>& mat);
+	template <typename T, uint R, uint C> constexpr Matrix<T, R, C> operator * (const T& mul, const Matrix<T, R, C>& mat);
+	template <typename T, uint R, uint C> std::ostream& operator << (std::ostream& out, const Matrix<T, R, C>& mat);
+
+	template <typename T> constexpr T determinant(const Matrix<T, 2, 2>& mat);
+	template <typename T> constexpr T determinant(const Matrix<T, 3, 3>& mat);
+	template <typename T> constexpr T determinant(const Matrix<T, 4, 4>& mat);
+	template <typename T, uint N> constexpr T determinant(const Matrix<T, N, N>& mat);
+
+	template <typename T> constexpr Matrix<T, 2, 2> invert(const Matrix<T, 2, 2>& mat);
+	template <typename T> constexpr Matrix<T, 3, 3> invert(const Matrix<T, 3, 3>& mat);
+	template <typename T> constexpr Matrix<T, 4, 4> invert(const Matrix<T, 4, 4>& mat);
+	template <typename T, uint N> constexpr Matrix<T, N, N> invert(const Matrix<T, N, N>& mat);
+
+
+
+	/*! Matrix
+	* Initialize the matrix with zeros
+	*/
+	template <typename T, uint R, uint C>
+	constexpr Matrix<T, R, C>::Matrix()
+		: _data{}
+	{}
+
+	/*! Matrix
+	* Initialize the matrix for types specifiques
+	* MatrixType: The type of matrix (ones, zeros or identity)
+	*/
+	template <typename T, uint R, uint C>
+	constexpr Matrix<T, R, C>::Matrix(const MatrixType& type)
+		: _data{}
+	{
+		for (uint i = 0; i < R; i++)
+			for (uint j = 0; j < C; j++)
+				_data[j + (C * i)] = (type == MatrixType::ONES || (type == MatrixType::IDENTITY && i == j)) ? T(1) : T(0);
+	}
+
+	/*! Matrix
+	* Initialize the matrix with its R * C values, line after line
+	* T value, V values: The values
+	*/
+	template <typename T, uint R, uint C>
+	template <typename... V, typename>
+	constexpr Matrix<T, R, C>::Matrix(const T& value, const V&... values)
+		: _data{ value, T(values)... }
+	{}
+
+	/*! Matrix
+	* Initialize the matrix with a array
+	* T*: The array to be copied, line after line
+	*/
+	template <typename T, uint R, uint C>
+	Matrix<T, R, C>::Matrix(const T* data)
+	{
+		std::copy(data, data + (R * C), _data);
+	}
+
+	/*! operator ()
+	* Get the value of specific line and column
+	* Checked only when LITO_MATRIX_CHECK_BOUNDS is on
+	* uint line: Indice of the line
+	* uint column: Indice of the column
+	* return: The value of specific line and column
+	*/
+	template <typename T, uint R, uint C>
+	constexpr T& Matrix<T, R, C>::operator () (const uint& line, const uint& column)
+	{
+#if LITO_MATRIX_CHECK_BOUNDS
+		if (line >= R || column >= C)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, R, C, line, column));
+#endif
+
+		return _data[column + (C * line)];
+	}
+
+	/*! operator ()
+	* Get the value of specific line and column
+	* Checked only when LITO_MATRIX_CHECK_BOUNDS is on
+	* uint line: Indice of the line
+	* uint column: Indice of the column
+	* return: The value of specific line and column
+	*/
+	template <typename T, uint R, uint C>
+	constexpr const T& Matrix<T, R, C>::operator () (const uint& line, const uint& column) const
+	{
+#if LITO_MATRIX_CHECK_BOUNDS
+		if (line >= R || column >= C)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, R, C, line, column));
+#endif
+
+		return _data[column + (C * line)];
+	}
+
+	/*! at
+	* Get the value of specific line and column, always checked
+	* uint line: Indice of the line
+	* uint column: Indice of the column
+	* return: The value of specific line and column
+	*/
+	template <typename T, uint R, uint C>
+	constexpr T& Matrix<T, R, C>::at (const uint& line, const uint& column)
+	{
+		if (line >= R || column >= C)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, R, C, line, column));
+
+		return _data[column + (C * line)];
+	}
+
+	/*! at
+	* Get the value of specific line and column, always checked
+	* uint line: Indice of the line
+	* uint column: Indice of the column
+	* return: The value of specific line and column
+	*/
+	template <typename T, uint R, uint C>
+	constexpr const T& Matrix<T, R, C>::at (const uint& line, const uint& column) const
+	{
+		if (line >= R || column >= C)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, R, C, line, column));
+
+		return _data[column + (C * line)];
+	}
+
+	/*! row
+	* Get the first value of a line, the C values of the line follow it
+	* Checked only when LITO_MATRIX_CHECK_BOUNDS is on
+	* uint line: Indice of the line
+	* return: Pointer to the line
+	*/
+	template <typename T, uint R, uint C>
+	constexpr T* Matrix<T, R, C>::row (const uint& line)
+	{
+#if LITO_MATRIX_CHECK_BOUNDS
+		if (line >= R)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, R, C, line, 0));
+#endif
+
+		return _data + (C * line);
+	}
+
+	/*! row
+	* Get the first value of a line, the C values of the line follow it
+	* Checked only when LITO_MATRIX_CHECK_BOUNDS is on
+	* uint line: Indice of the line
+	* return: Pointer to the line
+	*/
+	template <typename T, uint R, uint C>
+	constexpr const T* Matrix<T, R, C>::row (const uint& line) const
+	{
+#if LITO_MATRIX_CHECK_BOUNDS
+		if (line >= R)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, R, C, line, 0));
+#endif
+
+		return _data + (C * line);
+	}
+
+	/*! data
+	* Get the values of the matrix, stored line after line without padding
+	* return: Pointer to the first value
+	*/
+	template <typename T, uint R, uint C>
+	constexpr T* Matrix<T, R, C>::data ()
+	{
+		return _data;
+	}
+
+	/*! data
+	* Get the values of the matrix, stored line after line without padding
+	* return: Pointer to the first value
+	*/
+	template <typename T, uint R, uint C>
+	constexpr const T* Matrix<T, R, C>::data () const
+	{
+		return _data;
+	}
+
+	/*! getRows
+	* Get the quantities of rows
+	* return: R
+	*/
+	template <typename T, uint R, uint C>
+	constexpr uint Matrix<T, R, C>::getRows()
+	{
+		return R;
+	}
+
+	/*! getColumns
+	* Get the quantities of columns
+	* return: C
+	*/
+	template <typename T, uint R, uint C>
+	constexpr uint Matrix<T, R, C>::getColumns()
+	{
+		return C;
+	}
+
+	/*! operator +
+	* Sum the matrices
+	* Matrix<T, R, C> sum: Matrix to be added
+	* return: The sum of the matrices
+	*/
+	template <typename T, uint R, uint C>
+	constexpr Matrix<T, R, C> Matrix<T, R, C>::operator + (const Matrix<T, R, C>& sum) const
+	{
+		return this->sum(sum, MakeIndexSequence<R * C>());
+	}
+
+	/*! operator -
+	* Subtract the matrices
+	* Matrix<T, R, C> sub: Matrix to be subtracted
+	* return: The subtract of the matrices
+	*/
+	template <typename T, uint R, uint C>
+	constexpr Matrix<T, R, C> Matrix<T, R, C>::operator - (const Matrix<T, R, C>& sub) const
+	{
+		return this->sub(sub, MakeIndexSequence<R * C>());
+	}
+
+	/*! operator *
+	* Matrices multiplication
+	* Matrix<T, C, K> mul: Matrix to multiply
+	* return: The matrix of multiplication of the matrices
+	*/
+	template <typename T, uint R, uint C>
+	template <uint K>
+	constexpr Matrix<T, R, K> Matrix<T, R, C>::operator * (const Matrix<T, C, K>& mul) const
+	{
+		return product(mul, MakeIndexSequence<R * K>());
+	}
+
+	/*! mul
+	* Multiply the matrices value to value
+	* Matrix<T, R, C> mul: Matrix to be multiplied
+	* return: The multiplication of the matrices
+	*/
+	template <typename T, uint R, uint C>
+	constexpr Matrix<T, R, C> Matrix<T, R, C>::mul (const Matrix<T, R, C>& mul) const
+	{
+		return this->mul(mul, MakeIndexSequence<R * C>());
+	}
+
+	/*! operator +
+	* Sum the matrix with matrix identity multiplied to sum value
+	* T sum: Value to be multiplied to matrix identity
+	* return: The sum of the matrix with matrix identity multiplied to sum value
+	*/
+	template <typename T, uint R, uint C>
+	constexpr Matrix<T, R, C> Matrix<T, R, C>::operator + (const T& sum) const
+	{
+		return sumDiagonal(sum, MakeIndexSequence<R * C>());
+	}
+
+	/*! operator -
+	* Subtract the matrix with matrix identity multiplied to sub value
+	* T sub: Value to be multiplied to matrix identity
+	* return: The subtraction of the matrix with matrix identity multiplied to sub value
+	*/
+	template <typename T, uint R, uint C>
+	constexpr Matrix<T, R, C> Matrix<T, R, C>::operator - (const T& sub) const
+	{
+		return sumDiagonal(-sub, MakeIndexSequence<R * C>());
+	}
+
+	/*! operator *
+	* Multiply the matrix with mul value
+	* T mul: Value to be multiplied
+	* return: The multiplication of the matrix with mul value
+	*/
+	template <typename T, uint R, uint C>
+	constexpr Matrix<T, R, C> Matrix<T, R, C>::operator * (const T& mul) const
+	{
+		return scale(mul, MakeIndexSequence<R * C>());
+	}
+
+	/*! operator +=
+	* Sum the matrix sum into this matrix
+	* Matrix<T, R, C> sum: Matrix to be added
+	* return: The matrix modified
+	*/
+	template <typename T, uint R, uint C>
+	constexpr Matrix<T, R, C>& Matrix<T, R, C>::operator += (const Matrix<T, R, C>& sum)
+	{
+		return *this = *this + sum;
+	}
+
+	/*! operator -=
+	* Subtract the matrix sub from this matrix
+	* Matrix<T, R, C> sub: Matrix to be subtracted
+	* return: The matrix modified
+	*/
+	template <typename T, uint R, uint C>
+	constexpr Matrix<T, R, C>& Matrix<T, R, C>::operator -= (const Matrix<T, R, C>& sub)
+	{
+		return *this = *this - sub;
+	}
+
+	/*! operator *=
+	* Multiply this matrix by the square matrix mul
+	* Matrix<T, C, C> mul: Matrix to multiply
+	* return: The matrix modified
+	*/
+	template <typename T, uint R, uint C>
+	constexpr Matrix<T, R, C>& Matrix<T, R, C>::operator *= (const Matrix<T, C, C>& mul)
+	{
+		return *this = *this * mul;
+	}
+
+	/*! mulAssign
+	* Multiply this matrix by the matrix mul value to value
+	* Matrix<T, R, C> mul: Matrix to be multiplied
+	* return: The matrix modified
+	*/
+	template <typename T, uint R, uint C>
+	constexpr Matrix<T, R, C>& Matrix<T, R, C>::mulAssign (const Matrix<T, R, C>& mul)
+	{
+		return *this = this->mul(mul);
+	}
+
+	/*! operator +=
+	* Sum the matrix identity multiplied to sum value into this matrix
+	* T sum: Value to be multiplied to matrix identity
+	* return: The matrix modified
+	*/
+	template <typename T, uint R, uint C>
+	constexpr Matrix<T, R, C>& Matrix<T, R, C>::operator += (const T& sum)
+	{
+		return *this = *this + sum;
+	}
+
+	/*! operator -=
+	* Subtract the matrix identity multiplied to sub value from this matrix
+	* T sub: Value to be multiplied to matrix identity
+	* return: The matrix modified
+	*/
+	template <typename T, uint R, uint C>
+	constexpr Matrix<T, R, C>& Matrix<T, R, C>::operator -= (const T& sub)
+	{
+		return *this = *this - sub;
+	}
+
+	/*! operator *=
+	* Multiply this matrix by mul value
+	* T mul: Value to be multiplied
+	* return: The matrix modified
+	*/
+	template <typename T, uint R, uint C>
+	constexpr Matrix<T, R, C>& Matrix<T, R, C>::operator *= (const T& mul)
+	{
+		return *this = *this * mul;
+	}
+
+	/*! transpose
+	* Transpose the matrix
+	* return: The mtrix transposed
+	*/
+	template <typename T, uint R, uint C>
+	constexpr Matrix<T, C, R> Matrix<T, R, C>::transpose () const
+	{
+		return transpose(MakeIndexSequence<R * C>());
+	}
+
+	/*! sum
+	* Sum the matrices, one expression per value
+	*/
+	template <typename T, uint R, uint C>
+	template <uint... I>
+	constexpr Matrix<T, R, C> Matrix<T, R, C>::sum (const Matrix<T, R, C>& sum, IndexSequence<I...>) const
+	{
+		return Matrix<T, R, C>((_data[I] + sum._data[I])...);
+	}
+
+	/*! sub
+	* Subtract the matrices, one expression per value
+	*/
+	template <typename T, uint R, uint C>
+	template <uint... I>
+	constexpr Matrix<T, R, C> Matrix<T, R, C>::sub (const Matrix<T, R, C>& sub, IndexSequence<I...>) const
+	{
+		return Matrix<T, R, C>((_data[I] - sub._data[I])...);
+	}
+
+	/*! mul
+	* Multiply the matrices value to value, one expression per value
+	*/
+	template <typename T, uint R, uint C>
+	template <uint... I>
+	constexpr Matrix<T, R, C> Matrix<T, R, C>::mul (const Matrix<T, R, C>& mul, IndexSequence<I...>) const
+	{
+		return Matrix<T, R, C>((_data[I] * mul._data[I])...);
+	}
+
+	/*! sumDiagonal
+	* Sum a value to the diagonal, one expression per value
+	*/
+	template <typename T, uint R, uint C>
+	template <uint... I>
+	constexpr Matrix<T, R, C> Matrix<T, R, C>::sumDiagonal (const T& sum, IndexSequence<I...>) const
+	{
+		return Matrix<T, R, C>(((I / C == I % C) ? _data[I] + sum : _data[I])...);
+	}
+
+	/*! scale
+	* Multiply the matrix by a value, one expression per value
+	*/
+	template <typename T, uint R, uint C>
+	template <uint... I>
+	constexpr Matrix<T, R, C> Matrix<T, R, C>::scale (const T& mul, IndexSequence<I...>) const
+	{
+		return Matrix<T, R, C>((_data[I] * mul)...);
+	}
+
+	/*! transpose
+	* Transpose the matrix, the value I of the result is the value (I % R, I / R) of this matrix
+	*/
+	template <typename T, uint R, uint C>
+	template <uint... I>
+	constexpr Matrix<T, C, R> Matrix<T, R, C>::transpose (IndexSequence<I...>) const
+	{
+		return Matrix<T, C, R>(_data[(I / R) + (C * (I % R))]...);
+	}
+
+	/*! product
+	* Multiply the matrices, one dot product per value of the result
+	*/
+	template <typename T, uint R, uint C>
+	template <uint K, uint... I>
+	constexpr Matrix<T, R, K> Matrix<T, R, C>::product (const Matrix<T, C, K>& mul, IndexSequence<I...>) const
+	{
+		return Matrix<T, R, K>(dot<K>(_data + (C * (I / K)), mul._data + (I % K), MakeIndexSequence<C>())...);
+	}
+
+	/*! dot
+	* Dot product of a line of this matrix and a column of a matrix with K columns
+	* T* line: First value of the line
+	* T* column: First value of the column
+	* return: The dot product
+	*/
+	template <typename T, uint R, uint C>
+	template <uint K, uint... P>
+	constexpr T Matrix<T, R, C>::dot (const T* line, const T* column, IndexSequence<P...>)
+	{
+		return fixedSum((line[P] * column[K * P])...);
+	}
+
+	/*! fixedSum
+	* Sum the values from left to right
+	* return: The sum
+	*/
+	template <typename T>
+	constexpr T fixedSum(const T& value)
+	{
+		return value;
+	}
+
+	/*! fixedSum
+	* Sum the values from left to right
+	* return: The sum
+	*/
+	template <typename T, typename... V>
+	constexpr T fixedSum(const T& value1, const T& value2, const V&... values)
+	{
+		return fixedSum(T(value1 + value2), values...);
+	}
+
+	/*! operator +
+	* The matrix multiplied to +1
+	* Matrix<T, R, C> mat: Matrix to be multiplied
+	* return: The matrix multiplied to +1
+	*/
+	template <typename T, uint R, uint C>
+	constexpr Matrix<T, R, C> operator + (const Matrix<T, R, C>& mat)
+	{
+		return mat;
+	}
+
+	/*! operator -
+	* The matrix multiplied to -1
+	* Matrix<T, R, C> mat: Matrix to be multiplied
+	* return: The matrix multiplied to -1
+	*/
+	template <typename T, uint R, uint C>
+	constexpr Matrix<T, R, C> operator - (const Matrix<T, R, C>& mat)
+	{
+		return mat * T(-1);
+	}
+
+	/*! operator +
+	* Sum the matrix identity multiplied to sum value with matrix mat
+	* T sum: Value to be multiplied to matrix identity
+	* Matrix<T, R, C> mat: Matrix to add
+	* return: The sum the matrix identity multiplied to sum value with matrix mat
+	*/
+	template <typename T, uint R, uint C>
+	constexpr Matrix<T, R, C> operator + (const T& sum, const Matrix<T, R, C>& mat)
+	{
+		return mat + sum;
+	}
+
+	/*! operator -
+	* Subtract the matrix mat from the matrix identity multiplied to sub value
+	* T sub: Value to be multiplied to matrix identity
+	* Matrix<T, R, C> mat: Matrix to subtract
+	* return: The subtraction of the matrix identity multiplied to sub value with matrix mat
+	*/
+	template <typename T, uint R, uint C>
+	constexpr Matrix<T, R, C> operator - (const T& sub, const Matrix<T, R, C>& mat)
+	{
+		return (-mat) + sub;
+	}
+
+	/*! operator *
+	* Multiply the mul value to matrix mat
+	* T mul: Value to be multiplied
+	* Matrix<T, R, C> mat: Matrix to be multiplied
+	* return: The multiplication of the mul value to matrix
+	*/
+	template <typename T, uint R, uint C>
+	constexpr Matrix<T, R, C> operator * (const T& mul, const Matrix<T, R, C>& mat)
+	{
+		return mat * mul;
+	}
+
+	/*! operator <<
+	* Shows the matrix in console
+	* ostream out: Output stream
+	* Matrix<T, R, C> mat: Matrix to show
+	* return: Output stream
+	*/
+	template <typename T, uint R, uint C>
+	std::ostream& operator << (std::ostream& out, const Matrix<T, R, C>& mat)
+	{
+		out << '\n';
+
+		for (uint i = 0; i < R; i++)
+		{
+			const T* row = mat.data() + (C * i);
+
+			out << "[ " << row[0];
+			for (uint j = 1; j < C; j++)
+				out << ", " << row[j];
+			out << " ]\n";
+		}
+
+		return out;
+	}
+
+	/*! determinant
+	* Calculate the determinant of matrix 2x2
+	* Matrix<T, 2, 2> mat: Matrix 2x2
+	* return: Determinant of mat
+	*/
+	template <typename T>
+	constexpr T determinant(const Matrix<T, 2, 2>& mat)
+	{
+		const T* m = mat.data();
+
+		return ( m[0] * m[3] ) - ( m[1] * m[2] );
+	}
+
+	/*! determinant
+	* Calculate the determinant of matrix 3x3
+	* Matrix<T, 3, 3> mat: Matrix 3x3
+	* return: Determinant of mat
+	*/
+	template <typename T>
+	constexpr T determinant(const Matrix<T, 3, 3>& mat)
+	{
+		const T* m = mat.data();
+
+		return ( m[0] * ( ( m[4] * m[8] ) - ( m[5] * m[7] ) ) )
+		     - ( m[1] * ( ( m[3] * m[8] ) - ( m[5] * m[6] ) ) )
+		     + ( m[2] * ( ( m[3] * m[7] ) - ( m[4] * m[6] ) ) );
+	}
+
+	/*! determinant
+	* Calculate the determinant of matrix 4x4
+	* Matrix<T, 4, 4> mat: Matrix 4x4
+	* return: Determinant of mat
+	*/
+	template <typename T>
+	constexpr T determinant(const Matrix<T, 4, 4>& mat)
+	{
+		// [ 0  1  2  3  ]
+		// [ 4  5  6  7  ]
+		// [ 8  9  10 11 ]
+		// [ 12 13 14 15 ]
+
+		const T* m = mat.data();
+
+		T A = ( m[10] * m[15] ) - ( m[11] * m[14] );
+		T B = ( m[9 ] * m[15] ) - ( m[11] * m[13] );
+		T C = ( m[9 ] * m[14] ) - ( m[10] * m[13] );
+		T D = ( m[8 ] * m[15] ) - ( m[11] * m[12] );
+		T E = ( m[8 ] * m[14] ) - ( m[10] * m[12] );
+		T F = ( m[8 ] * m[13] ) - ( m[9 ] * m[12] );
+
+		return ( m[0] * ( ( m[5] * A ) - ( m[6] * B ) + ( m[7] * C ) ) )
+		     - ( m[1] * ( ( m[4] * A ) - ( m[6] * D ) + ( m[7] * E ) ) )
+		     + ( m[2] * ( ( m[4] * B ) - ( m[5] * D ) + ( m[7] * F ) ) )
+		     - ( m[3] * ( ( m[4] * C ) - ( m[5] * E ) + ( m[6] * F ) ) );
+	}
+
+	/*! determinant
+	* Calculate the determinant of a square matrix by Gauss reduction with partial pivoting
+	* Matrix<T, N, N> mat: Square matrix
+	* return: Determinant of mat
+	*/
+	template <typename T, uint N>
+	constexpr T determinant(const Matrix<T, N, N>& mat)
+	{
+		static_assert(N > 0, "determinant needs a matrix with the sizes known at compile time");
+
+		Matrix<T, N, N> reduction = mat;
+		T* m = reduction.data();
+		T deter = T(1);
+
+		for (uint i = 0; i < N; i++)
+		{
+			uint pivot = i;
+
+			for (uint j = i + 1; j < N; j++)
+				if (((m[i + (N * j)] < T(0)) ? -m[i + (N * j)] : m[i + (N * j)]) > ((m[i + (N * pivot)] < T(0)) ? -m[i + (N * pivot)] : m[i + (N * pivot)]))
+					pivot = j;
+
+			if (m[i + (N * pivot)] == T(0))
+				return T(0);
+
+			if (pivot != i)
+			{
+				for (uint k = i; k < N; k++)
+				{
+					T aux = m[k + (N * i)];
+					m[k + (N * i)] = m[k + (N * pivot)];
+					m[k + (N * pivot)] = aux;
+				}
+
+				deter = -deter;
+			}
+
+			deter *= m[i + (N * i)];
+
+			for (uint j = i + 1; j < N; j++)
+			{
+				T mulLine = m[i + (N * j)] / m[i + (N * i)];
+
+				for (uint k = i + 1; k < N; k++)
+					m[k + (N * j)] -= mulLine * m[k + (N * i)];
+			}
+		}
+
+		return deter;
+	}
+
+	/*! invert
+	* Calculate the inverted matrix
+	* Matrix<T, 2, 2> mat: Matrix to be inverted
+	* return: The inverted matrix
+	*/
+	template <typename T>
+	constexpr Matrix<T, 2, 2> invert(const Matrix<T, 2, 2>& mat)
+	{
+		const T* m = mat.data();
+		T deter = determinant(mat);
+
+		if (deter == T(0))
+			throw MatrixException{ MatrixExceptionType::SINGULAR_MATRIX };
+
+		T deterIverse = T(1) / deter;
+
+		return Matrix<T, 2, 2>{ deterIverse *  m[3], deterIverse * -m[1]
+		                      , deterIverse * -m[2], deterIverse *  m[0] };
+	}
+
+	/*! invert
+	* Calculate the inverted matrix by adjugate matrix
+	* Matrix<T, 3, 3> mat: Matrix to be inverted
+	* return: The inverted matrix
+	*/
+	template <typename T>
+	constexpr Matrix<T, 3, 3> invert(const Matrix<T, 3, 3>& mat)
+	{
+		// [ 0 1 2 ]
+		// [ 3 4 5 ]
+		// [ 6 7 8 ]
+
+		const T* m = mat.data();
+
+		// Finding the determination
+		T deter = determinant(mat);
+
+		if (deter == T(0))
+			throw MatrixException{ MatrixExceptionType::SINGULAR_MATRIX };
+
+		T deterIverse = T(1) / deter;
+
+		// Finding the cofactors times inverse of the determinant
+		T c0 = deterIverse * ( + ( ( m[4] * m[8] ) - ( m[5] * m[7] ) ) );
+		T c1 = deterIverse * ( - ( ( m[3] * m[8] ) - ( m[5] * m[6] ) ) );
+		T c2 = deterIverse * ( + ( ( m[3] * m[7] ) - ( m[4] * m[6] ) ) );
+
+		T c3 = deterIverse * ( - ( ( m[1] * m[8] ) - ( m[2] * m[7] ) ) );
+		T c4 = deterIverse * ( + ( ( m[0] * m[8] ) - ( m[2] * m[6] ) ) );
+		T c5 = deterIverse * ( - ( ( m[0] * m[7] ) - ( m[1] * m[6] ) ) );
+
+		T c6 = deterIverse * ( + ( ( m[1] * m[5] ) - ( m[2] * m[4] ) ) );
+		T c7 = deterIverse * ( - ( ( m[0] * m[5] ) - ( m[2] * m[3] ) ) );
+		T c8 = deterIverse * ( + ( ( m[0] * m[4] ) - ( m[1] * m[3] ) ) );
+
+		// Transposed adjunct matrix
+		return Matrix<T, 3, 3>{ c0, c3, c6
+		                      , c1, c4, c7
+		                      , c2, c5, c8 };
+	}
+
+	/*! invert
+	* Calculate the inverted matrix adjugate matrix
+	* Matrix<T, 4, 4> mat: Matrix to be inverted
+	* return: The inverted matrix
+	*/
+	template <typename T>
+	constexpr Matrix<T, 4, 4> invert(const Matrix<T, 4, 4>& mat)
+	{
+		const T* m = mat.data();
+
+		// Finding the determination
+		T A = ( m[10] * m[15] ) - ( m[11] * m[14] );
+		T B = ( m[9 ] * m[15] ) - ( m[11] * m[13] );
+		T C = ( m[9 ] * m[14] ) - ( m[10] * m[13] );
+		T D = ( m[8 ] * m[15] ) - ( m[11] * m[12] );
+		T E = ( m[8 ] * m[14] ) - ( m[10] * m[12] );
+		T F = ( m[8 ] * m[13] ) - ( m[9 ] * m[12] );
+
+		T deter = ( m[0] * ( ( m[5] * A ) - ( m[6] * B ) + ( m[7] * C ) ) )
+		        - ( m[1] * ( ( m[4] * A ) - ( m[6] * D ) + ( m[7] * E ) ) )
+		        + ( m[2] * ( ( m[4] * B ) - ( m[5] * D ) + ( m[7] * F ) ) )
+		        - ( m[3] * ( ( m[4] * C ) - ( m[5] * E ) + ( m[6] * F ) ) );
+
+		if (deter == T(0))
+			throw MatrixException{ MatrixExceptionType::SINGULAR_MATRIX };
+
+		T deterIverse = T(1) / deter;
+
+		T G = ( m[2 ] * m[7 ] ) - ( m[3 ] * m[6 ] );
+		T H = ( m[1 ] * m[7 ] ) - ( m[3 ] * m[5 ] );
+		T I = ( m[1 ] * m[6 ] ) - ( m[2 ] * m[5 ] );
+		T J = ( m[0 ] * m[7 ] ) - ( m[3 ] * m[4 ] );
+		T K = ( m[0 ] * m[6 ] ) - ( m[2 ] * m[4 ] );
+		T L = ( m[0 ] * m[5 ] ) - ( m[1 ] * m[4 ] );
+
+		// Finding the cofactors times inverse of the determinant
+		T c0  = deterIverse * ( + ( m[5 ] * A ) - ( m[6 ] * B ) + ( m[7 ] * C ) );
+		T c1  = deterIverse * ( - ( m[4 ] * A ) + ( m[6 ] * D ) - ( m[7 ] * E ) );
+		T c2  = deterIverse * ( + ( m[4 ] * B ) - ( m[5 ] * D ) + ( m[7 ] * F ) );
+		T c3  = deterIverse * ( - ( m[4 ] * C ) + ( m[5 ] * E ) - ( m[6 ] * F ) );
+
+		T c4  = deterIverse * ( - ( m[1 ] * A ) + ( m[2 ] * B ) - ( m[3 ] * C ) );
+		T c5  = deterIverse * ( + ( m[0 ] * A ) - ( m[2 ] * D ) + ( m[3 ] * E ) );
+		T c6  = deterIverse * ( - ( m[0 ] * B ) + ( m[1 ] * D ) - ( m[3 ] * F ) );
+		T c7  = deterIverse * ( + ( m[0 ] * C ) - ( m[1 ] * E ) + ( m[2 ] * F ) );
+
+		T c8  = deterIverse * ( + ( m[13] * G ) - ( m[14] * H ) + ( m[15] * I ) );
+		T c9  = deterIverse * ( - ( m[12] * G ) + ( m[14] * J ) - ( m[15] * K ) );
+		T c10 = deterIverse * ( + ( m[12] * H ) - ( m[13] * J ) + ( m[15] * L ) );
+		T c11 = deterIverse * ( - ( m[12] * I ) + ( m[13] * K ) - ( m[14] * L ) );
+
+		T c12 = deterIverse * ( - ( m[9 ] * G ) + ( m[10] * H ) - ( m[11] * I ) );
+		T c13 = deterIverse * ( + ( m[8 ] * G ) - ( m[10] * J ) + ( m[11] * K ) );
+		T c14 = deterIverse * ( - ( m[8 ] * H ) + ( m[9 ] * J ) - ( m[11] * L ) );
+		T c15 = deterIverse * ( + ( m[8 ] * I ) - ( m[9 ] * K ) + ( m[10] * L ) );
+
+		// Transposed adjunct matrix
+		return Matrix<T, 4, 4>{ c0 , c4 , c8 , c12
+		                      , c1 , c5 , c9 , c13
+		                      , c2 , c6 , c10, c14
+		                      , c3 , c7 , c11, c15 };
+	}
+
+	/*! invert
+	* Calculate the inverted matrix by Gauss Jordan reduction with partial pivoting
+	* Matrix<T, N, N> mat: Square matrix to be inverted
+	* return: The inverted matrix
+	*/
+	template <typename T, uint N>
+	constexpr Matrix<T, N, N> invert(const Matrix<T, N, N>& mat)
+	{
+		static_assert(N > 0, "invert needs a matrix with the sizes known at compile time");
+
+		Matrix<T, N, N> reduction = mat;
+		Matrix<T, N, N> inverse(MatrixType::IDENTITY);
+		T* m = reduction.data();
+		T* inv = inverse.data();
+
+		for (uint i = 0; i < N; i++)
+		{
+			uint pivot = i;
+
+			for (uint j = i + 1; j < N; j++)
+				if (((m[i + (N * j)] < T(0)) ? -m[i + (N * j)] : m[i + (N * j)]) > ((m[i + (N * pivot)] < T(0)) ? -m[i + (N * pivot)] : m[i + (N * pivot)]))
+					pivot = j;
+
+			if (m[i + (N * pivot)] == T(0))
+				throw MatrixException{ MatrixExceptionType::SINGULAR_MATRIX };
+
+			if (pivot != i)
+			{
+				for (uint k = 0; k < N; k++)
+				{
+					T aux = m[k + (N * i)];
+					m[k + (N * i)] = m[k + (N * pivot)];
+					m[k + (N * pivot)] = aux;
+
+					aux = inv[k + (N * i)];
+					inv[k + (N * i)] = inv[k + (N * pivot)];
+					inv[k + (N * pivot)] = aux;
+				}
+			}
+
+			T pivotIverse = T(1) / m[i + (N * i)];
+
+			for (uint k = 0; k < N; k++)
+			{
+				m[k + (N * i)] *= pivotIverse;
+				inv[k + (N * i)] *= pivotIverse;
+			}
+
+			for (uint j = 0; j < N; j++)
+			{
+				if (j != i && m[i + (N * j)] != T(0))
+				{
+					T mulLine = m[i + (N * j)];
+
+					for (uint k = 0; k < N; k++)
+					{
+						m[k + (N * j)] -= mulLine * m[k + (N * i)];
+						inv[k + (N * j)] -= mulLine * inv[k + (N * i)];
+					}
+				}
+			}
+		}
+
+		return inverse;
+	}
+
+}
+
+#endif
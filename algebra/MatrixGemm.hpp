@@ -0,0 +1,403 @@
+#ifndef MATRIX_GEMM_HPP
+#define MATRIX_GEMM_HPP
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include "MatrixEnum.hpp"
+#include "SimdKernels.hpp"
+#include "HalfFloat.hpp"
+#include "MatrixGemv.hpp"
+#include "MatrixBlas.hpp"
+#include "ThreadPool.hpp"
+
+namespace lito {
+
+	/*! GemmBlocking
+	* Sizes of the blocks used by the GEMM kernel
+	* MR x NR: Register tile computed by the micro kernel, a NR row of B fills a cache line
+	* MC x KC: Block of A packed to stay in L2
+	* KC x NC: Block of B packed to stay in L3
+	* The SIMD micro kernels of float and double are written for these MR and NR
+	*/
+	template <typename T>
+	struct GemmBlocking {
+		static const uint MR = 4;
+		static const uint NR = (sizeof(T) < 64) ? uint(64 / sizeof(T)) : 1;
+		static const uint MC = 128;
+		static const uint KC = 256;
+		static const uint NC = 4096;
+		static const uint SMALL = 32 * 32 * 32;
+	};
+
+	template <typename T> void gemmPackA(uint mc, uint kc, const T& alpha, const T* A, uint rowStrideA, uint columnStrideA, T* packA);
+	template <typename T> void gemmPackB(uint kc, uint nc, const T* B, uint rowStrideB, uint columnStrideB, T* packB);
+	template <typename T> void gemmMicroKernel(uint kc, const T* packA, const T* packB, T* C, uint rowStrideC, uint mr, uint nr);
+	template <typename T> void gemmKernel(uint m, uint n, uint k, const T& alpha, const T* A, uint rowStrideA, uint columnStrideA, const T* B, uint rowStrideB, uint columnStrideB, const T& beta, T* C, uint rowStrideC);
+	template <typename S> void gemmKernelFloat(uint m, uint n, uint k, float alpha, const S* A, uint rowStrideA, uint columnStrideA, const S* B, uint rowStrideB, uint columnStrideB, float beta, S* C, uint rowStrideC);
+	template <typename S, typename U> void gemmConvertBlock(uint rows, uint columns, const S* A, uint rowStrideA, uint columnStrideA, U* B, uint rowStrideB);
+
+
+
+	/*! gemmPackA
+	* Copy a mc x kc block of A, multiplied to alpha, in panels of MR rows
+	* Each panel is stored column after column and the last one is padded with zeros
+	* uint mc: Quantities of rows of the block
+	* uint kc: Quantities of columns of the block
+	* T alpha: Value to be multiplied
+	* T* A: First value of the block
+	* uint rowStrideA: Distance between two rows of A
+	* uint columnStrideA: Distance between two columns of A
+	* T* packA: Buffer with at least ceil(mc / MR) * MR * kc values
+	*/
+	template <typename T>
+	void gemmPackA(uint mc, uint kc, const T& alpha, const T* A, uint rowStrideA, uint columnStrideA, T* packA)
+	{
+		const uint MR = GemmBlocking<T>::MR;
+
+		for (uint i = 0; i < mc; i += MR)
+		{
+			uint mr = std::min(MR, mc - i);
+
+			for (uint p = 0; p < kc; p++)
+			{
+				for (uint ii = 0; ii < mr; ii++)
+					packA[ii] = alpha * A[(size_t(i + ii) * rowStrideA) + (size_t(p) * columnStrideA)];
+				for (uint ii = mr; ii < MR; ii++)
+					packA[ii] = T(0);
+
+				packA += MR;
+			}
+		}
+	}
+
+	/*! gemmPackB
+	* Copy a kc x nc block of B in panels of NR columns
+	* Each panel is stored row after row and the last one is padded with zeros
+	* uint kc: Quantities of rows of the block
+	* uint nc: Quantities of columns of the block
+	* T* B: First value of the block
+	* uint rowStrideB: Distance between two rows of B
+	* uint columnStrideB: Distance between two columns of B
+	* T* packB: Buffer with at least ceil(nc / NR) * NR * kc values
+	*/
+	template <typename T>
+	void gemmPackB(uint kc, uint nc, const T* B, uint rowStrideB, uint columnStrideB, T* packB)
+	{
+		const uint NR = GemmBlocking<T>::NR;
+
+		for (uint j = 0; j < nc; j += NR)
+		{
+			uint nr = std::min(NR, nc - j);
+
+			for (uint p = 0; p < kc; p++)
+			{
+				const T* rowB = B + (size_t(p) * rowStrideB) + (size_t(j) * columnStrideB);
+
+				if (columnStrideB == 1)
+					std::copy(rowB, rowB + nr, packB);
+				else
+					for (uint jj = 0; jj < nr; jj++)
+						packB[jj] = rowB[jj * columnStrideB];
+				for (uint jj = nr; jj < NR; jj++)
+					packB[jj] = T(0);
+
+				packB += NR;
+			}
+		}
+	}
+
+	/*! gemmMicroKernel
+	* Sum the product of a packed MR x kc panel of A and a packed kc x NR panel of B into C
+	* The whole MR x NR tile is accumulated in registers, only mr x nr values are written
+	* Used for the types without SIMD kernels and for the tiles on the borders of C
+	* uint kc: Quantities of columns of the panel of A
+	* T* packA: Packed panel of A
+	* T* packB: Packed panel of B
+	* T* C: First value of the tile of C
+	* uint rowStrideC: Distance between two rows of C
+	* uint mr: Quantities of rows of C to write
+	* uint nr: Quantities of columns of C to write
+	*/
+	template <typename T>
+	void gemmMicroKernel(uint kc, const T* packA, const T* packB, T* C, uint rowStrideC, uint mr, uint nr)
+	{
+		const uint MR = GemmBlocking<T>::MR;
+		const uint NR = GemmBlocking<T>::NR;
+		T ab[MR * NR];
+
+		std::fill(ab, ab + (MR * NR), T(0));
+
+		for (uint p = 0; p < kc; p++)
+		{
+			for (uint i = 0; i < MR; i++)
+			{
+				const T a = packA[i];
+
+				for (uint j = 0; j < NR; j++)
+					ab[(i * NR) + j] += a * packB[j];
+			}
+
+			packA += MR;
+			packB += NR;
+		}
+
+		for (uint i = 0; i < mr; i++)
+			for (uint j = 0; j < nr; j++)
+				C[(i * rowStrideC) + j] += ab[(i * NR) + j];
+	}
+
+	/*! gemmKernel
+	* Calculate C = alpha * A * B + beta * C
+	* A and B are read through strides, so transposed operands need no copy
+	* Big products are packed and blocked for the caches, small ones use a direct loop,
+	* and a C of one column or one row is a matrix-vector product done by gemvKernel
+	* With the PARALLEL policy the blocks of A are split among the threads of the pool
+	* When the build has a system CBLAS, float and double products that are not small go to it
+	* uint m: Quantities of rows of A and C
+	* uint n: Quantities of columns of B and C
+	* uint k: Quantities of columns of A and rows of B
+	* T alpha: Value multiplied to A * B
+	* T* A: First value of A
+	* uint rowStrideA: Distance between two rows of A
+	* uint columnStrideA: Distance between two columns of A
+	* T* B: First value of B
+	* uint rowStrideB: Distance between two rows of B
+	* uint columnStrideB: Distance between two columns of B
+	* T beta: Value multiplied to C, when zero C is only written
+	* T* C: First value of C, must not overlap A or B
+	* uint rowStrideC: Distance between two rows of C
+	*/
+	template <typename T>
+	void gemmKernel(uint m, uint n, uint k, const T& alpha, const T* A, uint rowStrideA, uint columnStrideA, const T* B, uint rowStrideB, uint columnStrideB, const T& beta, T* C, uint rowStrideC)
+	{
+		const uint MR = GemmBlocking<T>::MR;
+		const uint NR = GemmBlocking<T>::NR;
+		const uint MC = GemmBlocking<T>::MC;
+		const uint KC = GemmBlocking<T>::KC;
+		const uint NC = GemmBlocking<T>::NC;
+
+		if (m == 0 || n == 0)
+			return;
+
+		if (double(m) * double(n) * double(k) > double(GemmBlocking<T>::SMALL) && blasGemm(m, n, k, alpha, A, rowStrideA, columnStrideA, B, rowStrideB, columnStrideB, beta, C, rowStrideC))
+			return;
+
+		// A row of C is C^T = B^T * A^T, so both cases stream the operand by its contiguous dimension
+		if (n == 1)
+		{
+			gemvKernel(m, k, alpha, A, rowStrideA, columnStrideA, B, rowStrideB, beta, C, rowStrideC);
+			return;
+		}
+		else if (m == 1)
+		{
+			gemvKernel(n, k, alpha, B, columnStrideB, rowStrideB, A, columnStrideA, beta, C, 1);
+			return;
+		}
+
+		for (uint i = 0; i < m; i++)
+		{
+			T* rowC = C + (size_t(i) * rowStrideC);
+
+			if (beta == T(0))
+				std::fill(rowC, rowC + n, T(0));
+			else if (beta != T(1))
+				for (uint j = 0; j < n; j++)
+					rowC[j] *= beta;
+		}
+
+		if (k == 0 || alpha == T(0))
+			return;
+
+		if (double(m) * double(n) * double(k) <= double(GemmBlocking<T>::SMALL))
+		{
+			for (uint i = 0; i < m; i++)
+			{
+				T* rowC = C + (size_t(i) * rowStrideC);
+
+				for (uint p = 0; p < k; p++)
+				{
+					const T a = alpha * A[(size_t(i) * rowStrideA) + (size_t(p) * columnStrideA)];
+					const T* rowB = B + (size_t(p) * rowStrideB);
+
+					for (uint j = 0; j < n; j++)
+						rowC[j] += a * rowB[j * columnStrideB];
+				}
+			}
+
+			return;
+		}
+
+		void (*microKernel)(uint, const T*, const T*, T*, uint) = simdKernels<T>().gemmMicroKernel;
+		uint maxMC = std::min(MC, ((m + MR - 1) / MR) * MR);
+		uint maxKC = std::min(KC, k);
+		uint maxNC = std::min(NC, ((n + NR - 1) / NR) * NR);
+		uint blocksM = (m + MC - 1) / MC;
+		std::vector<T> packB(size_t(maxNC) * maxKC);
+
+		for (uint jc = 0; jc < n; jc += NC)
+		{
+			uint nc = std::min(NC, n - jc);
+			uint panelsN = (nc + NR - 1) / NR;
+
+			for (uint pc = 0; pc < k; pc += KC)
+			{
+				uint kc = std::min(KC, k - pc);
+				double work = double(m) * double(nc) * double(kc);
+				uint splitsN = 1;
+
+				gemmPackB(kc, nc, B + (size_t(pc) * rowStrideB) + (size_t(jc) * columnStrideB), rowStrideB, columnStrideB, packB.data());
+
+				// Each task packs one MC block of A and multiplies it by a range of the NR panels of B,
+				// the panels are split only when there are fewer blocks of A than threads
+				if (useParallel(work) && blocksM < threadPool().getThreads())
+					splitsN = std::min(panelsN, (threadPool().getThreads() + blocksM - 1) / blocksM);
+
+				parallelFor(0, blocksM * splitsN, work, [&](uint from, uint to)
+				{
+					std::vector<T> packA(size_t(maxMC) * maxKC);
+
+					for (uint task = from; task < to; task++)
+					{
+						uint ic = (task / splitsN) * MC;
+						uint mc = std::min(MC, m - ic);
+						uint split = task % splitsN;
+						uint jrBegin = ((panelsN * split) / splitsN) * NR;
+						uint jrEnd = std::min(nc, ((panelsN * (split + 1)) / splitsN) * NR);
+
+						gemmPackA(mc, kc, alpha, A + (size_t(ic) * rowStrideA) + (size_t(pc) * columnStrideA), rowStrideA, columnStrideA, packA.data());
+
+						for (uint jr = jrBegin; jr < jrEnd; jr += NR)
+						{
+							uint nr = std::min(NR, nc - jr);
+
+							for (uint ir = 0; ir < mc; ir += MR)
+							{
+								uint mr = std::min(MR, mc - ir);
+
+								if (microKernel != nullptr && mr == MR && nr == NR)
+									microKernel(kc, packA.data() + (size_t(ir) * kc), packB.data() + (size_t(jr) * kc),
+									            C + (size_t(ic + ir) * rowStrideC) + (jc + jr), rowStrideC);
+								else
+									gemmMicroKernel(kc, packA.data() + (size_t(ir) * kc), packB.data() + (size_t(jr) * kc),
+									                C + (size_t(ic + ir) * rowStrideC) + (jc + jr), rowStrideC, mr, nr);
+							}
+						}
+					}
+				});
+			}
+		}
+	}
+
+	/*! gemmKernelFloat
+	* Calculate C = alpha * A * B + beta * C for a 16 bits storage type S, accumulating in float
+	* Blocks of A, B and C are converted to float, multiplied by the float GEMM kernel and C is rounded back once,
+	* so the sums keep the precision of float and the SIMD float kernels are used
+	* The blocks take 256 x 256 values of A and 256 x 1024 values of B and of C, about 2.3 MB
+	* uint m: Quantities of rows of A and C
+	* uint n: Quantities of columns of B and C
+	* uint k: Quantities of columns of A and rows of B
+	* float alpha: Value multiplied to A * B
+	* S* A: First value of A
+	* uint rowStrideA: Distance between two rows of A
+	* uint columnStrideA: Distance between two columns of A
+	* S* B: First value of B
+	* uint rowStrideB: Distance between two rows of B
+	* uint columnStrideB: Distance between two columns of B
+	* float beta: Value multiplied to C, when zero C is only written
+	* S* C: First value of C, must not overlap A or B
+	* uint rowStrideC: Distance between two rows of C
+	*/
+	template <typename S>
+	void gemmKernelFloat(uint m, uint n, uint k, float alpha, const S* A, uint rowStrideA, uint columnStrideA, const S* B, uint rowStrideB, uint columnStrideB, float beta, S* C, uint rowStrideC)
+	{
+		const uint MB = 2 * GemmBlocking<float>::MC;
+		const uint KB = GemmBlocking<float>::KC;
+		const uint NB = GemmBlocking<float>::NC / 4;
+
+		if (m == 0 || n == 0)
+			return;
+
+		std::vector<float> blockA(size_t(std::min(MB, m)) * std::min(KB, k));
+		std::vector<float> blockB(size_t(std::min(KB, k)) * std::min(NB, n));
+		std::vector<float> blockC(size_t(std::min(MB, m)) * std::min(NB, n));
+
+		for (uint jc = 0; jc < n; jc += NB)
+		{
+			uint nb = std::min(NB, n - jc);
+
+			for (uint ic = 0; ic < m; ic += MB)
+			{
+				uint mb = std::min(MB, m - ic);
+				S* blockCStorage = C + (size_t(ic) * rowStrideC) + jc;
+
+				if (beta != 0.0f)
+					gemmConvertBlock(mb, nb, static_cast<const S*>(blockCStorage), rowStrideC, 1, blockC.data(), nb);
+
+				if (k == 0 || alpha == 0.0f)
+					gemmKernel(mb, nb, 0, alpha, blockA.data(), 0, 1, blockB.data(), nb, 1, beta, blockC.data(), nb);
+
+				for (uint pc = 0; pc < k && alpha != 0.0f; pc += KB)
+				{
+					uint kb = std::min(KB, k - pc);
+
+					gemmConvertBlock(mb, kb, A + (size_t(ic) * rowStrideA) + (size_t(pc) * columnStrideA), rowStrideA, columnStrideA, blockA.data(), kb);
+					gemmConvertBlock(kb, nb, B + (size_t(pc) * rowStrideB) + (size_t(jc) * columnStrideB), rowStrideB, columnStrideB, blockB.data(), nb);
+					gemmKernel(mb, nb, kb, alpha, blockA.data(), kb, 1, blockB.data(), nb, 1, (pc == 0) ? beta : 1.0f, blockC.data(), nb);
+				}
+
+				gemmConvertBlock(mb, nb, static_cast<const float*>(blockC.data()), nb, 1, blockCStorage, rowStrideC);
+			}
+		}
+	}
+
+	/*! gemmConvertBlock
+	* Copy a block converting its values, the lines in parallel and by the bulk conversions when the columns are contiguous
+	* uint rows: Quantities of rows of the block
+	* uint columns: Quantities of columns of the block
+	* S* A: First value of the block
+	* uint rowStrideA: Distance between two rows of A
+	* uint columnStrideA: Distance between two columns of A
+	* U* B: First value of the copy
+	* uint rowStrideB: Distance between two rows of B
+	*/
+	template <typename S, typename U>
+	void gemmConvertBlock(uint rows, uint columns, const S* A, uint rowStrideA, uint columnStrideA, U* B, uint rowStrideB)
+	{
+		parallelFor(0, rows, double(rows) * columns, [&](uint from, uint to)
+		{
+			for (uint i = from; i < to; i++)
+			{
+				const S* lineA = A + (size_t(i) * rowStrideA);
+				U* lineB = B + (size_t(i) * rowStrideB);
+
+				if (columnStrideA == 1)
+					convertValues(columns, lineA, lineB);
+				else
+					for (uint j = 0; j < columns; j++)
+						lineB[j] = U(lineA[size_t(j) * columnStrideA]);
+			}
+		});
+	}
+
+	/*! gemmKernel
+	* Calculate C = alpha * A * B + beta * C of half values, accumulating in float (gemmKernelFloat)
+	*/
+	template <>
+	inline void gemmKernel<half>(uint m, uint n, uint k, const half& alpha, const half* A, uint rowStrideA, uint columnStrideA, const half* B, uint rowStrideB, uint columnStrideB, const half& beta, half* C, uint rowStrideC)
+	{
+		gemmKernelFloat(m, n, k, float(alpha), A, rowStrideA, columnStrideA, B, rowStrideB, columnStrideB, float(beta), C, rowStrideC);
+	}
+
+	/*! gemmKernel
+	* Calculate C = alpha * A * B + beta * C of bfloat16 values, accumulating in float (gemmKernelFloat)
+	*/
+	template <>
+	inline void gemmKernel<bfloat16>(uint m, uint n, uint k, const bfloat16& alpha, const bfloat16* A, uint rowStrideA, uint columnStrideA, const bfloat16* B, uint rowStrideB, uint columnStrideB, const bfloat16& beta, bfloat16* C, uint rowStrideC)
+	{
+		gemmKernelFloat(m, n, k, float(alpha), A, rowStrideA, columnStrideA, B, rowStrideB, columnStrideB, float(beta), C, rowStrideC);
+	}
+
+}
+
+#endif
@@ -0,0 +1,298 @@
+#ifndef MATRIX_GEMV_HPP
+#define MATRIX_GEMV_HPP
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include "MatrixEnum.hpp"
+#include "SimdKernels.hpp"
+#include "ThreadPool.hpp"
+#include "MatrixBlas.hpp"
+
+namespace lito {
+
+	/*! GemvBlocking
+	* Sizes of the blocks used by the matrix-vector kernels
+	* MB: Values of y updated together by the column form of gemv, so they stay in L1 while A streams
+	* NB: Size of the diagonal blocks of trsv, the rest of the triangle is applied by gemv
+	*/
+	template <typename T>
+	struct GemvBlocking {
+		static const uint MB = 2048;
+		static const uint NB = 128;
+	};
+
+	template <typename T> void gemvKernel(uint m, uint n, const T& alpha, const T* A, uint rowStrideA, uint columnStrideA, const T* x, uint strideX, const T& beta, T* y, uint strideY);
+	template <typename T> void gerKernel(uint m, uint n, const T& alpha, const T* x, uint strideX, const T* y, uint strideY, T* A, uint rowStrideA, uint columnStrideA);
+	template <typename T> void trsvKernel(uint n, MatrixTriangle triangle, MatrixDiagonal diagonal, const T* A, uint rowStrideA, uint columnStrideA, T* x, uint strideX);
+	template <typename T> void trsvBlock(uint n, MatrixTriangle triangle, MatrixDiagonal diagonal, const T* A, uint rowStrideA, uint columnStrideA, T* x);
+	template <typename T> T* gemvPack(uint n, const T* x, uint strideX, std::vector<T>& pack);
+
+
+
+	/*! gemvKernel
+	* Calculate y = alpha * A * x + beta * y
+	* Rows of A that are contiguous are multiplied to x by the dot kernel, one value of y per row;
+	* columns that are contiguous are added to y by the axpy kernel, MB values of y at a time;
+	* other layouts use a direct loop
+	* With the PARALLEL policy the values of y are split among the threads of the pool
+	* uint m: Quantities of rows of A and values of y
+	* uint n: Quantities of columns of A and values of x
+	* T alpha: Value multiplied to A * x
+	* T* A: First value of A
+	* uint rowStrideA: Distance between two rows of A
+	* uint columnStrideA: Distance between two columns of A
+	* T* x: First value of x
+	* uint strideX: Distance between two values of x
+	* T beta: Value multiplied to y, when zero y is only written
+	* T* y: First value of y, must not overlap A or x
+	* uint strideY: Distance between two values of y
+	*/
+	template <typename T>
+	void gemvKernel(uint m, uint n, const T& alpha, const T* A, uint rowStrideA, uint columnStrideA, const T* x, uint strideX, const T& beta, T* y, uint strideY)
+	{
+		if (m == 0)
+			return;
+
+		if (beta == T(0))
+			for (uint i = 0; i < m; i++)
+				y[size_t(i) * strideY] = T(0);
+		else if (beta != T(1))
+			for (uint i = 0; i < m; i++)
+				y[size_t(i) * strideY] *= beta;
+
+		if (n == 0 || alpha == T(0))
+			return;
+
+		const double work = double(m) * double(n);
+
+		if (columnStrideA == 1 && (rowStrideA != 1 || n >= m))
+		{
+			std::vector<T> packX;
+			const T* vectorX = (strideX == 1) ? x : gemvPack(n, x, strideX, packX);
+			T (*dot)(uint, const T*, const T*) = simdKernels<T>().dot;
+
+			parallelFor(0, m, work, [&](uint from, uint to)
+			{
+				for (uint i = from; i < to; i++)
+					y[size_t(i) * strideY] += alpha * dot(n, A + (size_t(i) * rowStrideA), vectorX);
+			});
+		}
+		else if (rowStrideA == 1)
+		{
+			const uint MB = GemvBlocking<T>::MB;
+			std::vector<T> packY;
+			T* vectorY = (strideY == 1) ? y : gemvPack(m, y, strideY, packY);
+			void (*axpy)(uint, T, const T*, T*) = simdKernels<T>().axpy;
+
+			parallelFor(0, m, work, [&](uint from, uint to)
+			{
+				for (uint ib = from; ib < to; ib += MB)
+				{
+					uint mb = std::min(MB, to - ib);
+
+					for (uint j = 0; j < n; j++)
+						axpy(mb, alpha * x[size_t(j) * strideX], A + (size_t(j) * columnStrideA) + ib, vectorY + ib);
+				}
+			});
+
+			if (strideY != 1)
+				for (uint i = 0; i < m; i++)
+					y[size_t(i) * strideY] = vectorY[i];
+		}
+		else
+		{
+			parallelFor(0, m, work, [&](uint from, uint to)
+			{
+				for (uint i = from; i < to; i++)
+				{
+					const T* line = A + (size_t(i) * rowStrideA);
+					T sum = T(0);
+
+					for (uint j = 0; j < n; j++)
+						sum += line[size_t(j) * columnStrideA] * x[size_t(j) * strideX];
+
+					y[size_t(i) * strideY] += alpha * sum;
+				}
+			});
+		}
+	}
+
+	/*! gerKernel
+	* Calculate A = alpha * x * y^T + A, the rank-1 update
+	* Contiguous rows of A receive y by the axpy kernel, contiguous columns receive x
+	* With the PARALLEL policy the rows, or the columns, are split among the threads of the pool
+	* uint m: Quantities of rows of A and values of x
+	* uint n: Quantities of columns of A and values of y
+	* T alpha: Value multiplied to x * y^T
+	* T* x: First value of x, must not overlap A
+	* uint strideX: Distance between two values of x
+	* T* y: First value of y, must not overlap A
+	* uint strideY: Distance between two values of y
+	* T* A: First value of A
+	* uint rowStrideA: Distance between two rows of A
+	* uint columnStrideA: Distance between two columns of A
+	*/
+	template <typename T>
+	void gerKernel(uint m, uint n, const T& alpha, const T* x, uint strideX, const T* y, uint strideY, T* A, uint rowStrideA, uint columnStrideA)
+	{
+		if (m == 0 || n == 0 || alpha == T(0))
+			return;
+
+		const double work = double(m) * double(n);
+		void (*axpy)(uint, T, const T*, T*) = simdKernels<T>().axpy;
+
+		if (columnStrideA == 1 && (rowStrideA != 1 || n >= m))
+		{
+			std::vector<T> packY;
+			const T* vectorY = (strideY == 1) ? y : gemvPack(n, y, strideY, packY);
+
+			parallelFor(0, m, work, [&](uint from, uint to)
+			{
+				for (uint i = from; i < to; i++)
+					axpy(n, alpha * x[size_t(i) * strideX], vectorY, A + (size_t(i) * rowStrideA));
+			});
+		}
+		else if (rowStrideA == 1)
+		{
+			std::vector<T> packX;
+			const T* vectorX = (strideX == 1) ? x : gemvPack(m, x, strideX, packX);
+
+			parallelFor(0, n, work, [&](uint from, uint to)
+			{
+				for (uint j = from; j < to; j++)
+					axpy(m, alpha * y[size_t(j) * strideY], vectorX, A + (size_t(j) * columnStrideA));
+			});
+		}
+		else
+		{
+			parallelFor(0, m, work, [&](uint from, uint to)
+			{
+				for (uint i = from; i < to; i++)
+				{
+					const T a = alpha * x[size_t(i) * strideX];
+					T* line = A + (size_t(i) * rowStrideA);
+
+					for (uint j = 0; j < n; j++)
+						line[size_t(j) * columnStrideA] += a * y[size_t(j) * strideY];
+				}
+			});
+		}
+	}
+
+	/*! trsvKernel
+	* Solve A * x = b writing x over b, for a triangular A
+	* The triangle is walked in diagonal blocks of NB: the values of x already solved are applied to the
+	* next block by gemvKernel, so most of the work runs in the dot or axpy kernels and in parallel,
+	* and only the diagonal block is solved value by value
+	* When the build has a system CBLAS, float and double systems go to it
+	* The diagonal is not checked, a zero gives infinities as in the division
+	* uint n: Quantities of rows and columns of A and values of x
+	* MatrixTriangle triangle: LOWER or UPPER, the values of the other triangle are not read
+	* MatrixDiagonal diagonal: NON_UNIT, or UNIT to take the diagonal as ones without reading it
+	* T* A: First value of A
+	* uint rowStrideA: Distance between two rows of A
+	* uint columnStrideA: Distance between two columns of A
+	* T* x: First value of b, replaced by x, must not overlap A
+	* uint strideX: Distance between two values of x
+	*/
+	template <typename T>
+	void trsvKernel(uint n, MatrixTriangle triangle, MatrixDiagonal diagonal, const T* A, uint rowStrideA, uint columnStrideA, T* x, uint strideX)
+	{
+		const uint NB = GemvBlocking<T>::NB;
+
+		if (n == 0 || blasTrsv(n, triangle, diagonal, A, rowStrideA, columnStrideA, x, strideX))
+			return;
+
+		std::vector<T> packX;
+		T* vectorX = (strideX == 1) ? x : gemvPack(n, x, strideX, packX);
+
+		if (triangle == MatrixTriangle::LOWER)
+		{
+			for (uint k = 0; k < n; k += NB)
+			{
+				uint kb = std::min(NB, n - k);
+				const T* lineA = A + (size_t(k) * rowStrideA);
+
+				gemvKernel(kb, k, T(-1), lineA, rowStrideA, columnStrideA, vectorX, 1, T(1), vectorX + k, 1);
+				trsvBlock(kb, triangle, diagonal, lineA + (size_t(k) * columnStrideA), rowStrideA, columnStrideA, vectorX + k);
+			}
+		}
+		else
+		{
+			for (uint end = n; end > 0;)
+			{
+				uint kb = std::min(NB, end);
+				uint k = end - kb;
+				const T* lineA = A + (size_t(k) * rowStrideA);
+
+				gemvKernel(kb, n - end, T(-1), lineA + (size_t(end) * columnStrideA), rowStrideA, columnStrideA, vectorX + end, 1, T(1), vectorX + k, 1);
+				trsvBlock(kb, triangle, diagonal, lineA + (size_t(k) * columnStrideA), rowStrideA, columnStrideA, vectorX + k);
+
+				end = k;
+			}
+		}
+
+		if (strideX != 1)
+			for (uint i = 0; i < n; i++)
+				x[size_t(i) * strideX] = vectorX[i];
+	}
+
+	/*! trsvBlock
+	* Solve a triangular block of trsvKernel value by value, each one by a dot with the values already solved
+	* uint n: Quantities of rows and columns of the block
+	* MatrixTriangle triangle: LOWER or UPPER
+	* MatrixDiagonal diagonal: NON_UNIT or UNIT
+	* T* A: First value of the block
+	* uint rowStrideA: Distance between two rows of A
+	* uint columnStrideA: Distance between two columns of A
+	* T* x: The n contiguous values of b, replaced by x
+	*/
+	template <typename T>
+	void trsvBlock(uint n, MatrixTriangle triangle, MatrixDiagonal diagonal, const T* A, uint rowStrideA, uint columnStrideA, T* x)
+	{
+		T (*dot)(uint, const T*, const T*) = simdKernels<T>().dot;
+
+		for (uint step = 0; step < n; step++)
+		{
+			uint i = (triangle == MatrixTriangle::LOWER) ? step : n - step - 1;
+			uint from = (triangle == MatrixTriangle::LOWER) ? 0 : i + 1;
+			uint to = (triangle == MatrixTriangle::LOWER) ? i : n;
+			const T* line = A + (size_t(i) * rowStrideA);
+			T sum = T(0);
+
+			if (columnStrideA == 1)
+				sum = dot(to - from, line + from, x + from);
+			else
+				for (uint j = from; j < to; j++)
+					sum += line[size_t(j) * columnStrideA] * x[j];
+
+			x[i] -= sum;
+
+			if (diagonal == MatrixDiagonal::NON_UNIT)
+				x[i] /= line[size_t(i) * columnStrideA];
+		}
+	}
+
+	/*! gemvPack
+	* Copy n values of a strided vector to contiguous values
+	* uint n: Quantities of values
+	* T* x: First value
+	* uint strideX: Distance between two values
+	* vector<T> pack: Receives the copy
+	* return: The first value of the copy
+	*/
+	template <typename T>
+	T* gemvPack(uint n, const T* x, uint strideX, std::vector<T>& pack)
+	{
+		pack.resize(n);
+
+		for (uint i = 0; i < n; i++)
+			pack[i] = x[size_t(i) * strideX];
+
+		return pack.data();
+	}
+
+}
+
+#endif
@@ -0,0 +1,502 @@
+#ifndef MATRIX_LU_HPP
+#define MATRIX_LU_HPP
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "Matrix.hpp"
+#include "MatrixExpression.hpp"
+#include "MatrixTrsm.hpp"
+
+namespace lito {
+
+	/*! LUBlocking
+	* Size of the blocks used by the LU factorization
+	* NB: Columns of each panel, also the depth of the GEMM of the trailing matrix update
+	* Matrices with fewer than 2 * NB rows are factorized without blocks
+	*/
+	template <typename T>
+	struct LUBlocking {
+		static const uint NB = 128;
+	};
+
+	/*! LUFactorization
+	* Factorization P * A = L * U of a square matrix, computed once and used for many systems
+	* L (unit diagonal) and U are stored together in one matrix, P is kept as a vector of row indices
+	*/
+	template <typename T>
+	class LUFactorization {
+	public:
+		LUFactorization();
+		LUFactorization(Matrix<T>&& lu, std::vector<uint>&& permutation, bool permutationOdd, bool singular);
+
+		const Matrix<T>& getLU() const;
+		const std::vector<uint>& getPermutation() const;
+		const uint& getSize() const;
+		bool isSingular() const;
+
+		Matrix<T> solve(const Matrix<T>& vectorB) const;
+		Matrix<T> solveMany(const Matrix<T>& matrixB) const;
+		Matrix<T>& solveInPlace(Matrix<T>& matrixB) const;
+		T determinant() const;
+		Matrix<T> inverse() const;
+
+	private:
+		void check(const Matrix<T>& matrixB) const;
+		void solveTriangles(Matrix<T>& matrixB) const;
+
+		Matrix<T> _lu;
+		std::vector<uint> _permutation;
+		bool _permutationOdd;
+		bool _singular;
+	};
+
+	template <typename T> bool luFactorPanel(Matrix<T>& M, uint k, uint kb, std::vector<uint>& pivots, const T error);
+	template <typename T> void luSwapLines(Matrix<T>& M, const std::vector<uint>& pivots, uint k, uint kb, uint columnBegin, uint columnEnd);
+	template <typename T> void luSolveLines(Matrix<T>& M, uint k, uint kb, uint columnBegin, uint columnEnd);
+	template <typename T> void luUpdate(Matrix<T>& M, uint k, uint kb, uint columnBegin, uint columnEnd);
+
+	template <typename T> LUFactorization<T> luFactor(Matrix<T>&& M, const T error = T(0));
+	template <typename T> LUFactorization<T> luFactor(const Matrix<T>& M, const T error = T(0));
+	template <typename E> LUFactorization<typename E::ValueType> luFactor(const MatrixExpression<E>& M, const typename E::ValueType error = 0);
+
+
+
+	/*! LUFactorization
+	* Initialize an empty factorization
+	*/
+	template <typename T>
+	LUFactorization<T>::LUFactorization()
+		: _permutationOdd(false)
+		, _singular(true)
+	{}
+
+	/*! LUFactorization
+	* Initialize the factorization with its parts, as computed by luFactor
+	* Matrix<T> lu: L below the diagonal and U on and above it
+	* vector<uint> permutation: Line i of P * A is the line permutation[i] of A
+	* bool permutationOdd: If P has an odd quantities of swaps
+	* bool singular: If a pivot was zero
+	*/
+	template <typename T>
+	LUFactorization<T>::LUFactorization(Matrix<T>&& lu, std::vector<uint>&& permutation, bool permutationOdd, bool singular)
+		: _lu(std::move(lu))
+		, _permutation(std::move(permutation))
+		, _permutationOdd(permutationOdd)
+		, _singular(singular)
+	{}
+
+	/*! getLU
+	* Get L below the diagonal (its unit diagonal is not stored) and U on and above it
+	* return: The factors
+	*/
+	template <typename T>
+	const Matrix<T>& LUFactorization<T>::getLU() const
+	{
+		return _lu;
+	}
+
+	/*! getPermutation
+	* Get the line permutation, line i of P * A is the line permutation[i] of A
+	* return: The permutation
+	*/
+	template <typename T>
+	const std::vector<uint>& LUFactorization<T>::getPermutation() const
+	{
+		return _permutation;
+	}
+
+	/*! getSize
+	* Get the quantities of rows (and columns) of the matrix factorized
+	* return: The size
+	*/
+	template <typename T>
+	const uint& LUFactorization<T>::getSize() const
+	{
+		return _lu.getRows();
+	}
+
+	/*! isSingular
+	* Tell if a pivot was zero, then the systems can not be solved
+	* return: If the matrix is singular
+	*/
+	template <typename T>
+	bool LUFactorization<T>::isSingular() const
+	{
+		return _singular;
+	}
+
+	/*! solve
+	* Solve the system Ax=b
+	* Matrix<T> vectorB: The vector b, or a matrix with one b per column
+	* return: The vector x
+	*/
+	template <typename T>
+	Matrix<T> LUFactorization<T>::solve(const Matrix<T>& vectorB) const
+	{
+		return solveMany(vectorB);
+	}
+
+	/*! solveMany
+	* Solve the systems AX=B, one system per column of B
+	* X is created with the lines of B already permuted, so B is copied only once
+	* Matrix<T> matrixB: The matrix B
+	* return: The matrix X
+	*/
+	template <typename T>
+	Matrix<T> LUFactorization<T>::solveMany(const Matrix<T>& matrixB) const
+	{
+		check(matrixB);
+
+		uint columns = matrixB.getColumns();
+		Matrix<T> matrixX(getSize(), columns, MatrixType::ZEROS, matrixB.getAllocator());
+
+		for (uint i = 0; i < getSize(); i++)
+			std::copy(matrixB.row(_permutation[i]), matrixB.row(_permutation[i]) + columns, matrixX.row(i));
+
+		solveTriangles(matrixX);
+
+		return matrixX;
+	}
+
+	/*! solveInPlace
+	* Solve the systems AX=B writing X over B, in the storage of B
+	* P is applied by following its cycles with line swaps, so no copy of B is made
+	* Matrix<T> matrixB: The matrix B, replaced by X
+	* return: The matrix X
+	*/
+	template <typename T>
+	Matrix<T>& LUFactorization<T>::solveInPlace(Matrix<T>& matrixB) const
+	{
+		check(matrixB);
+
+		uint n = getSize();
+		uint columns = matrixB.getColumns();
+		std::vector<bool> placed(n, false);
+
+		// Line i receives the line _permutation[i]; along a cycle each swap places one line
+		for (uint start = 0; start < n; start++)
+		{
+			uint i = start;
+
+			while (!placed[i] && _permutation[i] != start)
+			{
+				std::swap_ranges(matrixB.row(i), matrixB.row(i) + columns, matrixB.row(_permutation[i]));
+				placed[i] = true;
+				i = _permutation[i];
+			}
+
+			placed[i] = true;
+		}
+
+		solveTriangles(matrixB);
+
+		return matrixB;
+	}
+
+	/*! determinant
+	* Calculate the determinant of A, the product of the pivots
+	* return: The determinant, zero when singular
+	*/
+	template <typename T>
+	T LUFactorization<T>::determinant() const
+	{
+		if (_lu.getRows() == 0)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+
+		if (_singular)
+			return T(0);
+
+		T deter = _permutationOdd ? T(-1) : T(1);
+
+		for (uint i = 0; i < getSize(); i++)
+			deter *= _lu.row(i)[i];
+
+		return deter;
+	}
+
+	/*! inverse
+	* Calculate the inverse of A solving AX=I
+	* return: The inverse
+	*/
+	template <typename T>
+	Matrix<T> LUFactorization<T>::inverse() const
+	{
+		return solveMany(Matrix<T>(getSize(), getSize(), MatrixType::IDENTITY));
+	}
+
+	/*! check
+	* Check if the systems with B can be solved
+	* Matrix<T> matrixB: The matrix B
+	*/
+	template <typename T>
+	void LUFactorization<T>::check(const Matrix<T>& matrixB) const
+	{
+		if (_lu.getRows() == 0 || matrixB.getRows() * matrixB.getColumns() == 0)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+		else if (matrixB.getRows() != getSize())
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, getSize(), getSize(), matrixB.getRows(), matrixB.getColumns(), 'X'));
+		else if (_singular)
+			throw(MatrixException(MatrixExceptionType::SINGULAR_MATRIX));
+	}
+
+	/*! solveTriangles
+	* Solve LUX=B writing X over B, whose lines are already permuted
+	* L and U are applied by the blocked triangular solve trsmKernel, mostly GEMM
+	* With the PARALLEL policy the columns of B, or the lines of a single column, are split among the threads
+	* Matrix<T> matrixB: The matrix P * B, replaced by X
+	*/
+	template <typename T>
+	void LUFactorization<T>::solveTriangles(Matrix<T>& matrixB) const
+	{
+		uint n = getSize();
+		uint columns = matrixB.getColumns();
+
+		trsmKernel(MatrixSide::LEFT, MatrixTriangle::LOWER, MatrixDiagonal::UNIT, n, columns, T(1), _lu.data(), _lu.getStride(), 1, matrixB.data(), matrixB.getStride());
+		trsmKernel(MatrixSide::LEFT, MatrixTriangle::UPPER, MatrixDiagonal::NON_UNIT, n, columns, T(1), _lu.data(), _lu.getStride(), 1, matrixB.data(), matrixB.getStride());
+	}
+
+	/*! luFactorPanel
+	* Factorize the panel of the columns [k, k + kb) and the lines [k, rows) by Gauss reduction with partial pivoting
+	* Only the columns of the panel are switched, luSwapLines switches the others later
+	* Matrix<T> M: The matrix in factorization, the columns before k are already factorized
+	* uint k: First column of the panel
+	* uint kb: Quantities of columns of the panel
+	* vector<uint> pivots: Receives, for each line i of the panel, the line switched with it
+	* T error: Pivots with absolute value up to error mark the matrix as singular
+	* return: If a pivot was singular
+	*/
+	template <typename T>
+	bool luFactorPanel(Matrix<T>& M, uint k, uint kb, std::vector<uint>& pivots, const T error)
+	{
+		uint n = M.getRows();
+		uint end = k + kb;
+		bool singular = false;
+
+		for (uint j = k; j < end; j++)
+		{
+			uint pivot = j;
+			T valueMaxPivot = T(std::abs(M.row(j)[j]));
+
+			for (uint i = j + 1; i < n; i++)
+			{
+				T valueAuxPivot = T(std::abs(M.row(i)[j]));
+
+				if (valueMaxPivot < valueAuxPivot)
+				{
+					valueMaxPivot = valueAuxPivot;
+					pivot = i;
+				}
+			}
+
+			if (valueMaxPivot <= error)
+			{
+				pivots[j] = j;
+				singular = true;
+				continue;
+			}
+
+			pivots[j] = pivot;
+
+			if (pivot != j)
+				std::swap_ranges(M.row(j) + k, M.row(j) + end, M.row(pivot) + k);
+
+			const T* lineJ = M.row(j);
+			const T pivotIverse = T(1) / lineJ[j];
+
+			// The lines below the pivot are independent, so they are eliminated in parallel
+			parallelFor(j + 1, n, 2.0 * double(n - j - 1) * (end - j - 1), [&](uint from, uint to)
+			{
+				for (uint i = from; i < to; i++)
+				{
+					T* lineI = M.row(i);
+					T mulLine = lineI[j] * pivotIverse;
+
+					lineI[j] = mulLine;
+
+					if (mulLine != T(0))
+						simdKernels<T>().axpy(end - j - 1, -mulLine, lineJ + j + 1, lineI + j + 1);
+				}
+			});
+		}
+
+		return singular;
+	}
+
+	/*! luSwapLines
+	* Switch the lines chosen by the pivots of a panel in a range of columns out of it
+	* Matrix<T> M: The matrix in factorization
+	* vector<uint> pivots: The line switched with each line of the panel
+	* uint k: First column (and line) of the panel
+	* uint kb: Quantities of columns of the panel
+	* uint columnBegin: First column
+	* uint columnEnd: Column after the last
+	*/
+	template <typename T>
+	void luSwapLines(Matrix<T>& M, const std::vector<uint>& pivots, uint k, uint kb, uint columnBegin, uint columnEnd)
+	{
+		if (columnBegin >= columnEnd)
+			return;
+
+		for (uint j = k; j < k + kb; j++)
+			if (pivots[j] != j)
+				std::swap_ranges(M.row(j) + columnBegin, M.row(j) + columnEnd, M.row(pivots[j]) + columnBegin);
+	}
+
+	/*! luSolveLines
+	* Calculate the lines of U right of a panel, solving L11 * U12 = A12 with the unit lower triangle of the panel
+	* Matrix<T> M: The matrix in factorization
+	* uint k: First column (and line) of the panel
+	* uint kb: Quantities of columns of the panel
+	* uint columnBegin: First column
+	* uint columnEnd: Column after the last
+	*/
+	template <typename T>
+	void luSolveLines(Matrix<T>& M, uint k, uint kb, uint columnBegin, uint columnEnd)
+	{
+		// Each column only depends on itself, so the columns are solved in parallel
+		parallelFor(columnBegin, columnEnd, double(kb) * kb * (columnEnd - columnBegin), [&](uint from, uint to)
+		{
+			for (uint i = k + 1; i < k + kb; i++)
+			{
+				const T* lineL = M.row(i);
+				T* lineI = M.row(i) + from;
+
+				for (uint j = k; j < i; j++)
+					if (lineL[j] != T(0))
+						simdKernels<T>().axpy(to - from, -lineL[j], M.row(j) + from, lineI);
+			}
+		});
+	}
+
+	/*! luUpdate
+	* Update the trailing matrix below the lines of U of a panel, A22 = A22 - L21 * U12, by the GEMM kernel
+	* Matrix<T> M: The matrix in factorization
+	* uint k: First column (and line) of the panel
+	* uint kb: Quantities of columns of the panel
+	* uint columnBegin: First column
+	* uint columnEnd: Column after the last
+	*/
+	template <typename T>
+	void luUpdate(Matrix<T>& M, uint k, uint kb, uint columnBegin, uint columnEnd)
+	{
+		uint next = k + kb;
+
+		if (next >= M.getRows() || columnBegin >= columnEnd)
+			return;
+
+		gemmKernel(M.getRows() - next, columnEnd - columnBegin, kb, T(-1),
+		           M.row(next) + k, M.getStride(), 1,
+		           M.row(k) + columnBegin, M.getStride(), 1,
+		           T(1), M.row(next) + columnBegin, M.getStride());
+	}
+
+	/*! luFactor
+	* Calculate P * A = L * U by Gauss reduction with partial pivoting in the storage of the matrix
+	* The row operations are kept in L and in the permutation instead of extra matrices
+	* Big matrices are factorized by panels of NB columns, right-looking: after each panel the lines of U
+	* right of it are solved and the trailing matrix is updated by the GEMM kernel
+	* With the PARALLEL policy the next panel is updated and factorized while the rest of the trailing
+	* matrix is updated (lookahead), so the panel factorization is not left alone on one core
+	* When the build has a system LAPACKE, float and double matrices are factorized by it
+	* Matrix<T> M: The square matrix A, its storage is taken by the factorization
+	* T error: Pivots with absolute value up to error mark the matrix as singular
+	* return: The factorization
+	*/
+	template <typename T>
+	LUFactorization<T> luFactor(Matrix<T>&& M, const T error)
+	{
+		if (M.getRows() * M.getColumns() == 0)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+		else if (M.getRows() != M.getColumns())
+			throw(MatrixException(MatrixExceptionType::INVALID_SIZE, M.getRows(), M.getColumns()));
+
+		uint n = M.getRows();
+		uint nb = (n < 2 * LUBlocking<T>::NB) ? n : LUBlocking<T>::NB;
+		std::vector<uint> pivots(n);
+		std::vector<uint> permutation(n);
+		bool permutationOdd = false;
+		bool singular = false;
+
+		// A system LAPACK factorizes the whole matrix, the pivots give the same permutation
+		if (lapackGetrf(n, M.data(), M.getStride(), pivots.data()))
+		{
+			for (uint i = 0; i < n; i++)
+				if (std::abs(M.row(i)[i]) <= error)
+					singular = true;
+		}
+		else
+		{
+			singular = luFactorPanel(M, 0, nb, pivots, error);
+
+			for (uint k = 0; k < n; k += nb)
+			{
+				uint kb = std::min(nb, n - k);
+				uint next = k + kb;
+
+				luSwapLines(M, pivots, k, kb, 0, k);
+				luSwapLines(M, pivots, k, kb, next, n);
+
+				if (next == n)
+					break;
+
+				uint nextKb = std::min(nb, n - next);
+
+				luSolveLines(M, k, kb, next, n);
+
+				// The next panel only needs its own columns updated, the rest of the update runs meanwhile
+				parallelInvoke(2.0 * double(n - next) * (n - next) * kb, [&]()
+				{
+					luUpdate(M, k, kb, next + nextKb, n);
+				}, [&]()
+				{
+					luUpdate(M, k, kb, next, next + nextKb);
+
+					if (luFactorPanel(M, next, nextKb, pivots, error))
+						singular = true;
+				});
+			}
+		}
+
+		for (uint i = 0; i < n; i++)
+			permutation[i] = i;
+
+		for (uint i = 0; i < n; i++)
+		{
+			if (pivots[i] != i)
+			{
+				std::swap(permutation[i], permutation[pivots[i]]);
+				permutationOdd = !permutationOdd;
+			}
+		}
+
+		return LUFactorization<T>(std::move(M), std::move(permutation), permutationOdd, singular);
+	}
+
+	/*! luFactor
+	* Calculate P * A = L * U by Gauss reduction with partial pivoting on a copy of the matrix
+	* Matrix<T> M: The square matrix A
+	* T error: Pivots with absolute value up to error mark the matrix as singular
+	* return: The factorization
+	*/
+	template <typename T>
+	LUFactorization<T> luFactor(const Matrix<T>& M, const T error)
+	{
+		return luFactor(Matrix<T>(M), error);
+	}
+
+	/*! luFactor
+	* Calculate P * A = L * U of an expression or a view, evaluated once into the factorization
+	* MatrixExpression<E> M: The square matrix A
+	* T error: Pivots with absolute value up to error mark the matrix as singular
+	* return: The factorization
+	*/
+	template <typename E>
+	LUFactorization<typename E::ValueType> luFactor(const MatrixExpression<E>& M, const typename E::ValueType error)
+	{
+		return luFactor(Matrix<typename E::ValueType>(M), error);
+	}
+
+}
+
+#endif
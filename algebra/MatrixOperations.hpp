@@ -2,6 +2,10 @@
 #define MATRIX_OPERATIONS_HPP
 
 #include "Matrix.hpp"
+#include "MatrixLU.hpp"
+#include "MatrixRefinement.hpp"
+#include "MatrixTrsm.hpp"
+#include "MatrixView.hpp"
 
 namespace lito {
 
@@ -10,7 +14,7 @@ namespace lito {
     template <typename T> Matrix<T> gaussReduction(const Matrix<T>& M, Matrix<T>& rowOperations, Matrix<T>& columnOperations, const T error = T(1e-5));
     template <typename T> Matrix<T> gaussJordanReduction(const Matrix<T>& M, Matrix<T>& rowOperations, Matrix<T>& columnOperations, const T error = T(1e-5));
 
-    template <typename T> Matrix<T> systemResoltionGauss(const Matrix<T>& M, const Matrix<T>& vectorB, const T error = T(1e-5));
+    template <typename T> Matrix<T> systemResoltionGauss(const Matrix<T>& M, const Matrix<T>& vectorB, const T error = T(1e-5), GaussMethod method = GaussMethod::REDUCTION);
     template <typename T> Matrix<T> systemResoltionGaussJordan(const Matrix<T>& M, const Matrix<T>& vectorB, const T error = T(1e-5));
 
 
@@ -25,17 +29,15 @@ namespace lito {
     template <typename T>
     void partialPivoting(Matrix<T>& M, Matrix<T>& rowOperations, const uint& idLine, const uint& idcolumn, const T error)
     {
-        if (M(idLine, idcolumn) <= error)
+        if (M.row(idLine)[idcolumn] <= error)
         {
             T valueAuxPivot;
             T  valueMaxPivot = T(0);
             uint idMaxPivot;
-            uint idMaxPivotLine;
-            uint idMaxPivotColumn;
 
             for (uint j = idLine + 1; j < M.getRows(); j++)
             {
-                valueAuxPivot = T(std::abs(M(j, idcolumn)));
+                valueAuxPivot = T(std::abs(M.row(j)[idcolumn]));
                 if (error < valueAuxPivot && valueMaxPivot < valueAuxPivot)
                 {
                     valueMaxPivot = valueAuxPivot;
@@ -63,18 +65,17 @@ namespace lito {
     template <typename T>
     void totalPivoting(Matrix<T>& M, Matrix<T>& rowOperation, Matrix<T>& columnOperation, const uint& idLine, const uint& idcolumn, const T error)
     {
-        if (M(idLine, idcolumn) <= error)
+        if (M.row(idLine)[idcolumn] <= error)
         {
             T valueAuxPivot;
             T  valueMaxPivot = T(0);
             uint idMaxPivot;
             uint idMaxPivotLine;
             uint idMaxPivotColumn;
-            uint auxColumnOrder;
 
             for (uint j = idLine + 1; j < M.getRows(); j++)
             {
-                valueAuxPivot = T(std::abs(M(j, idcolumn)));
+                valueAuxPivot = T(std::abs(M.row(j)[idcolumn]));
                 if (error < valueAuxPivot && valueMaxPivot < valueAuxPivot)
                 {
                     valueMaxPivot = valueAuxPivot;
@@ -89,9 +90,11 @@ namespace lito {
             }
             else
             {
+                const T* pivotLine = M.row(idLine);
+
                 for (uint j = idcolumn + 1; j < M.getColumns(); j++)
                 {
-                    valueAuxPivot = T(std::abs(M(idLine, j)));
+                    valueAuxPivot = T(std::abs(pivotLine[j]));
                     if (error < valueAuxPivot && valueMaxPivot < valueAuxPivot)
                     {
                         valueMaxPivot = valueAuxPivot;
@@ -108,9 +111,11 @@ namespace lito {
                 {
                     for (uint j = idLine + 1; j < M.getRows(); j++)
                     {
+                        const T* line = M.row(j);
+
                         for (uint k = idcolumn + 1; k < M.getColumns(); k++)
                         {
-                            valueAuxPivot = T(std::abs(M(j, k)));
+                            valueAuxPivot = T(std::abs(line[k]));
                             if (error < valueAuxPivot && valueMaxPivot < valueAuxPivot)
                             {
                                 valueMaxPivot = valueAuxPivot;
@@ -123,10 +128,10 @@ namespace lito {
                     if (valueMaxPivot > error)
                     {
                         M.elementarOperationSwitchLines(idLine, idMaxPivotLine);
-                        rowOperation.elementarOperationSwitchLines(idLine, idMaxPivot);
+                        rowOperation.elementarOperationSwitchLines(idLine, idMaxPivotLine);
 
                         M.elementarOperationSwitchColumns(idcolumn, idMaxPivotColumn);
-                        columnOperation.elementarOperationSwitchColumns(idcolumn, idMaxPivot);
+                        columnOperation.elementarOperationSwitchColumns(idcolumn, idMaxPivotColumn);
                     }
                 }
             }
@@ -145,23 +150,33 @@ namespace lito {
     {
         Matrix<T> reduction = M;
         columnOperations = rowOperations = Matrix<T>(reduction.getRows(), reduction.getColumns(), MatrixType::IDENTITY);
-        T mulLine;
 
         for (uint i = 0; i < reduction.getRows(); i++)
         {
             totalPivoting(reduction, rowOperations, columnOperations, i, i, error);
             
-            if (std::abs(reduction(i, i) > error))
+            if (T(std::abs(reduction.row(i)[i])) > error)
             {
-                for (uint j = i + 1; j < reduction.getRows(); j++)
+                const T pivot = reduction.row(i)[i];
+
+                // The rows below the pivot are independent, so they are eliminated in parallel
+                parallelFor(i + 1, reduction.getRows(), 2.0 * double(reduction.getRows() - i - 1) * reduction.getColumns(), [&](uint from, uint to)
                 {
-                    if (T(std::abs(reduction(j, i))) > error)
+                    T mulLine;
+
+                    for (uint j = from; j < to; j++)
                     {
-                        mulLine = -(reduction(j, i) / reduction(i, i));
-                        reduction.elementarOperationSumLines(i, j, mulLine);
-                        rowOperations.elementarOperationSumLines(i, j, mulLine);
+                        if (T(std::abs(reduction.row(j)[i])) > error)
+                        {
+                            mulLine = -(reduction.row(j)[i] / pivot);
+                            reduction.elementarOperationSumLines(i, j, mulLine);
+                            rowOperations.elementarOperationSumLines(i, j, mulLine);
+
+                            // The fused multiply-add of the kernels can leave a rounding remainder under the pivot
+                            reduction.row(j)[i] = T(0);
+                        }
                     }
-                }
+                });
             }
             else
             {
@@ -194,7 +209,7 @@ namespace lito {
         for (uint i = 0; i < reduction.getRows(); i++)
         {
             line = reduction.getRows() - i - 1;
-            actualMulLine = reduction(line, line);
+            actualMulLine = reduction.row(line)[line];
 
             if (T(std::abs(actualMulLine)) > error)
             {
@@ -204,7 +219,7 @@ namespace lito {
                 for (uint j = i + 1; j < reduction.getRows(); j++)
                 {
                     lineAux = reduction.getRows() - j - 1;
-                    mulLine = -reduction(lineAux, line);
+                    mulLine = -reduction.row(lineAux)[line];
 
                     if (T(std::abs(mulLine)) > error)
                     {
@@ -219,14 +234,30 @@ namespace lito {
 
     /*! systemResoltionGauss
     * Calculate the system Ax=b by Gauss reduction
+    * With GaussMethod::LU the blocked LU factorization is used, faster for big systems,
+    * then a singular A throws SINGULAR_MATRIX
+    * With GaussMethod::MIXED A is factorized in float and x refined in T (solveMixedPrecision),
+    * the LU in T is only used when the refinement stalls
     * Matrix<T> M: The matrix A
     * Matrix<T> vectorB: The vector b
     * T error: The error value
+    * GaussMethod method: REDUCTION (default), LU or MIXED
     * return: The vector x
     */
     template <typename T>
-    Matrix<T> systemResoltionGauss(const Matrix<T>& M, const Matrix<T>& vectorB, const T error)
+    Matrix<T> systemResoltionGauss(const Matrix<T>& M, const Matrix<T>& vectorB, const T error, GaussMethod method)
     {
+        if (method == GaussMethod::LU)
+            return luFactor(M, error).solve(vectorB);
+
+        if (method == GaussMethod::MIXED)
+        {
+            Matrix<T> vectorX;
+
+            solveMixedPrecision(M, vectorB, vectorX, RefinementSettings<T>(30, T(0), T(0.5), error));
+            return vectorX;
+        }
+
         Matrix<T> matrixReduction;
         Matrix<T> rowsOperations;
         Matrix<T> columnsOperations;
@@ -235,27 +266,41 @@ namespace lito {
 
         uint rowCalculated;
         uint columnCalculated;
+        uint columnsB = vectorB.getColumns();
 
         matrixReduction = gaussReduction(M, rowsOperations, columnsOperations, error);
-        vectorReduction = ((rowsOperations * vectorB).transpose() * columnsOperations).transpose();
+        vectorReduction = rowsOperations * vectorB;
+
+        // The reduced matrix is upper triangular, all the columns of b are solved at once by the blocked triangular solve
+        if (matrixReduction.getRows() == matrixReduction.getColumns())
+        {
+            trsmKernel(MatrixSide::LEFT, MatrixTriangle::UPPER, MatrixDiagonal::NON_UNIT, matrixReduction.getRows(), columnsB, T(1),
+                       matrixReduction.data(), matrixReduction.getStride(), 1, vectorReduction.data(), vectorReduction.getStride());
+
+            return columnsOperations * vectorReduction;
+        }
 
         for (uint i = 0; i < matrixReduction.getRows(); i++)
         {
             rowCalculated = matrixReduction.getRows() - i - 1;
-            
+
+            const T* lineReduction = matrixReduction.row(rowCalculated);
+            T* lineVector = vectorReduction.row(rowCalculated);
+            T* lineReturn = vectorReturn.row(rowCalculated);
+
+            // Each line of x already calculated is subtracted from the line of b as a whole
             for (uint j = 0; j < i; j++)
             {
                 columnCalculated = matrixReduction.getColumns() - j - 1;
-
-                for (uint k = 0; k < vectorReduction.getColumns(); k++)
-                    vectorReduction(rowCalculated, k) -= matrixReduction(rowCalculated, columnCalculated) * vectorReturn(columnCalculated, k);
+                simdKernels<T>().axpy(columnsB, -lineReduction[columnCalculated], vectorReturn.row(columnCalculated), lineVector);
             }
 
-            for (uint k = 0; k < vectorReduction.getColumns(); k++)
-                vectorReturn(rowCalculated, k) = vectorReduction(rowCalculated, k) / matrixReduction(rowCalculated, rowCalculated);
+            for (uint k = 0; k < columnsB; k++)
+                lineReturn[k] = lineVector[k] / lineReduction[rowCalculated];
         }
 
-        return vectorReturn;
+        // The columns switched by the pivoting are the lines of x switched
+        return columnsOperations * vectorReturn;
     }
 
     /*! systemResoltionGaussJordan
@@ -272,7 +317,9 @@ namespace lito {
         Matrix<T> columnsOperations;
 
         gaussJordanReduction(M, rowsOperations, columnsOperations, error);
-        return ((rowsOperations * vectorB).transpose() * columnsOperations).transpose();
+
+        // The columns switched by the pivoting are the lines of x switched, as in systemResoltionGauss
+        return columnsOperations * (rowsOperations * vectorB);
     }
 
 }
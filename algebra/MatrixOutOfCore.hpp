@@ -0,0 +1,1475 @@
+#ifndef MATRIX_OUT_OF_CORE_HPP
+#define MATRIX_OUT_OF_CORE_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <algorithm>
+#include <utility>
+#include "Matrix.hpp"
+#include "MatrixView.hpp"
+#include "MatrixLU.hpp"
+
+namespace lito {
+
+	template <typename T> class TiledMatrix;
+	template <typename T> class TileHandle;
+
+	/*! TileCache
+	* Bounded cache of the tiles of the TiledMatrix that use it, the only memory they take
+	* The tiles are kept while there is room in the budget and the least recently used tile not in use is
+	* evicted, written back to its file first when it was modified
+	* A thread of the cache loads the tiles asked by prefetch() while the tiles in use are calculated,
+	* so the calculation and the disk overlap; the prefetch only uses room that is free or held by tiles
+	* not modified, it never waits for a write
+	*/
+	template <typename T>
+	class TileCache {
+	public:
+		explicit TileCache(size_t budget);
+		TileCache(const TileCache<T>&) = delete;
+		TileCache<T>& operator = (const TileCache<T>&) = delete;
+		~TileCache();
+
+		const size_t& getBudget() const;
+		size_t getUsed() const;
+		size_t getReadTiles() const;
+		size_t getWrittenTiles() const;
+
+		void reserve(size_t bytes);
+		void unreserve(size_t bytes);
+
+	private:
+		enum class TileState { LOADING, READY, WRITING };
+		typedef std::pair<uintptr_t, size_t> Key;
+
+		struct Entry {
+			const TiledMatrix<T>* owner;
+			std::vector<T> data;
+			uint pins;
+			bool dirty;
+			TileState state;
+			typename std::list<Key>::iterator lru;
+		};
+
+		T* acquire(const TiledMatrix<T>* owner, size_t index, bool load);
+		void release(const TiledMatrix<T>* owner, size_t index, bool dirty);
+		void prefetch(const TiledMatrix<T>* owner, size_t index);
+		void flush(const TiledMatrix<T>* owner);
+		void drop(const TiledMatrix<T>* owner);
+
+		bool evict(std::unique_lock<std::mutex>& lock, bool clean);
+		bool hasRoom(std::unique_lock<std::mutex>& lock, size_t bytes);
+		void prefetchLoop();
+
+		static Key key(const TiledMatrix<T>* owner, size_t index);
+
+		size_t _budget;
+		size_t _used;
+		size_t _reserved;
+		size_t _readTiles;
+		size_t _writtenTiles;
+		std::map<Key, Entry> _entries;
+		std::list<Key> _lru;
+		std::deque<std::pair<const TiledMatrix<T>*, size_t>> _requests;
+		mutable std::mutex _mutex;
+		std::condition_variable _changed;
+		std::condition_variable _requested;
+		bool _stop;
+		std::thread _prefetcher;
+
+		friend class TiledMatrix<T>;
+		friend class TileHandle<T>;
+	};
+
+	/*! TileHandle
+	* A tile of a TiledMatrix kept in the cache while the handle lives
+	* Handles got by TiledMatrix::write give values() and mark the tile modified, the others only view()
+	*/
+	template <typename T>
+	class TileHandle {
+	public:
+		TileHandle(const TiledMatrix<T>& matrix, uint line, uint column, bool write, bool load);
+		TileHandle(const TileHandle<T>&) = delete;
+		TileHandle(TileHandle<T>&& moveHandle) noexcept;
+		TileHandle<T>& operator = (const TileHandle<T>&) = delete;
+		~TileHandle();
+
+		ConstMatrixView<T> view() const;
+		MatrixView<T> values() const;
+
+		const uint& getRows() const;
+		const uint& getColumns() const;
+		const uint& getStride() const;
+		T* data() const;
+
+	private:
+		const TiledMatrix<T>* _matrix;
+		size_t _index;
+		T* _data;
+		uint _rows;
+		uint _columns;
+		uint _stride;
+		bool _write;
+	};
+
+	/*! TiledMatrix
+	* Matrix stored in a file as square tiles of tileSize x tileSize values, tile after tile line by line,
+	* read and written through a TileCache, so its size is limited by the disk and not by the memory
+	* The tiles of the borders are stored with the full size, filled with zeros
+	* The file is created (replaced) by the constructor and kept after the destructor, that writes back the tiles modified
+	*/
+	template <typename T>
+	class TiledMatrix {
+	public:
+		TiledMatrix(TileCache<T>& cache, const std::string& path, uint rows, uint columns, uint tileSize = 1024);
+		TiledMatrix(const TiledMatrix<T>&) = delete;
+		TiledMatrix<T>& operator = (const TiledMatrix<T>&) = delete;
+		~TiledMatrix();
+
+		const uint& getRows() const;
+		const uint& getColumns() const;
+		const uint& getTileSize() const;
+		const uint& getTileRows() const;
+		const uint& getTileColumns() const;
+		uint rowsOfTile(uint line) const;
+		uint columnsOfTile(uint column) const;
+		size_t getTileBytes() const;
+		TileCache<T>& getCache() const;
+
+		TileHandle<T> read(uint line, uint column) const;
+		TileHandle<T> write(uint line, uint column, bool load = true);
+		void prefetch(uint line, uint column) const;
+		void flush();
+
+		void assign(const ConstMatrixView<T>& values);
+		void copyTo(MatrixView<T> values) const;
+
+	private:
+		void readTile(size_t index, T* data) const;
+		void writeTile(size_t index, const T* data) const;
+		void seek(size_t index) const;
+
+		TileCache<T>* _cache;
+		std::FILE* _file;
+		mutable std::mutex _fileMutex;
+		uint _rows;
+		uint _columns;
+		uint _tileSize;
+		uint _tileRows;
+		uint _tileColumns;
+
+		friend class TileCache<T>;
+		friend class TileHandle<T>;
+	};
+
+	/*! TiledLUFactorization
+	* Factorization P * A = L * U of a TiledMatrix, L (unit diagonal) and U stored in the tiles of A
+	* The TiledMatrix must live while the factorization is used
+	*/
+	template <typename T>
+	class TiledLUFactorization {
+	public:
+		TiledLUFactorization(const TiledMatrix<T>& lu, std::vector<uint>&& permutation, bool permutationOdd, bool singular);
+
+		const TiledMatrix<T>& getLU() const;
+		const std::vector<uint>& getPermutation() const;
+		bool isSingular() const;
+
+		Matrix<T> solve(const Matrix<T>& matrixB) const;
+		T determinant() const;
+
+	private:
+		const TiledMatrix<T>* _lu;
+		std::vector<uint> _permutation;
+		bool _permutationOdd;
+		bool _singular;
+	};
+
+	template <typename T> void tiledGemm(const T& alpha, const TiledMatrix<T>& A, const TiledMatrix<T>& B, const T& beta, TiledMatrix<T>& C);
+	template <typename T> TiledLUFactorization<T> tiledLUFactor(TiledMatrix<T>& M, const T error = T(0));
+	template <typename T> void tiledSwapLines(TiledMatrix<T>& M, const std::vector<uint>& pivots, uint column, uint lineBegin, uint lineEnd);
+
+
+
+	/*! TileCache
+	* Initialize the cache and start its prefetch thread
+	* size_t budget: Bytes the tiles can take, at least 3 tiles for tiledGemm and 2 columns of tiles plus 1 for tiledLUFactor
+	*/
+	template <typename T>
+	TileCache<T>::TileCache(size_t budget)
+		: _budget(budget)
+		, _used(0)
+		, _reserved(0)
+		, _readTiles(0)
+		, _writtenTiles(0)
+		, _stop(false)
+	{
+		_prefetcher = std::thread(&TileCache<T>::prefetchLoop, this);
+	}
+
+	/*! ~TileCache
+	* Stop the prefetch thread, the TiledMatrix using the cache must be destroyed before
+	*/
+	template <typename T>
+	TileCache<T>::~TileCache()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stop = true;
+		}
+
+		_requested.notify_all();
+		_prefetcher.join();
+	}
+
+	/*! getBudget
+	* Get the bytes the tiles can take
+	* return: The budget
+	*/
+	template <typename T>
+	const size_t& TileCache<T>::getBudget() const
+	{
+		return _budget;
+	}
+
+	/*! getUsed
+	* Get the bytes taken by the tiles in the cache
+	* return: The bytes
+	*/
+	template <typename T>
+	size_t TileCache<T>::getUsed() const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		return _used;
+	}
+
+	/*! getReadTiles
+	* Get the quantities of tiles read from the files since the cache was created
+	* return: The quantities of tiles
+	*/
+	template <typename T>
+	size_t TileCache<T>::getReadTiles() const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		return _readTiles;
+	}
+
+	/*! getWrittenTiles
+	* Get the quantities of tiles written to the files since the cache was created
+	* return: The quantities of tiles
+	*/
+	template <typename T>
+	size_t TileCache<T>::getWrittenTiles() const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		return _writtenTiles;
+	}
+
+	/*! acquire
+	* Get a tile and keep it in the cache until release, loading it when it is not in the cache
+	* Waits while the tile is loaded by the prefetch or written back
+	* const TiledMatrix<T>* owner: The matrix of the tile
+	* size_t index: Index of the tile in the matrix
+	* bool load: Read the tile from the file, otherwise a tile not in the cache is filled with zeros
+	* return: The values of the tile
+	*/
+	template <typename T>
+	T* TileCache<T>::acquire(const TiledMatrix<T>* owner, size_t index, bool load)
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		const Key tileKey = key(owner, index);
+		const size_t bytes = owner->getTileBytes();
+
+		while (true)
+		{
+			typename std::map<Key, Entry>::iterator found = _entries.find(tileKey);
+
+			if (found != _entries.end() && found->second.state == TileState::READY)
+			{
+				Entry& entry = found->second;
+
+				entry.pins++;
+				_lru.splice(_lru.end(), _lru, entry.lru);
+
+				return entry.data.data();
+			}
+			else if (found != _entries.end())
+				_changed.wait(lock);
+			else if (hasRoom(lock, bytes))
+				break;
+		}
+
+		Entry& entry = _entries[tileKey];
+
+		entry.owner = owner;
+		entry.pins = 1;
+		entry.dirty = false;
+		entry.state = TileState::LOADING;
+		_used += bytes;
+
+		lock.unlock();
+
+		try
+		{
+			entry.data.assign(bytes / sizeof(T), T(0));
+
+			if (load)
+				owner->readTile(index, entry.data.data());
+		}
+		catch (...)
+		{
+			lock.lock();
+			_used -= bytes;
+			_entries.erase(tileKey);
+			_changed.notify_all();
+			throw;
+		}
+
+		lock.lock();
+
+		_readTiles += load ? 1 : 0;
+		entry.state = TileState::READY;
+		entry.lru = _lru.insert(_lru.end(), tileKey);
+		_changed.notify_all();
+
+		return entry.data.data();
+	}
+
+	/*! release
+	* Allow a tile got by acquire to be evicted
+	* const TiledMatrix<T>* owner: The matrix of the tile
+	* size_t index: Index of the tile in the matrix
+	* bool dirty: If the tile was modified and must be written back
+	*/
+	template <typename T>
+	void TileCache<T>::release(const TiledMatrix<T>* owner, size_t index, bool dirty)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		Entry& entry = _entries.at(key(owner, index));
+
+		entry.pins--;
+		entry.dirty = entry.dirty || dirty;
+		_changed.notify_all();
+	}
+
+	/*! prefetch
+	* Ask the prefetch thread to load a tile, nothing is done when it is in the cache already
+	* const TiledMatrix<T>* owner: The matrix of the tile
+	* size_t index: Index of the tile in the matrix
+	*/
+	template <typename T>
+	void TileCache<T>::prefetch(const TiledMatrix<T>* owner, size_t index)
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			if (_entries.count(key(owner, index)) != 0)
+				return;
+
+			_requests.emplace_back(owner, index);
+		}
+
+		_requested.notify_one();
+	}
+
+	/*! flush
+	* Write back the modified tiles of a matrix that are not in use
+	* const TiledMatrix<T>* owner: The matrix
+	*/
+	template <typename T>
+	void TileCache<T>::flush(const TiledMatrix<T>* owner)
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		std::vector<Key> keys;
+
+		for (typename std::map<Key, Entry>::iterator it = _entries.lower_bound(key(owner, 0)); it != _entries.end() && it->first.first == key(owner, 0).first; ++it)
+			keys.push_back(it->first);
+
+		for (const Key& tileKey : keys)
+		{
+			typename std::map<Key, Entry>::iterator found = _entries.find(tileKey);
+
+			if (found == _entries.end() || found->second.state != TileState::READY || !found->second.dirty || found->second.pins > 0)
+				continue;
+
+			Entry& entry = found->second;
+
+			entry.state = TileState::WRITING;
+			entry.pins++;
+			lock.unlock();
+
+			try
+			{
+				owner->writeTile(tileKey.second, entry.data.data());
+			}
+			catch (...)
+			{
+				lock.lock();
+				entry.state = TileState::READY;
+				entry.pins--;
+				_changed.notify_all();
+				throw;
+			}
+
+			lock.lock();
+			_writtenTiles++;
+			entry.dirty = false;
+			entry.state = TileState::READY;
+			entry.pins--;
+			_changed.notify_all();
+		}
+	}
+
+	/*! drop
+	* Remove all the tiles of a matrix, the modified ones are lost, and its prefetch requests
+	* const TiledMatrix<T>* owner: The matrix
+	*/
+	template <typename T>
+	void TileCache<T>::drop(const TiledMatrix<T>* owner)
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		const uintptr_t ownerKey = key(owner, 0).first;
+
+		_requests.erase(std::remove_if(_requests.begin(), _requests.end(), [&](const std::pair<const TiledMatrix<T>*, size_t>& request)
+		{
+			return request.first == owner;
+		}), _requests.end());
+
+		_changed.wait(lock, [&]()
+		{
+			for (typename std::map<Key, Entry>::iterator it = _entries.lower_bound(key(owner, 0)); it != _entries.end() && it->first.first == ownerKey; ++it)
+				if (it->second.state != TileState::READY)
+					return false;
+
+			return true;
+		});
+
+		typename std::map<Key, Entry>::iterator it = _entries.lower_bound(key(owner, 0));
+
+		while (it != _entries.end() && it->first.first == ownerKey)
+		{
+			_used -= owner->getTileBytes();
+			_lru.erase(it->second.lru);
+			it = _entries.erase(it);
+		}
+
+		_changed.notify_all();
+	}
+
+	/*! reserve
+	* Take bytes of the budget for memory used out of the cache, evicting tiles when needed
+	* size_t bytes: The bytes
+	*/
+	template <typename T>
+	void TileCache<T>::reserve(size_t bytes)
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+
+		if (bytes > _budget - _reserved)
+			throw(MatrixException(MatrixExceptionType::INVALID_SIZE));
+
+		_reserved += bytes;
+
+		try
+		{
+			while (!hasRoom(lock, 0))
+			{
+			}
+		}
+		catch (...)
+		{
+			_reserved -= bytes;
+			throw;
+		}
+	}
+
+	/*! unreserve
+	* Give back bytes taken by reserve
+	* size_t bytes: The bytes
+	*/
+	template <typename T>
+	void TileCache<T>::unreserve(size_t bytes)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		_reserved -= bytes;
+		_changed.notify_all();
+	}
+
+	/*! evict
+	* Remove the least recently used tile not in use, writing it back when it was modified
+	* std::unique_lock<std::mutex> lock: The lock of the cache, released while the tile is written
+	* bool clean: Only evict tiles not modified
+	* return: If a tile was evicted
+	*/
+	template <typename T>
+	bool TileCache<T>::evict(std::unique_lock<std::mutex>& lock, bool clean)
+	{
+		for (typename std::list<Key>::iterator it = _lru.begin(); it != _lru.end(); ++it)
+		{
+			Entry& entry = _entries.at(*it);
+
+			if (entry.pins > 0 || (clean && entry.dirty))
+				continue;
+
+			const Key tileKey = *it;
+
+			_lru.erase(it);
+
+			if (entry.dirty)
+			{
+				entry.state = TileState::WRITING;
+				lock.unlock();
+
+				try
+				{
+					entry.owner->writeTile(tileKey.second, entry.data.data());
+				}
+				catch (...)
+				{
+					lock.lock();
+					entry.state = TileState::READY;
+					entry.lru = _lru.insert(_lru.begin(), tileKey);
+					_changed.notify_all();
+					throw;
+				}
+
+				lock.lock();
+				_writtenTiles++;
+			}
+
+			_used -= entry.owner->getTileBytes();
+			_entries.erase(tileKey);
+			_changed.notify_all();
+
+			return true;
+		}
+
+		return false;
+	}
+
+	/*! hasRoom
+	* Tell if there is room for more bytes in the budget, otherwise evict a tile or wait for one to be loaded or written
+	* The lock may be released meanwhile, so the caller must check the cache again when there was no room
+	* Throws INVALID_SIZE when all the tiles are in use and nothing is being loaded or written, as the budget is too small
+	* std::unique_lock<std::mutex> lock: The lock of the cache
+	* size_t bytes: The bytes needed
+	* return: If there is room
+	*/
+	template <typename T>
+	bool TileCache<T>::hasRoom(std::unique_lock<std::mutex>& lock, size_t bytes)
+	{
+		if (_used + bytes + _reserved <= _budget)
+			return true;
+		else if (evict(lock, false))
+			return false;
+
+		bool busy = false;
+
+		for (const std::pair<const Key, Entry>& entry : _entries)
+			busy = busy || entry.second.state != TileState::READY;
+
+		if (!busy)
+			throw(MatrixException(MatrixExceptionType::INVALID_SIZE));
+
+		_changed.wait(lock);
+
+		return false;
+	}
+
+	/*! prefetchLoop
+	* Body of the prefetch thread, loads the tiles asked while there is room for them
+	*/
+	template <typename T>
+	void TileCache<T>::prefetchLoop()
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+
+		while (true)
+		{
+			_requested.wait(lock, [&]() { return _stop || !_requests.empty(); });
+
+			if (_stop)
+				return;
+
+			const TiledMatrix<T>* owner = _requests.front().first;
+			const size_t index = _requests.front().second;
+			const Key tileKey = key(owner, index);
+			const size_t bytes = owner->getTileBytes();
+
+			_requests.pop_front();
+
+			if (_entries.count(tileKey) != 0)
+				continue;
+
+			while (_used + bytes + _reserved > _budget && evict(lock, true))
+			{
+			}
+
+			if (_used + bytes + _reserved > _budget)
+				continue;
+
+			Entry& entry = _entries[tileKey];
+
+			entry.owner = owner;
+			entry.pins = 0;
+			entry.dirty = false;
+			entry.state = TileState::LOADING;
+			_used += bytes;
+
+			lock.unlock();
+
+			bool loaded = true;
+
+			try
+			{
+				entry.data.assign(bytes / sizeof(T), T(0));
+				owner->readTile(index, entry.data.data());
+			}
+			catch (...)
+			{
+				loaded = false;
+			}
+
+			lock.lock();
+
+			if (loaded)
+			{
+				_readTiles++;
+				entry.state = TileState::READY;
+				entry.lru = _lru.insert(_lru.end(), tileKey);
+			}
+			else
+			{
+				_used -= bytes;
+				_entries.erase(tileKey);
+			}
+
+			_changed.notify_all();
+		}
+	}
+
+	/*! key
+	* Get the key of a tile in the cache
+	* const TiledMatrix<T>* owner: The matrix of the tile
+	* size_t index: Index of the tile in the matrix
+	* return: The key
+	*/
+	template <typename T>
+	typename TileCache<T>::Key TileCache<T>::key(const TiledMatrix<T>* owner, size_t index)
+	{
+		return Key(reinterpret_cast<uintptr_t>(owner), index);
+	}
+
+	/*! TileHandle
+	* Get a tile of a matrix from its cache
+	* TiledMatrix<T> matrix: The matrix
+	* uint line: Line of the tile
+	* uint column: Column of the tile
+	* bool write: If the tile will be modified
+	* bool load: Read the tile from the file, otherwise a tile not in the cache is filled with zeros
+	*/
+	template <typename T>
+	TileHandle<T>::TileHandle(const TiledMatrix<T>& matrix, uint line, uint column, bool write, bool load)
+		: _matrix(&matrix)
+		, _index((size_t(line) * matrix.getTileColumns()) + column)
+		, _data(nullptr)
+		, _rows(matrix.rowsOfTile(line))
+		, _columns(matrix.columnsOfTile(column))
+		, _stride(matrix.getTileSize())
+		, _write(write)
+	{
+		if (line >= matrix.getTileRows() || column >= matrix.getTileColumns())
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, matrix.getTileRows(), matrix.getTileColumns(), line, column));
+
+		_data = matrix.getCache().acquire(_matrix, _index, load);
+	}
+
+	/*! TileHandle
+	* Initialize the handle taking the tile of another one
+	* TileHandle<T> moveHandle: The handle to be moved, left empty
+	*/
+	template <typename T>
+	TileHandle<T>::TileHandle(TileHandle<T>&& moveHandle) noexcept
+		: _matrix(moveHandle._matrix)
+		, _index(moveHandle._index)
+		, _data(moveHandle._data)
+		, _rows(moveHandle._rows)
+		, _columns(moveHandle._columns)
+		, _stride(moveHandle._stride)
+		, _write(moveHandle._write)
+	{
+		moveHandle._data = nullptr;
+	}
+
+	/*! ~TileHandle
+	* Give the tile back to the cache
+	*/
+	template <typename T>
+	TileHandle<T>::~TileHandle()
+	{
+		if (_data != nullptr)
+			_matrix->getCache().release(_matrix, _index, _write);
+	}
+
+	/*! view
+	* View the values of the tile
+	* return: The view, valid while the handle lives
+	*/
+	template <typename T>
+	ConstMatrixView<T> TileHandle<T>::view() const
+	{
+		return ConstMatrixView<T>(_rows, _columns, _data, _stride);
+	}
+
+	/*! values
+	* View the values of a tile got to be written
+	* return: The view, valid while the handle lives
+	*/
+	template <typename T>
+	MatrixView<T> TileHandle<T>::values() const
+	{
+		if (!_write)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, _rows, _columns, _rows, _columns));
+
+		return MatrixView<T>(_rows, _columns, _data, _stride);
+	}
+
+	/*! getRows
+	* Get the quantities of rows of the tile, less than the tile size in the last line of tiles
+	* return: The quantities of rows
+	*/
+	template <typename T>
+	const uint& TileHandle<T>::getRows() const
+	{
+		return _rows;
+	}
+
+	/*! getColumns
+	* Get the quantities of columns of the tile, less than the tile size in the last column of tiles
+	* return: The quantities of columns
+	*/
+	template <typename T>
+	const uint& TileHandle<T>::getColumns() const
+	{
+		return _columns;
+	}
+
+	/*! getStride
+	* Get the distance between two rows of the tile, the tile size
+	* return: The distance, in values
+	*/
+	template <typename T>
+	const uint& TileHandle<T>::getStride() const
+	{
+		return _stride;
+	}
+
+	/*! data
+	* Get the value (0, 0) of the tile
+	* return: Pointer to the value
+	*/
+	template <typename T>
+	T* TileHandle<T>::data() const
+	{
+		return _data;
+	}
+
+	/*! TiledMatrix
+	* Create the file of the matrix, all values zero
+	* TileCache<T> cache: The cache of the tiles, must live longer than the matrix
+	* std::string path: Path of the file, replaced if it exists
+	* uint rows: Quantities of rows
+	* uint columns: Quantities of columns
+	* uint tileSize: Quantities of rows and columns of the tiles
+	*/
+	template <typename T>
+	TiledMatrix<T>::TiledMatrix(TileCache<T>& cache, const std::string& path, uint rows, uint columns, uint tileSize)
+		: _cache(&cache)
+		, _file(nullptr)
+		, _rows(rows)
+		, _columns(columns)
+		, _tileSize(tileSize)
+		, _tileRows(0)
+		, _tileColumns(0)
+	{
+		if (tileSize == 0)
+			throw(MatrixException(MatrixExceptionType::INVALID_SIZE, rows, columns));
+
+		_tileRows = (rows + tileSize - 1) / tileSize;
+		_tileColumns = (columns + tileSize - 1) / tileSize;
+		_file = std::fopen(path.c_str(), "w+b");
+
+		if (_file == nullptr)
+			throw(MatrixException(MatrixExceptionType::FILE_ERROR));
+	}
+
+	/*! ~TiledMatrix
+	* Write back the tiles modified and remove the tiles of the matrix from the cache
+	* Errors writing are not reported here, call flush() before to check them
+	*/
+	template <typename T>
+	TiledMatrix<T>::~TiledMatrix()
+	{
+		try
+		{
+			_cache->flush(this);
+		}
+		catch (...)
+		{
+		}
+
+		_cache->drop(this);
+		std::fclose(_file);
+	}
+
+	/*! getRows
+	* Get the quantities of rows
+	* return: The quantities of rows
+	*/
+	template <typename T>
+	const uint& TiledMatrix<T>::getRows() const
+	{
+		return _rows;
+	}
+
+	/*! getColumns
+	* Get the quantities of columns
+	* return: The quantities of columns
+	*/
+	template <typename T>
+	const uint& TiledMatrix<T>::getColumns() const
+	{
+		return _columns;
+	}
+
+	/*! getTileSize
+	* Get the quantities of rows and columns of the tiles
+	* return: The tile size
+	*/
+	template <typename T>
+	const uint& TiledMatrix<T>::getTileSize() const
+	{
+		return _tileSize;
+	}
+
+	/*! getTileRows
+	* Get the quantities of lines of tiles
+	* return: The quantities of lines of tiles
+	*/
+	template <typename T>
+	const uint& TiledMatrix<T>::getTileRows() const
+	{
+		return _tileRows;
+	}
+
+	/*! getTileColumns
+	* Get the quantities of columns of tiles
+	* return: The quantities of columns of tiles
+	*/
+	template <typename T>
+	const uint& TiledMatrix<T>::getTileColumns() const
+	{
+		return _tileColumns;
+	}
+
+	/*! rowsOfTile
+	* Get the quantities of rows of the matrix in a line of tiles
+	* uint line: The line of tiles
+	* return: The quantities of rows
+	*/
+	template <typename T>
+	uint TiledMatrix<T>::rowsOfTile(uint line) const
+	{
+		return std::min(_tileSize, _rows - (line * _tileSize));
+	}
+
+	/*! columnsOfTile
+	* Get the quantities of columns of the matrix in a column of tiles
+	* uint column: The column of tiles
+	* return: The quantities of columns
+	*/
+	template <typename T>
+	uint TiledMatrix<T>::columnsOfTile(uint column) const
+	{
+		return std::min(_tileSize, _columns - (column * _tileSize));
+	}
+
+	/*! getTileBytes
+	* Get the bytes of a tile
+	* return: The bytes
+	*/
+	template <typename T>
+	size_t TiledMatrix<T>::getTileBytes() const
+	{
+		return size_t(_tileSize) * _tileSize * sizeof(T);
+	}
+
+	/*! getCache
+	* Get the cache of the tiles
+	* return: The cache
+	*/
+	template <typename T>
+	TileCache<T>& TiledMatrix<T>::getCache() const
+	{
+		return *_cache;
+	}
+
+	/*! read
+	* Get a tile to read its values
+	* uint line: Line of the tile
+	* uint column: Column of the tile
+	* return: The tile, kept in the cache while the handle lives
+	*/
+	template <typename T>
+	TileHandle<T> TiledMatrix<T>::read(uint line, uint column) const
+	{
+		return TileHandle<T>(*this, line, column, false, true);
+	}
+
+	/*! write
+	* Get a tile to modify its values
+	* uint line: Line of the tile
+	* uint column: Column of the tile
+	* bool load: Read the values from the file, false when all the values will be replaced
+	* return: The tile, kept in the cache while the handle lives and written back when evicted
+	*/
+	template <typename T>
+	TileHandle<T> TiledMatrix<T>::write(uint line, uint column, bool load)
+	{
+		return TileHandle<T>(*this, line, column, true, load);
+	}
+
+	/*! prefetch
+	* Start loading a tile that will be used soon
+	* uint line: Line of the tile
+	* uint column: Column of the tile
+	*/
+	template <typename T>
+	void TiledMatrix<T>::prefetch(uint line, uint column) const
+	{
+		if (line < _tileRows && column < _tileColumns)
+			_cache->prefetch(this, (size_t(line) * _tileColumns) + column);
+	}
+
+	/*! flush
+	* Write back the tiles modified and flush the file
+	*/
+	template <typename T>
+	void TiledMatrix<T>::flush()
+	{
+		_cache->flush(this);
+
+		std::lock_guard<std::mutex> lock(_fileMutex);
+
+		if (std::fflush(_file) != 0)
+			throw(MatrixException(MatrixExceptionType::FILE_ERROR));
+	}
+
+	/*! assign
+	* Copy values to the matrix tile by tile, from a Matrix, a view or a MappedMatrix
+	* ConstMatrixView<T> values: The values, with the sizes of the matrix
+	*/
+	template <typename T>
+	void TiledMatrix<T>::assign(const ConstMatrixView<T>& values)
+	{
+		if (values.getRows() != _rows || values.getColumns() != _columns)
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, _rows, _columns, values.getRows(), values.getColumns(), '='));
+
+		for (uint i = 0; i < _tileRows; i++)
+		{
+			for (uint j = 0; j < _tileColumns; j++)
+			{
+				TileHandle<T> tile = write(i, j, false);
+
+				tile.values().assign(values.block(i * _tileSize, j * _tileSize, tile.getRows(), tile.getColumns()));
+			}
+		}
+	}
+
+	/*! copyTo
+	* Copy the values of the matrix tile by tile
+	* MatrixView<T> values: Receives the values, with the sizes of the matrix
+	*/
+	template <typename T>
+	void TiledMatrix<T>::copyTo(MatrixView<T> values) const
+	{
+		if (values.getRows() != _rows || values.getColumns() != _columns)
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, values.getRows(), values.getColumns(), _rows, _columns, '='));
+
+		for (uint i = 0; i < _tileRows; i++)
+		{
+			for (uint j = 0; j < _tileColumns; j++)
+			{
+				prefetch(i + ((j + 1) / _tileColumns), (j + 1) % _tileColumns);
+
+				TileHandle<T> tile = read(i, j);
+
+				values.block(i * _tileSize, j * _tileSize, tile.getRows(), tile.getColumns()).assign(tile.view());
+			}
+		}
+	}
+
+	/*! readTile
+	* Read a tile from the file, the parts never written are zeros
+	* size_t index: Index of the tile
+	* T* data: Receives the values of the tile
+	*/
+	template <typename T>
+	void TiledMatrix<T>::readTile(size_t index, T* data) const
+	{
+		const size_t count = size_t(_tileSize) * _tileSize;
+		std::lock_guard<std::mutex> lock(_fileMutex);
+
+		seek(index);
+
+		const size_t read = std::fread(data, sizeof(T), count, _file);
+
+		if (read < count)
+		{
+			if (std::ferror(_file))
+				throw(MatrixException(MatrixExceptionType::FILE_ERROR));
+
+			std::clearerr(_file);
+			std::fill(data + read, data + count, T(0));
+		}
+	}
+
+	/*! writeTile
+	* Write a tile to the file
+	* size_t index: Index of the tile
+	* T* data: The values of the tile
+	*/
+	template <typename T>
+	void TiledMatrix<T>::writeTile(size_t index, const T* data) const
+	{
+		const size_t count = size_t(_tileSize) * _tileSize;
+		std::lock_guard<std::mutex> lock(_fileMutex);
+
+		seek(index);
+
+		if (std::fwrite(data, sizeof(T), count, _file) != count)
+			throw(MatrixException(MatrixExceptionType::FILE_ERROR));
+	}
+
+	/*! seek
+	* Move the position of the file to the start of a tile, the file mutex must be locked
+	* size_t index: Index of the tile
+	*/
+	template <typename T>
+	void TiledMatrix<T>::seek(size_t index) const
+	{
+		const uint64_t offset = uint64_t(index) * getTileBytes();
+
+#ifdef _WIN32
+		const bool moved = _fseeki64(_file, int64_t(offset), SEEK_SET) == 0;
+#else
+		const bool moved = fseeko(_file, off_t(offset), SEEK_SET) == 0;
+#endif
+
+		if (!moved)
+			throw(MatrixException(MatrixExceptionType::FILE_ERROR));
+	}
+
+	/*! TiledLUFactorization
+	* Initialize the factorization
+	* TiledMatrix<T> lu: The matrix with L and U
+	* vector<uint> permutation: Line of A in each line of P * A
+	* bool permutationOdd: If P has an odd quantity of switches
+	* bool singular: If a pivot was singular
+	*/
+	template <typename T>
+	TiledLUFactorization<T>::TiledLUFactorization(const TiledMatrix<T>& lu, std::vector<uint>&& permutation, bool permutationOdd, bool singular)
+		: _lu(&lu)
+		, _permutation(std::move(permutation))
+		, _permutationOdd(permutationOdd)
+		, _singular(singular)
+	{}
+
+	/*! getLU
+	* Get the matrix with L (below the diagonal, its unit diagonal is not stored) and U
+	* return: The matrix
+	*/
+	template <typename T>
+	const TiledMatrix<T>& TiledLUFactorization<T>::getLU() const
+	{
+		return *_lu;
+	}
+
+	/*! getPermutation
+	* Get the line of A in each line of P * A
+	* return: The permutation
+	*/
+	template <typename T>
+	const std::vector<uint>& TiledLUFactorization<T>::getPermutation() const
+	{
+		return _permutation;
+	}
+
+	/*! isSingular
+	* Tell if a pivot was singular, the solutions are not valid then
+	* return: If the matrix is singular
+	*/
+	template <typename T>
+	bool TiledLUFactorization<T>::isSingular() const
+	{
+		return _singular;
+	}
+
+	/*! solve
+	* Solve A * X = B by a forward and a backward substitution streaming the tiles, B in memory
+	* Matrix<T> matrixB: The vector b, or a matrix with one b per column
+	* return: The solution
+	*/
+	template <typename T>
+	Matrix<T> TiledLUFactorization<T>::solve(const Matrix<T>& matrixB) const
+	{
+		const TiledMatrix<T>& lu = *_lu;
+		const uint n = lu.getRows();
+		const uint tiles = lu.getTileRows();
+		const uint ts = lu.getTileSize();
+
+		if (matrixB.getRows() != n)
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, n, n, matrixB.getRows(), matrixB.getColumns(), 'X'));
+		else if (_singular)
+			throw(MatrixException(MatrixExceptionType::SINGULAR_MATRIX));
+
+		const uint columns = matrixB.getColumns();
+		Matrix<T> x;
+
+		x.resize(n, columns);
+
+		for (uint i = 0; i < n; i++)
+			std::copy(matrixB.row(_permutation[i]), matrixB.row(_permutation[i]) + columns, x.row(i));
+
+		for (uint I = 0; I < tiles; I++)
+		{
+			for (uint J = 0; J <= I; J++)
+			{
+				lu.prefetch(J < I ? I : I + 1, J < I ? J + 1 : 0);
+
+				TileHandle<T> tile = lu.read(I, J);
+
+				if (J < I)
+				{
+					gemmKernel(tile.getRows(), columns, tile.getColumns(), T(-1), tile.data(), ts, 1, x.row(J * ts), x.getStride(), 1, T(1), x.row(I * ts), x.getStride());
+					continue;
+				}
+
+				for (uint i = 1; i < tile.getRows(); i++)
+				{
+					const T* lineL = tile.data() + (size_t(i) * ts);
+
+					for (uint j = 0; j < i; j++)
+						if (lineL[j] != T(0))
+							simdKernels<T>().axpy(columns, -lineL[j], x.row((I * ts) + j), x.row((I * ts) + i));
+				}
+			}
+		}
+
+		for (uint I = tiles; I-- > 0;)
+		{
+			for (uint J = tiles; J-- > I;)
+			{
+				lu.prefetch(J > I ? I : I - 1, J > I ? J - 1 : tiles - 1);
+
+				TileHandle<T> tile = lu.read(I, J);
+
+				if (J > I)
+				{
+					gemmKernel(tile.getRows(), columns, tile.getColumns(), T(-1), tile.data(), ts, 1, x.row(J * ts), x.getStride(), 1, T(1), x.row(I * ts), x.getStride());
+					continue;
+				}
+
+				for (uint i = tile.getRows(); i-- > 0;)
+				{
+					const T* lineU = tile.data() + (size_t(i) * ts);
+
+					for (uint j = i + 1; j < tile.getColumns(); j++)
+						if (lineU[j] != T(0))
+							simdKernels<T>().axpy(columns, -lineU[j], x.row((I * ts) + j), x.row((I * ts) + i));
+
+					simdKernels<T>().scale(columns, T(1) / lineU[i], x.row((I * ts) + i));
+				}
+			}
+		}
+
+		return x;
+	}
+
+	/*! determinant
+	* Calculate the determinant by the product of the diagonal of U, reading the tiles of the diagonal
+	* return: The determinant, zero when singular
+	*/
+	template <typename T>
+	T TiledLUFactorization<T>::determinant() const
+	{
+		if (_singular)
+			return T(0);
+
+		T det = _permutationOdd ? T(-1) : T(1);
+
+		for (uint I = 0; I < _lu->getTileRows(); I++)
+		{
+			TileHandle<T> tile = _lu->read(I, I);
+
+			for (uint i = 0; i < tile.getRows(); i++)
+				det *= tile.data()[(size_t(i) * tile.getStride()) + i];
+		}
+
+		return det;
+	}
+
+	/*! tiledGemm
+	* Calculate C = alpha * A * B + beta * C tile by tile, with the GEMM kernel on the tiles in memory
+	* While a tile of C is calculated, the next tiles of A and B are prefetched
+	* The three matrices must have the same tile size, and C must not be A or B
+	* T alpha: Value multiplied to A * B
+	* TiledMatrix<T> A: Matrix to multiply
+	* TiledMatrix<T> B: Matrix to multiply
+	* T beta: Value multiplied to C
+	* TiledMatrix<T> C: Matrix of the result
+	*/
+	template <typename T>
+	void tiledGemm(const T& alpha, const TiledMatrix<T>& A, const TiledMatrix<T>& B, const T& beta, TiledMatrix<T>& C)
+	{
+		if (A.getColumns() != B.getRows())
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, A.getRows(), A.getColumns(), B.getRows(), B.getColumns(), 'X'));
+		else if (C.getRows() != A.getRows() || C.getColumns() != B.getColumns() || &C == &A || &C == &B)
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, A.getRows(), B.getColumns(), C.getRows(), C.getColumns(), '='));
+		else if (A.getTileSize() != C.getTileSize() || B.getTileSize() != C.getTileSize())
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, A.getTileSize(), B.getTileSize(), C.getTileSize(), C.getTileSize(), 'X'));
+
+		const uint ts = C.getTileSize();
+		const uint tilesK = A.getTileColumns();
+
+		for (uint i = 0; i < C.getTileRows(); i++)
+		{
+			for (uint j = 0; j < C.getTileColumns(); j++)
+			{
+				TileHandle<T> tileC = C.write(i, j, beta != T(0));
+
+				if (tilesK == 0)
+				{
+					for (uint line = 0; line < tileC.getRows(); line++)
+						simdKernels<T>().scale(tileC.getColumns(), beta, tileC.data() + (size_t(line) * ts));
+				}
+
+				for (uint k = 0; k < tilesK; k++)
+				{
+					if (k + 1 < tilesK)
+					{
+						A.prefetch(i, k + 1);
+						B.prefetch(k + 1, j);
+					}
+					else
+					{
+						const uint nextI = i + ((j + 1) / C.getTileColumns());
+						const uint nextJ = (j + 1) % C.getTileColumns();
+
+						A.prefetch(nextI, 0);
+						B.prefetch(0, nextJ);
+
+						if (beta != T(0))
+							C.prefetch(nextI, nextJ);
+					}
+
+					TileHandle<T> tileA = A.read(i, k);
+					TileHandle<T> tileB = B.read(k, j);
+
+					gemmKernel(tileC.getRows(), tileC.getColumns(), tileA.getColumns(), alpha,
+					           tileA.data(), ts, 1, tileB.data(), ts, 1,
+					           (k == 0) ? beta : T(1), tileC.data(), ts);
+				}
+			}
+		}
+	}
+
+	/*! tiledLUFactor
+	* Calculate P * A = L * U with partial pivoting in the tiles of the matrix, right-looking by columns of tiles
+	* Each column of tiles (the panel) is copied to memory and factorized by the blocked LU, then for each column
+	* of tiles right of it its lines are switched, its tile of U is solved and its tiles below are updated by the
+	* GEMM kernel, while the next column is prefetched
+	* The switches of the columns left of each panel are done at the end, in one pass over L
+	* The cache budget must hold two columns of tiles plus one tile, the panel is reserved in it
+	* TiledMatrix<T> M: The square matrix A, receives L and U
+	* T error: Pivots with absolute value up to error mark the matrix as singular
+	* return: The factorization, using the matrix
+	*/
+	template <typename T>
+	TiledLUFactorization<T> tiledLUFactor(TiledMatrix<T>& M, const T error)
+	{
+		if (M.getRows() * M.getColumns() == 0)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+		else if (M.getRows() != M.getColumns())
+			throw(MatrixException(MatrixExceptionType::INVALID_SIZE, M.getRows(), M.getColumns()));
+
+		const uint n = M.getRows();
+		const uint ts = M.getTileSize();
+		const uint tiles = M.getTileRows();
+		const uint nb = LUBlocking<T>::NB;
+		const size_t panelBytes = size_t(n) * ts * sizeof(T);
+		std::vector<uint> pivots(n);
+		std::vector<uint> permutation(n);
+		bool permutationOdd = false;
+		bool singular = false;
+
+		if (panelBytes + (size_t(tiles) + 1) * M.getTileBytes() > M.getCache().getBudget())
+			throw(MatrixException(MatrixExceptionType::INVALID_SIZE, n, n));
+
+		M.getCache().reserve(panelBytes);
+
+		try
+		{
+			for (uint k = 0; k < tiles; k++)
+			{
+				const uint k0 = k * ts;
+				const uint kb = M.columnsOfTile(k);
+				std::vector<uint> panelPivots(kb);
+				Matrix<T> panel;
+
+				panel.resize(n - k0, kb);
+
+				for (uint I = k; I < tiles; I++)
+				{
+					M.prefetch(I + 1 < tiles ? I + 1 : k, I + 1 < tiles ? k : k + 1);
+
+					TileHandle<T> tile = M.read(I, k);
+
+					view(panel).block((I - k) * ts, 0, tile.getRows(), kb).assign(tile.view());
+				}
+
+				for (uint c = 0; c < kb; c += nb)
+				{
+					const uint cb = std::min(nb, kb - c);
+
+					if (luFactorPanel(panel, c, cb, panelPivots, error))
+						singular = true;
+
+					luSwapLines(panel, panelPivots, c, cb, 0, c);
+					luSwapLines(panel, panelPivots, c, cb, c + cb, kb);
+					luSolveLines(panel, c, cb, c + cb, kb);
+					luUpdate(panel, c, cb, c + cb, kb);
+				}
+
+				for (uint c = 0; c < kb; c++)
+					pivots[k0 + c] = k0 + panelPivots[c];
+
+				for (uint I = k; I < tiles; I++)
+				{
+					TileHandle<T> tile = M.write(I, k, false);
+
+					tile.values().assign(view(panel).block((I - k) * ts, 0, tile.getRows(), kb));
+				}
+
+				for (uint J = k + 1; J < tiles; J++)
+				{
+					std::vector<TileHandle<T>> column;
+
+					for (uint I = k; I < tiles; I++)
+						column.push_back(M.write(I, J));
+
+					for (uint I = k; J + 1 < tiles && I < tiles; I++)
+						M.prefetch(I, J + 1);
+
+					tiledSwapLines(M, pivots, J, k0, k0 + kb);
+
+					const TileHandle<T>& tileU = column[0];
+
+					for (uint i = 1; i < kb; i++)
+					{
+						const T* lineL = panel.row(i);
+
+						for (uint j = 0; j < i; j++)
+							if (lineL[j] != T(0))
+								simdKernels<T>().axpy(tileU.getColumns(), -lineL[j], tileU.data() + (size_t(j) * ts), tileU.data() + (size_t(i) * ts));
+					}
+
+					for (uint I = k + 1; I < tiles; I++)
+					{
+						const TileHandle<T>& tile = column[I - k];
+
+						gemmKernel(tile.getRows(), tile.getColumns(), kb, T(-1),
+						           panel.row((I - k) * ts), panel.getStride(), 1,
+						           tileU.data(), ts, 1,
+						           T(1), tile.data(), ts);
+					}
+				}
+			}
+
+			for (uint J = 0; J + 1 < tiles; J++)
+				tiledSwapLines(M, pivots, J, (J + 1) * ts, n);
+		}
+		catch (...)
+		{
+			M.getCache().unreserve(panelBytes);
+			throw;
+		}
+
+		M.getCache().unreserve(panelBytes);
+
+		for (uint i = 0; i < n; i++)
+			permutation[i] = i;
+
+		for (uint i = 0; i < n; i++)
+		{
+			if (pivots[i] != i)
+			{
+				std::swap(permutation[i], permutation[pivots[i]]);
+				permutationOdd = !permutationOdd;
+			}
+		}
+
+		return TiledLUFactorization<T>(M, std::move(permutation), permutationOdd, singular);
+	}
+
+	/*! tiledSwapLines
+	* Switch the lines chosen by the pivots of [lineBegin, lineEnd) in a column of tiles
+	* The tiles of the column from the line of tiles of lineBegin down are kept in the cache meanwhile
+	* TiledMatrix<T> M: The matrix in factorization
+	* vector<uint> pivots: The line switched with each line, never above it
+	* uint column: The column of tiles
+	* uint lineBegin: First line
+	* uint lineEnd: Line after the last
+	*/
+	template <typename T>
+	void tiledSwapLines(TiledMatrix<T>& M, const std::vector<uint>& pivots, uint column, uint lineBegin, uint lineEnd)
+	{
+		const uint ts = M.getTileSize();
+		const uint first = lineBegin / ts;
+		std::vector<TileHandle<T>> tiles;
+
+		if (lineBegin >= lineEnd)
+			return;
+
+		for (uint I = first; I < M.getTileRows(); I++)
+			tiles.push_back(M.write(I, column));
+
+		const uint columns = tiles[0].getColumns();
+
+		for (uint i = lineBegin; i < lineEnd; i++)
+		{
+			if (pivots[i] == i)
+				continue;
+
+			T* line = tiles[(i / ts) - first].data() + (size_t(i % ts) * ts);
+			T* pivot = tiles[(pivots[i] / ts) - first].data() + (size_t(pivots[i] % ts) * ts);
+
+			std::swap_ranges(line, line + columns, pivot);
+		}
+	}
+
+}
+
+#endif
@@ -0,0 +1,603 @@
+#ifndef MATRIX_QR_HPP
+#define MATRIX_QR_HPP
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "Matrix.hpp"
+#include "MatrixExpression.hpp"
+#include "MatrixBlas.hpp"
+
+namespace lito {
+
+	/*! QRBlocking
+	* Size of the blocks used by the QR factorization
+	* NB: Columns of each panel, its reflectors are applied together as I - V * T * Vt
+	* Matrices with fewer than 2 * NB columns are factorized as one panel
+	* WY: Minimum reflectors of a panel and columns of C to apply the panel by GEMM, else one reflector at a time
+	*/
+	template <typename T>
+	struct QRBlocking {
+		static const uint NB = 32;
+		static const uint WY = 8;
+	};
+
+	/*! QRFactorization
+	* Factorization A = Q * R by Householder reflectors, for any m x n matrix
+	* Q is never formed: the reflectors are kept below the diagonal of R, as the vectors v with unit first value,
+	* and each panel of reflectors keeps its triangular T of the compact WY form H1 * ... * Hk = I - V * T * Vt
+	*/
+	template <typename T>
+	class QRFactorization {
+	public:
+		QRFactorization();
+		QRFactorization(Matrix<T>&& qr, std::vector<T>&& tau, std::vector<Matrix<T>>&& blocks, uint nb);
+
+		const Matrix<T>& getQR() const;
+		const std::vector<T>& getTau() const;
+		const uint& getRows() const;
+		const uint& getColumns() const;
+
+		Matrix<T> getR() const;
+		Matrix<T> getThinQ() const;
+
+		Matrix<T>& applyQ(Matrix<T>& matrixC) const;
+		Matrix<T>& applyQt(Matrix<T>& matrixC) const;
+		Matrix<T> leastSquares(const Matrix<T>& vectorB, const T error = T(0)) const;
+
+	private:
+		void applyBlock(Matrix<T>& matrixC, uint block, bool transposed) const;
+
+		Matrix<T> _qr;
+		std::vector<T> _tau;
+		std::vector<Matrix<T>> _blocks;
+		uint _nb;
+	};
+
+	template <typename T> void qrFactorPanel(Matrix<T>& M, uint k, uint kb, std::vector<T>& tau);
+	template <typename T> Matrix<T> qrPanelVectors(const Matrix<T>& M, uint k, uint kb);
+	template <typename T> Matrix<T> qrBlockReflector(const Matrix<T>& V, const std::vector<T>& tau, uint k, uint kb);
+	template <typename T> void qrApplyBlock(const T* V, uint rowsV, uint kb, uint rowStrideV, const Matrix<T>& blockT, T* C, uint columnsC, uint rowStrideC, bool transposed);
+	template <typename T> void qrApplyReflectors(const Matrix<T>& M, const std::vector<T>& tau, uint k, uint kb, T* C, uint columnsC, uint rowStrideC, bool transposed);
+
+	template <typename T> QRFactorization<T> qrFactor(Matrix<T>&& M);
+	template <typename T> QRFactorization<T> qrFactor(const Matrix<T>& M);
+	template <typename T> Matrix<T> leastSquares(const Matrix<T>& M, const Matrix<T>& vectorB, const T error = T(0));
+	template <typename E> QRFactorization<typename E::ValueType> qrFactor(const MatrixExpression<E>& M);
+	template <typename E> Matrix<typename E::ValueType> leastSquares(const MatrixExpression<E>& M, const Matrix<typename E::ValueType>& vectorB, const typename E::ValueType error = 0);
+
+
+
+	/*! QRFactorization
+	* Initialize an empty factorization
+	*/
+	template <typename T>
+	QRFactorization<T>::QRFactorization()
+		: _nb(0)
+	{}
+
+	/*! QRFactorization
+	* Initialize the factorization with its parts, as computed by qrFactor
+	* Matrix<T> qr: R on and above the diagonal and the reflectors below it
+	* vector<T> tau: Scale of each reflector, H = I - tau * v * vt
+	* vector<Matrix<T>> blocks: T of the compact WY form of each panel, empty for panels with fewer than WY reflectors
+	* uint nb: Columns of each panel
+	*/
+	template <typename T>
+	QRFactorization<T>::QRFactorization(Matrix<T>&& qr, std::vector<T>&& tau, std::vector<Matrix<T>>&& blocks, uint nb)
+		: _qr(std::move(qr))
+		, _tau(std::move(tau))
+		, _blocks(std::move(blocks))
+		, _nb(nb)
+	{}
+
+	/*! getQR
+	* Get R on and above the diagonal and the reflectors below it
+	* return: The factors
+	*/
+	template <typename T>
+	const Matrix<T>& QRFactorization<T>::getQR() const
+	{
+		return _qr;
+	}
+
+	/*! getTau
+	* Get the scale of each reflector, H = I - tau * v * vt
+	* return: The scales
+	*/
+	template <typename T>
+	const std::vector<T>& QRFactorization<T>::getTau() const
+	{
+		return _tau;
+	}
+
+	/*! getRows
+	* Get the quantities of rows of the matrix factorized
+	* return: The rows
+	*/
+	template <typename T>
+	const uint& QRFactorization<T>::getRows() const
+	{
+		return _qr.getRows();
+	}
+
+	/*! getColumns
+	* Get the quantities of columns of the matrix factorized
+	* return: The columns
+	*/
+	template <typename T>
+	const uint& QRFactorization<T>::getColumns() const
+	{
+		return _qr.getColumns();
+	}
+
+	/*! getR
+	* Get the upper triangular R, min(m, n) x n
+	* return: The matrix R
+	*/
+	template <typename T>
+	Matrix<T> QRFactorization<T>::getR() const
+	{
+		if (_qr.getRows() == 0)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+
+		uint rows = std::min(getRows(), getColumns());
+		Matrix<T> matrixR(rows, getColumns());
+
+		for (uint i = 0; i < rows; i++)
+			std::copy(_qr.row(i) + i, _qr.row(i) + getColumns(), matrixR.row(i) + i);
+
+		return matrixR;
+	}
+
+	/*! getThinQ
+	* Get the first min(m, n) columns of Q, so A = Q * R with the R of getR
+	* return: The matrix Q, m x min(m, n)
+	*/
+	template <typename T>
+	Matrix<T> QRFactorization<T>::getThinQ() const
+	{
+		if (_qr.getRows() == 0)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+
+		uint columns = std::min(getRows(), getColumns());
+		Matrix<T> matrixQ(getRows(), columns);
+
+		for (uint i = 0; i < columns; i++)
+			matrixQ.row(i)[i] = T(1);
+
+		return std::move(applyQ(matrixQ));
+	}
+
+	/*! applyQ
+	* Calculate C = Q * C without forming Q, one panel of reflectors at a time
+	* Matrix<T> matrixC: The matrix C, m x k, replaced by Q * C
+	* return: The matrix C
+	*/
+	template <typename T>
+	Matrix<T>& QRFactorization<T>::applyQ(Matrix<T>& matrixC) const
+	{
+		if (_qr.getRows() == 0 || matrixC.getRows() * matrixC.getColumns() == 0)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+		else if (matrixC.getRows() != getRows())
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, getRows(), getRows(), matrixC.getRows(), matrixC.getColumns(), '*'));
+
+		for (uint block = uint(_blocks.size()); block-- > 0;)
+			applyBlock(matrixC, block, false);
+
+		return matrixC;
+	}
+
+	/*! applyQt
+	* Calculate C = Qt * C without forming Q, one panel of reflectors at a time
+	* Matrix<T> matrixC: The matrix C, m x k, replaced by Qt * C
+	* return: The matrix C
+	*/
+	template <typename T>
+	Matrix<T>& QRFactorization<T>::applyQt(Matrix<T>& matrixC) const
+	{
+		if (_qr.getRows() == 0 || matrixC.getRows() * matrixC.getColumns() == 0)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+		else if (matrixC.getRows() != getRows())
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, getRows(), getRows(), matrixC.getRows(), matrixC.getColumns(), '*'));
+
+		for (uint block = 0; block < _blocks.size(); block++)
+			applyBlock(matrixC, block, true);
+
+		return matrixC;
+	}
+
+	/*! leastSquares
+	* Calculate the x that minimizes ||Ax - b||, solving R * x = (Qt * b) in the first n lines
+	* The condition number is the one of A, not the square of it as with the normal equations At * A
+	* Matrix<T> vectorB: The vector b, or a matrix with one b per column
+	* T error: Values of the diagonal of R up to error (absolute) mean A has not full column rank
+	* return: The vector x, n x k, with the allocator of b
+	*/
+	template <typename T>
+	Matrix<T> QRFactorization<T>::leastSquares(const Matrix<T>& vectorB, const T error) const
+	{
+		if (getRows() < getColumns())
+			throw(MatrixException(MatrixExceptionType::INVALID_SIZE, getRows(), getColumns()));
+
+		uint n = getColumns();
+		Matrix<T> vectorQtB(vectorB);
+		Matrix<T> vectorX(n, vectorB.getColumns(), MatrixType::ZEROS, vectorB.getAllocator());
+		uint columnsB = vectorB.getColumns();
+
+		applyQt(vectorQtB);
+
+		for (uint i = n; i-- > 0;)
+		{
+			const T* lineR = _qr.row(i);
+			T* lineX = vectorX.row(i);
+
+			if (!(T(std::abs(lineR[i])) > error))
+				throw(MatrixException(MatrixExceptionType::SINGULAR_MATRIX));
+
+			std::copy(vectorQtB.row(i), vectorQtB.row(i) + columnsB, lineX);
+
+			for (uint j = i + 1; j < n; j++)
+				if (lineR[j] != T(0))
+					simdKernels<T>().axpy(columnsB, -lineR[j], vectorX.row(j), lineX);
+
+			simdKernels<T>().scale(columnsB, T(1) / lineR[i], lineX);
+		}
+
+		return vectorX;
+	}
+
+	/*! applyBlock
+	* Apply the reflectors of a panel to the lines of C from the first line of the panel on
+	* The reflectors are read in place from the factorization, nothing is copied per call
+	* Matrix<T> matrixC: The matrix C
+	* uint block: The panel
+	* bool transposed: If (I - V * T * Vt)t is applied instead of I - V * T * Vt
+	*/
+	template <typename T>
+	void QRFactorization<T>::applyBlock(Matrix<T>& matrixC, uint block, bool transposed) const
+	{
+		uint k = block * _nb;
+		uint kb = std::min(_nb, uint(_tau.size()) - k);
+
+		if (kb < QRBlocking<T>::WY || matrixC.getColumns() < QRBlocking<T>::WY)
+			qrApplyReflectors(_qr, _tau, k, kb, matrixC.row(k), matrixC.getColumns(), matrixC.getStride(), transposed);
+		else
+			qrApplyBlock(_qr.row(k) + k, getRows() - k, kb, _qr.getStride(), _blocks[block], matrixC.row(k), matrixC.getColumns(), matrixC.getStride(), transposed);
+	}
+
+	/*! qrFactorPanel
+	* Factorize the panel of the columns [k, k + kb) and the lines [k, rows) by Householder reflectors
+	* Each reflector H = I - tau * v * vt zeros a column below the diagonal and is applied to the columns
+	* of the panel right of it, line by line
+	* Matrix<T> M: The matrix in factorization, the columns before k are already factorized
+	* uint k: First column of the panel
+	* uint kb: Quantities of columns of the panel
+	* vector<T> tau: Receives the scale of each reflector of the panel
+	*/
+	template <typename T>
+	void qrFactorPanel(Matrix<T>& M, uint k, uint kb, std::vector<T>& tau)
+	{
+		uint m = M.getRows();
+		uint end = k + kb;
+
+		for (uint j = k; j < end; j++)
+		{
+			T alpha = M.row(j)[j];
+			T normSquare = T(0);
+
+			for (uint i = j + 1; i < m; i++)
+				normSquare += M.row(i)[j] * M.row(i)[j];
+
+			if (normSquare == T(0))
+			{
+				tau[j] = T(0);
+				continue;
+			}
+
+			T beta = T(std::sqrt((alpha * alpha) + normSquare));
+
+			if (alpha > T(0))
+				beta = -beta;
+
+			T scaleV = T(1) / (alpha - beta);
+			uint count = end - j - 1;
+
+			tau[j] = (beta - alpha) / beta;
+			M.row(j)[j] = beta;
+
+			for (uint i = j + 1; i < m; i++)
+				M.row(i)[j] *= scaleV;
+
+			if (count == 0)
+				continue;
+
+			qrApplyReflectors(M, tau, j, 1, M.row(j) + j + 1, count, M.getStride(), true);
+		}
+	}
+
+	/*! qrPanelVectors
+	* Copy the reflectors of a panel to V, with the unit diagonal and the zeros above it
+	* Matrix<T> M: The matrix with the reflectors below the diagonal
+	* uint k: First column of the panel
+	* uint kb: Quantities of columns of the panel
+	* return: The matrix V, (rows - k) x kb
+	*/
+	template <typename T>
+	Matrix<T> qrPanelVectors(const Matrix<T>& M, uint k, uint kb)
+	{
+		Matrix<T> V(M.getRows() - k, kb);
+
+		for (uint i = 0; i < V.getRows(); i++)
+		{
+			const T* lineM = M.row(k + i) + k;
+			T* lineV = V.row(i);
+
+			if (i < kb)
+			{
+				lineV[i] = T(1);
+				std::copy(lineM, lineM + i, lineV);
+			}
+			else
+			{
+				std::copy(lineM, lineM + kb, lineV);
+			}
+		}
+
+		return V;
+	}
+
+	/*! qrBlockReflector
+	* Calculate the upper triangular T of the compact WY form H1 * ... * Hkb = I - V * T * Vt
+	* Column j is T[0:j, j] = -tau[j] * T[0:j, 0:j] * Vt[0:j] * v[j], with T[j, j] = tau[j]
+	* Matrix<T> V: The reflectors of the panel
+	* vector<T> tau: Scale of each reflector
+	* uint k: First column of the panel
+	* uint kb: Quantities of columns of the panel
+	* return: The matrix T, kb x kb
+	*/
+	template <typename T>
+	Matrix<T> qrBlockReflector(const Matrix<T>& V, const std::vector<T>& tau, uint k, uint kb)
+	{
+		Matrix<T> blockT(kb, kb);
+		Matrix<T> products(kb, kb);
+
+		// products = Vt * V, only the values above the diagonal are used
+		gemmKernel(kb, kb, V.getRows(), T(1), V.data(), 1, V.getStride(), V.data(), V.getStride(), 1, T(0), products.data(), products.getStride());
+
+		for (uint j = 0; j < kb; j++)
+		{
+			blockT.row(j)[j] = tau[k + j];
+
+			for (uint i = 0; i < j; i++)
+			{
+				T value = T(0);
+
+				for (uint p = i; p < j; p++)
+					value += blockT.row(i)[p] * products.row(p)[j];
+
+				blockT.row(i)[j] = -tau[k + j] * value;
+			}
+		}
+
+		return blockT;
+	}
+
+	/*! qrApplyBlock
+	* Calculate C = (I - V * T * Vt) * C, or with (I - V * T * Vt)t, by GEMM
+	* V is read where the factorization stores it: its first kb lines, the unit lower triangle V1, are applied
+	* line by line, as the values on and above their diagonal belong to R, and the lines below, V2, by the GEMM
+	* const T* V: First value of V, below it the reflectors of the panel, rowsV x kb
+	* uint rowsV: Quantities of lines of V and of C
+	* uint kb: Quantities of reflectors
+	* uint rowStrideV: Distance between two rows of V
+	* Matrix<T> blockT: T of the compact WY form, kb x kb
+	* T* C: First value of C, rowsV x columnsC
+	* uint columnsC: Quantities of columns of C
+	* uint rowStrideC: Distance between two rows of C
+	* bool transposed: If (I - V * T * Vt)t = I - V * Tt * Vt is applied
+	*/
+	template <typename T>
+	void qrApplyBlock(const T* V, uint rowsV, uint kb, uint rowStrideV, const Matrix<T>& blockT, T* C, uint columnsC, uint rowStrideC, bool transposed)
+	{
+		Matrix<T> W(kb, columnsC);
+		Matrix<T> TW(kb, columnsC);
+		const T* V2 = V + (size_t(kb) * rowStrideV);
+		T* C2 = C + (size_t(kb) * rowStrideC);
+
+		// W = V1t * C1 + V2t * C2
+		for (uint i = 0; i < kb; i++)
+		{
+			const T* lineV = V + (size_t(i) * rowStrideV);
+			const T* lineC = C + (size_t(i) * rowStrideC);
+
+			simdKernels<T>().axpy(columnsC, T(1), lineC, W.row(i));
+
+			for (uint p = 0; p < i; p++)
+				simdKernels<T>().axpy(columnsC, lineV[p], lineC, W.row(p));
+		}
+
+		if (rowsV > kb)
+			gemmKernel(kb, columnsC, rowsV - kb, T(1), V2, 1, rowStrideV, C2, rowStrideC, 1, T(1), W.data(), W.getStride());
+
+		if (transposed)
+			gemmKernel(kb, columnsC, kb, T(1), blockT.data(), 1, blockT.getStride(), W.data(), W.getStride(), 1, T(0), TW.data(), TW.getStride());
+		else
+			gemmKernel(kb, columnsC, kb, T(1), blockT.data(), blockT.getStride(), 1, W.data(), W.getStride(), 1, T(0), TW.data(), TW.getStride());
+
+		// C1 = C1 - V1 * TW and C2 = C2 - V2 * TW
+		for (uint i = 0; i < kb; i++)
+		{
+			const T* lineV = V + (size_t(i) * rowStrideV);
+			T* lineC = C + (size_t(i) * rowStrideC);
+
+			simdKernels<T>().axpy(columnsC, T(-1), TW.row(i), lineC);
+
+			for (uint p = 0; p < i; p++)
+				simdKernels<T>().axpy(columnsC, -lineV[p], TW.row(p), lineC);
+		}
+
+		if (rowsV > kb)
+			gemmKernel(rowsV - kb, columnsC, kb, T(-1), V2, rowStrideV, 1, TW.data(), TW.getStride(), 1, T(1), C2, rowStrideC);
+	}
+
+	/*! qrApplyReflectors
+	* Calculate C = H(k) * ... * H(k + kb - 1) * C, or with the product transposed, one reflector at a time
+	* Each reflector calculates w = vt * C and C = C - tau * v * w along the lines of C, faster than the GEMM
+	* when there are few reflectors or few columns
+	* Matrix<T> M: The matrix with the reflectors below the diagonal
+	* vector<T> tau: Scale of each reflector
+	* uint k: First reflector, its lines start at the line k
+	* uint kb: Quantities of reflectors
+	* T* C: First value of C, (rows - k) x columnsC
+	* uint columnsC: Quantities of columns of C
+	* uint rowStrideC: Distance between two rows of C
+	* bool transposed: If the product is applied transposed, the first reflector first
+	*/
+	template <typename T>
+	void qrApplyReflectors(const Matrix<T>& M, const std::vector<T>& tau, uint k, uint kb, T* C, uint columnsC, uint rowStrideC, bool transposed)
+	{
+		uint m = M.getRows();
+		std::vector<T> vectorW(columnsC);
+
+		for (uint r = 0; r < kb; r++)
+		{
+			uint j = transposed ? (k + r) : (k + kb - r - 1);
+			T* lineJ = C + (size_t(j - k) * rowStrideC);
+
+			if (tau[j] == T(0))
+				continue;
+
+			// w = tau * (line j of C + the sum of the lines below it times v)
+			std::copy(lineJ, lineJ + columnsC, vectorW.begin());
+
+			for (uint i = j + 1; i < m; i++)
+				if (M.row(i)[j] != T(0))
+					simdKernels<T>().axpy(columnsC, M.row(i)[j], C + (size_t(i - k) * rowStrideC), vectorW.data());
+
+			simdKernels<T>().scale(columnsC, tau[j], vectorW.data());
+			simdKernels<T>().axpy(columnsC, T(-1), vectorW.data(), lineJ);
+
+			for (uint i = j + 1; i < m; i++)
+				if (M.row(i)[j] != T(0))
+					simdKernels<T>().axpy(columnsC, -M.row(i)[j], vectorW.data(), C + (size_t(i - k) * rowStrideC));
+		}
+	}
+
+	/*! qrFactor
+	* Calculate A = Q * R by Householder reflectors in the storage of the matrix
+	* The columns are factorized by panels of NB: each panel is reduced column by column and then its
+	* reflectors are applied to the columns right of it at once, I - V * Tt * Vt, by the GEMM kernel
+	* When the build has a system LAPACKE, float and double matrices are factorized by it
+	* Matrix<T> M: The matrix A, m x n, its storage is taken by the factorization
+	* return: The factorization
+	*/
+	template <typename T>
+	QRFactorization<T> qrFactor(Matrix<T>&& M)
+	{
+		if (M.getRows() * M.getColumns() == 0)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+
+		uint m = M.getRows();
+		uint n = M.getColumns();
+		uint reflectors = std::min(m, n);
+		uint nb = (n < 2 * QRBlocking<T>::NB) ? std::max(reflectors, 1u) : QRBlocking<T>::NB;
+		std::vector<T> tau(reflectors);
+		std::vector<Matrix<T>> blocks;
+
+		blocks.reserve((reflectors + nb - 1) / nb);
+
+		// A system LAPACK writes the same reflectors, only the T of each panel is built here for applyQ
+		if (lapackGeqrf(m, n, M.data(), M.getStride(), tau.data()))
+		{
+			for (uint k = 0; k < reflectors; k += nb)
+			{
+				uint kb = std::min(nb, reflectors - k);
+
+				if (kb < QRBlocking<T>::WY)
+					blocks.push_back(Matrix<T>());
+				else
+					blocks.push_back(qrBlockReflector(qrPanelVectors(M, k, kb), tau, k, kb));
+			}
+
+			return QRFactorization<T>(std::move(M), std::move(tau), std::move(blocks), nb);
+		}
+
+		for (uint k = 0; k < reflectors; k += nb)
+		{
+			uint kb = std::min(nb, reflectors - k);
+
+			qrFactorPanel(M, k, kb, tau);
+
+			// Panels with few reflectors are always applied one reflector at a time and need no T
+			if (kb < QRBlocking<T>::WY)
+			{
+				blocks.push_back(Matrix<T>());
+
+				if (k + kb < n)
+					qrApplyReflectors(M, tau, k, kb, M.row(k) + k + kb, n - k - kb, M.getStride(), true);
+			}
+			else
+			{
+				blocks.push_back(qrBlockReflector(qrPanelVectors(M, k, kb), tau, k, kb));
+
+				if (k + kb < n)
+					qrApplyBlock(M.row(k) + k, m - k, kb, M.getStride(), blocks.back(), M.row(k) + k + kb, n - k - kb, M.getStride(), true);
+			}
+		}
+
+		return QRFactorization<T>(std::move(M), std::move(tau), std::move(blocks), nb);
+	}
+
+	/*! qrFactor
+	* Calculate A = Q * R by Householder reflectors on a copy of the matrix
+	* Matrix<T> M: The matrix A, m x n
+	* return: The factorization
+	*/
+	template <typename T>
+	QRFactorization<T> qrFactor(const Matrix<T>& M)
+	{
+		return qrFactor(Matrix<T>(M));
+	}
+
+	/*! leastSquares
+	* Calculate the x that minimizes ||Ax - b|| by the QR factorization of A
+	* Use qrFactor and QRFactorization::leastSquares to fit many b with the same A
+	* Matrix<T> M: The matrix A, m x n with m >= n and full column rank
+	* Matrix<T> vectorB: The vector b, or a matrix with one b per column
+	* T error: Values of the diagonal of R up to error (absolute) mean A has not full column rank
+	* return: The vector x
+	*/
+	template <typename T>
+	Matrix<T> leastSquares(const Matrix<T>& M, const Matrix<T>& vectorB, const T error)
+	{
+		return qrFactor(M).leastSquares(vectorB, error);
+	}
+
+	/*! qrFactor
+	* Calculate A = Q * R of an expression or a view, evaluated once into the factorization
+	* MatrixExpression<E> M: The matrix A, m x n
+	* return: The factorization
+	*/
+	template <typename E>
+	QRFactorization<typename E::ValueType> qrFactor(const MatrixExpression<E>& M)
+	{
+		return qrFactor(Matrix<typename E::ValueType>(M));
+	}
+
+	/*! leastSquares
+	* Calculate the x that minimizes ||Ax - b|| for A an expression or a view
+	* MatrixExpression<E> M: The matrix A, m x n with m >= n and full column rank
+	* Matrix<T> vectorB: The vector b, or a matrix with one b per column
+	* T error: Values of the diagonal of R up to error (absolute) mean A has not full column rank
+	* return: The vector x
+	*/
+	template <typename E>
+	Matrix<typename E::ValueType> leastSquares(const MatrixExpression<E>& M, const Matrix<typename E::ValueType>& vectorB, const typename E::ValueType error)
+	{
+		return qrFactor(M).leastSquares(vectorB, error);
+	}
+
+}
+
+#endif
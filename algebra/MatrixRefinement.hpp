@@ -0,0 +1,234 @@
+#ifndef MATRIX_REFINEMENT_HPP
+#define MATRIX_REFINEMENT_HPP
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "Matrix.hpp"
+#include "MatrixLU.hpp"
+#include "ThreadPool.hpp"
+#include "HalfFloat.hpp"
+
+namespace lito {
+
+	/*! RefinementSettings
+	* Stop criteria of the mixed precision solver
+	* uint maxIterations: Maximum quantities of refinement steps before the full precision solve
+	* T tolerance: Backward error to reach, zero uses epsilon * sqrt(n) of T
+	* T stallRatio: A step that does not multiply the backward error by at most this ratio stalls the refinement
+	* T error: Pivots with absolute value up to error mark the matrix as singular
+	*/
+	template <typename T>
+	struct RefinementSettings {
+		RefinementSettings(uint maxIterations = 30, T tolerance = T(0), T stallRatio = T(0.5), T error = T(0))
+			: maxIterations(maxIterations)
+			, tolerance(tolerance)
+			, stallRatio(stallRatio)
+			, error(error)
+		{}
+
+		uint maxIterations;
+		T tolerance;
+		T stallRatio;
+		T error;
+	};
+
+	/*! RefinementStatistics
+	* Result of the mixed precision solver
+	* uint iterations: Refinement steps done
+	* T backwardError: Last max ||b - A * x|| / (||A|| * ||x|| + ||b||) of the columns, infinity norms
+	* bool converged: If the tolerance was reached
+	* bool fallback: If the refinement failed or stalled and the system was solved by the full precision factorization
+	*/
+	template <typename T>
+	struct RefinementStatistics {
+		uint iterations;
+		T backwardError;
+		bool converged;
+		bool fallback;
+	};
+
+	template <typename L, typename T> RefinementStatistics<T> solveMixedPrecision(const Matrix<T>& A, const Matrix<T>& B, Matrix<T>& X, const RefinementSettings<T>& settings = RefinementSettings<T>());
+	template <typename T> RefinementStatistics<T> solveMixedPrecision(const Matrix<T>& A, const Matrix<T>& B, Matrix<T>& X, const RefinementSettings<T>& settings = RefinementSettings<T>());
+
+	template <typename U, typename T> Matrix<U> convertMatrix(const Matrix<T>& M);
+	template <typename T> T refinementNorm(const Matrix<T>& A);
+	template <typename T> T refinementBackwardError(const T& normA, const Matrix<T>& B, const Matrix<T>& X, const Matrix<T>& R);
+
+
+
+	/*! solveMixedPrecision
+	* Solve AX=B factorizing A in the low precision L and refining X in the precision T of A
+	* The LU of A in L takes half of the time and memory traffic of the LU in T; each step calculates the residual
+	* R = B - A * X in T and adds the correction solved by the factorization in L, until the backward error reaches
+	* the tolerance. When the factorization in L is singular or overflows, or the refinement stalls or does not reach
+	* the tolerance in maxIterations steps, the system is solved by the LU in T
+	* Matrix<T> A: The square matrix A
+	* Matrix<T> B: The vector b, or a matrix with one b per column
+	* Matrix<T> X: Receives the solution
+	* RefinementSettings<T> settings: The stop criteria
+	* Type L: Precision of the factorization, float by default
+	* return: The refinement steps, the backward error and if the full precision solve was used
+	*/
+	template <typename L, typename T>
+	RefinementStatistics<T> solveMixedPrecision(const Matrix<T>& A, const Matrix<T>& B, Matrix<T>& X, const RefinementSettings<T>& settings)
+	{
+		if (A.getRows() * A.getColumns() == 0 || B.getRows() * B.getColumns() == 0)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+		else if (A.getRows() != A.getColumns())
+			throw(MatrixException(MatrixExceptionType::INVALID_SIZE, A.getRows(), A.getColumns()));
+		else if (B.getRows() != A.getRows())
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, A.getRows(), A.getColumns(), B.getRows(), B.getColumns(), 'X'));
+
+		const uint n = A.getRows();
+		const T normA = refinementNorm(A);
+		const T tolerance = (settings.tolerance > T(0)) ? settings.tolerance : std::numeric_limits<T>::epsilon() * std::sqrt(T(n));
+		RefinementStatistics<T> statistics = { 0, std::numeric_limits<T>::infinity(), false, false };
+		LUFactorization<L> lowLU = luFactor(convertMatrix<L>(A), L(settings.error));
+		Matrix<T> R(B.getAllocator());
+
+		if (!lowLU.isSingular())
+		{
+			T previous = std::numeric_limits<T>::infinity();
+
+			X = convertMatrix<T>(lowLU.solve(convertMatrix<L>(B)));
+
+			while (true)
+			{
+				R = B;
+				gemmKernel(n, B.getColumns(), n, T(-1), A.data(), A.getStride(), 1, X.data(), X.getStride(), 1, T(1), R.data(), R.getStride());
+				statistics.backwardError = refinementBackwardError(normA, B, X, R);
+
+				if (statistics.backwardError <= tolerance)
+				{
+					statistics.converged = true;
+					return statistics;
+				}
+
+				// NaN fails every comparison, so an overflow in L also ends the refinement here
+				if (!(statistics.backwardError <= settings.stallRatio * previous) || statistics.iterations >= settings.maxIterations)
+					break;
+
+				const Matrix<T> correction = convertMatrix<T>(lowLU.solve(convertMatrix<L>(R)));
+
+				for (uint i = 0; i < n; i++)
+					simdKernels<T>().axpy(B.getColumns(), T(1), correction.row(i), X.row(i));
+
+				previous = statistics.backwardError;
+				statistics.iterations++;
+			}
+		}
+
+		statistics.fallback = true;
+		X = luFactor(A, settings.error).solve(B);
+
+		R = B;
+		gemmKernel(n, B.getColumns(), n, T(-1), A.data(), A.getStride(), 1, X.data(), X.getStride(), 1, T(1), R.data(), R.getStride());
+		statistics.backwardError = refinementBackwardError(normA, B, X, R);
+		statistics.converged = statistics.backwardError <= tolerance;
+
+		return statistics;
+	}
+
+	/*! solveMixedPrecision
+	* Solve AX=B factorizing A in float and refining X in the precision T of A
+	* Matrix<T> A: The square matrix A
+	* Matrix<T> B: The vector b, or a matrix with one b per column
+	* Matrix<T> X: Receives the solution
+	* RefinementSettings<T> settings: The stop criteria
+	* return: The refinement steps, the backward error and if the full precision solve was used
+	*/
+	template <typename T>
+	RefinementStatistics<T> solveMixedPrecision(const Matrix<T>& A, const Matrix<T>& B, Matrix<T>& X, const RefinementSettings<T>& settings)
+	{
+		return solveMixedPrecision<float, T>(A, B, X, settings);
+	}
+
+	/*! convertMatrix
+	* Copy a matrix converting its values to another type, by the bulk conversions between float and half or bfloat16
+	* Matrix<T> M: The matrix
+	* Type U: Type of the values of the copy
+	* return: The copy, with the allocator of M
+	*/
+	template <typename U, typename T>
+	Matrix<U> convertMatrix(const Matrix<T>& M)
+	{
+		Matrix<U> converted(M.getAllocator());
+		const uint columns = M.getColumns();
+
+		converted.resize(M.getRows(), columns);
+
+		parallelFor(0, M.getRows(), double(M.getRows()) * columns, [&](uint from, uint to)
+		{
+			for (uint i = from; i < to; i++)
+				convertValues(columns, M.row(i), converted.row(i));
+		});
+
+		return converted;
+	}
+
+	/*! refinementNorm
+	* Calculate the infinity norm of a matrix, the max sum of the absolute values of a line
+	* Matrix<T> A: The matrix
+	* return: The norm
+	*/
+	template <typename T>
+	T refinementNorm(const Matrix<T>& A)
+	{
+		T norm = T(0);
+
+		for (uint i = 0; i < A.getRows(); i++)
+		{
+			const T* line = A.row(i);
+			T sum = T(0);
+
+			for (uint j = 0; j < A.getColumns(); j++)
+				sum += std::abs(line[j]);
+
+			norm = std::max(norm, sum);
+		}
+
+		return norm;
+	}
+
+	/*! refinementBackwardError
+	* Calculate the max of the normwise backward errors ||r|| / (||A|| * ||x|| + ||b||) of the columns, infinity norms
+	* T normA: Infinity norm of A
+	* Matrix<T> B: The matrix B
+	* Matrix<T> X: The solution X
+	* Matrix<T> R: The residual B - A * X
+	* return: The backward error, NaN when X or R has NaN
+	*/
+	template <typename T>
+	T refinementBackwardError(const T& normA, const Matrix<T>& B, const Matrix<T>& X, const Matrix<T>& R)
+	{
+		const uint columns = B.getColumns();
+		std::vector<T> normB(columns, T(0)), normX(columns, T(0)), normR(columns, T(0));
+		T backwardError = T(0);
+
+		for (uint i = 0; i < B.getRows(); i++)
+		{
+			for (uint j = 0; j < columns; j++)
+			{
+				normB[j] = std::max(normB[j], std::abs(B.row(i)[j]));
+				normX[j] = std::max(normX[j], std::abs(X.row(i)[j]));
+				normR[j] = (normR[j] < std::abs(R.row(i)[j]) || std::isnan(R.row(i)[j])) ? std::abs(R.row(i)[j]) : normR[j];
+			}
+		}
+
+		for (uint j = 0; j < columns; j++)
+		{
+			const T scale = (normA * normX[j]) + normB[j];
+			const T columnError = (normR[j] == T(0)) ? T(0) : normR[j] / scale;
+
+			if (std::isnan(columnError) || columnError > backwardError)
+				backwardError = columnError;
+		}
+
+		return backwardError;
+	}
+
+}
+
+#endif
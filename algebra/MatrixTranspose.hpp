@@ -0,0 +1,221 @@
+#ifndef MATRIX_TRANSPOSE_HPP
+#define MATRIX_TRANSPOSE_HPP
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include "MatrixEnum.hpp"
+#include "SimdKernels.hpp"
+#include "ThreadPool.hpp"
+
+namespace lito {
+
+	/*! TransposeBlocking
+	* Sizes of the blocks used by the transposition
+	* TILE x TILE: Tile transposed in registers by the SIMD kernel
+	* BLOCK x BLOCK: Block whose source and destination lines stay in L1/L2 and in the TLB while its tiles are transposed
+	*/
+	struct TransposeBlocking {
+		static const uint TILE = 8;
+		static const uint BLOCK = 64;
+	};
+
+	template <typename T> void transposeKernel(uint rows, uint columns, const T* A, uint strideA, T* B, uint strideB);
+	template <typename T> void transposeBlock(uint rows, uint columns, const T* A, uint strideA, T* B, uint strideB);
+	template <typename T> void transposeSquareInPlace(uint n, T* A, uint stride);
+	template <typename T> void transposeSwapBlocks(uint line, uint column, uint rows, uint columns, T* A, uint stride);
+	template <typename T> void transposeInPlace(uint rows, uint columns, T* A);
+
+
+
+	/*! transposeKernel
+	* Calculate B = A^T by blocks of tiles, in parallel over the bands of columns of A
+	* uint rows: Quantities of rows of A
+	* uint columns: Quantities of columns of A
+	* T* A: The matrix A
+	* uint strideA: Distance between two rows of A
+	* T* B: The matrix B, columns x rows, must not overlap A
+	* uint strideB: Distance between two rows of B
+	*/
+	template <typename T>
+	void transposeKernel(uint rows, uint columns, const T* A, uint strideA, T* B, uint strideB)
+	{
+		const uint BLOCK = TransposeBlocking::BLOCK;
+		const uint bands = (columns + BLOCK - 1) / BLOCK;
+
+		if (rows == 0 || columns == 0)
+			return;
+
+		parallelFor(0, bands, double(rows) * columns, [&](uint from, uint to)
+		{
+			for (uint band = from; band < to; band++)
+			{
+				const uint j = band * BLOCK;
+				const uint jb = std::min(BLOCK, columns - j);
+
+				for (uint i = 0; i < rows; i += BLOCK)
+				{
+					const uint ib = std::min(BLOCK, rows - i);
+
+					transposeBlock(ib, jb, A + (size_t(i) * strideA) + j, strideA, B + (size_t(j) * strideB) + i, strideB);
+				}
+			}
+		});
+	}
+
+	/*! transposeBlock
+	* Calculate B = A^T for a block, the full tiles by the SIMD kernel and the borders value to value
+	* uint rows: Quantities of rows of A
+	* uint columns: Quantities of columns of A
+	* T* A: The block A
+	* uint strideA: Distance between two rows of A
+	* T* B: The block B, must not overlap A
+	* uint strideB: Distance between two rows of B
+	*/
+	template <typename T>
+	void transposeBlock(uint rows, uint columns, const T* A, uint strideA, T* B, uint strideB)
+	{
+		const uint TILE = TransposeBlocking::TILE;
+		const uint tileRows = rows - (rows % TILE);
+		const uint tileColumns = columns - (columns % TILE);
+		void (*transposeTile)(const T*, uint, T*, uint) = simdKernels<T>().transposeTile;
+
+		for (uint i = 0; i < tileRows; i += TILE)
+			for (uint j = 0; j < tileColumns; j += TILE)
+				transposeTile(A + (size_t(i) * strideA) + j, strideA, B + (size_t(j) * strideB) + i, strideB);
+
+		for (uint i = 0; i < rows; i++)
+		{
+			const T* line = A + (size_t(i) * strideA);
+
+			for (uint j = (i < tileRows) ? tileColumns : 0; j < columns; j++)
+				B[(size_t(j) * strideB) + i] = line[j];
+		}
+	}
+
+	/*! transposeSquareInPlace
+	* Transpose a square matrix in its own storage, swapping each block above the diagonal with the one below it
+	* The bands of blocks are paired, the first with the last, so the threads get the same work
+	* uint n: Quantities of rows and columns
+	* T* A: The matrix
+	* uint stride: Distance between two rows
+	*/
+	template <typename T>
+	void transposeSquareInPlace(uint n, T* A, uint stride)
+	{
+		const uint BLOCK = TransposeBlocking::BLOCK;
+		const uint bands = (n + BLOCK - 1) / BLOCK;
+
+		auto swapBand = [&](uint band)
+		{
+			const uint i = band * BLOCK;
+			const uint ib = std::min(BLOCK, n - i);
+
+			for (uint j = i; j < n; j += BLOCK)
+				transposeSwapBlocks(i, j, ib, std::min(BLOCK, n - j), A, stride);
+		};
+
+		parallelFor(0, (bands + 1) / 2, 0.5 * n * n, [&](uint from, uint to)
+		{
+			for (uint pair = from; pair < to; pair++)
+			{
+				swapBand(pair);
+
+				if (bands - 1 - pair != pair)
+					swapBand(bands - 1 - pair);
+			}
+		});
+	}
+
+	/*! transposeSwapBlocks
+	* Swap the block (line, column) of a square matrix with the transpose of the block (column, line)
+	* A block in the diagonal (line == column) is transposed in place
+	* Each full tile is transposed to a buffer, its mirror is transposed over it and the buffer is copied to the mirror
+	* uint line: First line of the block
+	* uint column: First column of the block, column >= line
+	* uint rows: Quantities of rows of the block
+	* uint columns: Quantities of columns of the block
+	* T* A: The matrix
+	* uint stride: Distance between two rows
+	*/
+	template <typename T>
+	void transposeSwapBlocks(uint line, uint column, uint rows, uint columns, T* A, uint stride)
+	{
+		const uint TILE = TransposeBlocking::TILE;
+		const uint tileRows = rows - (rows % TILE);
+		const uint tileColumns = columns - (columns % TILE);
+		const bool diagonal = line == column;
+		void (*transposeTile)(const T*, uint, T*, uint) = simdKernels<T>().transposeTile;
+		T buffer[TILE * TILE];
+
+		for (uint i = 0; i < tileRows; i += TILE)
+		{
+			for (uint j = diagonal ? i : 0; j < tileColumns; j += TILE)
+			{
+				T* upper = A + (size_t(line + i) * stride) + column + j;
+				T* lower = A + (size_t(column + j) * stride) + line + i;
+
+				transposeTile(upper, stride, buffer, TILE);
+
+				if (upper != lower)
+					transposeTile(lower, stride, upper, stride);
+
+				for (uint k = 0; k < TILE; k++)
+					std::copy(buffer + (k * TILE), buffer + ((k + 1) * TILE), lower + (size_t(k) * stride));
+			}
+		}
+
+		for (uint i = 0; i < rows; i++)
+		{
+			for (uint j = (i < tileRows) ? tileColumns : 0; j < columns; j++)
+			{
+				if (diagonal && j <= i)
+					continue;
+
+				std::swap(A[(size_t(line + i) * stride) + column + j], A[(size_t(column + j) * stride) + line + i]);
+			}
+		}
+	}
+
+	/*! transposeInPlace
+	* Transpose a rectangular matrix stored without padding in its own storage by following the cycles of the permutation
+	* The value (i, j) in the position p = i * columns + j goes to j * rows + i; a bit per value marks the ones already moved,
+	* so the extra memory is 1/8 byte per value instead of a copy of the matrix
+	* uint rows: Quantities of rows, the matrix has columns x rows after the call
+	* uint columns: Quantities of columns
+	* T* A: The matrix, with distance columns between two rows
+	*/
+	template <typename T>
+	void transposeInPlace(uint rows, uint columns, T* A)
+	{
+		const size_t size = size_t(rows) * columns;
+
+		if (rows <= 1 || columns <= 1)
+			return;
+
+		const size_t last = size - 1;
+		std::vector<bool> moved(size, false);
+
+		for (size_t start = 1; start < last; start++)
+		{
+			if (moved[start])
+				continue;
+
+			size_t position = start;
+			T value = std::move(A[start]);
+
+			do
+			{
+				const size_t next = ((position % columns) * rows) + (position / columns);
+
+				std::swap(value, A[next]);
+				moved[next] = true;
+				position = next;
+			} while (position != start);
+		}
+	}
+
+}
+
+#endif
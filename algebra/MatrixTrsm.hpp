@@ -0,0 +1,346 @@
+#ifndef MATRIX_TRSM_HPP
+#define MATRIX_TRSM_HPP
+
+#include <cstddef>
+#include <algorithm>
+#include "MatrixEnum.hpp"
+#include "MatrixException.hpp"
+#include "SimdKernels.hpp"
+#include "ThreadPool.hpp"
+#include "MatrixGemm.hpp"
+#include "MatrixGemv.hpp"
+#include "MatrixView.hpp"
+#include "MatrixBlas.hpp"
+
+namespace lito {
+
+	/*! TrsmBlocking
+	* Sizes of the blocks used by the triangular solve with many right-hand sides
+	* NB: Size of the diagonal blocks, also the depth of the GEMM that applies a solved block to the others
+	* RB: Minimum right-hand sides of a task, so each GEMM still has a few register tiles of width
+	*/
+	template <typename T>
+	struct TrsmBlocking {
+		static const uint NB = 128;
+		static const uint RB = 32;
+	};
+
+	template <typename T> void trsmKernel(MatrixSide side, MatrixTriangle triangle, MatrixDiagonal diagonal, uint m, uint n, const T& alpha, const T* A, uint rowStrideA, uint columnStrideA, T* B, uint rowStrideB);
+	template <typename T> void trsmLeft(MatrixTriangle triangle, MatrixDiagonal diagonal, uint m, uint n, const T* A, uint rowStrideA, uint columnStrideA, T* B, uint rowStrideB);
+	template <typename T> void trsmRight(MatrixTriangle triangle, MatrixDiagonal diagonal, uint m, uint n, const T* A, uint rowStrideA, uint columnStrideA, T* B, uint rowStrideB);
+	template <typename T> void trsmDiagonalLeft(MatrixTriangle triangle, MatrixDiagonal diagonal, uint kb, uint n, const T* A, uint rowStrideA, uint columnStrideA, T* B, uint rowStrideB);
+	template <typename T> void trsmDiagonalRight(MatrixTriangle triangle, MatrixDiagonal diagonal, uint m, uint kb, const T* A, uint rowStrideA, uint columnStrideA, T* B, uint rowStrideB);
+
+	template <typename T> void trsm(MatrixSide side, MatrixTriangle triangle, MatrixDiagonal diagonal, const T& alpha, const ConstMatrixView<T>& A, MatrixView<T> B);
+
+
+
+	/*! trsmKernel
+	* Solve A * X = alpha * B (LEFT) or X * A = alpha * B (RIGHT) writing X over B, for a triangular A
+	* The triangle is walked in diagonal blocks of NB: each block is solved by the axpy and scale kernels
+	* and applied to the rest of B by gemmKernel, so almost all the work is GEMM
+	* The right-hand sides are independent, the columns of B for LEFT and the rows for RIGHT,
+	* so with the PARALLEL policy they are split among the threads in tasks of at least RB;
+	* a single one is solved by trsvKernel
+	* When the build has a system CBLAS, float and double systems go to it
+	* The diagonal is not checked, a zero gives infinities as in the division
+	* MatrixSide side: LEFT or RIGHT, the side of A
+	* MatrixTriangle triangle: LOWER or UPPER, the values of the other triangle are not read
+	* MatrixDiagonal diagonal: NON_UNIT, or UNIT to take the diagonal as ones without reading it
+	* uint m: Quantities of rows of B
+	* uint n: Quantities of columns of B
+	* T alpha: Value multiplied to B, when zero X is zeros
+	* T* A: First value of A, m x m for LEFT and n x n for RIGHT
+	* uint rowStrideA: Distance between two rows of A
+	* uint columnStrideA: Distance between two columns of A
+	* T* B: First value of B, replaced by X, must not overlap A
+	* uint rowStrideB: Distance between two rows of B
+	*/
+	template <typename T>
+	void trsmKernel(MatrixSide side, MatrixTriangle triangle, MatrixDiagonal diagonal, uint m, uint n, const T& alpha, const T* A, uint rowStrideA, uint columnStrideA, T* B, uint rowStrideB)
+	{
+		const uint RB = TrsmBlocking<T>::RB;
+
+		if (m == 0 || n == 0 || blasTrsm(side, triangle, diagonal, m, n, alpha, A, rowStrideA, columnStrideA, B, rowStrideB))
+			return;
+
+		for (uint i = 0; i < m; i++)
+		{
+			T* lineB = B + (size_t(i) * rowStrideB);
+
+			if (alpha == T(0))
+				std::fill(lineB, lineB + n, T(0));
+			else if (alpha != T(1))
+				simdKernels<T>().scale(n, alpha, lineB);
+		}
+
+		if (alpha == T(0))
+			return;
+
+		if (side == MatrixSide::LEFT)
+		{
+			if (n == 1)
+			{
+				trsvKernel(m, triangle, diagonal, A, rowStrideA, columnStrideA, B, rowStrideB);
+				return;
+			}
+
+			uint tasks = (n + RB - 1) / RB;
+
+			parallelFor(0, tasks, double(m) * m * n, [&](uint from, uint to)
+			{
+				uint columnBegin = from * RB;
+				uint columnEnd = std::min(n, to * RB);
+
+				trsmLeft(triangle, diagonal, m, columnEnd - columnBegin, A, rowStrideA, columnStrideA, B + columnBegin, rowStrideB);
+			});
+		}
+		else
+		{
+			// A row x of B solves x * A = b, that is A^T * x^T = b^T
+			if (m == 1)
+			{
+				MatrixTriangle transposed = (triangle == MatrixTriangle::LOWER) ? MatrixTriangle::UPPER : MatrixTriangle::LOWER;
+
+				trsvKernel(n, transposed, diagonal, A, columnStrideA, rowStrideA, B, 1);
+				return;
+			}
+
+			uint tasks = (m + RB - 1) / RB;
+
+			parallelFor(0, tasks, double(n) * n * m, [&](uint from, uint to)
+			{
+				uint lineBegin = from * RB;
+				uint lineEnd = std::min(m, to * RB);
+
+				trsmRight(triangle, diagonal, lineEnd - lineBegin, n, A, rowStrideA, columnStrideA, B + (size_t(lineBegin) * rowStrideB), rowStrideB);
+			});
+		}
+	}
+
+	/*! trsmLeft
+	* Solve A * X = B writing X over B for a range of columns of B, block of NB lines by block of NB lines
+	* MatrixTriangle triangle: LOWER or UPPER
+	* MatrixDiagonal diagonal: NON_UNIT or UNIT
+	* uint m: Quantities of rows of A and B
+	* uint n: Quantities of columns of the range of B
+	* T* A: First value of A
+	* uint rowStrideA: Distance between two rows of A
+	* uint columnStrideA: Distance between two columns of A
+	* T* B: First value of the range of B
+	* uint rowStrideB: Distance between two rows of B
+	*/
+	template <typename T>
+	void trsmLeft(MatrixTriangle triangle, MatrixDiagonal diagonal, uint m, uint n, const T* A, uint rowStrideA, uint columnStrideA, T* B, uint rowStrideB)
+	{
+		const uint NB = TrsmBlocking<T>::NB;
+
+		if (triangle == MatrixTriangle::LOWER)
+		{
+			for (uint k = 0; k < m; k += NB)
+			{
+				uint kb = std::min(NB, m - k);
+				const T* blockA = A + (size_t(k) * rowStrideA) + (size_t(k) * columnStrideA);
+				T* blockB = B + (size_t(k) * rowStrideB);
+
+				trsmDiagonalLeft(triangle, diagonal, kb, n, blockA, rowStrideA, columnStrideA, blockB, rowStrideB);
+
+				// The lines below take the lines just solved, B[k + kb:] -= A[k + kb:, k:k + kb] * X[k:k + kb]
+				gemmKernel(m - k - kb, n, kb, T(-1), blockA + (size_t(kb) * rowStrideA), rowStrideA, columnStrideA,
+				           blockB, rowStrideB, 1, T(1), blockB + (size_t(kb) * rowStrideB), rowStrideB);
+			}
+		}
+		else
+		{
+			for (uint end = m; end > 0;)
+			{
+				uint kb = std::min(NB, end);
+				uint k = end - kb;
+				T* blockB = B + (size_t(k) * rowStrideB);
+
+				trsmDiagonalLeft(triangle, diagonal, kb, n, A + (size_t(k) * rowStrideA) + (size_t(k) * columnStrideA), rowStrideA, columnStrideA, blockB, rowStrideB);
+
+				// The lines above take the lines just solved, B[:k] -= A[:k, k:end] * X[k:end]
+				gemmKernel(k, n, kb, T(-1), A + (size_t(k) * columnStrideA), rowStrideA, columnStrideA,
+				           blockB, rowStrideB, 1, T(1), B, rowStrideB);
+
+				end = k;
+			}
+		}
+	}
+
+	/*! trsmRight
+	* Solve X * A = B writing X over B for a range of rows of B, block of NB columns by block of NB columns
+	* MatrixTriangle triangle: LOWER or UPPER
+	* MatrixDiagonal diagonal: NON_UNIT or UNIT
+	* uint m: Quantities of rows of the range of B
+	* uint n: Quantities of rows of A and columns of B
+	* T* A: First value of A
+	* uint rowStrideA: Distance between two rows of A
+	* uint columnStrideA: Distance between two columns of A
+	* T* B: First value of the range of B
+	* uint rowStrideB: Distance between two rows of B
+	*/
+	template <typename T>
+	void trsmRight(MatrixTriangle triangle, MatrixDiagonal diagonal, uint m, uint n, const T* A, uint rowStrideA, uint columnStrideA, T* B, uint rowStrideB)
+	{
+		const uint NB = TrsmBlocking<T>::NB;
+
+		if (triangle == MatrixTriangle::UPPER)
+		{
+			for (uint k = 0; k < n; k += NB)
+			{
+				uint kb = std::min(NB, n - k);
+				const T* blockA = A + (size_t(k) * rowStrideA) + (size_t(k) * columnStrideA);
+
+				trsmDiagonalRight(triangle, diagonal, m, kb, blockA, rowStrideA, columnStrideA, B + k, rowStrideB);
+
+				// The columns at the right take the columns just solved, B[:, k + kb:] -= X[:, k:k + kb] * A[k:k + kb, k + kb:]
+				gemmKernel(m, n - k - kb, kb, T(-1), B + k, rowStrideB, 1,
+				           blockA + (size_t(kb) * columnStrideA), rowStrideA, columnStrideA, T(1), B + k + kb, rowStrideB);
+			}
+		}
+		else
+		{
+			for (uint end = n; end > 0;)
+			{
+				uint kb = std::min(NB, end);
+				uint k = end - kb;
+				const T* lineA = A + (size_t(k) * rowStrideA);
+
+				trsmDiagonalRight(triangle, diagonal, m, kb, lineA + (size_t(k) * columnStrideA), rowStrideA, columnStrideA, B + k, rowStrideB);
+
+				// The columns at the left take the columns just solved, B[:, :k] -= X[:, k:end] * A[k:end, :k]
+				gemmKernel(m, k, kb, T(-1), B + k, rowStrideB, 1,
+				           lineA, rowStrideA, columnStrideA, T(1), B, rowStrideB);
+
+				end = k;
+			}
+		}
+	}
+
+	/*! trsmDiagonalLeft
+	* Solve a diagonal block of trsmLeft line by line, each line of B updated as a whole by the axpy kernel
+	* MatrixTriangle triangle: LOWER or UPPER
+	* MatrixDiagonal diagonal: NON_UNIT or UNIT
+	* uint kb: Quantities of rows of the block
+	* uint n: Quantities of columns of B
+	* T* A: First value of the block of A
+	* uint rowStrideA: Distance between two rows of A
+	* uint columnStrideA: Distance between two columns of A
+	* T* B: First value of the lines of B of the block
+	* uint rowStrideB: Distance between two rows of B
+	*/
+	template <typename T>
+	void trsmDiagonalLeft(MatrixTriangle triangle, MatrixDiagonal diagonal, uint kb, uint n, const T* A, uint rowStrideA, uint columnStrideA, T* B, uint rowStrideB)
+	{
+		for (uint step = 0; step < kb; step++)
+		{
+			uint i = (triangle == MatrixTriangle::LOWER) ? step : kb - step - 1;
+			uint from = (triangle == MatrixTriangle::LOWER) ? 0 : i + 1;
+			uint to = (triangle == MatrixTriangle::LOWER) ? i : kb;
+			const T* lineA = A + (size_t(i) * rowStrideA);
+			T* lineB = B + (size_t(i) * rowStrideB);
+
+			for (uint j = from; j < to; j++)
+				if (lineA[size_t(j) * columnStrideA] != T(0))
+					simdKernels<T>().axpy(n, -lineA[size_t(j) * columnStrideA], B + (size_t(j) * rowStrideB), lineB);
+
+			if (diagonal == MatrixDiagonal::NON_UNIT)
+				simdKernels<T>().scale(n, T(1) / lineA[size_t(i) * columnStrideA], lineB);
+		}
+	}
+
+	/*! trsmDiagonalRight
+	* Solve a diagonal block of trsmRight line of B by line of B, each value solved is taken out of
+	* the others by the axpy kernel over a line of A
+	* MatrixTriangle triangle: LOWER or UPPER
+	* MatrixDiagonal diagonal: NON_UNIT or UNIT
+	* uint m: Quantities of rows of B
+	* uint kb: Quantities of columns of the block
+	* T* A: First value of the block of A
+	* uint rowStrideA: Distance between two rows of A
+	* uint columnStrideA: Distance between two columns of A
+	* T* B: First value of the columns of B of the block
+	* uint rowStrideB: Distance between two rows of B
+	*/
+	template <typename T>
+	void trsmDiagonalRight(MatrixTriangle triangle, MatrixDiagonal diagonal, uint m, uint kb, const T* A, uint rowStrideA, uint columnStrideA, T* B, uint rowStrideB)
+	{
+		for (uint i = 0; i < m; i++)
+		{
+			T* lineB = B + (size_t(i) * rowStrideB);
+
+			for (uint step = 0; step < kb; step++)
+			{
+				uint p = (triangle == MatrixTriangle::UPPER) ? step : kb - step - 1;
+				uint from = (triangle == MatrixTriangle::UPPER) ? p + 1 : 0;
+				uint to = (triangle == MatrixTriangle::UPPER) ? kb : p;
+				const T* lineA = A + (size_t(p) * rowStrideA);
+
+				if (diagonal == MatrixDiagonal::NON_UNIT)
+					lineB[p] /= lineA[size_t(p) * columnStrideA];
+
+				if (columnStrideA == 1)
+					simdKernels<T>().axpy(to - from, -lineB[p], lineA + from, lineB + from);
+				else
+					for (uint j = from; j < to; j++)
+						lineB[j] -= lineB[p] * lineA[size_t(j) * columnStrideA];
+			}
+		}
+	}
+
+	/*! trsm
+	* Solve A * X = alpha * B (LEFT) or X * A = alpha * B (RIGHT) writing X over the viewed positions of B
+	* A transposed B is solved as the transposed system, X^T * A^T = alpha * B^T or A^T * X^T = alpha * B^T,
+	* and a B that overlaps A, or without any contiguous dimension, is solved in a temporary
+	* MatrixSide side: LEFT or RIGHT, the side of A
+	* MatrixTriangle triangle: LOWER or UPPER, the values of the other triangle are not read
+	* MatrixDiagonal diagonal: NON_UNIT, or UNIT to take the diagonal as ones
+	* T alpha: Value multiplied to B
+	* ConstMatrixView<T> A: The square triangular matrix, in any layout
+	* MatrixView<T> B: The right-hand sides, replaced by X
+	*/
+	template <typename T>
+	void trsm(MatrixSide side, MatrixTriangle triangle, MatrixDiagonal diagonal, const T& alpha, const ConstMatrixView<T>& A, MatrixView<T> B)
+	{
+		uint size = (side == MatrixSide::LEFT) ? B.getRows() : B.getColumns();
+
+		if (A.getRows() != A.getColumns())
+			throw(MatrixException(MatrixExceptionType::INVALID_SIZE, A.getRows(), A.getColumns()));
+		else if (A.getRows() != size)
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, A.getRows(), A.getColumns(), B.getRows(), B.getColumns(), 'X'));
+
+		if (diagonal == MatrixDiagonal::NON_UNIT)
+			for (uint i = 0; i < size; i++)
+				if (A(i, i) == T(0))
+					throw(MatrixException(MatrixExceptionType::SINGULAR_MATRIX));
+
+		if (B.getRows() == 0 || B.getColumns() == 0)
+			return;
+
+		if (viewsOverlap(A, B) || (B.getColumnStride() != 1 && B.getRowStride() != 1))
+		{
+			Matrix<T> newMatrix(B);
+
+			trsm(side, triangle, diagonal, alpha, A, view(newMatrix));
+			B.assign(view(newMatrix));
+		}
+		else if (B.getColumnStride() == 1)
+		{
+			trsmKernel(side, triangle, diagonal, B.getRows(), B.getColumns(), alpha,
+			           A.data(), A.getRowStride(), A.getColumnStride(), B.data(), B.getRowStride());
+		}
+		else
+		{
+			MatrixSide transposedSide = (side == MatrixSide::LEFT) ? MatrixSide::RIGHT : MatrixSide::LEFT;
+			MatrixTriangle transposedTriangle = (triangle == MatrixTriangle::LOWER) ? MatrixTriangle::UPPER : MatrixTriangle::LOWER;
+
+			trsmKernel(transposedSide, transposedTriangle, diagonal, B.getColumns(), B.getRows(), alpha,
+			           A.data(), A.getColumnStride(), A.getRowStride(), B.data(), B.getColumnStride());
+		}
+	}
+
+}
+
+#endif
@@ -0,0 +1,718 @@
+#ifndef MATRIX_VIEW_HPP
+#define MATRIX_VIEW_HPP
+
+#include <algorithm>
+#include "Matrix.hpp"
+#include "MatrixExpression.hpp"
+
+namespace lito {
+
+	/*! ConstMatrixView
+	* Read only window over values stored by someone else, as a Matrix, a block of it or its transpose
+	* The value (line, column) is data[line * rowStride + column * columnStride], so a transpose only swaps
+	* the sizes and the strides and a block only moves data; nothing is copied
+	* The view is a lazy expression, it can be used wherever a MatrixExpression is accepted,
+	* and it must not outlive the values it refers to; assigning a transposed or shifted view of a matrix
+	* to the same matrix goes through a temporary, Matrix::transpose does it in place
+	*/
+	template <typename T>
+	class ConstMatrixView : public MatrixExpression<ConstMatrixView<T>> {
+	public:
+		typedef T ValueType;
+
+		ConstMatrixView();
+		ConstMatrixView(const Matrix<T>& matrix);
+		ConstMatrixView(uint rows, uint columns, const T* data, uint rowStride, uint columnStride = 1);
+
+		const uint& getRows() const;
+		const uint& getColumns() const;
+		const uint& getRowStride() const;
+		const uint& getColumnStride() const;
+		bool isTransposed() const;
+		const T* data() const;
+
+		const T& operator () (const uint& line, const uint& column) const;
+		const T& at(const uint& line, const uint& column) const;
+
+		ConstMatrixView<T> block(uint line, uint column, uint rows, uint columns) const;
+		ConstMatrixView<T> line(uint line) const;
+		ConstMatrixView<T> column(uint column) const;
+		ConstMatrixView<T> transpose() const;
+
+		bool reads(const T* data, uint rows, uint columns, uint rowStride, uint columnStride) const;
+		void apply(const Matrix<T>& vectorX, Matrix<T>& vectorY) const;
+
+	protected:
+		uint _rows;
+		uint _columns;
+		uint _rowStride;
+		uint _columnStride;
+		T* _data;
+	};
+
+	/*! MatrixView
+	* Window over values stored by someone else that can modify them, see ConstMatrixView
+	* Copying a view copies the window, assign copies values into the viewed positions
+	*/
+	template <typename T>
+	class MatrixView : public ConstMatrixView<T> {
+	public:
+		MatrixView();
+		MatrixView(Matrix<T>& matrix);
+		MatrixView(uint rows, uint columns, T* data, uint rowStride, uint columnStride = 1);
+
+		T* data() const;
+
+		T& operator () (const uint& line, const uint& column) const;
+		T& at(const uint& line, const uint& column) const;
+
+		MatrixView<T> block(uint line, uint column, uint rows, uint columns) const;
+		MatrixView<T> line(uint line) const;
+		MatrixView<T> column(uint column) const;
+		MatrixView<T> transpose() const;
+
+		MatrixView<T>& assign(const ConstMatrixView<T>& values);
+		template <typename E> MatrixView<T>& assign(const MatrixExpression<E>& expression);
+		MatrixView<T>& fill(const T& value);
+
+		template <typename E> MatrixView<T>& operator += (const MatrixExpression<E>& expression);
+		template <typename E> MatrixView<T>& operator -= (const MatrixExpression<E>& expression);
+		MatrixView<T>& operator *= (const T& mul);
+
+	private:
+		template <typename F> void forEach(const F& func);
+
+		using ConstMatrixView<T>::_rows;
+		using ConstMatrixView<T>::_columns;
+		using ConstMatrixView<T>::_rowStride;
+		using ConstMatrixView<T>::_columnStride;
+		using ConstMatrixView<T>::_data;
+	};
+
+	template <typename T> MatrixView<T> view(Matrix<T>& matrix);
+	template <typename T> ConstMatrixView<T> view(const Matrix<T>& matrix);
+
+	template <typename T> Matrix<T> operator * (const ConstMatrixView<T>& matrix1, const ConstMatrixView<T>& matrix2);
+	template <typename T> Matrix<T> operator * (const Matrix<T>& matrix1, const ConstMatrixView<T>& matrix2);
+	template <typename T> Matrix<T> operator * (const ConstMatrixView<T>& matrix1, const Matrix<T>& matrix2);
+	template <typename T> void gemm(const T& alpha, const ConstMatrixView<T>& A, const ConstMatrixView<T>& B, const T& beta, MatrixView<T> C);
+	template <typename T> bool viewsOverlap(const ConstMatrixView<T>& view1, const ConstMatrixView<T>& view2);
+
+
+
+	/*! ConstMatrixView
+	* Initialize an empty view
+	*/
+	template <typename T>
+	ConstMatrixView<T>::ConstMatrixView()
+		: _rows(0)
+		, _columns(0)
+		, _rowStride(0)
+		, _columnStride(1)
+		, _data(nullptr)
+	{}
+
+	/*! ConstMatrixView
+	* Initialize a view of all the matrix
+	* Matrix<T> matrix: The matrix viewed
+	*/
+	template <typename T>
+	ConstMatrixView<T>::ConstMatrixView(const Matrix<T>& matrix)
+		: _rows(matrix.getRows())
+		, _columns(matrix.getColumns())
+		, _rowStride(matrix.getStride())
+		, _columnStride(1)
+		, _data(const_cast<T*>(matrix.data()))
+	{}
+
+	/*! ConstMatrixView
+	* Initialize a view of values in any layout
+	* uint rows: Quantities of rows
+	* uint columns: Quantities of columns
+	* T* data: The value (0, 0)
+	* uint rowStride: Distance between two rows
+	* uint columnStride: Distance between two columns
+	*/
+	template <typename T>
+	ConstMatrixView<T>::ConstMatrixView(uint rows, uint columns, const T* data, uint rowStride, uint columnStride)
+		: _rows(rows)
+		, _columns(columns)
+		, _rowStride(rowStride)
+		, _columnStride(columnStride)
+		, _data(const_cast<T*>(data))
+	{}
+
+	/*! getRows
+	* Get the quantities of rows
+	* return: The quantities of rows
+	*/
+	template <typename T>
+	const uint& ConstMatrixView<T>::getRows() const
+	{
+		return _rows;
+	}
+
+	/*! getColumns
+	* Get the quantities of columns
+	* return: The quantities of columns
+	*/
+	template <typename T>
+	const uint& ConstMatrixView<T>::getColumns() const
+	{
+		return _columns;
+	}
+
+	/*! getRowStride
+	* Get the distance between two rows
+	* return: The distance, in values
+	*/
+	template <typename T>
+	const uint& ConstMatrixView<T>::getRowStride() const
+	{
+		return _rowStride;
+	}
+
+	/*! getColumnStride
+	* Get the distance between two columns
+	* return: The distance, in values
+	*/
+	template <typename T>
+	const uint& ConstMatrixView<T>::getColumnStride() const
+	{
+		return _columnStride;
+	}
+
+	/*! isTransposed
+	* Tell if the columns of the view are not contiguous, as in the transpose of a Matrix
+	* return: If the view is transposed
+	*/
+	template <typename T>
+	bool ConstMatrixView<T>::isTransposed() const
+	{
+		return _columnStride != 1 && _columns > 1;
+	}
+
+	/*! data
+	* Get the value (0, 0)
+	* return: Pointer to the value
+	*/
+	template <typename T>
+	const T* ConstMatrixView<T>::data() const
+	{
+		return _data;
+	}
+
+	/*! operator ()
+	* Access a value of the view without checking the position
+	* uint line: Line of the value
+	* uint column: Column of the value
+	* return: The value
+	*/
+	template <typename T>
+	const T& ConstMatrixView<T>::operator () (const uint& line, const uint& column) const
+	{
+		return _data[(size_t(line) * _rowStride) + (size_t(column) * _columnStride)];
+	}
+
+	/*! at
+	* Access a value of the view checking the position
+	* uint line: Line of the value
+	* uint column: Column of the value
+	* return: The value
+	*/
+	template <typename T>
+	const T& ConstMatrixView<T>::at(const uint& line, const uint& column) const
+	{
+		if (line >= _rows || column >= _columns)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, _rows, _columns, line, column));
+
+		return (*this)(line, column);
+	}
+
+	/*! block
+	* View a block of the view
+	* uint line: First line of the block
+	* uint column: First column of the block
+	* uint rows: Quantities of rows of the block
+	* uint columns: Quantities of columns of the block
+	* return: The view of the block
+	*/
+	template <typename T>
+	ConstMatrixView<T> ConstMatrixView<T>::block(uint line, uint column, uint rows, uint columns) const
+	{
+		if (line + rows > _rows || column + columns > _columns || line + rows < line || column + columns < column)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, _rows, _columns, line + rows, column + columns));
+
+		return ConstMatrixView<T>(rows, columns, _data + (size_t(line) * _rowStride) + (size_t(column) * _columnStride), _rowStride, _columnStride);
+	}
+
+	/*! line
+	* View a line of the view as a 1 x columns matrix
+	* uint line: The line
+	* return: The view of the line
+	*/
+	template <typename T>
+	ConstMatrixView<T> ConstMatrixView<T>::line(uint line) const
+	{
+		return block(line, 0, 1, _columns);
+	}
+
+	/*! column
+	* View a column of the view as a rows x 1 matrix
+	* uint column: The column
+	* return: The view of the column
+	*/
+	template <typename T>
+	ConstMatrixView<T> ConstMatrixView<T>::column(uint column) const
+	{
+		return block(0, column, _rows, 1);
+	}
+
+	/*! transpose
+	* View the transpose of the view, swapping the sizes and the strides
+	* return: The view transposed
+	*/
+	template <typename T>
+	ConstMatrixView<T> ConstMatrixView<T>::transpose() const
+	{
+		return ConstMatrixView<T>(_columns, _rows, _data, _columnStride, _rowStride);
+	}
+
+	/*! reads
+	* Tell if the view is read at positions of a destination other than the one evaluated, see expressionReads
+	* T* data: Value (0, 0) of the destination
+	* uint rows: Quantities of rows of the destination
+	* uint columns: Quantities of columns of the destination
+	* uint rowStride: Distance between two rows of the destination
+	* uint columnStride: Distance between two columns of the destination
+	* return: If the destination must not be written while the view is read
+	*/
+	template <typename T>
+	bool ConstMatrixView<T>::reads(const T* data, uint rows, uint columns, uint rowStride, uint columnStride) const
+	{
+		return expressionReads(_data, _rows, _columns, _rowStride, _columnStride, data, rows, columns, rowStride, columnStride);
+	}
+
+	/*! apply
+	* Calculate y = V * x, so a view can be the operator of the iterative solvers
+	* Matrix<T> vectorX: The vector x
+	* Matrix<T> vectorY: Receives the vector y
+	*/
+	template <typename T>
+	void ConstMatrixView<T>::apply(const Matrix<T>& vectorX, Matrix<T>& vectorY) const
+	{
+		if (vectorX.getRows() != _columns || vectorX.getColumns() != 1)
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, _rows, _columns, vectorX.getRows(), vectorX.getColumns(), '*'));
+
+		if (vectorY.getRows() != _rows || vectorY.getColumns() != 1)
+			vectorY.resize(_rows, 1);
+
+		gemm(T(1), *this, ConstMatrixView<T>(vectorX), T(0), MatrixView<T>(vectorY));
+	}
+
+	/*! MatrixView
+	* Initialize an empty view
+	*/
+	template <typename T>
+	MatrixView<T>::MatrixView()
+		: ConstMatrixView<T>()
+	{}
+
+	/*! MatrixView
+	* Initialize a view of all the matrix
+	* Matrix<T> matrix: The matrix viewed
+	*/
+	template <typename T>
+	MatrixView<T>::MatrixView(Matrix<T>& matrix)
+		: ConstMatrixView<T>(matrix)
+	{}
+
+	/*! MatrixView
+	* Initialize a view of values in any layout
+	* uint rows: Quantities of rows
+	* uint columns: Quantities of columns
+	* T* data: The value (0, 0)
+	* uint rowStride: Distance between two rows
+	* uint columnStride: Distance between two columns
+	*/
+	template <typename T>
+	MatrixView<T>::MatrixView(uint rows, uint columns, T* data, uint rowStride, uint columnStride)
+		: ConstMatrixView<T>(rows, columns, data, rowStride, columnStride)
+	{}
+
+	/*! data
+	* Get the value (0, 0)
+	* return: Pointer to the value
+	*/
+	template <typename T>
+	T* MatrixView<T>::data() const
+	{
+		return _data;
+	}
+
+	/*! operator ()
+	* Access a value of the view without checking the position
+	* uint line: Line of the value
+	* uint column: Column of the value
+	* return: The value
+	*/
+	template <typename T>
+	T& MatrixView<T>::operator () (const uint& line, const uint& column) const
+	{
+		return _data[(size_t(line) * _rowStride) + (size_t(column) * _columnStride)];
+	}
+
+	/*! at
+	* Access a value of the view checking the position
+	* uint line: Line of the value
+	* uint column: Column of the value
+	* return: The value
+	*/
+	template <typename T>
+	T& MatrixView<T>::at(const uint& line, const uint& column) const
+	{
+		if (line >= _rows || column >= _columns)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, _rows, _columns, line, column));
+
+		return (*this)(line, column);
+	}
+
+	/*! block
+	* View a block of the view
+	* uint line: First line of the block
+	* uint column: First column of the block
+	* uint rows: Quantities of rows of the block
+	* uint columns: Quantities of columns of the block
+	* return: The view of the block
+	*/
+	template <typename T>
+	MatrixView<T> MatrixView<T>::block(uint line, uint column, uint rows, uint columns) const
+	{
+		ConstMatrixView<T> values = ConstMatrixView<T>::block(line, column, rows, columns);
+
+		return MatrixView<T>(rows, columns, const_cast<T*>(values.data()), _rowStride, _columnStride);
+	}
+
+	/*! line
+	* View a line of the view as a 1 x columns matrix
+	* uint line: The line
+	* return: The view of the line
+	*/
+	template <typename T>
+	MatrixView<T> MatrixView<T>::line(uint line) const
+	{
+		return block(line, 0, 1, _columns);
+	}
+
+	/*! column
+	* View a column of the view as a rows x 1 matrix
+	* uint column: The column
+	* return: The view of the column
+	*/
+	template <typename T>
+	MatrixView<T> MatrixView<T>::column(uint column) const
+	{
+		return block(0, column, _rows, 1);
+	}
+
+	/*! transpose
+	* View the transpose of the view, swapping the sizes and the strides
+	* return: The view transposed
+	*/
+	template <typename T>
+	MatrixView<T> MatrixView<T>::transpose() const
+	{
+		return MatrixView<T>(_columns, _rows, _data, _columnStride, _rowStride);
+	}
+
+	/*! assign
+	* Copy values to the viewed positions; when both overlap the values are copied through a temporary
+	* A transposed view of contiguous lines is copied by tiles, see transposeKernel
+	* ConstMatrixView<T> values: The values, with the sizes of the view
+	* return: The view
+	*/
+	template <typename T>
+	MatrixView<T>& MatrixView<T>::assign(const ConstMatrixView<T>& values)
+	{
+		if (values.getRows() != _rows || values.getColumns() != _columns)
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, _rows, _columns, values.getRows(), values.getColumns(), '='));
+
+		if (viewsOverlap(*this, values))
+			return assign(Matrix<T>(values));
+
+		if (_columnStride == 1 && values.getRowStride() == 1 && values.isTransposed())
+			transposeKernel(values.getColumns(), values.getRows(), values.data(), values.getColumnStride(), _data, _rowStride);
+		else
+			forEach([&](T& value, uint i, uint j) { value = values(i, j); });
+
+		return *this;
+	}
+
+	/*! assign
+	* Evaluate an expression into the viewed positions
+	* An expression that reads viewed positions other than the one being written is evaluated apart first
+	* MatrixExpression<E> expression: The expression, with the sizes of the view
+	* return: The view
+	*/
+	template <typename T>
+	template <typename E>
+	MatrixView<T>& MatrixView<T>::assign(const MatrixExpression<E>& expression)
+	{
+		if (expression.getRows() != _rows || expression.getColumns() != _columns)
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, _rows, _columns, expression.getRows(), expression.getColumns(), '='));
+
+		const E& exp = expression.self();
+
+		if (exp.reads(_data, _rows, _columns, _rowStride, _columnStride))
+			return assign(Matrix<T>(expression));
+
+		forEach([&](T& value, uint i, uint j) { value = exp(i, j); });
+
+		return *this;
+	}
+
+	/*! fill
+	* Set all the viewed positions to a value
+	* T value: The value
+	* return: The view
+	*/
+	template <typename T>
+	MatrixView<T>& MatrixView<T>::fill(const T& value)
+	{
+		forEach([&](T& position, uint, uint) { position = value; });
+
+		return *this;
+	}
+
+	/*! operator +=
+	* Sum an expression into the viewed positions
+	* An expression that reads viewed positions other than the one being written is evaluated apart first
+	* MatrixExpression<E> expression: The expression, with the sizes of the view
+	* return: The view
+	*/
+	template <typename T>
+	template <typename E>
+	MatrixView<T>& MatrixView<T>::operator += (const MatrixExpression<E>& expression)
+	{
+		if (expression.getRows() != _rows || expression.getColumns() != _columns)
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, _rows, _columns, expression.getRows(), expression.getColumns(), '+'));
+
+		const E& exp = expression.self();
+
+		if (exp.reads(_data, _rows, _columns, _rowStride, _columnStride))
+		{
+			Matrix<T> values(expression);
+
+			return *this += ConstMatrixView<T>(values);
+		}
+
+		forEach([&](T& value, uint i, uint j) { value += exp(i, j); });
+
+		return *this;
+	}
+
+	/*! operator -=
+	* Subtract an expression from the viewed positions
+	* An expression that reads viewed positions other than the one being written is evaluated apart first
+	* MatrixExpression<E> expression: The expression, with the sizes of the view
+	* return: The view
+	*/
+	template <typename T>
+	template <typename E>
+	MatrixView<T>& MatrixView<T>::operator -= (const MatrixExpression<E>& expression)
+	{
+		if (expression.getRows() != _rows || expression.getColumns() != _columns)
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, _rows, _columns, expression.getRows(), expression.getColumns(), '-'));
+
+		const E& exp = expression.self();
+
+		if (exp.reads(_data, _rows, _columns, _rowStride, _columnStride))
+		{
+			Matrix<T> values(expression);
+
+			return *this -= ConstMatrixView<T>(values);
+		}
+
+		forEach([&](T& value, uint i, uint j) { value -= exp(i, j); });
+
+		return *this;
+	}
+
+	/*! operator *=
+	* Multiply the viewed positions to a value
+	* T mul: Value to be multiplied
+	* return: The view
+	*/
+	template <typename T>
+	MatrixView<T>& MatrixView<T>::operator *= (const T& mul)
+	{
+		forEach([&](T& value, uint, uint) { value *= mul; });
+
+		return *this;
+	}
+
+	/*! forEach
+	* Call func(value, line, column) for each viewed position, line by line when the columns are contiguous
+	* and column by column when the view is transposed
+	* F func: The function
+	*/
+	template <typename T>
+	template <typename F>
+	void MatrixView<T>::forEach(const F& func)
+	{
+		if (this->isTransposed() && _rowStride == 1)
+		{
+			for (uint j = 0; j < _columns; j++)
+			{
+				T* column = _data + (size_t(j) * _columnStride);
+
+				for (uint i = 0; i < _rows; i++)
+					func(column[i], i, j);
+			}
+		}
+		else
+		{
+			for (uint i = 0; i < _rows; i++)
+			{
+				T* line = _data + (size_t(i) * _rowStride);
+
+				for (uint j = 0; j < _columns; j++)
+					func(line[size_t(j) * _columnStride], i, j);
+			}
+		}
+	}
+
+	/*! view
+	* View all the matrix, allowing to modify it
+	* Matrix<T> matrix: The matrix
+	* return: The view
+	*/
+	template <typename T>
+	MatrixView<T> view(Matrix<T>& matrix)
+	{
+		return MatrixView<T>(matrix);
+	}
+
+	/*! view
+	* View all the matrix
+	* Matrix<T> matrix: The matrix
+	* return: The view
+	*/
+	template <typename T>
+	ConstMatrixView<T> view(const Matrix<T>& matrix)
+	{
+		return ConstMatrixView<T>(matrix);
+	}
+
+	/*! operator *
+	* Multiply two views by the GEMM kernel, reading the values in place whatever their strides
+	* ConstMatrixView<T> matrix1: Matrix to multiply
+	* ConstMatrixView<T> matrix2: Matrix to multiply
+	* return: The matrix of the multiplication
+	*/
+	template <typename T>
+	Matrix<T> operator * (const ConstMatrixView<T>& matrix1, const ConstMatrixView<T>& matrix2)
+	{
+		if (matrix1.getColumns() != matrix2.getRows())
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, matrix1.getRows(), matrix1.getColumns(), matrix2.getRows(), matrix2.getColumns(), 'X'));
+
+		Matrix<T> newMatrix;
+
+		newMatrix.resize(matrix1.getRows(), matrix2.getColumns());
+		gemmKernel(matrix1.getRows(), matrix2.getColumns(), matrix1.getColumns(), T(1),
+		           matrix1.data(), matrix1.getRowStride(), matrix1.getColumnStride(),
+		           matrix2.data(), matrix2.getRowStride(), matrix2.getColumnStride(),
+		           T(0), newMatrix.data(), newMatrix.getStride());
+
+		return newMatrix;
+	}
+
+	/*! operator *
+	* Multiply a matrix by a view
+	* Matrix<T> matrix1: Matrix to multiply
+	* ConstMatrixView<T> matrix2: Matrix to multiply
+	* return: The matrix of the multiplication
+	*/
+	template <typename T>
+	Matrix<T> operator * (const Matrix<T>& matrix1, const ConstMatrixView<T>& matrix2)
+	{
+		return ConstMatrixView<T>(matrix1) * matrix2;
+	}
+
+	/*! operator *
+	* Multiply a view by a matrix
+	* ConstMatrixView<T> matrix1: Matrix to multiply
+	* Matrix<T> matrix2: Matrix to multiply
+	* return: The matrix of the multiplication
+	*/
+	template <typename T>
+	Matrix<T> operator * (const ConstMatrixView<T>& matrix1, const Matrix<T>& matrix2)
+	{
+		return matrix1 * ConstMatrixView<T>(matrix2);
+	}
+
+	/*! gemm
+	* Calculate C = alpha * A * B + beta * C writing into the viewed positions of C
+	* A transposed C is calculated as C^T = B^T * A^T, and a C that overlaps A or B,
+	* or without any contiguous dimension, is calculated in a temporary
+	* T alpha: Value multiplied to A * B
+	* ConstMatrixView<T> A: Matrix to multiply
+	* ConstMatrixView<T> B: Matrix to multiply
+	* T beta: Value multiplied to C
+	* MatrixView<T> C: Matrix of the result
+	*/
+	template <typename T>
+	void gemm(const T& alpha, const ConstMatrixView<T>& A, const ConstMatrixView<T>& B, const T& beta, MatrixView<T> C)
+	{
+		if (A.getColumns() != B.getRows())
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, A.getRows(), A.getColumns(), B.getRows(), B.getColumns(), 'X'));
+		else if (C.getRows() != A.getRows() || C.getColumns() != B.getColumns())
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, A.getRows(), B.getColumns(), C.getRows(), C.getColumns(), '='));
+
+		if (C.getRows() == 0 || C.getColumns() == 0)
+			return;
+
+		if (viewsOverlap(A, C) || viewsOverlap(B, C) || (C.getColumnStride() != 1 && C.getRowStride() != 1))
+		{
+			Matrix<T> newMatrix(C);
+
+			gemm(alpha, A, B, beta, view(newMatrix));
+			C.assign(view(newMatrix));
+		}
+		else if (C.getColumnStride() == 1)
+		{
+			gemmKernel(A.getRows(), B.getColumns(), A.getColumns(), alpha,
+			           A.data(), A.getRowStride(), A.getColumnStride(),
+			           B.data(), B.getRowStride(), B.getColumnStride(),
+			           beta, C.data(), C.getRowStride());
+		}
+		else
+		{
+			gemmKernel(B.getColumns(), A.getRows(), A.getColumns(), alpha,
+			           B.data(), B.getColumnStride(), B.getRowStride(),
+			           A.data(), A.getColumnStride(), A.getRowStride(),
+			           beta, C.data(), C.getColumnStride());
+		}
+	}
+
+	/*! viewsOverlap
+	* Tell if the memory spanned by two views overlaps
+	* ConstMatrixView<T> view1: A view
+	* ConstMatrixView<T> view2: A view
+	* return: If the address ranges from the first to the last value of the views overlap
+	*/
+	template <typename T>
+	bool viewsOverlap(const ConstMatrixView<T>& view1, const ConstMatrixView<T>& view2)
+	{
+		if (view1.getRows() == 0 || view1.getColumns() == 0 || view2.getRows() == 0 || view2.getColumns() == 0)
+			return false;
+
+		const T* end1 = &view1(view1.getRows() - 1, view1.getColumns() - 1);
+		const T* end2 = &view2(view2.getRows() - 1, view2.getColumns() - 1);
+
+		return !(end1 < view2.data() || end2 < view1.data());
+	}
+
+}
+
+#endif
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include "MatrixEnum.hpp"
 #include "Vec_2.hpp"
+#include "HalfFloat.hpp"
 
 namespace lito {
 
@@ -47,6 +48,8 @@ namespace lito {
 	
 	typedef Matriz_2<float>  Matriz_2f;
 	typedef Matriz_2<double> Matriz_2d;
+	typedef Matriz_2<half>   Matriz_2h;
+	typedef Matriz_2<bfloat16> Matriz_2bf;
 	
 	template <class T> Matriz_2<T>  operator + ( const Matriz_2<T> &mat );
 	template <class T> Matriz_2<T>  operator - ( const Matriz_2<T> &mat );
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include "MatrixEnum.hpp"
 #include "Vec_3.hpp"
+#include "HalfFloat.hpp"
 
 namespace lito {
 
@@ -48,6 +49,8 @@ namespace lito {
 	
 	typedef Matriz_3<float>  Matriz_3f;
 	typedef Matriz_3<double> Matriz_3d;
+	typedef Matriz_3<half>   Matriz_3h;
+	typedef Matriz_3<bfloat16> Matriz_3bf;
 	
 	template <class T> Matriz_3<T>  operator + ( const Matriz_3<T> &mat );
 	template <class T> Matriz_3<T>  operator - ( const Matriz_3<T> &mat );
@@ -7,6 +7,8 @@
 #include "MatrixEnum.hpp"
 #include "Vec_4.hpp"
 #include "Vec_3.hpp"
+#include "SimdKernels.hpp"
+#include "HalfFloat.hpp"
 
 namespace lito {
 
@@ -50,6 +52,8 @@ namespace lito {
 	
 	typedef Matriz_4<float>  Matriz_4f;
 	typedef Matriz_4<double> Matriz_4d;
+	typedef Matriz_4<half>   Matriz_4h;
+	typedef Matriz_4<bfloat16> Matriz_4bf;
 	
 	template <class T> Matriz_4<T>  operator + ( const Matriz_4<T> &mat );
 	template <class T> Matriz_4<T>  operator - ( const Matriz_4<T> &mat );
@@ -189,6 +193,24 @@ namespace lito {
 		return mat;
 	}
 	/*===============================================================================================================================*/
+	template <>
+	inline Matriz_4<float> Matriz_4<float>::operator * ( const Matriz_4<float> &m ) {
+		Matriz_4<float> mat;
+		
+		simdKernels<float>().matrix4Mul( _val, m._val, mat._val );
+		
+		return mat;
+	}
+	/*===============================================================================================================================*/
+	template <>
+	inline Matriz_4<double> Matriz_4<double>::operator * ( const Matriz_4<double> &m ) {
+		Matriz_4<double> mat;
+		
+		simdKernels<double>().matrix4Mul( _val, m._val, mat._val );
+		
+		return mat;
+	}
+	/*===============================================================================================================================*/
 	template <class T>	
 	Vec_4<T> Matriz_4<T>::operator * ( const Vec_4<T> &v ) {
 		Vec_4<T> vet;
@@ -300,6 +322,26 @@ namespace lito {
 		return *this;
 	}
 	/*===============================================================================================================================*/
+	template <>
+	inline Matriz_4<float>& Matriz_4<float>::operator *= ( const Matriz_4<float> &m ) {
+		float mat[16];
+		
+		simdKernels<float>().matrix4Mul( _val, m._val, mat );
+		memcpy( _val, mat, sizeof(float) * 16 );
+		
+		return *this;
+	}
+	/*===============================================================================================================================*/
+	template <>
+	inline Matriz_4<double>& Matriz_4<double>::operator *= ( const Matriz_4<double> &m ) {
+		double mat[16];
+		
+		simdKernels<double>().matrix4Mul( _val, m._val, mat );
+		memcpy( _val, mat, sizeof(double) * 16 );
+		
+		return *this;
+	}
+	/*===============================================================================================================================*/
 	template <class T>	
 	Matriz_4<T>& Matriz_4<T>::operator += ( T c ) {
 		for ( size_t i = 0; i < 16; i += 5 ) {
@@ -0,0 +1,325 @@
+#ifndef PRECONDITIONERS_HPP
+#define PRECONDITIONERS_HPP
+
+#include <vector>
+#include <algorithm>
+#include "Matrix.hpp"
+#include "SparseMatrix.hpp"
+
+namespace lito {
+
+	/*! IdentityPreconditioner
+	* Preconditioner that does nothing, z = r
+	* The preconditioners give z = M^-1 * r by apply(r, z), with M close to A and cheap to solve
+	*/
+	template <typename T>
+	class IdentityPreconditioner {
+	public:
+		void apply(const Matrix<T>& vectorR, Matrix<T>& vectorZ) const;
+	};
+
+	/*! JacobiPreconditioner
+	* Preconditioner M = D, the diagonal of A
+	*/
+	template <typename T>
+	class JacobiPreconditioner {
+	public:
+		explicit JacobiPreconditioner(const SparseMatrix<T>& A);
+		explicit JacobiPreconditioner(const Matrix<T>& A);
+
+		void apply(const Matrix<T>& vectorR, Matrix<T>& vectorZ) const;
+
+	private:
+		std::vector<T> _inverseDiagonal;
+	};
+
+	/*! SSORPreconditioner
+	* Preconditioner M = w / (2 - w) * (D / w + L) * (D / w)^-1 * (D / w + U), L and U the strict triangles of A
+	* Applied by one forward and one backward sweep over the lines of A
+	*/
+	template <typename T>
+	class SSORPreconditioner {
+	public:
+		explicit SSORPreconditioner(const SparseMatrix<T>& A, const T& omega = T(1));
+
+		void apply(const Matrix<T>& vectorR, Matrix<T>& vectorZ) const;
+
+	private:
+		SparseMatrix<T> _matrix;
+		std::vector<size_t> _diagonal;
+		T _omega;
+	};
+
+	/*! ILU0Preconditioner
+	* Preconditioner M = L * U, the incomplete LU factorization of A with the positions of the values of A only
+	* L (unit diagonal) and U are stored together in the same positions of A
+	*/
+	template <typename T>
+	class ILU0Preconditioner {
+	public:
+		explicit ILU0Preconditioner(const SparseMatrix<T>& A);
+
+		const SparseMatrix<T>& getLU() const;
+
+		void apply(const Matrix<T>& vectorR, Matrix<T>& vectorZ) const;
+
+	private:
+		SparseMatrix<T> _lu;
+		std::vector<size_t> _diagonal;
+	};
+
+	template <typename T> std::vector<size_t> sparseDiagonal(const SparseMatrix<T>& A);
+
+
+
+	/*! apply
+	* Calculate z = r
+	* Matrix<T> vectorR: The vector r
+	* Matrix<T> vectorZ: Receives the vector z
+	*/
+	template <typename T>
+	void IdentityPreconditioner<T>::apply(const Matrix<T>& vectorR, Matrix<T>& vectorZ) const
+	{
+		vectorZ = vectorR;
+	}
+
+	/*! JacobiPreconditioner
+	* Initialize the preconditioner with the diagonal of a sparse matrix
+	* SparseMatrix<T> A: The matrix A, square
+	*/
+	template <typename T>
+	JacobiPreconditioner<T>::JacobiPreconditioner(const SparseMatrix<T>& A)
+	{
+		std::vector<size_t> diagonal = sparseDiagonal(A);
+
+		_inverseDiagonal.resize(diagonal.size());
+
+		for (uint i = 0; i < diagonal.size(); i++)
+			_inverseDiagonal[i] = T(1) / A.getValues()[diagonal[i]];
+	}
+
+	/*! JacobiPreconditioner
+	* Initialize the preconditioner with the diagonal of a dense matrix
+	* Matrix<T> A: The matrix A, square
+	*/
+	template <typename T>
+	JacobiPreconditioner<T>::JacobiPreconditioner(const Matrix<T>& A)
+	{
+		if (A.getRows() != A.getColumns())
+			throw(MatrixException(MatrixExceptionType::INVALID_SIZE, A.getRows(), A.getColumns()));
+
+		_inverseDiagonal.resize(A.getRows());
+
+		for (uint i = 0; i < A.getRows(); i++)
+		{
+			if (A.row(i)[i] == T(0))
+				throw(MatrixException(MatrixExceptionType::SINGULAR_MATRIX));
+
+			_inverseDiagonal[i] = T(1) / A.row(i)[i];
+		}
+	}
+
+	/*! apply
+	* Calculate z = D^-1 * r
+	* Matrix<T> vectorR: The vector r
+	* Matrix<T> vectorZ: Receives the vector z
+	*/
+	template <typename T>
+	void JacobiPreconditioner<T>::apply(const Matrix<T>& vectorR, Matrix<T>& vectorZ) const
+	{
+		uint n = uint(_inverseDiagonal.size());
+
+		if (vectorR.getRows() != n || vectorR.getColumns() != 1)
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, n, n, vectorR.getRows(), vectorR.getColumns(), '*'));
+
+		if (vectorZ.getRows() != n || vectorZ.getColumns() != 1)
+			vectorZ.resize(n, 1);
+
+		parallelFor(0, n, double(n), [&](uint from, uint to)
+		{
+			for (uint i = from; i < to; i++)
+				vectorZ.row(i)[0] = _inverseDiagonal[i] * vectorR.row(i)[0];
+		});
+	}
+
+	/*! SSORPreconditioner
+	* Initialize the preconditioner
+	* SparseMatrix<T> A: The matrix A, square with no zero in the diagonal
+	* T omega: Relaxation, between 0 and 2, 1 for symmetric Gauss-Seidel
+	*/
+	template <typename T>
+	SSORPreconditioner<T>::SSORPreconditioner(const SparseMatrix<T>& A, const T& omega)
+		: _matrix(A.toFormat(SparseFormat::CSR))
+		, _diagonal(sparseDiagonal(_matrix))
+		, _omega(omega)
+	{
+		if (!(omega > T(0) && omega < T(2)))
+			throw(MatrixException(MatrixExceptionType::INVALID_SIZE, A.getRows(), A.getColumns()));
+	}
+
+	/*! apply
+	* Calculate z = M^-1 * r, solving (D / w + L) * u = r and then (D / w + U) * z = (2 - w) / w * (D / w) * u
+	* Matrix<T> vectorR: The vector r
+	* Matrix<T> vectorZ: Receives the vector z
+	*/
+	template <typename T>
+	void SSORPreconditioner<T>::apply(const Matrix<T>& vectorR, Matrix<T>& vectorZ) const
+	{
+		uint n = _matrix.getRows();
+		const std::vector<size_t>& pointers = _matrix.getPointers();
+		const std::vector<uint>& indices = _matrix.getIndices();
+		const std::vector<T>& values = _matrix.getValues();
+
+		if (vectorR.getRows() != n || vectorR.getColumns() != 1)
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, n, n, vectorR.getRows(), vectorR.getColumns(), '*'));
+
+		if (vectorZ.getRows() != n || vectorZ.getColumns() != 1)
+			vectorZ.resize(n, 1);
+
+		for (uint i = 0; i < n; i++)
+		{
+			T value = vectorR.row(i)[0];
+
+			for (size_t p = pointers[i]; p < _diagonal[i]; p++)
+				value -= values[p] * vectorZ.row(indices[p])[0];
+
+			vectorZ.row(i)[0] = (value * _omega) / values[_diagonal[i]];
+		}
+
+		const T scale = (T(2) - _omega) / _omega;
+
+		for (uint i = n; i-- > 0;)
+		{
+			const T diagonal = values[_diagonal[i]] / _omega;
+			T value = scale * diagonal * vectorZ.row(i)[0];
+
+			for (size_t p = _diagonal[i] + 1; p < pointers[i + 1]; p++)
+				value -= values[p] * vectorZ.row(indices[p])[0];
+
+			vectorZ.row(i)[0] = value / diagonal;
+		}
+	}
+
+	/*! ILU0Preconditioner
+	* Initialize the preconditioner, factorizing A line by line (IKJ) only in the positions of its values
+	* SparseMatrix<T> A: The matrix A, square with no zero in the diagonal
+	*/
+	template <typename T>
+	ILU0Preconditioner<T>::ILU0Preconditioner(const SparseMatrix<T>& A)
+		: _lu(A.toFormat(SparseFormat::CSR))
+		, _diagonal(sparseDiagonal(_lu))
+	{
+		uint n = _lu.getRows();
+		const std::vector<size_t>& pointers = _lu.getPointers();
+		const std::vector<uint>& indices = _lu.getIndices();
+		std::vector<T>& values = _lu.getValues();
+		std::vector<size_t> position(n, size_t(-1));
+
+		for (uint i = 0; i < n; i++)
+		{
+			for (size_t p = pointers[i]; p < pointers[i + 1]; p++)
+				position[indices[p]] = p;
+
+			for (size_t p = pointers[i]; p < _diagonal[i]; p++)
+			{
+				uint k = indices[p];
+				const T mulLine = values[p] / values[_diagonal[k]];
+
+				values[p] = mulLine;
+
+				for (size_t q = _diagonal[k] + 1; q < pointers[k + 1]; q++)
+					if (position[indices[q]] != size_t(-1))
+						values[position[indices[q]]] -= mulLine * values[q];
+			}
+
+			if (values[_diagonal[i]] == T(0))
+				throw(MatrixException(MatrixExceptionType::SINGULAR_MATRIX));
+
+			for (size_t p = pointers[i]; p < pointers[i + 1]; p++)
+				position[indices[p]] = size_t(-1);
+		}
+	}
+
+	/*! getLU
+	* Get L (below the diagonal, its unit diagonal is not stored) and U in the positions of A
+	* return: The factors
+	*/
+	template <typename T>
+	const SparseMatrix<T>& ILU0Preconditioner<T>::getLU() const
+	{
+		return _lu;
+	}
+
+	/*! apply
+	* Calculate z = U^-1 * L^-1 * r by a forward and a backward substitution
+	* Matrix<T> vectorR: The vector r
+	* Matrix<T> vectorZ: Receives the vector z
+	*/
+	template <typename T>
+	void ILU0Preconditioner<T>::apply(const Matrix<T>& vectorR, Matrix<T>& vectorZ) const
+	{
+		uint n = _lu.getRows();
+		const std::vector<size_t>& pointers = _lu.getPointers();
+		const std::vector<uint>& indices = _lu.getIndices();
+		const std::vector<T>& values = _lu.getValues();
+
+		if (vectorR.getRows() != n || vectorR.getColumns() != 1)
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, n, n, vectorR.getRows(), vectorR.getColumns(), '*'));
+
+		if (vectorZ.getRows() != n || vectorZ.getColumns() != 1)
+			vectorZ.resize(n, 1);
+
+		for (uint i = 0; i < n; i++)
+		{
+			T value = vectorR.row(i)[0];
+
+			for (size_t p = pointers[i]; p < _diagonal[i]; p++)
+				value -= values[p] * vectorZ.row(indices[p])[0];
+
+			vectorZ.row(i)[0] = value;
+		}
+
+		for (uint i = n; i-- > 0;)
+		{
+			T value = vectorZ.row(i)[0];
+
+			for (size_t p = _diagonal[i] + 1; p < pointers[i + 1]; p++)
+				value -= values[p] * vectorZ.row(indices[p])[0];
+
+			vectorZ.row(i)[0] = value / values[_diagonal[i]];
+		}
+	}
+
+	/*! sparseDiagonal
+	* Find the position of each value of the diagonal in the values of a square sparse matrix
+	* SparseMatrix<T> A: The matrix
+	* return: The positions, throws SINGULAR_MATRIX when a value of the diagonal is not stored or zero
+	*/
+	template <typename T>
+	std::vector<size_t> sparseDiagonal(const SparseMatrix<T>& A)
+	{
+		if (A.getRows() != A.getColumns())
+			throw(MatrixException(MatrixExceptionType::INVALID_SIZE, A.getRows(), A.getColumns()));
+
+		const std::vector<size_t>& pointers = A.getPointers();
+		const std::vector<uint>& indices = A.getIndices();
+		std::vector<size_t> diagonal(A.getRows());
+
+		for (uint i = 0; i < A.getRows(); i++)
+		{
+			std::vector<uint>::const_iterator begin = indices.begin() + pointers[i];
+			std::vector<uint>::const_iterator end = indices.begin() + pointers[i + 1];
+			std::vector<uint>::const_iterator found = std::lower_bound(begin, end, i);
+
+			if (found == end || *found != i || A.getValues()[found - indices.begin()] == T(0))
+				throw(MatrixException(MatrixExceptionType::SINGULAR_MATRIX));
+
+			diagonal[i] = size_t(found - indices.begin());
+		}
+
+		return diagonal;
+	}
+
+}
+
+#endif
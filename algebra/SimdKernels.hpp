@@ -0,0 +1,975 @@
+#ifndef SIMD_KERNELS_HPP
+#define SIMD_KERNELS_HPP
+
+#include "CpuFeatures.hpp"
+
+#ifdef LITO_SIMD_X86
+	#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+	#define LITO_SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+	#define LITO_SIMD_TARGET(isa)
+#endif
+
+namespace lito {
+
+	/*! SimdKernels
+	* Table of the kernels used by the algebra hot loops
+	* axpy: y = alpha * x + y
+	* mul: y = x * y value to value
+	* scale: y = alpha * y
+	* dot: sum of x * y value to value
+	* gemmMicroKernel: C += packA * packB for a full MR x NR tile of the GEMM, nullptr when there is no SIMD version
+	* matrix4Mul: c = a * b for 4x4 row major matrices, c must not overlap a or b
+	* transposeTile: b = a^T for 8x8 tiles with row strides, b must not overlap a
+	*/
+	template <typename T>
+	struct SimdKernels {
+		void (*axpy)(uint n, T alpha, const T* x, T* y);
+		void (*mul)(uint n, const T* x, T* y);
+		void (*scale)(uint n, T alpha, T* y);
+		T (*dot)(uint n, const T* x, const T* y);
+		void (*gemmMicroKernel)(uint kc, const T* packA, const T* packB, T* C, uint rowStrideC);
+		void (*matrix4Mul)(const T* a, const T* b, T* c);
+		void (*transposeTile)(const T* a, uint strideA, T* b, uint strideB);
+	};
+
+	template <typename T> const SimdKernels<T>& simdKernels();
+
+
+
+	/*! scalarAxpy
+	* Calculate y = alpha * x + y
+	* uint n: Quantities of values
+	* T alpha: Value multiplied to x
+	* T* x: Values to be added
+	* T* y: Values modified
+	*/
+	template <typename T>
+	void scalarAxpy(uint n, T alpha, const T* x, T* y)
+	{
+		for (uint i = 0; i < n; i++)
+			y[i] += alpha * x[i];
+	}
+
+	/*! scalarMul
+	* Calculate y = x * y value to value
+	* uint n: Quantities of values
+	* T* x: Values to be multiplied
+	* T* y: Values modified
+	*/
+	template <typename T>
+	void scalarMul(uint n, const T* x, T* y)
+	{
+		for (uint i = 0; i < n; i++)
+			y[i] *= x[i];
+	}
+
+	/*! scalarScale
+	* Calculate y = alpha * y
+	* uint n: Quantities of values
+	* T alpha: Value to be multiplied
+	* T* y: Values modified
+	*/
+	template <typename T>
+	void scalarScale(uint n, T alpha, T* y)
+	{
+		for (uint i = 0; i < n; i++)
+			y[i] *= alpha;
+	}
+
+	/*! scalarDot
+	* Calculate the sum of x * y value to value
+	* uint n: Quantities of values
+	* T* x: Values to be multiplied
+	* T* y: Values to be multiplied
+	* return: The sum
+	*/
+	template <typename T>
+	T scalarDot(uint n, const T* x, const T* y)
+	{
+		T sum = T(0);
+
+		for (uint i = 0; i < n; i++)
+			sum += x[i] * y[i];
+
+		return sum;
+	}
+
+	/*! scalarMatrix4Mul
+	* Calculate c = a * b for 4x4 row major matrices
+	* T* a: Matrix to multiply
+	* T* b: Matrix to multiply
+	* T* c: Result, must not overlap a or b
+	*/
+	template <typename T>
+	void scalarMatrix4Mul(const T* a, const T* b, T* c)
+	{
+		for (uint i = 0; i < 4; i++)
+			for (uint j = 0; j < 4; j++)
+				c[(i * 4) + j] = (a[(i * 4)] * b[j]) + (a[(i * 4) + 1] * b[4 + j]) + (a[(i * 4) + 2] * b[8 + j]) + (a[(i * 4) + 3] * b[12 + j]);
+	}
+
+	/*! scalarTransposeTile
+	* Calculate b = a^T for a 8x8 tile
+	* T* a: Tile to transpose
+	* uint strideA: Distance between two rows of a
+	* T* b: Result, must not overlap a
+	* uint strideB: Distance between two rows of b
+	*/
+	template <typename T>
+	void scalarTransposeTile(const T* a, uint strideA, T* b, uint strideB)
+	{
+		for (uint i = 0; i < 8; i++)
+			for (uint j = 0; j < 8; j++)
+				b[(size_t(j) * strideB) + i] = a[(size_t(i) * strideA) + j];
+	}
+
+#ifdef LITO_SIMD_X86
+
+	/*===============================================================================================================================*/
+	/* SSE2                                                                                                                          */
+	/*===============================================================================================================================*/
+
+	LITO_SIMD_TARGET("sse2")
+	inline void sse2Axpy(uint n, float alpha, const float* x, float* y)
+	{
+		__m128 a = _mm_set1_ps(alpha);
+		uint i = 0;
+
+		for (; i + 8 <= n; i += 8)
+		{
+			_mm_storeu_ps(y + i,     _mm_add_ps(_mm_loadu_ps(y + i),     _mm_mul_ps(a, _mm_loadu_ps(x + i))));
+			_mm_storeu_ps(y + i + 4, _mm_add_ps(_mm_loadu_ps(y + i + 4), _mm_mul_ps(a, _mm_loadu_ps(x + i + 4))));
+		}
+		for (; i < n; i++)
+			y[i] += alpha * x[i];
+	}
+
+	LITO_SIMD_TARGET("sse2")
+	inline void sse2Axpy(uint n, double alpha, const double* x, double* y)
+	{
+		__m128d a = _mm_set1_pd(alpha);
+		uint i = 0;
+
+		for (; i + 4 <= n; i += 4)
+		{
+			_mm_storeu_pd(y + i,     _mm_add_pd(_mm_loadu_pd(y + i),     _mm_mul_pd(a, _mm_loadu_pd(x + i))));
+			_mm_storeu_pd(y + i + 2, _mm_add_pd(_mm_loadu_pd(y + i + 2), _mm_mul_pd(a, _mm_loadu_pd(x + i + 2))));
+		}
+		for (; i < n; i++)
+			y[i] += alpha * x[i];
+	}
+
+	LITO_SIMD_TARGET("sse2")
+	inline void sse2Mul(uint n, const float* x, float* y)
+	{
+		uint i = 0;
+
+		for (; i + 4 <= n; i += 4)
+			_mm_storeu_ps(y + i, _mm_mul_ps(_mm_loadu_ps(y + i), _mm_loadu_ps(x + i)));
+		for (; i < n; i++)
+			y[i] *= x[i];
+	}
+
+	LITO_SIMD_TARGET("sse2")
+	inline void sse2Mul(uint n, const double* x, double* y)
+	{
+		uint i = 0;
+
+		for (; i + 2 <= n; i += 2)
+			_mm_storeu_pd(y + i, _mm_mul_pd(_mm_loadu_pd(y + i), _mm_loadu_pd(x + i)));
+		for (; i < n; i++)
+			y[i] *= x[i];
+	}
+
+	LITO_SIMD_TARGET("sse2")
+	inline void sse2Scale(uint n, float alpha, float* y)
+	{
+		__m128 a = _mm_set1_ps(alpha);
+		uint i = 0;
+
+		for (; i + 4 <= n; i += 4)
+			_mm_storeu_ps(y + i, _mm_mul_ps(a, _mm_loadu_ps(y + i)));
+		for (; i < n; i++)
+			y[i] *= alpha;
+	}
+
+	LITO_SIMD_TARGET("sse2")
+	inline void sse2Scale(uint n, double alpha, double* y)
+	{
+		__m128d a = _mm_set1_pd(alpha);
+		uint i = 0;
+
+		for (; i + 2 <= n; i += 2)
+			_mm_storeu_pd(y + i, _mm_mul_pd(a, _mm_loadu_pd(y + i)));
+		for (; i < n; i++)
+			y[i] *= alpha;
+	}
+
+	LITO_SIMD_TARGET("sse2")
+	inline float sse2Dot(uint n, const float* x, const float* y)
+	{
+		__m128 s0 = _mm_setzero_ps(), s1 = _mm_setzero_ps();
+		uint i = 0;
+
+		for (; i + 8 <= n; i += 8)
+		{
+			s0 = _mm_add_ps(s0, _mm_mul_ps(_mm_loadu_ps(x + i),     _mm_loadu_ps(y + i)));
+			s1 = _mm_add_ps(s1, _mm_mul_ps(_mm_loadu_ps(x + i + 4), _mm_loadu_ps(y + i + 4)));
+		}
+
+		s0 = _mm_add_ps(s0, s1);
+		s0 = _mm_add_ps(s0, _mm_movehl_ps(s0, s0));
+		s0 = _mm_add_ss(s0, _mm_shuffle_ps(s0, s0, 1));
+
+		float sum = _mm_cvtss_f32(s0);
+
+		for (; i < n; i++)
+			sum += x[i] * y[i];
+
+		return sum;
+	}
+
+	LITO_SIMD_TARGET("sse2")
+	inline double sse2Dot(uint n, const double* x, const double* y)
+	{
+		__m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd();
+		uint i = 0;
+
+		for (; i + 4 <= n; i += 4)
+		{
+			s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_loadu_pd(x + i),     _mm_loadu_pd(y + i)));
+			s1 = _mm_add_pd(s1, _mm_mul_pd(_mm_loadu_pd(x + i + 2), _mm_loadu_pd(y + i + 2)));
+		}
+
+		s0 = _mm_add_pd(s0, s1);
+
+		double sum = _mm_cvtsd_f64(_mm_add_sd(s0, _mm_unpackhi_pd(s0, s0)));
+
+		for (; i < n; i++)
+			sum += x[i] * y[i];
+
+		return sum;
+	}
+
+	/*! sse2GemmMicroKernel
+	* 4x16 float tile, computed as two halves of 4x8 to fit the 16 xmm registers
+	*/
+	LITO_SIMD_TARGET("sse2")
+	inline void sse2GemmMicroKernel(uint kc, const float* packA, const float* packB, float* C, uint rowStrideC)
+	{
+		for (uint h = 0; h < 16; h += 8)
+		{
+			__m128 c00 = _mm_setzero_ps(), c01 = _mm_setzero_ps();
+			__m128 c10 = _mm_setzero_ps(), c11 = _mm_setzero_ps();
+			__m128 c20 = _mm_setzero_ps(), c21 = _mm_setzero_ps();
+			__m128 c30 = _mm_setzero_ps(), c31 = _mm_setzero_ps();
+			const float* a = packA;
+			const float* b = packB + h;
+
+			for (uint p = 0; p < kc; p++)
+			{
+				__m128 b0 = _mm_loadu_ps(b);
+				__m128 b1 = _mm_loadu_ps(b + 4);
+				__m128 ai;
+
+				ai = _mm_set1_ps(a[0]); c00 = _mm_add_ps(c00, _mm_mul_ps(ai, b0)); c01 = _mm_add_ps(c01, _mm_mul_ps(ai, b1));
+				ai = _mm_set1_ps(a[1]); c10 = _mm_add_ps(c10, _mm_mul_ps(ai, b0)); c11 = _mm_add_ps(c11, _mm_mul_ps(ai, b1));
+				ai = _mm_set1_ps(a[2]); c20 = _mm_add_ps(c20, _mm_mul_ps(ai, b0)); c21 = _mm_add_ps(c21, _mm_mul_ps(ai, b1));
+				ai = _mm_set1_ps(a[3]); c30 = _mm_add_ps(c30, _mm_mul_ps(ai, b0)); c31 = _mm_add_ps(c31, _mm_mul_ps(ai, b1));
+
+				a += 4;
+				b += 16;
+			}
+
+			float* c = C + h;
+			_mm_storeu_ps(c,     _mm_add_ps(_mm_loadu_ps(c),     c00)); _mm_storeu_ps(c + 4, _mm_add_ps(_mm_loadu_ps(c + 4), c01)); c += rowStrideC;
+			_mm_storeu_ps(c,     _mm_add_ps(_mm_loadu_ps(c),     c10)); _mm_storeu_ps(c + 4, _mm_add_ps(_mm_loadu_ps(c + 4), c11)); c += rowStrideC;
+			_mm_storeu_ps(c,     _mm_add_ps(_mm_loadu_ps(c),     c20)); _mm_storeu_ps(c + 4, _mm_add_ps(_mm_loadu_ps(c + 4), c21)); c += rowStrideC;
+			_mm_storeu_ps(c,     _mm_add_ps(_mm_loadu_ps(c),     c30)); _mm_storeu_ps(c + 4, _mm_add_ps(_mm_loadu_ps(c + 4), c31));
+		}
+	}
+
+	/*! sse2GemmMicroKernel
+	* 4x8 double tile, computed as two halves of 4x4 to fit the 16 xmm registers
+	*/
+	LITO_SIMD_TARGET("sse2")
+	inline void sse2GemmMicroKernel(uint kc, const double* packA, const double* packB, double* C, uint rowStrideC)
+	{
+		for (uint h = 0; h < 8; h += 4)
+		{
+			__m128d c00 = _mm_setzero_pd(), c01 = _mm_setzero_pd();
+			__m128d c10 = _mm_setzero_pd(), c11 = _mm_setzero_pd();
+			__m128d c20 = _mm_setzero_pd(), c21 = _mm_setzero_pd();
+			__m128d c30 = _mm_setzero_pd(), c31 = _mm_setzero_pd();
+			const double* a = packA;
+			const double* b = packB + h;
+
+			for (uint p = 0; p < kc; p++)
+			{
+				__m128d b0 = _mm_loadu_pd(b);
+				__m128d b1 = _mm_loadu_pd(b + 2);
+				__m128d ai;
+
+				ai = _mm_set1_pd(a[0]); c00 = _mm_add_pd(c00, _mm_mul_pd(ai, b0)); c01 = _mm_add_pd(c01, _mm_mul_pd(ai, b1));
+				ai = _mm_set1_pd(a[1]); c10 = _mm_add_pd(c10, _mm_mul_pd(ai, b0)); c11 = _mm_add_pd(c11, _mm_mul_pd(ai, b1));
+				ai = _mm_set1_pd(a[2]); c20 = _mm_add_pd(c20, _mm_mul_pd(ai, b0)); c21 = _mm_add_pd(c21, _mm_mul_pd(ai, b1));
+				ai = _mm_set1_pd(a[3]); c30 = _mm_add_pd(c30, _mm_mul_pd(ai, b0)); c31 = _mm_add_pd(c31, _mm_mul_pd(ai, b1));
+
+				a += 4;
+				b += 8;
+			}
+
+			double* c = C + h;
+			_mm_storeu_pd(c, _mm_add_pd(_mm_loadu_pd(c), c00)); _mm_storeu_pd(c + 2, _mm_add_pd(_mm_loadu_pd(c + 2), c01)); c += rowStrideC;
+			_mm_storeu_pd(c, _mm_add_pd(_mm_loadu_pd(c), c10)); _mm_storeu_pd(c + 2, _mm_add_pd(_mm_loadu_pd(c + 2), c11)); c += rowStrideC;
+			_mm_storeu_pd(c, _mm_add_pd(_mm_loadu_pd(c), c20)); _mm_storeu_pd(c + 2, _mm_add_pd(_mm_loadu_pd(c + 2), c21)); c += rowStrideC;
+			_mm_storeu_pd(c, _mm_add_pd(_mm_loadu_pd(c), c30)); _mm_storeu_pd(c + 2, _mm_add_pd(_mm_loadu_pd(c + 2), c31));
+		}
+	}
+
+	LITO_SIMD_TARGET("sse2")
+	inline void sse2Matrix4Mul(const float* a, const float* b, float* c)
+	{
+		__m128 b0 = _mm_loadu_ps(b);
+		__m128 b1 = _mm_loadu_ps(b + 4);
+		__m128 b2 = _mm_loadu_ps(b + 8);
+		__m128 b3 = _mm_loadu_ps(b + 12);
+
+		for (uint i = 0; i < 16; i += 4)
+		{
+			__m128 row = _mm_mul_ps(_mm_set1_ps(a[i]), b0);
+			row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[i + 1]), b1));
+			row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[i + 2]), b2));
+			row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[i + 3]), b3));
+			_mm_storeu_ps(c + i, row);
+		}
+	}
+
+	LITO_SIMD_TARGET("sse2")
+	inline void sse2Matrix4Mul(const double* a, const double* b, double* c)
+	{
+		for (uint h = 0; h < 4; h += 2)
+		{
+			__m128d b0 = _mm_loadu_pd(b + h);
+			__m128d b1 = _mm_loadu_pd(b + 4 + h);
+			__m128d b2 = _mm_loadu_pd(b + 8 + h);
+			__m128d b3 = _mm_loadu_pd(b + 12 + h);
+
+			for (uint i = 0; i < 16; i += 4)
+			{
+				__m128d row = _mm_mul_pd(_mm_set1_pd(a[i]), b0);
+				row = _mm_add_pd(row, _mm_mul_pd(_mm_set1_pd(a[i + 1]), b1));
+				row = _mm_add_pd(row, _mm_mul_pd(_mm_set1_pd(a[i + 2]), b2));
+				row = _mm_add_pd(row, _mm_mul_pd(_mm_set1_pd(a[i + 3]), b3));
+				_mm_storeu_pd(c + i + h, row);
+			}
+		}
+	}
+
+	LITO_SIMD_TARGET("sse2")
+	inline void sse2TransposeTile(const float* a, uint strideA, float* b, uint strideB)
+	{
+		for (uint i = 0; i < 8; i += 4)
+		{
+			for (uint j = 0; j < 8; j += 4)
+			{
+				const float* from = a + (size_t(i) * strideA) + j;
+				float* to = b + (size_t(j) * strideB) + i;
+
+				__m128 r0 = _mm_loadu_ps(from);
+				__m128 r1 = _mm_loadu_ps(from + strideA);
+				__m128 r2 = _mm_loadu_ps(from + (size_t(2) * strideA));
+				__m128 r3 = _mm_loadu_ps(from + (size_t(3) * strideA));
+
+				_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+				_mm_storeu_ps(to, r0);
+				_mm_storeu_ps(to + strideB, r1);
+				_mm_storeu_ps(to + (size_t(2) * strideB), r2);
+				_mm_storeu_ps(to + (size_t(3) * strideB), r3);
+			}
+		}
+	}
+
+	LITO_SIMD_TARGET("sse2")
+	inline void sse2TransposeTile(const double* a, uint strideA, double* b, uint strideB)
+	{
+		for (uint i = 0; i < 8; i += 2)
+		{
+			for (uint j = 0; j < 8; j += 2)
+			{
+				const double* from = a + (size_t(i) * strideA) + j;
+				double* to = b + (size_t(j) * strideB) + i;
+
+				__m128d r0 = _mm_loadu_pd(from);
+				__m128d r1 = _mm_loadu_pd(from + strideA);
+
+				_mm_storeu_pd(to, _mm_unpacklo_pd(r0, r1));
+				_mm_storeu_pd(to + strideB, _mm_unpackhi_pd(r0, r1));
+			}
+		}
+	}
+
+	/*===============================================================================================================================*/
+	/* AVX2 + FMA                                                                                                                    */
+	/*===============================================================================================================================*/
+
+	LITO_SIMD_TARGET("avx2,fma")
+	inline void avx2Axpy(uint n, float alpha, const float* x, float* y)
+	{
+		__m256 a = _mm256_set1_ps(alpha);
+		uint i = 0;
+
+		for (; i + 16 <= n; i += 16)
+		{
+			_mm256_storeu_ps(y + i,     _mm256_fmadd_ps(a, _mm256_loadu_ps(x + i),     _mm256_loadu_ps(y + i)));
+			_mm256_storeu_ps(y + i + 8, _mm256_fmadd_ps(a, _mm256_loadu_ps(x + i + 8), _mm256_loadu_ps(y + i + 8)));
+		}
+		for (; i < n; i++)
+			y[i] += alpha * x[i];
+	}
+
+	LITO_SIMD_TARGET("avx2,fma")
+	inline void avx2Axpy(uint n, double alpha, const double* x, double* y)
+	{
+		__m256d a = _mm256_set1_pd(alpha);
+		uint i = 0;
+
+		for (; i + 8 <= n; i += 8)
+		{
+			_mm256_storeu_pd(y + i,     _mm256_fmadd_pd(a, _mm256_loadu_pd(x + i),     _mm256_loadu_pd(y + i)));
+			_mm256_storeu_pd(y + i + 4, _mm256_fmadd_pd(a, _mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4)));
+		}
+		for (; i < n; i++)
+			y[i] += alpha * x[i];
+	}
+
+	LITO_SIMD_TARGET("avx2,fma")
+	inline void avx2Mul(uint n, const float* x, float* y)
+	{
+		uint i = 0;
+
+		for (; i + 8 <= n; i += 8)
+			_mm256_storeu_ps(y + i, _mm256_mul_ps(_mm256_loadu_ps(y + i), _mm256_loadu_ps(x + i)));
+		for (; i < n; i++)
+			y[i] *= x[i];
+	}
+
+	LITO_SIMD_TARGET("avx2,fma")
+	inline void avx2Mul(uint n, const double* x, double* y)
+	{
+		uint i = 0;
+
+		for (; i + 4 <= n; i += 4)
+			_mm256_storeu_pd(y + i, _mm256_mul_pd(_mm256_loadu_pd(y + i), _mm256_loadu_pd(x + i)));
+		for (; i < n; i++)
+			y[i] *= x[i];
+	}
+
+	LITO_SIMD_TARGET("avx2,fma")
+	inline void avx2Scale(uint n, float alpha, float* y)
+	{
+		__m256 a = _mm256_set1_ps(alpha);
+		uint i = 0;
+
+		for (; i + 8 <= n; i += 8)
+			_mm256_storeu_ps(y + i, _mm256_mul_ps(a, _mm256_loadu_ps(y + i)));
+		for (; i < n; i++)
+			y[i] *= alpha;
+	}
+
+	LITO_SIMD_TARGET("avx2,fma")
+	inline void avx2Scale(uint n, double alpha, double* y)
+	{
+		__m256d a = _mm256_set1_pd(alpha);
+		uint i = 0;
+
+		for (; i + 4 <= n; i += 4)
+			_mm256_storeu_pd(y + i, _mm256_mul_pd(a, _mm256_loadu_pd(y + i)));
+		for (; i < n; i++)
+			y[i] *= alpha;
+	}
+
+	LITO_SIMD_TARGET("avx2,fma")
+	inline float avx2Dot(uint n, const float* x, const float* y)
+	{
+		__m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps();
+		uint i = 0;
+
+		for (; i + 16 <= n; i += 16)
+		{
+			s0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i),     _mm256_loadu_ps(y + i),     s0);
+			s1 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 8), _mm256_loadu_ps(y + i + 8), s1);
+		}
+
+		s0 = _mm256_add_ps(s0, s1);
+
+		__m128 s = _mm_add_ps(_mm256_castps256_ps128(s0), _mm256_extractf128_ps(s0, 1));
+
+		s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+		s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+
+		float sum = _mm_cvtss_f32(s);
+
+		for (; i < n; i++)
+			sum += x[i] * y[i];
+
+		return sum;
+	}
+
+	LITO_SIMD_TARGET("avx2,fma")
+	inline double avx2Dot(uint n, const double* x, const double* y)
+	{
+		__m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+		uint i = 0;
+
+		for (; i + 8 <= n; i += 8)
+		{
+			s0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i),     _mm256_loadu_pd(y + i),     s0);
+			s1 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4), s1);
+		}
+
+		s0 = _mm256_add_pd(s0, s1);
+
+		__m128d s = _mm_add_pd(_mm256_castpd256_pd128(s0), _mm256_extractf128_pd(s0, 1));
+		double sum = _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+
+		for (; i < n; i++)
+			sum += x[i] * y[i];
+
+		return sum;
+	}
+
+	/*! avx2GemmMicroKernel
+	* 4x16 float tile, two ymm accumulators per row
+	*/
+	LITO_SIMD_TARGET("avx2,fma")
+	inline void avx2GemmMicroKernel(uint kc, const float* packA, const float* packB, float* C, uint rowStrideC)
+	{
+		__m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+		__m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+		__m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+		__m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+
+		for (uint p = 0; p < kc; p++)
+		{
+			__m256 b0 = _mm256_loadu_ps(packB);
+			__m256 b1 = _mm256_loadu_ps(packB + 8);
+			__m256 ai;
+
+			ai = _mm256_broadcast_ss(packA);     c00 = _mm256_fmadd_ps(ai, b0, c00); c01 = _mm256_fmadd_ps(ai, b1, c01);
+			ai = _mm256_broadcast_ss(packA + 1); c10 = _mm256_fmadd_ps(ai, b0, c10); c11 = _mm256_fmadd_ps(ai, b1, c11);
+			ai = _mm256_broadcast_ss(packA + 2); c20 = _mm256_fmadd_ps(ai, b0, c20); c21 = _mm256_fmadd_ps(ai, b1, c21);
+			ai = _mm256_broadcast_ss(packA + 3); c30 = _mm256_fmadd_ps(ai, b0, c30); c31 = _mm256_fmadd_ps(ai, b1, c31);
+
+			packA += 4;
+			packB += 16;
+		}
+
+		float* c = C;
+		_mm256_storeu_ps(c, _mm256_add_ps(_mm256_loadu_ps(c), c00)); _mm256_storeu_ps(c + 8, _mm256_add_ps(_mm256_loadu_ps(c + 8), c01)); c += rowStrideC;
+		_mm256_storeu_ps(c, _mm256_add_ps(_mm256_loadu_ps(c), c10)); _mm256_storeu_ps(c + 8, _mm256_add_ps(_mm256_loadu_ps(c + 8), c11)); c += rowStrideC;
+		_mm256_storeu_ps(c, _mm256_add_ps(_mm256_loadu_ps(c), c20)); _mm256_storeu_ps(c + 8, _mm256_add_ps(_mm256_loadu_ps(c + 8), c21)); c += rowStrideC;
+		_mm256_storeu_ps(c, _mm256_add_ps(_mm256_loadu_ps(c), c30)); _mm256_storeu_ps(c + 8, _mm256_add_ps(_mm256_loadu_ps(c + 8), c31));
+	}
+
+	/*! avx2GemmMicroKernel
+	* 4x8 double tile, two ymm accumulators per row
+	*/
+	LITO_SIMD_TARGET("avx2,fma")
+	inline void avx2GemmMicroKernel(uint kc, const double* packA, const double* packB, double* C, uint rowStrideC)
+	{
+		__m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+		__m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+		__m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+		__m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+
+		for (uint p = 0; p < kc; p++)
+		{
+			__m256d b0 = _mm256_loadu_pd(packB);
+			__m256d b1 = _mm256_loadu_pd(packB + 4);
+			__m256d ai;
+
+			ai = _mm256_broadcast_sd(packA);     c00 = _mm256_fmadd_pd(ai, b0, c00); c01 = _mm256_fmadd_pd(ai, b1, c01);
+			ai = _mm256_broadcast_sd(packA + 1); c10 = _mm256_fmadd_pd(ai, b0, c10); c11 = _mm256_fmadd_pd(ai, b1, c11);
+			ai = _mm256_broadcast_sd(packA + 2); c20 = _mm256_fmadd_pd(ai, b0, c20); c21 = _mm256_fmadd_pd(ai, b1, c21);
+			ai = _mm256_broadcast_sd(packA + 3); c30 = _mm256_fmadd_pd(ai, b0, c30); c31 = _mm256_fmadd_pd(ai, b1, c31);
+
+			packA += 4;
+			packB += 8;
+		}
+
+		double* c = C;
+		_mm256_storeu_pd(c, _mm256_add_pd(_mm256_loadu_pd(c), c00)); _mm256_storeu_pd(c + 4, _mm256_add_pd(_mm256_loadu_pd(c + 4), c01)); c += rowStrideC;
+		_mm256_storeu_pd(c, _mm256_add_pd(_mm256_loadu_pd(c), c10)); _mm256_storeu_pd(c + 4, _mm256_add_pd(_mm256_loadu_pd(c + 4), c11)); c += rowStrideC;
+		_mm256_storeu_pd(c, _mm256_add_pd(_mm256_loadu_pd(c), c20)); _mm256_storeu_pd(c + 4, _mm256_add_pd(_mm256_loadu_pd(c + 4), c21)); c += rowStrideC;
+		_mm256_storeu_pd(c, _mm256_add_pd(_mm256_loadu_pd(c), c30)); _mm256_storeu_pd(c + 4, _mm256_add_pd(_mm256_loadu_pd(c + 4), c31));
+	}
+
+	LITO_SIMD_TARGET("avx2,fma")
+	inline void avx2Matrix4Mul(const float* a, const float* b, float* c)
+	{
+		__m128 b0 = _mm_loadu_ps(b);
+		__m128 b1 = _mm_loadu_ps(b + 4);
+		__m128 b2 = _mm_loadu_ps(b + 8);
+		__m128 b3 = _mm_loadu_ps(b + 12);
+
+		for (uint i = 0; i < 16; i += 4)
+		{
+			__m128 row = _mm_mul_ps(_mm_broadcast_ss(a + i), b0);
+			row = _mm_fmadd_ps(_mm_broadcast_ss(a + i + 1), b1, row);
+			row = _mm_fmadd_ps(_mm_broadcast_ss(a + i + 2), b2, row);
+			row = _mm_fmadd_ps(_mm_broadcast_ss(a + i + 3), b3, row);
+			_mm_storeu_ps(c + i, row);
+		}
+	}
+
+	LITO_SIMD_TARGET("avx2,fma")
+	inline void avx2Matrix4Mul(const double* a, const double* b, double* c)
+	{
+		__m256d b0 = _mm256_loadu_pd(b);
+		__m256d b1 = _mm256_loadu_pd(b + 4);
+		__m256d b2 = _mm256_loadu_pd(b + 8);
+		__m256d b3 = _mm256_loadu_pd(b + 12);
+
+		for (uint i = 0; i < 16; i += 4)
+		{
+			__m256d row = _mm256_mul_pd(_mm256_broadcast_sd(a + i), b0);
+			row = _mm256_fmadd_pd(_mm256_broadcast_sd(a + i + 1), b1, row);
+			row = _mm256_fmadd_pd(_mm256_broadcast_sd(a + i + 2), b2, row);
+			row = _mm256_fmadd_pd(_mm256_broadcast_sd(a + i + 3), b3, row);
+			_mm256_storeu_pd(c + i, row);
+		}
+	}
+
+	LITO_SIMD_TARGET("avx2,fma")
+	inline void avx2TransposeTile(const float* a, uint strideA, float* b, uint strideB)
+	{
+		__m256 r0 = _mm256_loadu_ps(a);
+		__m256 r1 = _mm256_loadu_ps(a + strideA);
+		__m256 r2 = _mm256_loadu_ps(a + (size_t(2) * strideA));
+		__m256 r3 = _mm256_loadu_ps(a + (size_t(3) * strideA));
+		__m256 r4 = _mm256_loadu_ps(a + (size_t(4) * strideA));
+		__m256 r5 = _mm256_loadu_ps(a + (size_t(5) * strideA));
+		__m256 r6 = _mm256_loadu_ps(a + (size_t(6) * strideA));
+		__m256 r7 = _mm256_loadu_ps(a + (size_t(7) * strideA));
+
+		__m256 t0 = _mm256_unpacklo_ps(r0, r1);
+		__m256 t1 = _mm256_unpackhi_ps(r0, r1);
+		__m256 t2 = _mm256_unpacklo_ps(r2, r3);
+		__m256 t3 = _mm256_unpackhi_ps(r2, r3);
+		__m256 t4 = _mm256_unpacklo_ps(r4, r5);
+		__m256 t5 = _mm256_unpackhi_ps(r4, r5);
+		__m256 t6 = _mm256_unpacklo_ps(r6, r7);
+		__m256 t7 = _mm256_unpackhi_ps(r6, r7);
+
+		r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+		r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+		r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+		r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+		r4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+		r5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+		r6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+		r7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+		_mm256_storeu_ps(b, _mm256_permute2f128_ps(r0, r4, 0x20));
+		_mm256_storeu_ps(b + strideB, _mm256_permute2f128_ps(r1, r5, 0x20));
+		_mm256_storeu_ps(b + (size_t(2) * strideB), _mm256_permute2f128_ps(r2, r6, 0x20));
+		_mm256_storeu_ps(b + (size_t(3) * strideB), _mm256_permute2f128_ps(r3, r7, 0x20));
+		_mm256_storeu_ps(b + (size_t(4) * strideB), _mm256_permute2f128_ps(r0, r4, 0x31));
+		_mm256_storeu_ps(b + (size_t(5) * strideB), _mm256_permute2f128_ps(r1, r5, 0x31));
+		_mm256_storeu_ps(b + (size_t(6) * strideB), _mm256_permute2f128_ps(r2, r6, 0x31));
+		_mm256_storeu_ps(b + (size_t(7) * strideB), _mm256_permute2f128_ps(r3, r7, 0x31));
+	}
+
+	LITO_SIMD_TARGET("avx2,fma")
+	inline void avx2TransposeTile(const double* a, uint strideA, double* b, uint strideB)
+	{
+		for (uint i = 0; i < 8; i += 4)
+		{
+			for (uint j = 0; j < 8; j += 4)
+			{
+				const double* from = a + (size_t(i) * strideA) + j;
+				double* to = b + (size_t(j) * strideB) + i;
+
+				__m256d r0 = _mm256_loadu_pd(from);
+				__m256d r1 = _mm256_loadu_pd(from + strideA);
+				__m256d r2 = _mm256_loadu_pd(from + (size_t(2) * strideA));
+				__m256d r3 = _mm256_loadu_pd(from + (size_t(3) * strideA));
+
+				__m256d t0 = _mm256_unpacklo_pd(r0, r1);
+				__m256d t1 = _mm256_unpackhi_pd(r0, r1);
+				__m256d t2 = _mm256_unpacklo_pd(r2, r3);
+				__m256d t3 = _mm256_unpackhi_pd(r2, r3);
+
+				_mm256_storeu_pd(to, _mm256_permute2f128_pd(t0, t2, 0x20));
+				_mm256_storeu_pd(to + strideB, _mm256_permute2f128_pd(t1, t3, 0x20));
+				_mm256_storeu_pd(to + (size_t(2) * strideB), _mm256_permute2f128_pd(t0, t2, 0x31));
+				_mm256_storeu_pd(to + (size_t(3) * strideB), _mm256_permute2f128_pd(t1, t3, 0x31));
+			}
+		}
+	}
+
+	/*===============================================================================================================================*/
+	/* AVX-512                                                                                                                       */
+	/*===============================================================================================================================*/
+
+	LITO_SIMD_TARGET("avx512f")
+	inline void avx512Axpy(uint n, float alpha, const float* x, float* y)
+	{
+		__m512 a = _mm512_set1_ps(alpha);
+		uint i = 0;
+
+		for (; i + 32 <= n; i += 32)
+		{
+			_mm512_storeu_ps(y + i,      _mm512_fmadd_ps(a, _mm512_loadu_ps(x + i),      _mm512_loadu_ps(y + i)));
+			_mm512_storeu_ps(y + i + 16, _mm512_fmadd_ps(a, _mm512_loadu_ps(x + i + 16), _mm512_loadu_ps(y + i + 16)));
+		}
+		for (; i < n; i++)
+			y[i] += alpha * x[i];
+	}
+
+	LITO_SIMD_TARGET("avx512f")
+	inline void avx512Axpy(uint n, double alpha, const double* x, double* y)
+	{
+		__m512d a = _mm512_set1_pd(alpha);
+		uint i = 0;
+
+		for (; i + 16 <= n; i += 16)
+		{
+			_mm512_storeu_pd(y + i,     _mm512_fmadd_pd(a, _mm512_loadu_pd(x + i),     _mm512_loadu_pd(y + i)));
+			_mm512_storeu_pd(y + i + 8, _mm512_fmadd_pd(a, _mm512_loadu_pd(x + i + 8), _mm512_loadu_pd(y + i + 8)));
+		}
+		for (; i < n; i++)
+			y[i] += alpha * x[i];
+	}
+
+	LITO_SIMD_TARGET("avx512f")
+	inline void avx512Mul(uint n, const float* x, float* y)
+	{
+		uint i = 0;
+
+		for (; i + 16 <= n; i += 16)
+			_mm512_storeu_ps(y + i, _mm512_mul_ps(_mm512_loadu_ps(y + i), _mm512_loadu_ps(x + i)));
+		for (; i < n; i++)
+			y[i] *= x[i];
+	}
+
+	LITO_SIMD_TARGET("avx512f")
+	inline void avx512Mul(uint n, const double* x, double* y)
+	{
+		uint i = 0;
+
+		for (; i + 8 <= n; i += 8)
+			_mm512_storeu_pd(y + i, _mm512_mul_pd(_mm512_loadu_pd(y + i), _mm512_loadu_pd(x + i)));
+		for (; i < n; i++)
+			y[i] *= x[i];
+	}
+
+	LITO_SIMD_TARGET("avx512f")
+	inline void avx512Scale(uint n, float alpha, float* y)
+	{
+		__m512 a = _mm512_set1_ps(alpha);
+		uint i = 0;
+
+		for (; i + 16 <= n; i += 16)
+			_mm512_storeu_ps(y + i, _mm512_mul_ps(a, _mm512_loadu_ps(y + i)));
+		for (; i < n; i++)
+			y[i] *= alpha;
+	}
+
+	LITO_SIMD_TARGET("avx512f")
+	inline void avx512Scale(uint n, double alpha, double* y)
+	{
+		__m512d a = _mm512_set1_pd(alpha);
+		uint i = 0;
+
+		for (; i + 8 <= n; i += 8)
+			_mm512_storeu_pd(y + i, _mm512_mul_pd(a, _mm512_loadu_pd(y + i)));
+		for (; i < n; i++)
+			y[i] *= alpha;
+	}
+
+	LITO_SIMD_TARGET("avx512f")
+	inline float avx512Dot(uint n, const float* x, const float* y)
+	{
+		__m512 s0 = _mm512_setzero_ps(), s1 = _mm512_setzero_ps();
+		uint i = 0;
+
+		for (; i + 32 <= n; i += 32)
+		{
+			s0 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i),      _mm512_loadu_ps(y + i),      s0);
+			s1 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i + 16), _mm512_loadu_ps(y + i + 16), s1);
+		}
+
+		// Summed through memory, the reduce intrinsics of some GCC versions warn of uninitialized values
+		alignas(64) float lanes[16];
+		float sum = float(0);
+
+		_mm512_store_ps(lanes, _mm512_add_ps(s0, s1));
+
+		for (uint lane = 0; lane < 16; lane++)
+			sum += lanes[lane];
+
+		for (; i < n; i++)
+			sum += x[i] * y[i];
+
+		return sum;
+	}
+
+	LITO_SIMD_TARGET("avx512f")
+	inline double avx512Dot(uint n, const double* x, const double* y)
+	{
+		__m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd();
+		uint i = 0;
+
+		for (; i + 16 <= n; i += 16)
+		{
+			s0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i),     _mm512_loadu_pd(y + i),     s0);
+			s1 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 8), _mm512_loadu_pd(y + i + 8), s1);
+		}
+
+		// Summed through memory, the reduce intrinsics of some GCC versions warn of uninitialized values
+		alignas(64) double lanes[8];
+		double sum = double(0);
+
+		_mm512_store_pd(lanes, _mm512_add_pd(s0, s1));
+
+		for (uint lane = 0; lane < 8; lane++)
+			sum += lanes[lane];
+
+		for (; i < n; i++)
+			sum += x[i] * y[i];
+
+		return sum;
+	}
+
+	/*! avx512GemmMicroKernel
+	* 4x16 float tile, one zmm accumulator per row
+	*/
+	LITO_SIMD_TARGET("avx512f")
+	inline void avx512GemmMicroKernel(uint kc, const float* packA, const float* packB, float* C, uint rowStrideC)
+	{
+		__m512 c0 = _mm512_setzero_ps();
+		__m512 c1 = _mm512_setzero_ps();
+		__m512 c2 = _mm512_setzero_ps();
+		__m512 c3 = _mm512_setzero_ps();
+
+		for (uint p = 0; p < kc; p++)
+		{
+			__m512 b = _mm512_loadu_ps(packB);
+
+			c0 = _mm512_fmadd_ps(_mm512_set1_ps(packA[0]), b, c0);
+			c1 = _mm512_fmadd_ps(_mm512_set1_ps(packA[1]), b, c1);
+			c2 = _mm512_fmadd_ps(_mm512_set1_ps(packA[2]), b, c2);
+			c3 = _mm512_fmadd_ps(_mm512_set1_ps(packA[3]), b, c3);
+
+			packA += 4;
+			packB += 16;
+		}
+
+		float* c = C;
+		_mm512_storeu_ps(c, _mm512_add_ps(_mm512_loadu_ps(c), c0)); c += rowStrideC;
+		_mm512_storeu_ps(c, _mm512_add_ps(_mm512_loadu_ps(c), c1)); c += rowStrideC;
+		_mm512_storeu_ps(c, _mm512_add_ps(_mm512_loadu_ps(c), c2)); c += rowStrideC;
+		_mm512_storeu_ps(c, _mm512_add_ps(_mm512_loadu_ps(c), c3));
+	}
+
+	/*! avx512GemmMicroKernel
+	* 4x8 double tile, one zmm accumulator per row
+	*/
+	LITO_SIMD_TARGET("avx512f")
+	inline void avx512GemmMicroKernel(uint kc, const double* packA, const double* packB, double* C, uint rowStrideC)
+	{
+		__m512d c0 = _mm512_setzero_pd();
+		__m512d c1 = _mm512_setzero_pd();
+		__m512d c2 = _mm512_setzero_pd();
+		__m512d c3 = _mm512_setzero_pd();
+
+		for (uint p = 0; p < kc; p++)
+		{
+			__m512d b = _mm512_loadu_pd(packB);
+
+			c0 = _mm512_fmadd_pd(_mm512_set1_pd(packA[0]), b, c0);
+			c1 = _mm512_fmadd_pd(_mm512_set1_pd(packA[1]), b, c1);
+			c2 = _mm512_fmadd_pd(_mm512_set1_pd(packA[2]), b, c2);
+			c3 = _mm512_fmadd_pd(_mm512_set1_pd(packA[3]), b, c3);
+
+			packA += 4;
+			packB += 8;
+		}
+
+		double* c = C;
+		_mm512_storeu_pd(c, _mm512_add_pd(_mm512_loadu_pd(c), c0)); c += rowStrideC;
+		_mm512_storeu_pd(c, _mm512_add_pd(_mm512_loadu_pd(c), c1)); c += rowStrideC;
+		_mm512_storeu_pd(c, _mm512_add_pd(_mm512_loadu_pd(c), c2)); c += rowStrideC;
+		_mm512_storeu_pd(c, _mm512_add_pd(_mm512_loadu_pd(c), c3));
+	}
+
+#endif
+
+	/*! simdKernels
+	* Get the kernels for types without SIMD versions
+	* return: The table of kernels
+	*/
+	template <typename T>
+	const SimdKernels<T>& simdKernels()
+	{
+		static const SimdKernels<T> kernels = { scalarAxpy<T>, scalarMul<T>, scalarScale<T>, scalarDot<T>, nullptr, scalarMatrix4Mul<T>, scalarTransposeTile<T> };
+
+		return kernels;
+	}
+
+	/*! simdKernels
+	* Get the float kernels of the SIMD level in use
+	* return: The table of kernels
+	*/
+	template <>
+	inline const SimdKernels<float>& simdKernels<float>()
+	{
+#ifdef LITO_SIMD_X86
+		static const SimdKernels<float> kernels[] = {
+			{ scalarAxpy<float>, scalarMul<float>, scalarScale<float>, scalarDot<float>, nullptr, scalarMatrix4Mul<float>, scalarTransposeTile<float> },
+			{ sse2Axpy, sse2Mul, sse2Scale, sse2Dot, sse2GemmMicroKernel, sse2Matrix4Mul, sse2TransposeTile },
+			{ avx2Axpy, avx2Mul, avx2Scale, avx2Dot, avx2GemmMicroKernel, avx2Matrix4Mul, avx2TransposeTile },
+			{ avx512Axpy, avx512Mul, avx512Scale, avx512Dot, avx512GemmMicroKernel, avx2Matrix4Mul, avx2TransposeTile }
+		};
+
+		return kernels[static_cast<int>(simdLevel())];
+#else
+		static const SimdKernels<float> kernels = { scalarAxpy<float>, scalarMul<float>, scalarScale<float>, scalarDot<float>, nullptr, scalarMatrix4Mul<float>, scalarTransposeTile<float> };
+
+		return kernels;
+#endif
+	}
+
+	/*! simdKernels
+	* Get the double kernels of the SIMD level in use
+	* return: The table of kernels
+	*/
+	template <>
+	inline const SimdKernels<double>& simdKernels<double>()
+	{
+#ifdef LITO_SIMD_X86
+		static const SimdKernels<double> kernels[] = {
+			{ scalarAxpy<double>, scalarMul<double>, scalarScale<double>, scalarDot<double>, nullptr, scalarMatrix4Mul<double>, scalarTransposeTile<double> },
+			{ sse2Axpy, sse2Mul, sse2Scale, sse2Dot, sse2GemmMicroKernel, sse2Matrix4Mul, sse2TransposeTile },
+			{ avx2Axpy, avx2Mul, avx2Scale, avx2Dot, avx2GemmMicroKernel, avx2Matrix4Mul, avx2TransposeTile },
+			{ avx512Axpy, avx512Mul, avx512Scale, avx512Dot, avx512GemmMicroKernel, avx2Matrix4Mul, avx2TransposeTile }
+		};
+
+		return kernels[static_cast<int>(simdLevel())];
+#else
+		static const SimdKernels<double> kernels = { scalarAxpy<double>, scalarMul<double>, scalarScale<double>, scalarDot<double>, nullptr, scalarMatrix4Mul<double>, scalarTransposeTile<double> };
+
+		return kernels;
+#endif
+	}
+
+}
+
+#endif
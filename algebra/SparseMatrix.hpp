@@ -0,0 +1,777 @@
+#ifndef SPARSE_MATRIX_HPP
+#define SPARSE_MATRIX_HPP
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "Matrix.hpp"
+
+namespace lito {
+
+	/*! SparseTriplets
+	* Builder of sparse matrices from (line, column, value) triplets in any order
+	* Triplets of the same position are summed when the SparseMatrix is built, as the assembly of FEM matrices
+	*/
+	template <typename T>
+	class SparseTriplets {
+	public:
+		SparseTriplets(uint rows = 0, uint columns = 0);
+
+		SparseTriplets<T>& reserve(size_t nonZeros);
+		SparseTriplets<T>& add(uint line, uint column, const T& value);
+		void clear();
+
+		const uint& getRows() const;
+		const uint& getColumns() const;
+		size_t getNonZeros() const;
+		const std::vector<uint>& getLines() const;
+		const std::vector<uint>& getColumnIds() const;
+		const std::vector<T>& getValues() const;
+
+	private:
+		uint _rows;
+		uint _columns;
+		std::vector<uint> _lines;
+		std::vector<uint> _columnIds;
+		std::vector<T> _values;
+	};
+
+	/*! SparseMatrix
+	* Matrix that stores only its non zero values, compressed by lines (CSR) or by columns (CSC)
+	* The outer dimension is the lines in CSR and the columns in CSC:
+	* the values of the outer o are values[pointers[o] .. pointers[o + 1]), at the inner positions of indices,
+	* sorted and without repetitions
+	*/
+	template <typename T>
+	class SparseMatrix {
+	public:
+		SparseMatrix();
+		SparseMatrix(uint rows, uint columns, SparseFormat format = SparseFormat::CSR);
+		SparseMatrix(uint rows, uint columns, std::vector<size_t>&& pointers, std::vector<uint>&& indices, std::vector<T>&& values, SparseFormat format = SparseFormat::CSR);
+		SparseMatrix(const SparseTriplets<T>& triplets, SparseFormat format = SparseFormat::CSR);
+		explicit SparseMatrix(const Matrix<T>& dense, SparseFormat format = SparseFormat::CSR, const T error = T(0));
+
+		const uint& getRows() const;
+		const uint& getColumns() const;
+		SparseFormat getFormat() const;
+		size_t getNonZeros() const;
+		const std::vector<size_t>& getPointers() const;
+		const std::vector<uint>& getIndices() const;
+		const std::vector<T>& getValues() const;
+		std::vector<T>& getValues();
+
+		T at(uint line, uint column) const;
+
+		SparseMatrix<T> toFormat(SparseFormat format) const;
+		SparseMatrix<T> transpose() const;
+		Matrix<T> toMatrix() const;
+
+		Matrix<T> operator * (const Matrix<T>& dense) const;
+		SparseMatrix<T>& operator *= (const T& value);
+		void multiply(const Matrix<T>& matrixX, Matrix<T>& matrixY, const T& alpha = T(1), const T& beta = T(0)) const;
+		void apply(const Matrix<T>& vectorX, Matrix<T>& vectorY) const;
+
+	private:
+		uint outerSize() const;
+		uint innerSize() const;
+		std::vector<uint> outerBlocks(uint blocks) const;
+		void multiplyLines(const Matrix<T>& matrixX, Matrix<T>& matrixY, const T& alpha, const T& beta, uint lineBegin, uint lineEnd) const;
+		void multiplyColumns(const Matrix<T>& matrixX, Matrix<T>& matrixY, const T& alpha, uint columnBegin, uint columnEnd) const;
+
+		uint _rows;
+		uint _columns;
+		SparseFormat _format;
+		std::vector<size_t> _pointers;
+		std::vector<uint> _indices;
+		std::vector<T> _values;
+	};
+
+
+
+	/*! SparseTriplets
+	* Initialize an empty builder
+	* uint rows: Quantities of rows of the matrix
+	* uint columns: Quantities of columns of the matrix
+	*/
+	template <typename T>
+	SparseTriplets<T>::SparseTriplets(uint rows, uint columns)
+		: _rows(rows)
+		, _columns(columns)
+	{}
+
+	/*! reserve
+	* Reserve memory for the triplets
+	* size_t nonZeros: Quantities of triplets expected
+	* return: The builder
+	*/
+	template <typename T>
+	SparseTriplets<T>& SparseTriplets<T>::reserve(size_t nonZeros)
+	{
+		_lines.reserve(nonZeros);
+		_columnIds.reserve(nonZeros);
+		_values.reserve(nonZeros);
+
+		return *this;
+	}
+
+	/*! add
+	* Add a value to a position, summed with the other values of the same position
+	* uint line: Line of the value
+	* uint column: Column of the value
+	* T value: The value
+	* return: The builder
+	*/
+	template <typename T>
+	SparseTriplets<T>& SparseTriplets<T>::add(uint line, uint column, const T& value)
+	{
+		if (line >= _rows || column >= _columns)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, _rows, _columns, line, column));
+
+		_lines.push_back(line);
+		_columnIds.push_back(column);
+		_values.push_back(value);
+
+		return *this;
+	}
+
+	/*! clear
+	* Remove the triplets, keeping the sizes and the memory
+	*/
+	template <typename T>
+	void SparseTriplets<T>::clear()
+	{
+		_lines.clear();
+		_columnIds.clear();
+		_values.clear();
+	}
+
+	/*! getRows
+	* Get the quantities of rows of the matrix
+	* return: The rows
+	*/
+	template <typename T>
+	const uint& SparseTriplets<T>::getRows() const
+	{
+		return _rows;
+	}
+
+	/*! getColumns
+	* Get the quantities of columns of the matrix
+	* return: The columns
+	*/
+	template <typename T>
+	const uint& SparseTriplets<T>::getColumns() const
+	{
+		return _columns;
+	}
+
+	/*! getNonZeros
+	* Get the quantities of triplets, repetitions included
+	* return: The quantities of triplets
+	*/
+	template <typename T>
+	size_t SparseTriplets<T>::getNonZeros() const
+	{
+		return _values.size();
+	}
+
+	/*! getLines
+	* Get the line of each triplet
+	* return: The lines
+	*/
+	template <typename T>
+	const std::vector<uint>& SparseTriplets<T>::getLines() const
+	{
+		return _lines;
+	}
+
+	/*! getColumnIds
+	* Get the column of each triplet
+	* return: The columns
+	*/
+	template <typename T>
+	const std::vector<uint>& SparseTriplets<T>::getColumnIds() const
+	{
+		return _columnIds;
+	}
+
+	/*! getValues
+	* Get the value of each triplet
+	* return: The values
+	*/
+	template <typename T>
+	const std::vector<T>& SparseTriplets<T>::getValues() const
+	{
+		return _values;
+	}
+
+	/*! SparseMatrix
+	* Initialize an empty matrix
+	*/
+	template <typename T>
+	SparseMatrix<T>::SparseMatrix()
+		: _rows(0)
+		, _columns(0)
+		, _format(SparseFormat::CSR)
+		, _pointers(1, 0)
+	{}
+
+	/*! SparseMatrix
+	* Initialize a matrix of zeros
+	* uint rows: Quantities of rows
+	* uint columns: Quantities of columns
+	* SparseFormat format: CSR or CSC
+	*/
+	template <typename T>
+	SparseMatrix<T>::SparseMatrix(uint rows, uint columns, SparseFormat format)
+		: _rows(rows)
+		, _columns(columns)
+		, _format(format)
+		, _pointers(size_t(outerSize()) + 1, 0)
+	{}
+
+	/*! SparseMatrix
+	* Initialize a matrix with its compressed arrays
+	* uint rows: Quantities of rows
+	* uint columns: Quantities of columns
+	* vector<size_t> pointers: Start of each outer in indices and values, outer + 1 values
+	* vector<uint> indices: Inner position of each value, sorted and without repetitions in each outer
+	* vector<T> values: The values
+	* SparseFormat format: CSR or CSC
+	*/
+	template <typename T>
+	SparseMatrix<T>::SparseMatrix(uint rows, uint columns, std::vector<size_t>&& pointers, std::vector<uint>&& indices, std::vector<T>&& values, SparseFormat format)
+		: _rows(rows)
+		, _columns(columns)
+		, _format(format)
+		, _pointers(std::move(pointers))
+		, _indices(std::move(indices))
+		, _values(std::move(values))
+	{
+		if (_pointers.size() != size_t(outerSize()) + 1 || _indices.size() != _values.size() || _pointers.back() != _values.size())
+			throw(MatrixException(MatrixExceptionType::INVALID_SIZE, rows, columns));
+	}
+
+	/*! SparseMatrix
+	* Initialize a matrix with triplets, the values of the same position are summed
+	* The triplets are sorted by two counting passes, inner and then outer, in O(nonZeros + rows + columns)
+	* SparseTriplets<T> triplets: The triplets
+	* SparseFormat format: CSR or CSC
+	*/
+	template <typename T>
+	SparseMatrix<T>::SparseMatrix(const SparseTriplets<T>& triplets, SparseFormat format)
+		: _rows(triplets.getRows())
+		, _columns(triplets.getColumns())
+		, _format(format)
+		, _pointers(size_t(outerSize()) + 1, 0)
+	{
+		const std::vector<uint>& outers = (_format == SparseFormat::CSR) ? triplets.getLines() : triplets.getColumnIds();
+		const std::vector<uint>& inners = (_format == SparseFormat::CSR) ? triplets.getColumnIds() : triplets.getLines();
+		size_t count = triplets.getNonZeros();
+		std::vector<size_t> innerPointers(size_t(innerSize()) + 1, 0);
+		std::vector<size_t> order(count);
+
+		// First pass: the triplets ordered by inner, so the second pass leaves each outer sorted
+		for (size_t p = 0; p < count; p++)
+			innerPointers[inners[p] + 1]++;
+		for (uint i = 0; i < innerSize(); i++)
+			innerPointers[i + 1] += innerPointers[i];
+		for (size_t p = 0; p < count; p++)
+			order[innerPointers[inners[p]]++] = p;
+
+		for (size_t p = 0; p < count; p++)
+			_pointers[outers[p] + 1]++;
+		for (uint o = 0; o < outerSize(); o++)
+			_pointers[o + 1] += _pointers[o];
+
+		std::vector<size_t> next(_pointers.begin(), _pointers.end() - 1);
+		_indices.resize(count);
+		_values.resize(count);
+
+		for (size_t q = 0; q < count; q++)
+		{
+			size_t p = order[q];
+			size_t position = next[outers[p]]++;
+
+			_indices[position] = inners[p];
+			_values[position] = triplets.getValues()[p];
+		}
+
+		// The repetitions are now side by side, they are summed and the arrays compacted
+		size_t write = 0;
+
+		for (uint o = 0; o < outerSize(); o++)
+		{
+			size_t begin = _pointers[o];
+			size_t end = _pointers[o + 1];
+
+			_pointers[o] = write;
+
+			for (size_t p = begin; p < end; p++)
+			{
+				if (write > _pointers[o] && _indices[write - 1] == _indices[p])
+				{
+					_values[write - 1] += _values[p];
+				}
+				else
+				{
+					_indices[write] = _indices[p];
+					_values[write] = _values[p];
+					write++;
+				}
+			}
+		}
+
+		_pointers[outerSize()] = write;
+		_indices.resize(write);
+		_values.resize(write);
+	}
+
+	/*! SparseMatrix
+	* Initialize a matrix with the values of a dense matrix greater than error (absolute)
+	* Matrix<T> dense: The dense matrix
+	* SparseFormat format: CSR or CSC
+	* T error: Values up to error are not stored
+	*/
+	template <typename T>
+	SparseMatrix<T>::SparseMatrix(const Matrix<T>& dense, SparseFormat format, const T error)
+		: _rows(dense.getRows())
+		, _columns(dense.getColumns())
+		, _format(SparseFormat::CSR)
+		, _pointers(size_t(dense.getRows()) + 1, 0)
+	{
+		for (uint i = 0; i < _rows; i++)
+		{
+			const T* line = dense.row(i);
+
+			for (uint j = 0; j < _columns; j++)
+			{
+				if (T(std::abs(line[j])) > error)
+				{
+					_indices.push_back(j);
+					_values.push_back(line[j]);
+				}
+			}
+
+			_pointers[i + 1] = _values.size();
+		}
+
+		if (format == SparseFormat::CSC)
+			*this = toFormat(SparseFormat::CSC);
+	}
+
+	/*! getRows
+	* Get the quantities of rows
+	* return: The rows
+	*/
+	template <typename T>
+	const uint& SparseMatrix<T>::getRows() const
+	{
+		return _rows;
+	}
+
+	/*! getColumns
+	* Get the quantities of columns
+	* return: The columns
+	*/
+	template <typename T>
+	const uint& SparseMatrix<T>::getColumns() const
+	{
+		return _columns;
+	}
+
+	/*! getFormat
+	* Get the storage format
+	* return: CSR or CSC
+	*/
+	template <typename T>
+	SparseFormat SparseMatrix<T>::getFormat() const
+	{
+		return _format;
+	}
+
+	/*! getNonZeros
+	* Get the quantities of values stored
+	* return: The quantities of values
+	*/
+	template <typename T>
+	size_t SparseMatrix<T>::getNonZeros() const
+	{
+		return _values.size();
+	}
+
+	/*! getPointers
+	* Get the start of each outer in the indices and the values, plus the end of the last one
+	* return: The pointers
+	*/
+	template <typename T>
+	const std::vector<size_t>& SparseMatrix<T>::getPointers() const
+	{
+		return _pointers;
+	}
+
+	/*! getIndices
+	* Get the inner position of each value
+	* return: The indices
+	*/
+	template <typename T>
+	const std::vector<uint>& SparseMatrix<T>::getIndices() const
+	{
+		return _indices;
+	}
+
+	/*! getValues
+	* Get the values stored
+	* return: The values
+	*/
+	template <typename T>
+	const std::vector<T>& SparseMatrix<T>::getValues() const
+	{
+		return _values;
+	}
+
+	/*! getValues
+	* Get the values stored, they can be changed but not the positions
+	* return: The values
+	*/
+	template <typename T>
+	std::vector<T>& SparseMatrix<T>::getValues()
+	{
+		return _values;
+	}
+
+	/*! at
+	* Get the value of a position by binary search in its outer
+	* uint line: Line of the value
+	* uint column: Column of the value
+	* return: The value, zero when not stored
+	*/
+	template <typename T>
+	T SparseMatrix<T>::at(uint line, uint column) const
+	{
+		if (line >= _rows || column >= _columns)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, _rows, _columns, line, column));
+
+		uint outer = (_format == SparseFormat::CSR) ? line : column;
+		uint inner = (_format == SparseFormat::CSR) ? column : line;
+		std::vector<uint>::const_iterator begin = _indices.begin() + _pointers[outer];
+		std::vector<uint>::const_iterator end = _indices.begin() + _pointers[outer + 1];
+		std::vector<uint>::const_iterator found = std::lower_bound(begin, end, inner);
+
+		return (found != end && *found == inner) ? _values[found - _indices.begin()] : T(0);
+	}
+
+	/*! toFormat
+	* Convert the matrix to a storage format by one counting pass, in O(nonZeros + rows + columns)
+	* SparseFormat format: CSR or CSC
+	* return: The matrix in the format
+	*/
+	template <typename T>
+	SparseMatrix<T> SparseMatrix<T>::toFormat(SparseFormat format) const
+	{
+		if (format == _format)
+			return *this;
+
+		std::vector<size_t> pointers(size_t(innerSize()) + 1, 0);
+		std::vector<uint> indices(_indices.size());
+		std::vector<T> values(_values.size());
+
+		for (size_t p = 0; p < _indices.size(); p++)
+			pointers[_indices[p] + 1]++;
+		for (uint i = 0; i < innerSize(); i++)
+			pointers[i + 1] += pointers[i];
+
+		std::vector<size_t> next(pointers.begin(), pointers.end() - 1);
+
+		for (uint o = 0; o < outerSize(); o++)
+		{
+			for (size_t p = _pointers[o]; p < _pointers[o + 1]; p++)
+			{
+				size_t position = next[_indices[p]]++;
+
+				indices[position] = o;
+				values[position] = _values[p];
+			}
+		}
+
+		return SparseMatrix<T>(_rows, _columns, std::move(pointers), std::move(indices), std::move(values), format);
+	}
+
+	/*! transpose
+	* Calculate the transpose matrix, the CSR of A is the CSC of At, so only the arrays are copied
+	* return: The transpose, in the other format
+	*/
+	template <typename T>
+	SparseMatrix<T> SparseMatrix<T>::transpose() const
+	{
+		std::vector<size_t> pointers(_pointers);
+		std::vector<uint> indices(_indices);
+		std::vector<T> values(_values);
+
+		return SparseMatrix<T>(_columns, _rows, std::move(pointers), std::move(indices), std::move(values),
+		                       (_format == SparseFormat::CSR) ? SparseFormat::CSC : SparseFormat::CSR);
+	}
+
+	/*! toMatrix
+	* Convert the matrix to a dense matrix
+	* return: The dense matrix
+	*/
+	template <typename T>
+	Matrix<T> SparseMatrix<T>::toMatrix() const
+	{
+		Matrix<T> dense(_rows, _columns);
+
+		for (uint o = 0; o < outerSize(); o++)
+		{
+			for (size_t p = _pointers[o]; p < _pointers[o + 1]; p++)
+			{
+				if (_format == SparseFormat::CSR)
+					dense.row(o)[_indices[p]] = _values[p];
+				else
+					dense.row(_indices[p])[o] = _values[p];
+			}
+		}
+
+		return dense;
+	}
+
+	/*! operator *
+	* Calculate the product by a dense matrix (SpMM), or by a vector n x 1 (SpMV)
+	* Matrix<T> dense: The dense matrix
+	* return: The dense result, with the allocator of the dense matrix
+	*/
+	template <typename T>
+	Matrix<T> SparseMatrix<T>::operator * (const Matrix<T>& dense) const
+	{
+		Matrix<T> result(dense.getAllocator());
+
+		multiply(dense, result);
+
+		return result;
+	}
+
+	/*! operator *=
+	* Multiply the values stored by a value
+	* T value: Value to be multiplied
+	* return: The matrix multiplied
+	*/
+	template <typename T>
+	SparseMatrix<T>& SparseMatrix<T>::operator *= (const T& value)
+	{
+		for (T& stored : _values)
+			stored *= value;
+
+		return *this;
+	}
+
+	/*! multiply
+	* Calculate Y = alpha * A * X + beta * Y, A the sparse matrix and X, Y dense
+	* With the PARALLEL policy the lines (CSR) or the columns (CSC) are split in blocks with about the same
+	* quantities of values; the CSC blocks sum in private results that are added at the end
+	* Matrix<T> matrixX: The matrix X, columns x k, must not be Y
+	* Matrix<T> matrixY: The matrix Y, rows x k, resized when beta is zero
+	* T alpha: Value multiplied to A * X
+	* T beta: Value multiplied to Y, when zero Y is only written
+	*/
+	template <typename T>
+	void SparseMatrix<T>::multiply(const Matrix<T>& matrixX, Matrix<T>& matrixY, const T& alpha, const T& beta) const
+	{
+		if (matrixX.getRows() != _columns)
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, _rows, _columns, matrixX.getRows(), matrixX.getColumns(), '*'));
+
+		uint k = matrixX.getColumns();
+
+		if (matrixY.getRows() != _rows || matrixY.getColumns() != k)
+		{
+			if (beta != T(0))
+				throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, _rows, k, matrixY.getRows(), matrixY.getColumns(), '+'));
+
+			matrixY.resize(_rows, k);
+		}
+
+		if (_rows == 0 || k == 0)
+			return;
+
+		double work = 2.0 * double(getNonZeros()) * k + double(_rows) * k;
+		uint blocks = useParallel(work) ? threadPool().getThreads() * 4 : 1;
+
+		if (_format == SparseFormat::CSR)
+		{
+			std::vector<uint> bounds = outerBlocks(blocks);
+
+			parallelFor(0, blocks, work, [&](uint from, uint to)
+			{
+				multiplyLines(matrixX, matrixY, alpha, beta, bounds[from], bounds[to]);
+			});
+
+			return;
+		}
+
+		for (uint i = 0; i < _rows; i++)
+		{
+			T* lineY = matrixY.row(i);
+
+			if (beta == T(0))
+				std::fill(lineY, lineY + k, T(0));
+			else if (beta != T(1))
+				simdKernels<T>().scale(k, beta, lineY);
+		}
+
+		if (blocks == 1)
+		{
+			multiplyColumns(matrixX, matrixY, alpha, 0, _columns);
+			return;
+		}
+
+		// Columns of different blocks write the same lines of Y, so each block has its own result
+		blocks = threadPool().getThreads();
+
+		std::vector<uint> bounds = outerBlocks(blocks);
+		std::vector<Matrix<T>> partials(blocks);
+
+		parallelFor(0, blocks, work, [&](uint from, uint to)
+		{
+			for (uint b = from; b < to; b++)
+			{
+				partials[b] = Matrix<T>(_rows, k);
+				multiplyColumns(matrixX, partials[b], alpha, bounds[b], bounds[b + 1]);
+			}
+		});
+
+		parallelFor(0, _rows, double(_rows) * k * blocks, [&](uint from, uint to)
+		{
+			for (uint i = from; i < to; i++)
+				for (uint b = 0; b < blocks; b++)
+					simdKernels<T>().axpy(k, T(1), partials[b].row(i), matrixY.row(i));
+		});
+	}
+
+	/*! apply
+	* Calculate y = A * x, the operator used by the iterative solvers
+	* Matrix<T> vectorX: The vector x
+	* Matrix<T> vectorY: Receives the vector y
+	*/
+	template <typename T>
+	void SparseMatrix<T>::apply(const Matrix<T>& vectorX, Matrix<T>& vectorY) const
+	{
+		multiply(vectorX, vectorY);
+	}
+
+	/*! outerSize
+	* Get the quantities of outers, lines in CSR and columns in CSC
+	* return: The quantities of outers
+	*/
+	template <typename T>
+	uint SparseMatrix<T>::outerSize() const
+	{
+		return (_format == SparseFormat::CSR) ? _rows : _columns;
+	}
+
+	/*! innerSize
+	* Get the quantities of inners, columns in CSR and lines in CSC
+	* return: The quantities of inners
+	*/
+	template <typename T>
+	uint SparseMatrix<T>::innerSize() const
+	{
+		return (_format == SparseFormat::CSR) ? _columns : _rows;
+	}
+
+	/*! outerBlocks
+	* Split the outers in blocks with about the same quantities of values
+	* uint blocks: Quantities of blocks
+	* return: The first outer of each block, plus the outers
+	*/
+	template <typename T>
+	std::vector<uint> SparseMatrix<T>::outerBlocks(uint blocks) const
+	{
+		std::vector<uint> bounds(size_t(blocks) + 1, outerSize());
+
+		bounds[0] = 0;
+
+		for (uint b = 1; b < blocks; b++)
+		{
+			size_t target = (getNonZeros() * b) / blocks;
+			uint bound = uint(std::lower_bound(_pointers.begin(), _pointers.end(), target) - _pointers.begin());
+
+			bounds[b] = std::max(bounds[b - 1], std::min(bound, outerSize()));
+		}
+
+		return bounds;
+	}
+
+	/*! multiplyLines
+	* Calculate Y = alpha * A * X + beta * Y on a range of lines of a CSR matrix
+	* Each line of Y sums the lines of X of its values, by the axpy kernel
+	* Matrix<T> matrixX: The matrix X
+	* Matrix<T> matrixY: The matrix Y
+	* T alpha: Value multiplied to A * X
+	* T beta: Value multiplied to Y
+	* uint lineBegin: First line
+	* uint lineEnd: Line after the last
+	*/
+	template <typename T>
+	void SparseMatrix<T>::multiplyLines(const Matrix<T>& matrixX, Matrix<T>& matrixY, const T& alpha, const T& beta, uint lineBegin, uint lineEnd) const
+	{
+		uint k = matrixX.getColumns();
+		const T* dataX = matrixX.data();
+		size_t strideX = matrixX.getStride();
+
+		for (uint i = lineBegin; i < lineEnd; i++)
+		{
+			T* lineY = matrixY.row(i);
+
+			if (k == 1)
+			{
+				T value = T(0);
+
+				for (size_t p = _pointers[i]; p < _pointers[i + 1]; p++)
+					value += _values[p] * dataX[_indices[p] * strideX];
+
+				lineY[0] = (beta == T(0)) ? (alpha * value) : ((alpha * value) + (beta * lineY[0]));
+				continue;
+			}
+
+			if (beta == T(0))
+				std::fill(lineY, lineY + k, T(0));
+			else if (beta != T(1))
+				simdKernels<T>().scale(k, beta, lineY);
+
+			for (size_t p = _pointers[i]; p < _pointers[i + 1]; p++)
+				simdKernels<T>().axpy(k, alpha * _values[p], dataX + (_indices[p] * strideX), lineY);
+		}
+	}
+
+	/*! multiplyColumns
+	* Calculate Y = alpha * A * X + Y on a range of columns of a CSC matrix
+	* Each column adds its line of X to the lines of Y of its values, by the axpy kernel
+	* Matrix<T> matrixX: The matrix X
+	* Matrix<T> matrixY: The matrix Y
+	* T alpha: Value multiplied to A * X
+	* uint columnBegin: First column
+	* uint columnEnd: Column after the last
+	*/
+	template <typename T>
+	void SparseMatrix<T>::multiplyColumns(const Matrix<T>& matrixX, Matrix<T>& matrixY, const T& alpha, uint columnBegin, uint columnEnd) const
+	{
+		uint k = matrixX.getColumns();
+		T* dataY = matrixY.data();
+		size_t strideY = matrixY.getStride();
+
+		for (uint j = columnBegin; j < columnEnd; j++)
+		{
+			const T* lineX = matrixX.row(j);
+
+			for (size_t p = _pointers[j]; p < _pointers[j + 1]; p++)
+			{
+				if (k == 1)
+					dataY[_indices[p] * strideY] += alpha * _values[p] * lineX[0];
+				else
+					simdKernels<T>().axpy(k, alpha * _values[p], lineX, dataY + (_indices[p] * strideY));
+			}
+		}
+	}
+
+}
+
+#endif
@@ -0,0 +1,382 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <exception>
+#include <algorithm>
+#include "MatrixEnum.hpp"
+
+namespace lito {
+
+	/*! ParallelSettings
+	* Execution policy of the matrix operations
+	* ExecutionPolicy policy: SEQUENTIAL (default) or PARALLEL
+	* double threshold: Minimum work (values touched or multiply-adds) of an operation to run in parallel
+	* uint threads: Threads of the shared pool, zero for one per hardware thread
+	*/
+	struct ParallelSettings {
+		ExecutionPolicy policy;
+		double threshold;
+		uint threads;
+	};
+
+	class ThreadPool {
+	public:
+		ThreadPool(uint threads = std::thread::hardware_concurrency());
+		~ThreadPool();
+
+		uint getThreads() const;
+
+		void run(const std::function<void()>& task);
+
+		template <typename F>
+		void parallelFor(uint begin, uint end, uint grain, const F& func);
+
+		template <typename F, typename G>
+		void invoke(const F& first, const G& second);
+
+	private:
+		struct Job {
+			std::function<void(uint, uint)> func;
+			uint begin;
+			uint end;
+			uint grain;
+			uint chunks;
+			std::atomic<uint> next;
+			uint done;
+			std::exception_ptr error;
+			std::mutex mutex;
+			std::condition_variable finished;
+		};
+
+		static void work(const std::shared_ptr<Job>& job);
+		void loop();
+
+		std::vector<std::thread> _workers;
+		std::deque<std::function<void()>> _tasks;
+		std::mutex _mutex;
+		std::condition_variable _wake;
+		bool _stop;
+	};
+
+	inline ParallelSettings& parallelSettings();
+	inline void setExecutionPolicy(ExecutionPolicy policy, double threshold = 65536.0, uint threads = 0);
+	inline bool useParallel(double work);
+	inline ThreadPool& threadPool();
+
+	template <typename F> void parallelFor(uint begin, uint end, double work, const F& func);
+	template <typename F, typename G> void parallelInvoke(double work, const F& first, const G& second);
+
+
+
+	/*! ThreadPool
+	* Start the workers of the pool
+	* The thread calling parallelFor also works, so threads - 1 workers are started
+	* uint threads: Quantities of threads used by each parallelFor
+	*/
+	inline ThreadPool::ThreadPool(uint threads)
+		: _stop(false)
+	{
+		for (uint i = 1; i < threads; i++)
+			_workers.push_back(std::thread(&ThreadPool::loop, this));
+	}
+
+	/*! ~ThreadPool
+	* Finish the queued tasks and stop the workers
+	*/
+	inline ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stop = true;
+		}
+
+		_wake.notify_all();
+
+		for (std::thread& worker : _workers)
+			worker.join();
+	}
+
+	/*! getThreads
+	* Get the quantities of threads used by each parallelFor
+	* return: The workers plus the calling thread
+	*/
+	inline uint ThreadPool::getThreads() const
+	{
+		return uint(_workers.size()) + 1;
+	}
+
+	/*! run
+	* Queue a task to be executed by a worker
+	* Without workers the task is executed now
+	* function<void()> task: The task
+	*/
+	inline void ThreadPool::run(const std::function<void()>& task)
+	{
+		if (_workers.empty())
+		{
+			task();
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_tasks.push_back(task);
+		}
+
+		_wake.notify_one();
+	}
+
+	/*! parallelFor
+	* Execute func over [begin, end) split in chunks of at least grain indices
+	* The calling thread also takes chunks, so nested calls do not deadlock
+	* The first exception thrown by a chunk is thrown again here
+	* uint begin: First index
+	* uint end: Index after the last
+	* uint grain: Minimum quantities of indices of a chunk
+	* F func: Function called as func(from, to) for each chunk
+	*/
+	template <typename F>
+	void ThreadPool::parallelFor(uint begin, uint end, uint grain, const F& func)
+	{
+		if (end <= begin)
+			return;
+
+		uint size = end - begin;
+		grain = std::max(grain, 1u);
+		uint chunks = std::min((size + grain - 1) / grain, getThreads() * 4);
+
+		if (chunks <= 1 || _workers.empty())
+		{
+			func(begin, end);
+			return;
+		}
+
+		std::shared_ptr<Job> job = std::make_shared<Job>();
+		job->func = func;
+		job->begin = begin;
+		job->end = end;
+		job->grain = (size + chunks - 1) / chunks;
+		job->chunks = (size + job->grain - 1) / job->grain;
+		job->next = 0;
+		job->done = 0;
+
+		for (uint i = 1; i < std::min(job->chunks, getThreads()); i++)
+			run([job]() { work(job); });
+
+		work(job);
+
+		std::unique_lock<std::mutex> lock(job->mutex);
+		job->finished.wait(lock, [&job]() { return job->done == job->chunks; });
+
+		if (job->error)
+			std::rethrow_exception(job->error);
+	}
+
+	/*! invoke
+	* Execute first in a worker and second in the calling thread at the same time
+	* When no worker took first by the end of second, the calling thread executes it
+	* The first exception thrown is thrown again here, after both finished
+	* F first: Function called as first()
+	* G second: Function called as second()
+	*/
+	template <typename F, typename G>
+	void ThreadPool::invoke(const F& first, const G& second)
+	{
+		if (_workers.empty())
+		{
+			first();
+			second();
+			return;
+		}
+
+		std::shared_ptr<Job> job = std::make_shared<Job>();
+		std::exception_ptr error;
+		job->func = [&first](uint, uint) { first(); };
+		job->begin = 0;
+		job->end = 1;
+		job->grain = 1;
+		job->chunks = 1;
+		job->next = 0;
+		job->done = 0;
+
+		run([job]() { work(job); });
+
+		try
+		{
+			second();
+		}
+		catch (...)
+		{
+			error = std::current_exception();
+		}
+
+		work(job);
+
+		std::unique_lock<std::mutex> lock(job->mutex);
+		job->finished.wait(lock, [&job]() { return job->done == job->chunks; });
+
+		if (job->error)
+			std::rethrow_exception(job->error);
+		else if (error)
+			std::rethrow_exception(error);
+	}
+
+	/*! work
+	* Take and execute chunks of the job until there is none left
+	* Job job: The job
+	*/
+	inline void ThreadPool::work(const std::shared_ptr<Job>& job)
+	{
+		uint chunk;
+
+		while ((chunk = job->next++) < job->chunks)
+		{
+			uint from = job->begin + (chunk * job->grain);
+			uint to = std::min(job->end, from + job->grain);
+
+			try
+			{
+				job->func(from, to);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(job->mutex);
+
+				if (!job->error)
+					job->error = std::current_exception();
+			}
+
+			std::lock_guard<std::mutex> lock(job->mutex);
+
+			if (++job->done == job->chunks)
+				job->finished.notify_all();
+		}
+	}
+
+	/*! loop
+	* Main loop of the workers
+	*/
+	inline void ThreadPool::loop()
+	{
+		while (true)
+		{
+			std::function<void()> task;
+
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_wake.wait(lock, [this]() { return _stop || !_tasks.empty(); });
+
+				if (_tasks.empty())
+					return;
+
+				task = std::move(_tasks.front());
+				_tasks.pop_front();
+			}
+
+			task();
+		}
+	}
+
+	/*! parallelSettings
+	* Storage of the execution policy of the matrix operations
+	* return: The settings
+	*/
+	inline ParallelSettings& parallelSettings()
+	{
+		static ParallelSettings settings = { ExecutionPolicy::SEQUENTIAL, 65536.0, 0 };
+
+		return settings;
+	}
+
+	/*! setExecutionPolicy
+	* Choose how the matrix operations are executed
+	* Must be called before the operations are used by other threads
+	* ExecutionPolicy policy: SEQUENTIAL or PARALLEL
+	* double threshold: Minimum work (values touched or multiply-adds) of an operation to run in parallel
+	* uint threads: Threads of the shared pool, zero for one per hardware thread, only used before the pool starts
+	*/
+	inline void setExecutionPolicy(ExecutionPolicy policy, double threshold, uint threads)
+	{
+		parallelSettings().policy = policy;
+		parallelSettings().threshold = threshold;
+		parallelSettings().threads = threads;
+	}
+
+	/*! useParallel
+	* Tell if an operation with the work given must run in parallel
+	* double work: Values touched or multiply-adds of the operation
+	* return: If the operation must run in parallel
+	*/
+	inline bool useParallel(double work)
+	{
+		return parallelSettings().policy == ExecutionPolicy::PARALLEL && work >= parallelSettings().threshold;
+	}
+
+	/*! threadPool
+	* Get the pool shared by the matrix operations, started on the first use
+	* return: The pool
+	*/
+	inline ThreadPool& threadPool()
+	{
+		static ThreadPool pool((parallelSettings().threads > 0) ? parallelSettings().threads : std::max(std::thread::hardware_concurrency(), 1u));
+
+		return pool;
+	}
+
+	/*! parallelFor
+	* Execute func over [begin, end) in the shared pool when the policy allows it
+	* Small operations and the SEQUENTIAL policy call func(begin, end) directly
+	* uint begin: First index
+	* uint end: Index after the last
+	* double work: Values touched or multiply-adds of the whole operation
+	* F func: Function called as func(from, to) for each chunk
+	*/
+	template <typename F>
+	void parallelFor(uint begin, uint end, double work, const F& func)
+	{
+		if (end <= begin)
+			return;
+
+		if (!useParallel(work))
+		{
+			func(begin, end);
+			return;
+		}
+
+		double workPerIndex = work / double(end - begin);
+		uint grain = uint(std::max(1.0, parallelSettings().threshold / (4.0 * std::max(workPerIndex, 1.0))));
+
+		threadPool().parallelFor(begin, end, grain, func);
+	}
+
+	/*! parallelInvoke
+	* Execute first and second at the same time in the shared pool when the policy allows it
+	* Small operations and the SEQUENTIAL policy call first() and then second()
+	* double work: Values touched or multiply-adds of both functions
+	* F first: Function called as first()
+	* G second: Function called as second()
+	*/
+	template <typename F, typename G>
+	void parallelInvoke(double work, const F& first, const G& second)
+	{
+		if (!useParallel(work))
+		{
+			first();
+			second();
+			return;
+		}
+
+		threadPool().invoke(first, second);
+	}
+
+}
+
+#endif
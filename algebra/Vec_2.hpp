@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <cstring>
+#include "HalfFloat.hpp"
 
 namespace lito {
 
@@ -61,6 +62,8 @@ namespace lito {
 	
 	typedef Vec_2<float>  Vec_2f;
 	typedef Vec_2<double> Vec_2d;
+	typedef Vec_2<half>   Vec_2h;
+	typedef Vec_2<bfloat16> Vec_2bf;
 
 	template <class T> Vec_2<T> log ( const Vec_2<T> &v )             { return Vec_2<T>( std::log( v._x ), std::log( v._y ) ); }
 	template <class T> Vec_2<T> pow ( const Vec_2<T> &v, T c )        { return Vec_2<T>( std::pow( v._x, c ), std::pow( v._y, c ) ); }
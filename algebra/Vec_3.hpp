@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <cmath>
+#include "HalfFloat.hpp"
 
 namespace lito
 {
@@ -69,6 +70,8 @@ namespace lito
 	
 	typedef Vec_3<float>  Vec_3f;
 	typedef Vec_3<double> Vec_3d;
+	typedef Vec_3<half>   Vec_3h;
+	typedef Vec_3<bfloat16> Vec_3bf;
 	
 	template <class T> Vec_3<T> log ( const Vec_3<T> &v )             { return Vec_3<T>( std::log( v._x ), std::log( v._y ), std::log( v._z ) ); }
 	template <class T> Vec_3<T> pow ( const Vec_3<T> &v, T c )        { return Vec_3<T>( std::pow( v._x, c ), std::pow( v._y, c ), std::pow( v._z, c ) ); }
@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <cstring>
+#include "HalfFloat.hpp"
 
 namespace lito
 {
@@ -73,6 +74,8 @@ namespace lito
 	
 	typedef Vec_4<float>  Vec_4f;
 	typedef Vec_4<double> Vec_4d;
+	typedef Vec_4<half>   Vec_4h;
+	typedef Vec_4<bfloat16> Vec_4bf;
 	
 	template <class T> Vec_4<T> log ( const Vec_4<T> &v )             { return Vec_4<T>( std::log( v._x ), std::log( v._y ), std::log( v._z ), std::log( v._w ) ); }
 	template <class T> Vec_4<T> pow ( const Vec_4<T> &v, T c )        { return Vec_4<T>( std::pow( v._x, c ), std::pow( v._y, c ), std::pow( v._z, c ), std::pow( v._w, c ) ); }
@@ -0,0 +1,743 @@
+#ifndef VECTOR_HPP
+#define VECTOR_HPP
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <utility>
+#include <initializer_list>
+#include <new>
+#include "MatrixEnum.hpp"
+#include "MatrixException.hpp"
+#include "MatrixAllocator.hpp"
+#include "MatrixGemv.hpp"
+#include "Matrix.hpp"
+#include "MatrixView.hpp"
+
+namespace lito {
+
+	/*! Vector
+	* Vector with the size known at run time, its values are contiguous in a storage given by a MatrixAllocator
+	* It is the operand of the matrix-vector kernels: gemv, ger and trsv work on it without building a n x 1 Matrix,
+	* and view() shows it as a n x 1 matrix to the operations on views
+	*/
+	template <typename T>
+	class Vector {
+	public:
+		Vector();
+		explicit Vector(MatrixAllocator* allocator);
+		explicit Vector(uint size, const T& value = T(0), MatrixAllocator* allocator = nullptr);
+		Vector(uint size, const T* data);
+		Vector(std::initializer_list<T> values);
+		explicit Vector(const Matrix<T>& matrix);
+		Vector(const Vector<T>& copyVector);
+		Vector(Vector<T>&& moveVector) noexcept;
+		~Vector();
+
+		Vector<T>& resize(uint size);
+
+		T& operator [] (const uint& index);
+		const T& operator [] (const uint& index) const;
+		T& at (const uint& index);
+		const T& at (const uint& index) const;
+
+		T* data ();
+		const T* data () const;
+		const uint& getSize() const;
+		MatrixAllocator* getAllocator() const;
+
+		Vector<T>& operator = (const Vector<T>& rec);
+		Vector<T>& operator = (Vector<T>&& rec) noexcept;
+
+		Vector<T> operator + (const Vector<T>& sum) const;
+		Vector<T> operator - (const Vector<T>& sub) const;
+		Vector<T> operator * (const T& mul) const;
+
+		Vector<T>& operator += (const Vector<T>& sum);
+		Vector<T>& operator -= (const Vector<T>& sub);
+		Vector<T>& operator *= (const T& mul);
+
+		T dot (const Vector<T>& other) const;
+		T norm () const;
+
+		ConstMatrixView<T> view () const;
+		MatrixView<T> view ();
+		Matrix<T> toMatrix () const;
+
+	private:
+		void release();
+		void check(const Vector<T>& other, char operation) const;
+
+		uint _size;
+		size_t _capacity;
+		T* _data;
+		MatrixAllocator* _allocator;
+	};
+
+	template <typename T> Vector<T> operator * (const T& mul, const Vector<T>& vec);
+	template <typename T> Vector<T> operator * (const ConstMatrixView<T>& matrix, const Vector<T>& vec);
+	template <typename T> Vector<T> operator * (const Matrix<T>& matrix, const Vector<T>& vec);
+	template <typename T> std::ostream& operator << (std::ostream& out, const Vector<T>& vec);
+
+	template <typename T> void gemv(const T& alpha, const ConstMatrixView<T>& A, const Vector<T>& x, const T& beta, Vector<T>& y);
+	template <typename T> void ger(const T& alpha, const Vector<T>& x, const Vector<T>& y, MatrixView<T> A);
+	template <typename T> void trsv(MatrixTriangle triangle, MatrixDiagonal diagonal, const ConstMatrixView<T>& A, Vector<T>& x);
+
+
+
+	/*! Vector
+	* Default initialization of the vector
+	*/
+	template <typename T>
+	Vector<T>::Vector()
+		: Vector(nullptr)
+	{}
+
+	/*! Vector
+	* Initialize an empty vector with the storage given by an allocator
+	* MatrixAllocator* allocator: The allocator, nullptr for matrixAllocator()
+	*/
+	template <typename T>
+	Vector<T>::Vector(MatrixAllocator* allocator)
+		: _size(0)
+		, _capacity(0)
+		, _data(nullptr)
+		, _allocator((allocator != nullptr) ? allocator : matrixAllocator())
+	{}
+
+	/*! Vector
+	* Initialize the vector with all the values equal
+	* uint size: Quantities of values
+	* T value: The value
+	* MatrixAllocator* allocator: The allocator, nullptr for matrixAllocator()
+	*/
+	template <typename T>
+	Vector<T>::Vector(uint size, const T& value, MatrixAllocator* allocator)
+		: Vector(allocator)
+	{
+		resize(size);
+		std::fill(_data, _data + _size, value);
+	}
+
+	/*! Vector
+	* Initialize the vector with a array
+	* uint size: Quantities of values
+	* T*: The array to be copied
+	*/
+	template <typename T>
+	Vector<T>::Vector(uint size, const T* data)
+		: Vector()
+	{
+		resize(size);
+		std::copy(data, data + _size, _data);
+	}
+
+	/*! Vector
+	* Initialize the vector with a list of values
+	* initializer_list<T> values: The values
+	*/
+	template <typename T>
+	Vector<T>::Vector(std::initializer_list<T> values)
+		: Vector()
+	{
+		resize(uint(values.size()));
+		std::copy(values.begin(), values.end(), _data);
+	}
+
+	/*! Vector
+	* Initialize the vector with the values of a matrix of one column or one row, with the same allocator
+	* Matrix<T> matrix: The matrix to be copied
+	*/
+	template <typename T>
+	Vector<T>::Vector(const Matrix<T>& matrix)
+		: Vector(matrix.getAllocator())
+	{
+		if (matrix.getColumns() == 1)
+		{
+			resize(matrix.getRows());
+
+			for (uint i = 0; i < _size; i++)
+				_data[i] = matrix.row(i)[0];
+		}
+		else if (matrix.getRows() == 1)
+		{
+			resize(matrix.getColumns());
+			std::copy(matrix.row(0), matrix.row(0) + _size, _data);
+		}
+		else if (matrix.getRows() * matrix.getColumns() != 0)
+		{
+			throw(MatrixException(MatrixExceptionType::INVALID_SIZE, matrix.getRows(), matrix.getColumns()));
+		}
+	}
+
+	/*! Vector
+	* Initialize the vector as copy of another vector, with the same allocator
+	* Vector<T> copyVector: The vector to be copied
+	*/
+	template <typename T>
+	Vector<T>::Vector(const Vector<T>& copyVector)
+		: Vector(copyVector._allocator)
+	{
+		resize(copyVector._size);
+		std::copy(copyVector._data, copyVector._data + _size, _data);
+	}
+
+	/*! Vector
+	* Initialize the vector taking the storage and the allocator of another vector
+	* Vector<T> moveVector: The vector to be moved, left empty
+	*/
+	template <typename T>
+	Vector<T>::Vector(Vector<T>&& moveVector) noexcept
+		: _size(moveVector._size)
+		, _capacity(moveVector._capacity)
+		, _data(moveVector._data)
+		, _allocator(moveVector._allocator)
+	{
+		moveVector._size = 0;
+		moveVector._capacity = 0;
+		moveVector._data = nullptr;
+	}
+
+	/*! ~Vector
+	* Destroy the vector
+	*/
+	template <typename T>
+	Vector<T>::~Vector()
+	{
+		release();
+	}
+
+	/*! resize
+	* Resize the quantities of values of the vector
+	* The storage is kept when its capacity is enough, otherwise a new one is allocated, zero releases it
+	* The values are not kept
+	* uint size: New quantities of values
+	* return: The vector resized
+	*/
+	template <typename T>
+	Vector<T>& Vector<T>::resize(uint size)
+	{
+		if (size == 0)
+		{
+			release();
+		}
+		else if (size > _capacity)
+		{
+			release();
+
+			_data = static_cast<T*>(_allocator->allocate(sizeof(T) * size, _allocator->getAlignment()));
+			_capacity = size;
+
+			for (size_t i = 0; i < _capacity; i++)
+				new (_data + i) T;
+		}
+
+		_size = size;
+
+		return *this;
+	}
+
+	/*! release
+	* Destroy the values and give the storage back to the allocator
+	*/
+	template <typename T>
+	void Vector<T>::release()
+	{
+		if (_data != nullptr)
+		{
+			for (size_t i = 0; i < _capacity; i++)
+				_data[i].~T();
+
+			_allocator->deallocate(_data, sizeof(T) * _capacity, _allocator->getAlignment());
+		}
+
+		_size = 0;
+		_capacity = 0;
+		_data = nullptr;
+	}
+
+	/*! check
+	* Check if an operation value to value with another vector can be done
+	* Vector<T> other: The other vector
+	* char operation: The operation, for the exception
+	*/
+	template <typename T>
+	void Vector<T>::check(const Vector<T>& other, char operation) const
+	{
+		if (_size != other._size)
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, _size, 1, other._size, 1, operation));
+		else if (_data == nullptr)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+	}
+
+	/*! operator []
+	* Get the value of a index
+	* Checked only when LITO_MATRIX_CHECK_BOUNDS is on
+	* uint index: The index
+	* return: The value
+	*/
+	template <typename T>
+	T& Vector<T>::operator [] (const uint& index)
+	{
+#if LITO_MATRIX_CHECK_BOUNDS
+		if (index >= _size)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, _size, 1, index, 0));
+#endif
+
+		return _data[index];
+	}
+
+	/*! operator []
+	* Get the value of a index
+	* Checked only when LITO_MATRIX_CHECK_BOUNDS is on
+	* uint index: The index
+	* return: The value
+	*/
+	template <typename T>
+	const T& Vector<T>::operator [] (const uint& index) const
+	{
+#if LITO_MATRIX_CHECK_BOUNDS
+		if (index >= _size)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, _size, 1, index, 0));
+#endif
+
+		return _data[index];
+	}
+
+	/*! at
+	* Get the value of a index, always checked
+	* uint index: The index
+	* return: The value
+	*/
+	template <typename T>
+	T& Vector<T>::at (const uint& index)
+	{
+		if (index >= _size)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, _size, 1, index, 0));
+
+		return _data[index];
+	}
+
+	/*! at
+	* Get the value of a index, always checked
+	* uint index: The index
+	* return: The value
+	*/
+	template <typename T>
+	const T& Vector<T>::at (const uint& index) const
+	{
+		if (index >= _size)
+			throw(MatrixException(MatrixExceptionType::INVALID_ACCESS, _size, 1, index, 0));
+
+		return _data[index];
+	}
+
+	/*! data
+	* Get the first value of the vector
+	* return: The first value, nullptr when empty
+	*/
+	template <typename T>
+	T* Vector<T>::data ()
+	{
+		return _data;
+	}
+
+	/*! data
+	* Get the first value of the vector
+	* return: The first value, nullptr when empty
+	*/
+	template <typename T>
+	const T* Vector<T>::data () const
+	{
+		return _data;
+	}
+
+	/*! getSize
+	* Get the quantities of values of the vector
+	* return: The quantities of values
+	*/
+	template <typename T>
+	const uint& Vector<T>::getSize() const
+	{
+		return _size;
+	}
+
+	/*! getAllocator
+	* Get the allocator of the storage of the vector
+	* return: The allocator
+	*/
+	template <typename T>
+	MatrixAllocator* Vector<T>::getAllocator() const
+	{
+		return _allocator;
+	}
+
+	/*! operator =
+	* Copy the values of another vector, keeping the allocator
+	* Vector<T> rec: The vector to be copied
+	* return: The vector modified
+	*/
+	template <typename T>
+	Vector<T>& Vector<T>::operator = (const Vector<T>& rec)
+	{
+		if (this != &rec)
+		{
+			resize(rec._size);
+			std::copy(rec._data, rec._data + _size, _data);
+		}
+
+		return *this;
+	}
+
+	/*! operator =
+	* Take the storage and the allocator of another vector
+	* Vector<T> rec: The vector to be moved, left empty
+	* return: The vector modified
+	*/
+	template <typename T>
+	Vector<T>& Vector<T>::operator = (Vector<T>&& rec) noexcept
+	{
+		if (this != &rec)
+		{
+			release();
+
+			_size = rec._size;
+			_capacity = rec._capacity;
+			_data = rec._data;
+			_allocator = rec._allocator;
+
+			rec._size = 0;
+			rec._capacity = 0;
+			rec._data = nullptr;
+		}
+
+		return *this;
+	}
+
+	/*! operator +
+	* Sum two vectors
+	* Vector<T> sum: Vector to be added
+	* return: The sum of the vectors
+	*/
+	template <typename T>
+	Vector<T> Vector<T>::operator + (const Vector<T>& sum) const
+	{
+		Vector<T> newVector(*this);
+
+		newVector += sum;
+
+		return newVector;
+	}
+
+	/*! operator -
+	* Subtract two vectors
+	* Vector<T> sub: Vector to be subtracted
+	* return: The subtraction of the vectors
+	*/
+	template <typename T>
+	Vector<T> Vector<T>::operator - (const Vector<T>& sub) const
+	{
+		Vector<T> newVector(*this);
+
+		newVector -= sub;
+
+		return newVector;
+	}
+
+	/*! operator *
+	* Multiply the vector with mul value
+	* T mul: Value to be multiplied
+	* return: The multiplication of the vector with mul value
+	*/
+	template <typename T>
+	Vector<T> Vector<T>::operator * (const T& mul) const
+	{
+		Vector<T> newVector(*this);
+
+		newVector *= mul;
+
+		return newVector;
+	}
+
+	/*! operator +=
+	* Sum the vector sum into this vector
+	* Vector<T> sum: Vector to be added
+	* return: The vector modified
+	*/
+	template <typename T>
+	Vector<T>& Vector<T>::operator += (const Vector<T>& sum)
+	{
+		check(sum, '+');
+
+		T* data = _data;
+		const T* other = sum._data;
+
+		parallelFor(0, _size, double(_size), [=](uint from, uint to)
+		{
+			simdKernels<T>().axpy(to - from, T(1), other + from, data + from);
+		});
+
+		return *this;
+	}
+
+	/*! operator -=
+	* Subtract the vector sub from this vector
+	* Vector<T> sub: Vector to be subtracted
+	* return: The vector modified
+	*/
+	template <typename T>
+	Vector<T>& Vector<T>::operator -= (const Vector<T>& sub)
+	{
+		check(sub, '-');
+
+		T* data = _data;
+		const T* other = sub._data;
+
+		parallelFor(0, _size, double(_size), [=](uint from, uint to)
+		{
+			simdKernels<T>().axpy(to - from, T(-1), other + from, data + from);
+		});
+
+		return *this;
+	}
+
+	/*! operator *=
+	* Multiply this vector with mul value
+	* T mul: Value to be multiplied
+	* return: The vector modified
+	*/
+	template <typename T>
+	Vector<T>& Vector<T>::operator *= (const T& mul)
+	{
+		T* data = _data;
+
+		parallelFor(0, _size, double(_size), [=](uint from, uint to)
+		{
+			simdKernels<T>().scale(to - from, mul, data + from);
+		});
+
+		return *this;
+	}
+
+	/*! dot
+	* Calculate the dot product with another vector
+	* Vector<T> other: The other vector
+	* return: The sum of the products value to value
+	*/
+	template <typename T>
+	T Vector<T>::dot (const Vector<T>& other) const
+	{
+		check(other, '*');
+
+		return simdKernels<T>().dot(_size, _data, other._data);
+	}
+
+	/*! norm
+	* Calculate the euclidean norm of the vector
+	* return: The square root of the dot product with itself
+	*/
+	template <typename T>
+	T Vector<T>::norm () const
+	{
+		if (_data == nullptr)
+			throw(MatrixException(MatrixExceptionType::MATRIX_NOT_INITIALIZED));
+
+		return T(std::sqrt(simdKernels<T>().dot(_size, _data, _data)));
+	}
+
+	/*! view
+	* Get the vector as a read only n x 1 matrix view
+	* return: The view
+	*/
+	template <typename T>
+	ConstMatrixView<T> Vector<T>::view () const
+	{
+		return ConstMatrixView<T>(_size, 1, _data, 1);
+	}
+
+	/*! view
+	* Get the vector as a n x 1 matrix view
+	* return: The view
+	*/
+	template <typename T>
+	MatrixView<T> Vector<T>::view ()
+	{
+		return MatrixView<T>(_size, 1, _data, 1);
+	}
+
+	/*! toMatrix
+	* Copy the vector to a n x 1 matrix, with the same allocator
+	* return: The matrix
+	*/
+	template <typename T>
+	Matrix<T> Vector<T>::toMatrix () const
+	{
+		Matrix<T> matrix(_allocator);
+
+		matrix.resize(_size, 1);
+
+		for (uint i = 0; i < _size; i++)
+			matrix.row(i)[0] = _data[i];
+
+		return matrix;
+	}
+
+	/*! operator *
+	* Multiply the vector with mul value
+	* T mul: Value to be multiplied
+	* Vector<T> vec: The vector
+	* return: The multiplication of the vector with mul value
+	*/
+	template <typename T>
+	Vector<T> operator * (const T& mul, const Vector<T>& vec)
+	{
+		return vec * mul;
+	}
+
+	/*! operator *
+	* Multiply a matrix with a vector by gemv
+	* ConstMatrixView<T> matrix: The matrix
+	* Vector<T> vec: The vector
+	* return: The vector of the multiplication
+	*/
+	template <typename T>
+	Vector<T> operator * (const ConstMatrixView<T>& matrix, const Vector<T>& vec)
+	{
+		Vector<T> newVector(vec.getAllocator());
+
+		newVector.resize(matrix.getRows());
+		gemv(T(1), matrix, vec, T(0), newVector);
+
+		return newVector;
+	}
+
+	/*! operator *
+	* Multiply a matrix with a vector by gemv
+	* Matrix<T> matrix: The matrix
+	* Vector<T> vec: The vector
+	* return: The vector of the multiplication
+	*/
+	template <typename T>
+	Vector<T> operator * (const Matrix<T>& matrix, const Vector<T>& vec)
+	{
+		return ConstMatrixView<T>(matrix) * vec;
+	}
+
+	/*! operator <<
+	* Write the values of the vector
+	* ostream out: The stream
+	* Vector<T> vec: The vector
+	* return: The stream
+	*/
+	template <typename T>
+	std::ostream& operator << (std::ostream& out, const Vector<T>& vec)
+	{
+		if (vec.getSize() == 0)
+		{
+			out << "Vector not initialized!";
+		}
+		else
+		{
+			out << "[ " << vec.data()[0];
+			for (uint i = 1; i < vec.getSize(); i++)
+			{
+				out << ", " << vec.data()[i];
+			}
+			out << " ]";
+		}
+
+		return out;
+	}
+
+	/*! gemv
+	* Calculate y = alpha * A * x + beta * y by gemvKernel
+	* A y that overlaps A or x is calculated in a temporary
+	* T alpha: Value multiplied to A * x
+	* ConstMatrixView<T> A: The matrix, in any layout
+	* Vector<T> x: The vector x
+	* T beta: Value multiplied to y, when zero y is only written
+	* Vector<T> y: The vector y, with the rows of A
+	*/
+	template <typename T>
+	void gemv(const T& alpha, const ConstMatrixView<T>& A, const Vector<T>& x, const T& beta, Vector<T>& y)
+	{
+		if (A.getColumns() != x.getSize())
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, A.getRows(), A.getColumns(), x.getSize(), 1, '*'));
+		else if (y.getSize() != A.getRows())
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, A.getRows(), 1, y.getSize(), 1, '='));
+
+		if (viewsOverlap(A, y.view()) || viewsOverlap(x.view(), y.view()))
+		{
+			Vector<T> newVector(y);
+
+			gemvKernel(A.getRows(), A.getColumns(), alpha, A.data(), A.getRowStride(), A.getColumnStride(), x.data(), 1, beta, newVector.data(), 1);
+			y = std::move(newVector);
+		}
+		else
+		{
+			gemvKernel(A.getRows(), A.getColumns(), alpha, A.data(), A.getRowStride(), A.getColumnStride(), x.data(), 1, beta, y.data(), 1);
+		}
+	}
+
+	/*! ger
+	* Calculate A = alpha * x * y^T + A, the rank-1 update, by gerKernel
+	* Values of x or y that overlap A are copied before the update
+	* T alpha: Value multiplied to x * y^T
+	* Vector<T> x: The vector x, with the rows of A
+	* Vector<T> y: The vector y, with the columns of A
+	* MatrixView<T> A: The matrix, in any layout
+	*/
+	template <typename T>
+	void ger(const T& alpha, const Vector<T>& x, const Vector<T>& y, MatrixView<T> A)
+	{
+		if (A.getRows() != x.getSize() || A.getColumns() != y.getSize())
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, A.getRows(), A.getColumns(), x.getSize(), y.getSize(), '+'));
+
+		if (viewsOverlap(ConstMatrixView<T>(A), x.view()) || viewsOverlap(ConstMatrixView<T>(A), y.view()))
+		{
+			Vector<T> copyX(x);
+			Vector<T> copyY(y);
+
+			gerKernel(A.getRows(), A.getColumns(), alpha, copyX.data(), 1, copyY.data(), 1, A.data(), A.getRowStride(), A.getColumnStride());
+		}
+		else
+		{
+			gerKernel(A.getRows(), A.getColumns(), alpha, x.data(), 1, y.data(), 1, A.data(), A.getRowStride(), A.getColumnStride());
+		}
+	}
+
+	/*! trsv
+	* Solve A * x = b writing x over b, for a triangular A, by trsvKernel
+	* MatrixTriangle triangle: LOWER or UPPER, the values of the other triangle are not read
+	* MatrixDiagonal diagonal: NON_UNIT, or UNIT to take the diagonal as ones
+	* ConstMatrixView<T> A: The square matrix, in any layout
+	* Vector<T> x: The vector b, replaced by x
+	*/
+	template <typename T>
+	void trsv(MatrixTriangle triangle, MatrixDiagonal diagonal, const ConstMatrixView<T>& A, Vector<T>& x)
+	{
+		if (A.getRows() != A.getColumns())
+			throw(MatrixException(MatrixExceptionType::INVALID_SIZE, A.getRows(), A.getColumns()));
+		else if (A.getColumns() != x.getSize())
+			throw(MatrixException(MatrixExceptionType::INCOMPATIBLE_SIZES, A.getRows(), A.getColumns(), x.getSize(), 1, 'X'));
+
+		if (diagonal == MatrixDiagonal::NON_UNIT)
+			for (uint i = 0; i < A.getRows(); i++)
+				if (A(i, i) == T(0))
+					throw(MatrixException(MatrixExceptionType::SINGULAR_MATRIX));
+
+		if (viewsOverlap(A, x.view()))
+		{
+			Matrix<T> copyA(A);
+
+			trsvKernel(x.getSize(), triangle, diagonal, copyA.data(), copyA.getStride(), 1, x.data(), 1);
+		}
+		else
+		{
+			trsvKernel(x.getSize(), triangle, diagonal, A.data(), A.getRowStride(), A.getColumnStride(), x.data(), 1);
+		}
+	}
+
+}
+
+#endif
@@ -7,20 +7,10 @@
 #include "Matriz_2.hpp"
 #include "Matriz_3.hpp"
 #include "Matriz_4.hpp"
+#include "MatrixException.hpp"
 
 namespace lito {
 
-	class MatrixException : public std::exception
-	{
-	public:
-		MatrixException ( std::string e ) : error( e ) {}
-		void showExeception ()       { std::cerr << error << std::endl; }
-		void showExeception () const { std::cerr << error << std::endl; }
-
-	private:
-		std::string error;
-	};
-
 	template <class T> T determinant ( const Matriz_2<T> &m );
 	template <class T> T determinant ( const Matriz_3<T> &m );
 	template <class T> T determinant ( const Matriz_4<T> &m );
@@ -407,7 +397,7 @@ namespace lito {
 		T deter = determinant( m );
 		
 		if ( deter == T(0) )
-			throw MatrixException{ "There is no inverse for the matrix." };
+			throw MatrixException{ MatrixExceptionType::SINGULAR_MATRIX };
 		
 		T deterIverse = T(1) / deter;
 		
@@ -425,7 +415,7 @@ namespace lito {
 		T c8 = deterIverse * ( + ( ( m[0] * m[4] ) - ( m[1] * m[3] ) ) );
 
 		// Transposed adjunct matrix
-		return Matriz_3<T> { c0, c3, c2
+		return Matriz_3<T> { c0, c3, c6
 		                   , c1, c4, c7
 						   , c2, c5, c8 };
 	}
@@ -452,7 +442,7 @@ namespace lito {
 			    - ( m[3] * ( ( m[4] * C ) - ( m[5] * E ) + ( m[6] * F ) ) );
 		
 		if ( deter == T(0) )
-			throw MatrixException{ "There is no inverse for the matrix." };
+			throw MatrixException{ MatrixExceptionType::SINGULAR_MATRIX };
 		
 		T deterIverse = T(1) / deter;
 
@@ -0,0 +1,199 @@
+#ifndef ALGEBRA_TEST_HPP
+#define ALGEBRA_TEST_HPP
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <algorithm>
+#include <string>
+#include "CpuFeatures.hpp"
+#include "ThreadPool.hpp"
+#include "Matrix.hpp"
+#include "MatrixView.hpp"
+
+namespace lito {
+
+	/*! testFailures
+	* Quantities of checks that failed, the return of the test program
+	*/
+	inline int& testFailures()
+	{
+		static int failures = 0;
+
+		return failures;
+	}
+
+	/*! testConfiguration
+	* Name of the configuration being checked, shown with the checks that fail
+	*/
+	inline std::string& testConfiguration()
+	{
+		static std::string configuration;
+
+		return configuration;
+	}
+
+	/*! testCheck
+	* Report a check that failed, with where it is and a value to compare
+	* bool condition: The check
+	* const char* name: What was checked
+	* double value: Value measured, shown when the check fails
+	*/
+	inline void testCheck(bool condition, const char* name, double value = 0.0)
+	{
+		if (!condition)
+		{
+			std::printf("FAILED: %s (%g) %s\n", name, value, testConfiguration().c_str());
+			testFailures()++;
+		}
+	}
+
+	/*! testSimdLevels
+	* Call func once with each SIMD level up to the detected one, so the kernels of every level are checked
+	* F func: Function called as func()
+	*/
+	template <typename F>
+	void testSimdLevels(const F& func)
+	{
+		const char* names[] = { "SCALAR", "SSE2", "AVX2", "AVX512" };
+		const SimdLevel detected = detectedSimdLevel();
+
+		for (int level = 0; level <= static_cast<int>(detected); level++)
+		{
+			setSimdLevel(static_cast<SimdLevel>(level));
+			testConfiguration() = names[level];
+			func();
+		}
+
+		setSimdLevel(detected);
+		testConfiguration().clear();
+	}
+
+	/*! testConfigurations
+	* Call func with each SIMD level up to the detected one, first sequential and then with the PARALLEL policy
+	* over a pool of four threads and a threshold that sends every operation to the pool
+	* F func: Function called as func()
+	*/
+	template <typename F>
+	void testConfigurations(const F& func)
+	{
+		const char* names[] = { "SCALAR", "SSE2", "AVX2", "AVX512" };
+		const ExecutionPolicy policies[] = { ExecutionPolicy::SEQUENTIAL, ExecutionPolicy::PARALLEL };
+		const SimdLevel detected = detectedSimdLevel();
+
+		for (ExecutionPolicy policy : policies)
+		{
+			setExecutionPolicy(policy, 1.0, 4);
+
+			for (int level = 0; level <= static_cast<int>(detected); level++)
+			{
+				setSimdLevel(static_cast<SimdLevel>(level));
+				testConfiguration() = std::string(names[level]) + ((policy == ExecutionPolicy::PARALLEL) ? " PARALLEL" : " SEQUENTIAL");
+				func();
+			}
+		}
+
+		setExecutionPolicy(ExecutionPolicy::SEQUENTIAL);
+		setSimdLevel(detected);
+		testConfiguration().clear();
+	}
+
+	/*! testRandom
+	* Fill a matrix with values in [-1, 1)
+	* Matrix<T> M: The matrix
+	* std::mt19937 generator: The random generator
+	* return: The matrix
+	*/
+	template <typename T>
+	Matrix<T>& testRandom(Matrix<T>& M, std::mt19937& generator)
+	{
+		std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+		for (uint i = 0; i < M.getRows(); i++)
+			for (uint j = 0; j < M.getColumns(); j++)
+				M(i, j) = T(distribution(generator));
+
+		return M;
+	}
+
+	/*! testProduct
+	* Reference product A * B, three loops in double
+	* ConstMatrixView<T> A: The matrix A
+	* ConstMatrixView<T> B: The matrix B
+	* return: A * B
+	*/
+	template <typename T>
+	Matrix<T> testProduct(const ConstMatrixView<T>& A, const ConstMatrixView<T>& B)
+	{
+		Matrix<T> C(A.getRows(), B.getColumns());
+
+		for (uint i = 0; i < A.getRows(); i++)
+		{
+			for (uint j = 0; j < B.getColumns(); j++)
+			{
+				double value = 0.0;
+
+				for (uint p = 0; p < A.getColumns(); p++)
+					value += double(A(i, p)) * double(B(p, j));
+
+				C(i, j) = T(value);
+			}
+		}
+
+		return C;
+	}
+
+	/*! testDifference
+	* Largest absolute difference between two matrices of the same size
+	* ConstMatrixView<T> A: The first matrix
+	* ConstMatrixView<T> B: The second matrix
+	* return: The difference, infinity when the sizes differ
+	*/
+	template <typename T>
+	double testDifference(const ConstMatrixView<T>& A, const ConstMatrixView<T>& B)
+	{
+		if (A.getRows() != B.getRows() || A.getColumns() != B.getColumns())
+			return HUGE_VAL;
+
+		double difference = 0.0;
+
+		for (uint i = 0; i < A.getRows(); i++)
+			for (uint j = 0; j < A.getColumns(); j++)
+				difference = std::max(difference, std::abs(double(A(i, j)) - double(B(i, j))));
+
+		return difference;
+	}
+
+	/*! testResidual
+	* Largest value of A * X - B, by the reference product
+	* ConstMatrixView<T> A: The matrix A
+	* ConstMatrixView<T> X: The solution X
+	* ConstMatrixView<T> B: The right-hand sides B
+	* return: The residual
+	*/
+	template <typename T>
+	double testResidual(const ConstMatrixView<T>& A, const ConstMatrixView<T>& X, const ConstMatrixView<T>& B)
+	{
+		Matrix<T> AX = testProduct(A, X);
+
+		return testDifference(view(AX), B);
+	}
+
+	/*! testResult
+	* Print the result of the test program
+	* const char* name: Name of the test program
+	* return: The exit code, 0 when every check passed
+	*/
+	inline int testResult(const char* name)
+	{
+		if (testFailures() == 0)
+			std::printf("%s: passed\n", name);
+		else
+			std::printf("%s: %d checks failed\n", name, testFailures());
+
+		return testFailures() == 0 ? 0 : 1;
+	}
+
+}
+
+#endif
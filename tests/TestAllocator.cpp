@@ -0,0 +1,196 @@
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "AlgebraTest.hpp"
+#include "Vector.hpp"
+#include "SparseMatrix.hpp"
+
+using namespace lito;
+
+/*! testPoolReuse
+* A storage released to the pool is given again to the next storage of the same size class,
+* of the pool directly and of the matrices using it
+*/
+void testPoolReuse()
+{
+	PoolAllocator pool;
+
+	void* first = pool.allocate(1000, 64);
+
+	pool.deallocate(first, 1000, 64);
+
+	void* second = pool.allocate(800, 64);
+
+	testCheck(second == first, "storage of the same size class reused");
+	testCheck(reinterpret_cast<uintptr_t>(second) % 64 == 0, "storage of the pool aligned");
+	pool.deallocate(second, 800, 64);
+
+	const double* data;
+
+	{
+		Matrix<double> temporary(10, 10, MatrixType::ONES, &pool);
+
+		data = temporary.data();
+	}
+
+	Matrix<double> M(9, 11, MatrixType::ZEROS, &pool);
+
+	testCheck(M.data() == data, "storage of a temporary matrix reused");
+	testCheck(M(8, 10) == 0.0, "values of a reused storage initialized");
+
+	void* large = pool.allocate(size_t(PoolAllocator::MIN_BYTES) << PoolAllocator::CLASSES, 64);
+
+	pool.deallocate(large, size_t(PoolAllocator::MIN_BYTES) << PoolAllocator::CLASSES, 64);
+
+	void* aligned = pool.allocate(64, 128);
+
+	testCheck(reinterpret_cast<uintptr_t>(aligned) % 128 == 0, "storage aligned over the classes given by the heap");
+	pool.deallocate(aligned, 64, 128);
+}
+
+/*! testPoolThreads
+* Storages allocated by one thread and released by another, directly and by matrices moved between them
+*/
+void testPoolThreads()
+{
+	PoolAllocator pool;
+	std::vector<void*> blocks;
+
+	for (uint i = 0; i < 64; i++)
+		blocks.push_back(pool.allocate(64 * (i + 1), 64));
+
+	std::thread release([&]()
+	{
+		for (uint i = 0; i < 64; i++)
+			pool.deallocate(blocks[i], 64 * (i + 1), 64);
+	});
+
+	release.join();
+
+	std::vector<Matrix<double>> matrices;
+
+	std::thread create([&]()
+	{
+		for (uint i = 1; i <= 16; i++)
+			matrices.push_back(Matrix<double>(i, i + 3, MatrixType::ONES, &pool));
+	});
+
+	create.join();
+
+	double sum = 0.0;
+
+	for (Matrix<double>& M : matrices)
+		sum += M(M.getRows() - 1, M.getColumns() - 1);
+
+	matrices.clear();
+
+	std::thread another([&]()
+	{
+		Matrix<double> M(40, 40, MatrixType::IDENTITY, &pool);
+		Matrix<double> N(M);
+
+		N += M;
+		sum += N(39, 39);
+	});
+
+	another.join();
+
+	testCheck(sum == 18.0, "matrices of the pool across threads", sum);
+}
+
+/*! testResizeCapacity
+* resize keeps the storage while its capacity is enough, with and without row padding,
+* and fills the padding with zeros
+*/
+void testResizeCapacity()
+{
+	Matrix<double> M(20, 20);
+	const double* data = M.data();
+
+	M.resize(10, 30);
+	testCheck(M.data() == data && M.getCapacity() == 400, "storage kept by a resize to the same size", double(M.getCapacity()));
+
+	M.resize(5, 5);
+	testCheck(M.data() == data && M.getCapacity() == 400 && M.getStride() == 5, "storage kept by a smaller resize", double(M.getCapacity()));
+
+	M.resize(21, 20);
+	testCheck(M.getCapacity() == 420, "storage of a bigger resize", double(M.getCapacity()));
+
+	AlignedAllocator allocator(64, true);
+	Matrix<double> padded(16, 16, MatrixType::ONES, &allocator);
+
+	data = padded.data();
+
+	for (uint i = 0; i < 16; i++)
+		for (uint j = 0; j < 16; j++)
+			padded(i, j) = 7.0;
+
+	padded.resize(20, 5);
+
+	bool zeros = true;
+
+	for (uint i = 0; i < 20; i++)
+		for (uint j = 5; j < 8; j++)
+			zeros = zeros && padded.data()[(size_t(padded.getStride()) * i) + j] == 0.0;
+
+	testCheck(padded.data() == data && padded.getCapacity() == 256 && padded.getStride() == 8, "padded storage kept by resize", double(padded.getStride()));
+	testCheck(zeros, "padding filled with zeros by resize");
+	testCheck(reinterpret_cast<uintptr_t>(padded.row(19)) % 64 == 0, "padded rows aligned");
+}
+
+/*! testResultAllocator
+* The results built by the products take the allocator of their operand, the matrix of a product in the pool
+* reuses the storage of the temporary released before it
+*/
+void testResultAllocator(std::mt19937& generator)
+{
+	PoolAllocator pool;
+	Matrix<double> A(40, 40, MatrixType::ZEROS, &pool);
+	Matrix<double> B(40, 40, MatrixType::ZEROS, &pool);
+
+	testRandom(A, generator);
+	testRandom(B, generator);
+
+	Matrix<double> product = A * B;
+
+	testCheck(product.getAllocator() == &pool, "allocator of the product");
+	testCheck(testDifference(view(product), view(testProduct(view(A), view(B)))) <= 1e-13, "product in the pool");
+
+	const double* data = product.data();
+
+	product = Matrix<double>(&pool);
+	product = A * B;
+	testCheck(product.data() == data, "storage of the product reused by the next product");
+
+	Matrix<double> C(&pool);
+
+	gemm(2.0, A, B, 0.0, C);
+	testCheck(C.getAllocator() == &pool && C.getRows() == 40 && C.getColumns() == 40, "allocator of the matrix resized by gemm");
+
+	Vector<double> x(40, 1.0, &pool);
+	Vector<double> y = A * x;
+
+	testCheck(y.getAllocator() == &pool, "allocator of the matrix-vector product");
+
+	SparseTriplets<double> triplets(40, 40);
+
+	triplets.add(3, 5, 2.0);
+
+	SparseMatrix<double> S(triplets);
+	Matrix<double> sparseProduct = S * B;
+
+	testCheck(sparseProduct.getAllocator() == &pool && sparseProduct(3, 7) == 2.0 * B(5, 7), "allocator of the sparse product");
+}
+
+int main()
+{
+	testPoolReuse();
+	testPoolThreads();
+	testResizeCapacity();
+
+	std::mt19937 generator(2024);
+
+	testResultAllocator(generator);
+
+	return testResult("TestAllocator");
+}
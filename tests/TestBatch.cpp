@@ -0,0 +1,98 @@
+#include "AlgebraTest.hpp"
+#include "MatrixBatch.hpp"
+
+using namespace lito;
+
+/*! testBatchSize
+* Invert and solve a batch of NxN matrices and compare each one with A * A^-1 = I and A * x = b
+* Every 7th matrix is singular and must be marked, with zeros as its inverse
+* The count is not a multiple of the SIMD width, so the last lanes are checked too
+* double singularError: Determinants up to it are singular, above the rounding of the determinant of a singular matrix in T
+* double tolerance: Largest error of the inverses and the solutions
+*/
+template <typename T, uint N>
+void testBatchSize(std::mt19937& generator, double singularError, double tolerance)
+{
+	const uint count = 1001;
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	MatrixBatch<T, N, N> a(count);
+	MatrixBatch<T, N, 1> b(count);
+	MatrixBatch<T, N, N> inverse;
+	MatrixBatch<T, N, 1> x;
+
+	for (uint index = 0; index < count; index++)
+	{
+		for (uint i = 0; i < N; i++)
+		{
+			for (uint j = 0; j < N; j++)
+				a.at(index, i, j) = T(distribution(generator) + ((i == j) ? 3.0 : 0.0));
+
+			b.at(index, i, 0) = T(distribution(generator));
+		}
+
+		// Two equal lines make the matrix singular
+		if (index % 7 == 0)
+			for (uint j = 0; j < N; j++)
+				a.at(index, 1, j) = a.at(index, 0, j);
+	}
+
+	std::vector<uint8_t> singularInverse = batchInvert(a, inverse, T(singularError));
+	std::vector<uint8_t> singularSolve = batchSolve(a, b, x, T(singularError));
+	uint wrongFlags = 0;
+	double inverseError = 0.0;
+	double solveError = 0.0;
+	double singularValues = 0.0;
+
+	for (uint index = 0; index < count; index++)
+	{
+		bool singular = index % 7 == 0;
+
+		wrongFlags += (singularInverse[index] != 0) != singular;
+		wrongFlags += (singularSolve[index] != 0) != singular;
+
+		for (uint i = 0; i < N; i++)
+		{
+			double residual = -double(b.at(index, i, 0));
+
+			for (uint j = 0; j < N; j++)
+			{
+				double product = 0.0;
+
+				for (uint p = 0; p < N; p++)
+					product += double(a.at(index, i, p)) * double(inverse.at(index, p, j));
+
+				if (singular)
+					singularValues = std::max(singularValues, std::abs(double(inverse.at(index, i, j))));
+				else
+					inverseError = std::max(inverseError, std::abs(product - ((i == j) ? 1.0 : 0.0)));
+
+				residual += double(a.at(index, i, j)) * double(x.at(index, j, 0));
+			}
+
+			if (singular)
+				singularValues = std::max(singularValues, std::abs(double(x.at(index, i, 0))));
+			else
+				solveError = std::max(solveError, std::abs(residual));
+		}
+	}
+
+	testCheck(wrongFlags == 0, "batch singular flags", wrongFlags);
+	testCheck(inverseError <= tolerance, "batch inverse", inverseError);
+	testCheck(solveError <= tolerance, "batch solve", solveError);
+	testCheck(singularValues == 0.0, "batch zeros for singular matrices", singularValues);
+}
+
+int main()
+{
+	std::mt19937 generator(2024);
+
+	testConfigurations([&]()
+	{
+		testBatchSize<double, 3>(generator, 1e-9, 1e-13);
+		testBatchSize<double, 4>(generator, 1e-9, 1e-13);
+		testBatchSize<float, 3>(generator, 1e-3, 1e-5);
+		testBatchSize<float, 4>(generator, 1e-3, 1e-5);
+	});
+
+	return testResult("TestBatch");
+}
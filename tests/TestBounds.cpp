@@ -0,0 +1,116 @@
+// The target sets LITO_TEST_CHECK_BOUNDS, which takes the place of the LITO_ALGEBRA_CHECK_BOUNDS option,
+// so this file is built once with the checks of operator () and row() and once without them
+#ifdef LITO_MATRIX_CHECK_BOUNDS
+#undef LITO_MATRIX_CHECK_BOUNDS
+#endif
+#define LITO_MATRIX_CHECK_BOUNDS LITO_TEST_CHECK_BOUNDS
+
+#include "AlgebraTest.hpp"
+#include "MatrixOperations.hpp"
+
+using namespace lito;
+
+/*! testThrows
+* If func throws a MatrixException
+* F func: Function called as func()
+* return: If it threw
+*/
+template <typename F>
+bool testThrows(const F& func)
+{
+	try
+	{
+		func();
+	}
+	catch (const MatrixException&)
+	{
+		return true;
+	}
+
+	return false;
+}
+
+/*! testAccess
+* operator () and row() throw past the last line or column only with the checks on, at() always throws,
+* the values at the last line and column are reached by every access
+*/
+void testAccess()
+{
+	Matrix<double> M(3, 5);
+	const Matrix<double>& C = M;
+
+	M(2, 4) = 7.0;
+	testCheck(M.at(2, 4) == 7.0 && C.at(2, 4) == 7.0 && C(2, 4) == 7.0 && M.row(2)[4] == 7.0 && C.row(2)[4] == 7.0, "access of the last value");
+
+	testCheck(testThrows([&]() { M.at(0, 5); }), "at() with column == getColumns()");
+	testCheck(testThrows([&]() { M.at(3, 0); }), "at() with line == getRows()");
+	testCheck(testThrows([&]() { C.at(0, 5); }), "const at() with column == getColumns()");
+	testCheck(testThrows([&]() { C.at(3, 0); }), "const at() with line == getRows()");
+
+#if LITO_MATRIX_CHECK_BOUNDS
+	testCheck(testThrows([&]() { M(0, 5); }), "operator () with column == getColumns()");
+	testCheck(testThrows([&]() { M(3, 0); }), "operator () with line == getRows()");
+	testCheck(testThrows([&]() { C(0, 5); }), "const operator () with column == getColumns()");
+	testCheck(testThrows([&]() { C(3, 0); }), "const operator () with line == getRows()");
+	testCheck(testThrows([&]() { M.row(3); }), "row() with line == getRows()");
+	testCheck(testThrows([&]() { C.row(3); }), "const row() with line == getRows()");
+#else
+	// Without the checks the access is only the address, the line past the last one is one stride after it
+	testCheck(!testThrows([&]() { M.row(3); }) && M.row(3) == M.data() + (3 * M.getStride()), "row() without checks");
+#endif
+}
+
+/*! testGaussReduction
+* The reduction must be rowOperations * M * columnOperations and upper triangular
+* Matrix<T> M: The matrix reduced
+* const char* name: What was checked
+*/
+void testGaussReduction(const Matrix<double>& M, const char* name)
+{
+	Matrix<double> rowOperations;
+	Matrix<double> columnOperations;
+	Matrix<double> reduction = gaussReduction(M, rowOperations, columnOperations, 1e-12);
+	Matrix<double> operations = testProduct(view(testProduct(view(rowOperations), view(M))), view(columnOperations));
+	double lower = 0.0;
+
+	for (uint i = 0; i < reduction.getRows(); i++)
+		for (uint j = 0; j < i; j++)
+			lower = std::max(lower, std::abs(reduction(i, j)));
+
+	testCheck(testDifference(view(reduction), view(operations)) <= 1e-12, name, testDifference(view(reduction), view(operations)));
+	testCheck(lower == 0.0, name, lower);
+}
+
+/*! testGauss
+* gaussReduction with a negative pivot, which must still eliminate the lines below it,
+* and with a pivot found only by the last branch of totalPivoting, which swaps a line and a column at once
+*/
+void testGauss()
+{
+	// The line swap brings -4 to the pivot and 2 below it must be eliminated
+	double negative[] = { 0.0, 1.0, 1.0,
+	                     -4.0, 2.0, 1.0,
+	                      2.0, 1.0, 3.0 };
+
+	// Nothing under or on the right of the first pivot, 5 is taken from the lines and columns after it
+	double diagonal[] = { 0.0, 0.0, 0.0,
+	                      0.0, 0.0, 5.0,
+	                      0.0, 2.0, 1.0 };
+
+	testGaussReduction(Matrix<double>(3, 3, negative), "gaussReduction with a negative pivot");
+	testGaussReduction(Matrix<double>(3, 3, diagonal), "gaussReduction by the last branch of totalPivoting");
+
+	Matrix<double> rowOperations;
+	Matrix<double> columnOperations;
+	Matrix<double> reduction = gaussReduction(Matrix<double>(3, 3, diagonal), rowOperations, columnOperations, 1e-12);
+
+	testCheck(reduction(0, 0) == 5.0 && rowOperations(0, 1) == 1.0 && columnOperations(2, 0) == 1.0, "swaps of the last branch of totalPivoting");
+}
+
+int main()
+{
+	testAccess();
+	testGauss();
+
+	return testResult(LITO_MATRIX_CHECK_BOUNDS ? "TestBounds" : "TestBoundsUnchecked");
+}
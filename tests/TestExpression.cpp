@@ -0,0 +1,116 @@
+#include "AlgebraTest.hpp"
+#include "MatrixExpression.hpp"
+
+using namespace lito;
+
+/*! testExpressionValues
+* Lazy expressions against the same values calculated one by one, built into a new matrix and assigned,
+* summed and subtracted into an existing one
+*/
+void testExpressionValues(std::mt19937& generator)
+{
+	Matrix<double> A(13, 7);
+	Matrix<double> B(13, 7);
+	Matrix<double> C(13, 7);
+
+	testRandom(A, generator);
+	testRandom(B, generator);
+	testRandom(C, generator);
+
+	Matrix<double> expected(13, 7);
+
+	for (uint i = 0; i < 13; i++)
+		for (uint j = 0; j < 7; j++)
+			expected(i, j) = (A(i, j) + (2.0 * B(i, j))) - (A(i, j) * C(i, j)) - (-C(i, j));
+
+	Matrix<double> built = (lazy(A) + (2.0 * lazy(B))) - mul(lazy(A), C) - (-lazy(C));
+
+	testCheck(testDifference(view(built), view(expected)) <= 1e-15, "expression built into a matrix");
+
+	Matrix<double> assigned(2, 3);
+
+	assigned = (lazy(A) + (lazy(B) * 2.0)) - mul(A, lazy(C)) + lazy(C);
+	testCheck(testDifference(view(assigned), view(expected)) <= 1e-15, "expression assigned to a matrix of other sizes");
+
+	Matrix<double> summed(C);
+	Matrix<double> subtracted(C);
+
+	summed += lazy(A) - B;
+	subtracted -= A + lazy(B);
+
+	for (uint i = 0; i < 13; i++)
+	{
+		for (uint j = 0; j < 7; j++)
+		{
+			expected(i, j) = C(i, j) + A(i, j) - B(i, j);
+			assigned(i, j) = C(i, j) - A(i, j) - B(i, j);
+		}
+	}
+
+	testCheck(testDifference(view(summed), view(expected)) <= 1e-15, "expression summed into a matrix");
+	testCheck(testDifference(view(subtracted), view(assigned)) <= 1e-15, "expression subtracted from a matrix");
+}
+
+/*! testExpressionDestination
+* Expressions that read the matrix they are assigned to, each value at the position being written
+*/
+void testExpressionDestination(std::mt19937& generator)
+{
+	Matrix<double> A(9, 11);
+	Matrix<double> M(9, 11);
+
+	testRandom(A, generator);
+	testRandom(M, generator);
+
+	Matrix<double> original(M);
+	Matrix<double> expected(9, 11);
+
+	for (uint i = 0; i < 9; i++)
+		for (uint j = 0; j < 11; j++)
+			expected(i, j) = (3.0 * original(i, j)) - A(i, j);
+
+	M = (lazy(M) * 3.0) - A;
+	testCheck(testDifference(view(M), view(expected)) <= 1e-15, "expression assigned to a matrix it reads");
+
+	M = original;
+	M += mul(lazy(M), A);
+
+	for (uint i = 0; i < 9; i++)
+		for (uint j = 0; j < 11; j++)
+			expected(i, j) = original(i, j) + (original(i, j) * A(i, j));
+
+	testCheck(testDifference(view(M), view(expected)) <= 1e-15, "expression summed into a matrix it reads");
+}
+
+/*! testExpressionSizes
+* Expressions of different sizes throw INCOMPATIBLE_SIZES when they are built, and an empty matrix
+* throws MATRIX_NOT_INITIALIZED when it starts an expression
+*/
+void testExpressionSizes()
+{
+	Matrix<double> A(3, 4);
+	Matrix<double> B(4, 3);
+	Matrix<double> empty;
+	Matrix<double> C(3, 4);
+	int thrown = 0;
+
+	try { Matrix<double> sum = lazy(A) + B; } catch (const MatrixException& exception) { thrown += exception.getType() == MatrixExceptionType::INCOMPATIBLE_SIZES; }
+	try { Matrix<double> sub = A - lazy(B); } catch (const MatrixException& exception) { thrown += exception.getType() == MatrixExceptionType::INCOMPATIBLE_SIZES; }
+	try { Matrix<double> product = mul(lazy(A), lazy(B)); } catch (const MatrixException& exception) { thrown += exception.getType() == MatrixExceptionType::INCOMPATIBLE_SIZES; }
+	try { C += lazy(B) * 2.0; } catch (const MatrixException& exception) { thrown += exception.getType() == MatrixExceptionType::INCOMPATIBLE_SIZES; }
+	try { C -= -lazy(B); } catch (const MatrixException& exception) { thrown += exception.getType() == MatrixExceptionType::INCOMPATIBLE_SIZES; }
+	try { Matrix<double> value = lazy(empty) * 2.0; } catch (const MatrixException& exception) { thrown += exception.getType() == MatrixExceptionType::MATRIX_NOT_INITIALIZED; }
+
+	testCheck(thrown == 6, "exceptions of the expressions", thrown);
+}
+
+int main()
+{
+	std::mt19937 generator(2024);
+
+	testExpressionValues(generator);
+	testExpressionDestination(generator);
+	testExpressionSizes();
+
+	return testResult("TestExpression");
+}
@@ -0,0 +1,87 @@
+#include "AlgebraTest.hpp"
+#include "MatrixLU.hpp"
+
+using namespace lito;
+
+// Operations of the fixed matrices evaluated at compile time
+constexpr Matrix<int, 2, 3> fixedA{ 1, 2, 3, 4, 5, 6 };
+constexpr Matrix<int, 3, 2> fixedB{ 7, 8, 9, 10, 11, 12 };
+constexpr Matrix<int, 2, 2> fixedProduct = fixedA * fixedB;
+constexpr Matrix<double, 3, 3> fixedC{ 2.0, 0.0, 1.0, 1.0, 3.0, 0.0, 0.0, 1.0, 4.0 };
+constexpr Matrix<double, 2, 2> fixedInverse = invert(Matrix<double, 2, 2>{ 4.0, 2.0, 2.0, 3.0 });
+
+static_assert(Matrix<int, 2, 3>::getRows() == 2 && Matrix<int, 2, 3>::getColumns() == 3, "sizes of a fixed matrix");
+static_assert(fixedProduct(0, 0) == 58 && fixedProduct(0, 1) == 64 && fixedProduct(1, 0) == 139 && fixedProduct(1, 1) == 154, "product of fixed matrices");
+static_assert(fixedA.transpose()(2, 1) == 6 && (fixedA + fixedA)(1, 2) == 12 && (fixedA * 3)(0, 1) == 6, "transpose, sum and scale of a fixed matrix");
+static_assert(Matrix<int, 3, 3>(MatrixType::IDENTITY)(1, 1) == 1 && Matrix<int, 3, 3>(MatrixType::IDENTITY)(0, 1) == 0, "identity of a fixed matrix");
+static_assert(determinant(fixedC) == 25.0 && determinant<double, 3>(fixedC) == 25.0, "determinant of a fixed matrix");
+static_assert(fixedInverse(0, 0) == 0.375 && fixedInverse(0, 1) == -0.25 && fixedInverse(1, 1) == 0.5, "inverse of a fixed matrix");
+
+/*! testDynamic
+* Copy a fixed matrix into a matrix with the sizes known at run time
+*/
+template <typename T, uint N>
+Matrix<T> testDynamic(const Matrix<T, N, N>& M)
+{
+	Matrix<T> dynamic(N, N);
+
+	for (uint i = 0; i < N; i++)
+		for (uint j = 0; j < N; j++)
+			dynamic(i, j) = M(i, j);
+
+	return dynamic;
+}
+
+/*! testFixedSize
+* Determinant and inverse of random fixed matrices, closed forms (2x2, 3x3, 4x4) or Gauss reduction (larger),
+* against the general reduction and the LU of the same values
+*/
+template <uint N>
+void testFixedSize(std::mt19937& generator)
+{
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+	for (uint k = 0; k < 100; k++)
+	{
+		Matrix<double, N, N> M;
+
+		for (uint i = 0; i < N; i++)
+			for (uint j = 0; j < N; j++)
+				M(i, j) = distribution(generator) + ((i == j) ? 2.0 : 0.0);
+
+		LUFactorization<double> lu = luFactor(testDynamic(M));
+		double deter = determinant(M);
+		Matrix<double, N, N> inverse = invert(M);
+
+		testCheck(std::abs(deter - lu.determinant()) <= 1e-12 * std::abs(deter), "determinant against LU", N);
+		testCheck(std::abs(deter - determinant<double, N>(M)) <= 1e-12 * std::abs(deter), "determinant against Gauss reduction", N);
+		testCheck(testDifference(view(testDynamic(inverse)), view(lu.inverse())) <= 1e-10, "inverse against LU", N);
+		testCheck(testDifference(view(testDynamic(inverse * M)), view(Matrix<double>(N, N, MatrixType::IDENTITY))) <= 1e-12, "inverse times matrix", N);
+	}
+
+	Matrix<double, N, N> singular(MatrixType::ONES);
+	bool thrown = false;
+
+	try
+	{
+		invert(singular);
+	}
+	catch (const MatrixException& exception)
+	{
+		thrown = exception.getType() == MatrixExceptionType::SINGULAR_MATRIX;
+	}
+
+	testCheck(thrown && determinant(singular) == 0.0, "singular fixed matrix", N);
+}
+
+int main()
+{
+	std::mt19937 generator(2024);
+
+	testFixedSize<2>(generator);
+	testFixedSize<3>(generator);
+	testFixedSize<4>(generator);
+	testFixedSize<6>(generator);
+
+	return testResult("TestFixedMatrix");
+}
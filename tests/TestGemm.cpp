@@ -0,0 +1,48 @@
+#include "AlgebraTest.hpp"
+
+using namespace lito;
+
+/*! testGemmSizes
+* Compare Matrix::operator * and gemm with the reference product for sizes that do not fill the micro-kernel or the blocks
+*/
+template <typename T>
+void testGemmSizes(std::mt19937& generator, double tolerance)
+{
+	const uint sizes[][3] = { { 1, 1, 1 }, { 3, 5, 7 }, { 17, 13, 11 }, { 33, 65, 31 }, { 127, 129, 67 }, { 300, 257, 301 } };
+
+	for (const auto& size : sizes)
+	{
+		Matrix<T> A(size[0], size[1]);
+		Matrix<T> B(size[1], size[2]);
+
+		testRandom(A, generator);
+		testRandom(B, generator);
+
+		Matrix<T> C = A * B;
+
+		Matrix<T> reference = testProduct(view(A), view(B));
+
+		testCheck(testDifference(view(C), view(reference)) <= tolerance * size[1], "gemm of odd sizes", size[1]);
+
+		// C = 2 * A * B - C
+		for (uint i = 0; i < size[0]; i++)
+			for (uint j = 0; j < size[2]; j++)
+				reference(i, j) = T(2) * reference(i, j) - C(i, j);
+
+		gemm(T(2), A, B, T(-1), C);
+		testCheck(testDifference(view(C), view(reference)) <= 2 * tolerance * size[1], "gemm with alpha and beta", size[1]);
+	}
+}
+
+int main()
+{
+	std::mt19937 generator(2024);
+
+	testConfigurations([&]()
+	{
+		testGemmSizes<double>(generator, 1e-14);
+		testGemmSizes<float>(generator, 1e-6);
+	});
+
+	return testResult("TestGemm");
+}
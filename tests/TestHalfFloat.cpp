@@ -0,0 +1,287 @@
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include "AlgebraTest.hpp"
+#include "HalfFloat.hpp"
+#include "algebra_matriz.hpp"
+
+using namespace lito;
+
+/*! testFloatBits
+* Float with a binary32 representation
+* uint32_t bits: The representation
+* return: The value
+*/
+float testFloatBits(uint32_t bits)
+{
+	float value;
+
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+/*! testHalfValues
+* Known roundings of half: ties to even, the largest value, overflow, subnormals and NaN
+*/
+void testHalfValues()
+{
+	testCheck(half(1.0f).getBits() == 0x3C00, "half 1");
+	testCheck(half(-2.0f).getBits() == 0xC000, "half -2");
+	testCheck(half(65504.0f).getBits() == 0x7BFF, "half largest value");
+	testCheck(half(65519.0f).getBits() == 0x7BFF, "half below the overflow rounds down");
+	testCheck(half(65520.0f).getBits() == 0x7C00, "half overflow to infinity");
+	testCheck(half(std::ldexp(1.0f, -24)).getBits() == 0x0001, "half smallest subnormal");
+	testCheck(half(std::ldexp(1.0f, -25)).getBits() == 0x0000, "half tie below the smallest subnormal to even");
+	testCheck(half(std::ldexp(3.0f, -25)).getBits() == 0x0002, "half subnormal tie to even");
+	testCheck(half(1.0f + std::ldexp(1.0f, -11)).getBits() == 0x3C00, "half tie to even down");
+	testCheck(half(1.0f + std::ldexp(3.0f, -11)).getBits() == 0x3C02, "half tie to even up");
+	testCheck(std::isnan(float(half(std::nanf("")))), "half NaN");
+
+	// Every half converts to float and back to itself
+	uint wrong = 0;
+
+	for (uint bits = 0; bits < 0x10000; bits++)
+	{
+		half value = half::fromBits(uint16_t(bits));
+		bool nan = (bits & 0x7C00) == 0x7C00 && (bits & 0x03FF) != 0;
+
+		if (nan)
+			wrong += !std::isnan(float(value));
+		else
+			wrong += half(float(value)).getBits() != bits;
+	}
+
+	testCheck(wrong == 0, "half round trip of every value", wrong);
+}
+
+/*! testBfloat16Values
+* Known roundings of bfloat16: ties to even, overflow and NaN
+*/
+void testBfloat16Values()
+{
+	testCheck(bfloat16(1.0f).getBits() == 0x3F80, "bfloat16 1");
+	testCheck(bfloat16(testFloatBits(0x3F808000)).getBits() == 0x3F80, "bfloat16 tie to even down");
+	testCheck(bfloat16(testFloatBits(0x3F818000)).getBits() == 0x3F82, "bfloat16 tie to even up");
+	testCheck(bfloat16(testFloatBits(0x3F808001)).getBits() == 0x3F81, "bfloat16 above the tie");
+	testCheck(bfloat16(testFloatBits(0x7F7FFFFF)).getBits() == 0x7F80, "bfloat16 overflow to infinity");
+	testCheck(std::isnan(float(bfloat16(std::nanf("")))), "bfloat16 NaN");
+
+	uint wrong = 0;
+
+	for (uint bits = 0; bits < 0x10000; bits++)
+	{
+		bfloat16 value = bfloat16::fromBits(uint16_t(bits));
+		bool nan = (bits & 0x7F80) == 0x7F80 && (bits & 0x007F) != 0;
+
+		if (nan)
+			wrong += !std::isnan(float(value));
+		else
+			wrong += bfloat16(float(value)).getBits() != bits;
+	}
+
+	testCheck(wrong == 0, "bfloat16 round trip of every value", wrong);
+}
+
+/*! testBulkConversion
+* convertValues, by the SIMD kernels of the level in use, must give the bits of the scalar conversion,
+* with a count that leaves a tail after the vectors
+* S: half or bfloat16
+*/
+template <typename S>
+void testBulkConversion(std::mt19937& generator, const char* name)
+{
+	const uint n = 1027;
+	std::uniform_int_distribution<uint32_t> distribution;
+	std::vector<float> values(n);
+	std::vector<S> converted(n);
+	std::vector<float> back(n);
+	uint wrong = 0;
+
+	// Random representations cover normal, subnormal, overflowing, infinite and NaN values
+	for (uint i = 0; i < n; i++)
+		values[i] = testFloatBits(distribution(generator));
+
+	values[0] = 1.0f;
+	values[1] = -0.0f;
+	values[2] = 65520.0f;
+	values[3] = std::ldexp(3.0f, -25);
+
+	convertValues(n, values.data(), converted.data());
+	convertValues(n, converted.data(), back.data());
+
+	for (uint i = 0; i < n; i++)
+	{
+		S scalar(values[i]);
+
+		// The AVX-512 BF16 rounding takes the subnormal floats as zeros, which keep their sign
+		bool flushed = std::is_same<S, bfloat16>::value && std::fpclassify(values[i]) == FP_SUBNORMAL
+		            && converted[i].getBits() == (scalar.getBits() & 0x8000);
+
+		if (std::isnan(values[i]))
+			wrong += !std::isnan(float(converted[i])) || !std::isnan(back[i]);
+		else if (!flushed)
+			wrong += converted[i].getBits() != scalar.getBits() || back[i] != float(scalar);
+	}
+
+	testCheck(wrong == 0, name, wrong);
+}
+
+/*! testHalfGemmSizes
+* Compare Matrix::operator * and gemm of half or bfloat16 values, accumulated in float, with a product in double
+* of the same values, for sizes under the direct loop, over several blocks with partial micro-tiles, a C of one row,
+* beta not zero and k zero
+* S: half or bfloat16
+* double unit: Rounding of one conversion to S
+*/
+template <typename S>
+void testHalfGemmSizes(std::mt19937& generator, double unit, const char* name)
+{
+	const uint sizes[][3] = { { 7, 9, 11 }, { 1, 300, 45 }, { 300, 520, 37 }, { 19, 33, 1030 } };
+	const std::string product = std::string(name) + " product";
+	const std::string alphaBeta = std::string(name) + " gemm with alpha and beta";
+	const std::string emptyProduct = std::string(name) + " gemm with k zero and beta zero";
+	const std::string emptyBeta = std::string(name) + " gemm with k zero";
+
+	for (const auto& size : sizes)
+	{
+		Matrix<S> A(size[0], size[1]);
+		Matrix<S> B(size[1], size[2]);
+		Matrix<S> C0(size[0], size[2]);
+
+		testRandom(A, generator);
+		testRandom(B, generator);
+		testRandom(C0, generator);
+
+		Matrix<double> AD(size[0], size[1]);
+		Matrix<double> BD(size[1], size[2]);
+
+		for (uint i = 0; i < size[0]; i++)
+			for (uint p = 0; p < size[1]; p++)
+				AD(i, p) = double(float(A(i, p)));
+
+		for (uint p = 0; p < size[1]; p++)
+			for (uint j = 0; j < size[2]; j++)
+				BD(p, j) = double(float(B(p, j)));
+
+		Matrix<double> reference = testProduct(view(AD), view(BD));
+
+		// The sums in float add about k float roundings, C is rounded to S once
+		Matrix<S> C = A * B;
+		uint wrong = 0;
+
+		for (uint i = 0; i < size[0]; i++)
+			for (uint j = 0; j < size[2]; j++)
+				wrong += std::abs(double(float(C(i, j))) - reference(i, j)) > unit * std::abs(reference(i, j)) + 1e-6 * size[1];
+
+		testCheck(C.getRows() == size[0] && C.getColumns() == size[2] && wrong == 0, product.c_str(), wrong);
+
+		// C = 2 * A * B - 0.5 * C0
+		C = C0;
+		gemm(S(2.0f), A, B, S(-0.5f), C);
+		wrong = 0;
+
+		for (uint i = 0; i < size[0]; i++)
+		{
+			for (uint j = 0; j < size[2]; j++)
+			{
+				double expected = 2.0 * reference(i, j) - 0.5 * double(float(C0(i, j)));
+
+				wrong += std::abs(double(float(C(i, j))) - expected) > unit * std::abs(expected) + 2e-6 * size[1];
+			}
+		}
+
+		testCheck(wrong == 0, alphaBeta.c_str(), wrong);
+
+		// With k zero the kernel writes zeros when beta is zero and otherwise only scales C,
+		// a Matrix of zero columns has no storage so the kernel is called directly
+		C = C0;
+		gemmKernel(size[0], size[2], 0, S(1.0f), A.data(), A.getStride(), 1, B.data(), B.getStride(), 1, S(0.0f), C.data(), C.getStride());
+		wrong = 0;
+
+		for (uint i = 0; i < size[0]; i++)
+			for (uint j = 0; j < size[2]; j++)
+				wrong += float(C(i, j)) != 0.0f;
+
+		testCheck(wrong == 0, emptyProduct.c_str(), wrong);
+
+		C = C0;
+		gemmKernel(size[0], size[2], 0, S(1.0f), A.data(), A.getStride(), 1, B.data(), B.getStride(), 1, S(0.5f), C.data(), C.getStride());
+		wrong = 0;
+
+		for (uint i = 0; i < size[0]; i++)
+			for (uint j = 0; j < size[2]; j++)
+				wrong += float(C(i, j)) != float(S(0.5f * float(C0(i, j))));
+
+		testCheck(wrong == 0, emptyBeta.c_str(), wrong);
+	}
+}
+
+/*! testHalfFixedTypes
+* Operations of the small matrices and vectors of half and bfloat16 against the same operations of float,
+* with values that are exact in both types, so every result is exact too
+*/
+void testHalfFixedTypes()
+{
+	Matriz_3h M3h(1.0f, 2.0f, -0.5f, 0.25f, 3.0f, 1.5f, -2.0f, 0.75f, 4.0f);
+	Matriz_3f M3f(1.0f, 2.0f, -0.5f, 0.25f, 3.0f, 1.5f, -2.0f, 0.75f, 4.0f);
+	Matriz_3h P3h = M3h * M3h;
+	Matriz_3f P3f = M3f * M3f;
+	uint wrong = 0;
+
+	for (uint i = 0; i < 9; i++)
+		wrong += float(P3h[i]) != P3f[i];
+
+	testCheck(wrong == 0, "Matriz_3h product", wrong);
+
+	Matriz_4bf M4bf(MatrixType::IDENTITY);
+	Matriz_2h M2h(MatrixType::ONES);
+
+	M4bf = (M4bf * bfloat16(2.0f)) + M4bf;
+	M2h *= half(-0.5f);
+	wrong = 0;
+
+	for (uint i = 0; i < 4; i++)
+		for (uint j = 0; j < 4; j++)
+			wrong += float(M4bf(i, j)) != ((i == j) ? 3.0f : 0.0f);
+
+	for (uint i = 0; i < 4; i++)
+		wrong += float(M2h[i]) != -0.5f;
+
+	testCheck(wrong == 0, "Matriz_4bf and Matriz_2h operations", wrong);
+
+	Vec_3h v3h(0.5f, -1.0f, 2.0f);
+	Vec_4bf v4bf(1.0f, -2.0f, 0.5f, 4.0f);
+	Vec_2bf v2bf(0.125f, -8.0f);
+	Vec_3h s3h = (v3h * v3h) - v3h;
+	Vec_4bf s4bf = v4bf * bfloat16(2.0f);
+	Vec_2bf s2bf = v2bf + v2bf;
+
+	wrong = float(s3h.x()) != -0.25f || float(s3h.y()) != 2.0f || float(s3h.z()) != 2.0f;
+	wrong += float(s4bf[0]) != 2.0f || float(s4bf[1]) != -4.0f || float(s4bf[2]) != 1.0f || float(s4bf[3]) != 8.0f;
+	wrong += float(s2bf.x()) != 0.25f || float(s2bf.y()) != -16.0f;
+	testCheck(wrong == 0, "Vec_3h, Vec_4bf and Vec_2bf operations", wrong);
+}
+
+int main()
+{
+	std::mt19937 generator(2024);
+
+	testHalfValues();
+	testBfloat16Values();
+
+	testSimdLevels([&]()
+	{
+		testBulkConversion<half>(generator, "half bulk conversion");
+		testBulkConversion<bfloat16>(generator, "bfloat16 bulk conversion");
+	});
+
+	testHalfFixedTypes();
+
+	testConfigurations([&]()
+	{
+		testHalfGemmSizes<half>(generator, std::ldexp(1.0, -11), "half");
+		testHalfGemmSizes<bfloat16>(generator, std::ldexp(1.0, -8), "bfloat16");
+	});
+
+	return testResult("TestHalfFloat");
+}
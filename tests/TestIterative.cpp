@@ -0,0 +1,151 @@
+#include "AlgebraTest.hpp"
+#include "IterativeSolvers.hpp"
+
+using namespace lito;
+
+/*! testGrid
+* Matrix of -laplacian(u) + convection * du/dx on a grid side x side by finite differences (upwind),
+* symmetric positive definite without convection and nonsymmetric with it
+*/
+SparseMatrix<double> testGrid(uint side, double convection)
+{
+	uint n = side * side;
+	SparseTriplets<double> triplets(n, n);
+
+	for (uint i = 0; i < side; i++)
+	{
+		for (uint j = 0; j < side; j++)
+		{
+			uint p = j + (side * i);
+
+			triplets.add(p, p, 4.0 + convection);
+
+			if (i > 0) triplets.add(p, p - side, -1.0);
+			if (i + 1 < side) triplets.add(p, p + side, -1.0);
+			if (j > 0) triplets.add(p, p - 1, -1.0 - convection);
+			if (j + 1 < side) triplets.add(p, p + 1, -1.0);
+		}
+	}
+
+	return SparseMatrix<double>(triplets);
+}
+
+/*! testTrueResidual
+* Recalculate ||b - A * x|| / ||b||, which the solvers only update by recurrence
+*/
+template <typename O>
+double testTrueResidual(const O& A, const Matrix<double>& b, const Matrix<double>& x)
+{
+	Matrix<double> r;
+
+	applyOperator(A, x, r);
+	vectorXpby(b, -1.0, r);
+
+	return vectorNorm(r) / vectorNorm(b);
+}
+
+/*! testSolver
+* Check the convergence and the true residual of a solve
+*/
+template <typename O>
+void testSolver(const IterativeStatistics<double>& statistics, const O& A, const Matrix<double>& b, const Matrix<double>& x, const char* name)
+{
+	double residual = testTrueResidual(A, b, x);
+
+	testCheck(statistics.converged && statistics.residual <= 1e-8, name, statistics.iterations);
+	testCheck(residual <= 1e-7, name, residual);
+}
+
+/*! testPoisson
+* CG, BiCGSTAB and GMRES on the Poisson system, without preconditioner and with Jacobi, SSOR and ILU(0),
+* and CG on the same system as a dense matrix
+*/
+void testPoisson(std::mt19937& generator)
+{
+	SparseMatrix<double> A = testGrid(30, 0.0);
+	Matrix<double> b(900, 1);
+	Matrix<double> x;
+	IterativeSettings<double> settings(2000, 1e-8, 40);
+
+	testRandom(b, generator);
+
+	JacobiPreconditioner<double> jacobi(A);
+	SSORPreconditioner<double> ssor(A, 1.5);
+	ILU0Preconditioner<double> ilu(A);
+
+	IterativeStatistics<double> plain = solveCG(A, b, x, settings);
+
+	testSolver(plain, A, b, x, "CG on Poisson");
+	x.resize(0, 0);
+	testSolver(solveCG(A, b, x, jacobi, settings), A, b, x, "CG with Jacobi on Poisson");
+	x.resize(0, 0);
+
+	IterativeStatistics<double> preconditioned = solveCG(A, b, x, ssor, settings);
+
+	testSolver(preconditioned, A, b, x, "CG with SSOR on Poisson");
+	testCheck(preconditioned.iterations < plain.iterations, "SSOR reduces the iterations of CG", preconditioned.iterations);
+	x.resize(0, 0);
+	testSolver(solveBiCGSTAB(A, b, x, ilu, settings), A, b, x, "BiCGSTAB with ILU(0) on Poisson");
+	x.resize(0, 0);
+	testSolver(solveGMRES(A, b, x, ilu, settings), A, b, x, "GMRES with ILU(0) on Poisson");
+
+	Matrix<double> dense = testGrid(10, 0.0).toMatrix();
+	Matrix<double> c(100, 1);
+
+	testRandom(c, generator);
+	x.resize(0, 0);
+	testSolver(solveCG(dense, c, x, JacobiPreconditioner<double>(dense), settings), dense, c, x, "CG with Jacobi on dense Poisson");
+}
+
+/*! testNonsymmetric
+* BiCGSTAB and GMRES on a convection-diffusion system, without preconditioner and with Jacobi, SSOR and ILU(0),
+* starting from a guess given in x
+*/
+void testNonsymmetric(std::mt19937& generator)
+{
+	SparseMatrix<double> A = testGrid(30, 2.0);
+	Matrix<double> b(900, 1);
+	Matrix<double> guess(900, 1);
+	Matrix<double> x;
+	IterativeSettings<double> settings(2000, 1e-8, 40);
+
+	testRandom(b, generator);
+	testRandom(guess, generator);
+
+	JacobiPreconditioner<double> jacobi(A);
+	SSORPreconditioner<double> ssor(A);
+	ILU0Preconditioner<double> ilu(A);
+
+	x = guess;
+	testSolver(solveBiCGSTAB(A, b, x, settings), A, b, x, "BiCGSTAB on convection-diffusion");
+	x = guess;
+	testSolver(solveBiCGSTAB(A, b, x, jacobi, settings), A, b, x, "BiCGSTAB with Jacobi on convection-diffusion");
+	x = guess;
+	testSolver(solveBiCGSTAB(A, b, x, ilu, settings), A, b, x, "BiCGSTAB with ILU(0) on convection-diffusion");
+
+	x = guess;
+	IterativeStatistics<double> plain = solveGMRES(A, b, x, settings);
+
+	testSolver(plain, A, b, x, "GMRES on convection-diffusion");
+	x = guess;
+	testSolver(solveGMRES(A, b, x, ssor, settings), A, b, x, "GMRES with SSOR on convection-diffusion");
+	x = guess;
+
+	IterativeStatistics<double> preconditioned = solveGMRES(A, b, x, ilu, settings);
+
+	testSolver(preconditioned, A, b, x, "GMRES with ILU(0) on convection-diffusion");
+	testCheck(preconditioned.iterations < plain.iterations, "ILU(0) reduces the iterations of GMRES", preconditioned.iterations);
+}
+
+int main()
+{
+	std::mt19937 generator(2024);
+
+	testConfigurations([&]()
+	{
+		testPoisson(generator);
+		testNonsymmetric(generator);
+	});
+
+	return testResult("TestIterative");
+}
@@ -0,0 +1,321 @@
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AlgebraTest.hpp"
+#include "MatrixFile.hpp"
+
+using namespace lito;
+
+/*! testLoadFails
+* Tell if loadMatrix refuses a file with the exception expected
+* std::string path: The file
+* MatrixExceptionType expected: The exception
+* return: If the exception was thrown
+*/
+template <typename T>
+bool testLoadFails(const std::string& path, MatrixExceptionType expected)
+{
+	try
+	{
+		loadMatrix<T>(path);
+	}
+	catch (const MatrixException& exception)
+	{
+		return exception.getType() == expected;
+	}
+
+	return false;
+}
+
+/*! testMapFails
+* Tell if MappedMatrix refuses a file as invalid
+* std::string path: The file
+* return: If INVALID_FILE_FORMAT was thrown
+*/
+template <typename T>
+bool testMapFails(const std::string& path)
+{
+	try
+	{
+		MappedMatrix<T> mapped(path);
+	}
+	catch (const MatrixException& exception)
+	{
+		return exception.getType() == MatrixExceptionType::INVALID_FILE_FORMAT;
+	}
+
+	return false;
+}
+
+/*! testRoundTrip
+* Save a block of a matrix, with and without row padding, and read it by loadMatrix and by MappedMatrix
+*/
+template <typename T>
+void testRoundTrip(std::mt19937& generator, const std::string& path, const char* name)
+{
+	Matrix<double> values(37, 29);
+
+	testRandom(values, generator);
+
+	Matrix<T> M(37, 29);
+
+	for (uint i = 0; i < 37; i++)
+		for (uint j = 0; j < 29; j++)
+			M(i, j) = T(values(i, j) * 100.0);
+
+	const bool paddings[] = { false, true };
+
+	for (bool rowPadding : paddings)
+	{
+		ConstMatrixView<T> block = view(M).block(3, 2, 31, 23);
+		Matrix<T> expected(block);
+
+		saveMatrix(path, block, rowPadding);
+
+		Matrix<T> loaded = loadMatrix<T>(path);
+		MappedMatrix<T> mapped(path);
+
+		testCheck(testDifference(view(loaded), view(expected)) == 0.0, name);
+		testCheck(testDifference(mapped.view(), view(expected)) == 0.0, name);
+		testCheck(!rowPadding || (mapped.getStride() * sizeof(T)) % MATRIX_FILE_ALIGNMENT == 0, "row padding of the file");
+	}
+}
+
+/*! testStreaming
+* Write a file by parts with MatrixFileWriter, and check that close() refuses a file with missing rows
+*/
+void testStreaming(std::mt19937& generator, const std::string& path)
+{
+	Matrix<double> M(50, 17);
+
+	testRandom(M, generator);
+
+	MatrixFileWriter<double> writer(path, 50, 17);
+
+	writer.write(view(M).block(0, 0, 20, 17));
+	writer.write(view(M).block(20, 0, 30, 17));
+	writer.close();
+
+	testCheck(testDifference(view(loadMatrix<double>(path)), view(M)) == 0.0, "file written by parts");
+
+	bool refused = false;
+	MatrixFileWriter<double> incomplete(path, 50, 17);
+
+	incomplete.write(view(M).block(0, 0, 20, 17));
+
+	try
+	{
+		incomplete.close();
+	}
+	catch (const MatrixException& exception)
+	{
+		refused = exception.getType() == MatrixExceptionType::INCOMPATIBLE_SIZES;
+	}
+
+	testCheck(refused, "close of a file with missing rows");
+}
+
+/*! testByteOrder
+* A file written with the other byte order is read by loadMatrix with its values swapped, and refused by MappedMatrix
+*/
+void testByteOrder(const std::string& path)
+{
+	Matrix<double> M(3, 4);
+
+	for (uint i = 0; i < 3; i++)
+		for (uint j = 0; j < 4; j++)
+			M(i, j) = double(i * 4 + j) + 0.25;
+
+	MatrixFileHeader header;
+
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, MATRIX_FILE_MAGIC, sizeof(header.magic));
+	header.version = swapBytes(MATRIX_FILE_VERSION);
+	header.type = swapBytes(uint32_t(MatrixFileType::FLOAT64));
+	header.endianness = swapBytes(MATRIX_FILE_ENDIANNESS);
+	header.valueSize = swapBytes(uint32_t(sizeof(double)));
+	header.rows = swapBytes(uint64_t(3));
+	header.columns = swapBytes(uint64_t(4));
+	header.stride = swapBytes(uint64_t(4));
+	header.payloadOffset = swapBytes(MATRIX_FILE_ALIGNMENT);
+
+	std::FILE* file = std::fopen(path.c_str(), "wb");
+
+	std::fwrite(&header, sizeof(header), 1, file);
+
+	for (uint i = 0; i < 3; i++)
+	{
+		for (uint j = 0; j < 4; j++)
+		{
+			double value = swapBytes(M(i, j));
+
+			std::fwrite(&value, sizeof(value), 1, file);
+		}
+	}
+
+	std::fclose(file);
+
+	testCheck(testDifference(view(loadMatrix<double>(path)), view(M)) == 0.0, "file of the other byte order");
+	testCheck(testMapFails<double>(path), "mapping of a file of the other byte order");
+}
+
+/*! testInvalidFiles
+* Truncated files, a header that promises more values than the file holds, a wrong type and a missing file
+*/
+void testInvalidFiles(std::mt19937& generator, const std::string& path)
+{
+	Matrix<double> M(40, 40);
+
+	testRandom(M, generator);
+	saveMatrix(path, view(M));
+
+	// The payload loses its last row
+	std::FILE* file = std::fopen(path.c_str(), "rb");
+	std::vector<char> bytes(sizeof(MatrixFileHeader) + (40 * 40 * sizeof(double)));
+
+	testCheck(std::fread(bytes.data(), 1, bytes.size(), file) == bytes.size(), "read of the saved file");
+	std::fclose(file);
+
+	file = std::fopen(path.c_str(), "wb");
+	std::fwrite(bytes.data(), 1, bytes.size() - (40 * sizeof(double)), file);
+	std::fclose(file);
+
+	testCheck(testLoadFails<double>(path, MatrixExceptionType::INVALID_FILE_FORMAT), "load of a truncated file");
+	testCheck(testMapFails<double>(path), "mapping of a truncated file");
+
+	// A header of 65536 x 65537 values with 4 values after it must be refused before the matrix is allocated
+	MatrixFileHeader header;
+
+	std::memcpy(&header, bytes.data(), sizeof(header));
+	header.rows = 65536;
+	header.columns = 65537;
+	header.stride = 65537;
+
+	file = std::fopen(path.c_str(), "wb");
+	std::fwrite(&header, sizeof(header), 1, file);
+	std::fwrite(M.data(), sizeof(double), 4, file);
+	std::fclose(file);
+
+	testCheck(testLoadFails<double>(path, MatrixExceptionType::INVALID_FILE_FORMAT), "load of a header bigger than the file");
+	testCheck(testMapFails<double>(path), "mapping of a header bigger than the file");
+
+	// Rows without stride would be billions of empty reads
+	header.rows = 4000000000u;
+	header.columns = 0;
+	header.stride = 0;
+
+	file = std::fopen(path.c_str(), "wb");
+	std::fwrite(&header, sizeof(header), 1, file);
+	std::fclose(file);
+
+	testCheck(testLoadFails<double>(path, MatrixExceptionType::INVALID_FILE_FORMAT), "load of rows of stride zero");
+	testCheck(testMapFails<double>(path), "mapping of rows of stride zero");
+
+	// Only the header, shorter than a header, and values of another type
+	file = std::fopen(path.c_str(), "wb");
+	std::fwrite(bytes.data(), 1, sizeof(MatrixFileHeader) / 2, file);
+	std::fclose(file);
+
+	testCheck(testLoadFails<double>(path, MatrixExceptionType::INVALID_FILE_FORMAT), "load of a file shorter than the header");
+
+	saveMatrix(path, view(M));
+	testCheck(testLoadFails<float>(path, MatrixExceptionType::INVALID_FILE_FORMAT), "load of a file of another type");
+
+	std::remove(path.c_str());
+	testCheck(testLoadFails<double>(path, MatrixExceptionType::FILE_ERROR), "load of a missing file");
+}
+
+#ifndef _WIN32
+/*! testStreamWrite
+* Write bytes to a named pipe from another thread while the test reads it
+* std::string pipe: The pipe
+* std::vector<char> bytes: The bytes
+* return: The thread, to be joined
+*/
+std::thread testStreamWrite(const std::string& pipe, const std::vector<char>& bytes)
+{
+	return std::thread([pipe, bytes]()
+	{
+		std::FILE* file = std::fopen(pipe.c_str(), "wb");
+
+		if (file != nullptr)
+		{
+			std::fwrite(bytes.data(), 1, bytes.size(), file);
+			std::fclose(file);
+		}
+	});
+}
+
+/*! testStreams
+* loadMatrix of a named pipe, whose length is not known: a whole matrix, and a header of 2^32 - 1 x 2^32 - 1 values
+* followed by a few values, which must fail at the end of the stream instead of allocating the matrix
+*/
+void testStreams(std::mt19937& generator, const std::string& path)
+{
+	const std::string pipe = path + ".pipe";
+	Matrix<double> M(23, 17);
+
+	testRandom(M, generator);
+	saveMatrix(path, view(M), true);
+
+	std::FILE* file = std::fopen(path.c_str(), "rb");
+	std::vector<char> bytes;
+	int byte;
+
+	while ((byte = std::fgetc(file)) != EOF)
+		bytes.push_back(char(byte));
+
+	std::fclose(file);
+	std::remove(pipe.c_str());
+
+	if (mkfifo(pipe.c_str(), 0600) != 0)
+	{
+		testCheck(false, "creation of a named pipe");
+		return;
+	}
+
+	std::thread writer = testStreamWrite(pipe, bytes);
+	Matrix<double> loaded = loadMatrix<double>(pipe);
+
+	writer.join();
+	testCheck(testDifference(view(loaded), view(M)) == 0.0, "load of a stream");
+
+	MatrixFileHeader header;
+
+	std::memcpy(&header, bytes.data(), sizeof(header));
+	header.rows = 4294967295u;
+	header.columns = 4294967295u;
+	header.stride = 4294967295u;
+	std::memcpy(bytes.data(), &header, sizeof(header));
+	bytes.resize(sizeof(header) + (4 * sizeof(double)));
+
+	writer = testStreamWrite(pipe, bytes);
+	testCheck(testLoadFails<double>(pipe, MatrixExceptionType::INVALID_FILE_FORMAT), "load of a stream shorter than its header");
+	writer.join();
+
+	std::remove(pipe.c_str());
+}
+#endif
+
+int main()
+{
+	std::mt19937 generator(2024);
+	const std::string path = "TestMatrixFile.lmat";
+
+	testRoundTrip<double>(generator, path, "round trip of double");
+	testRoundTrip<float>(generator, path, "round trip of float");
+	testRoundTrip<int32_t>(generator, path, "round trip of int32");
+	testRoundTrip<half>(generator, path, "round trip of half");
+	testStreaming(generator, path);
+	testByteOrder(path);
+	testInvalidFiles(generator, path);
+#ifndef _WIN32
+	testStreams(generator, path);
+#endif
+
+	std::remove(path.c_str());
+
+	return testResult("TestMatrixFile");
+}
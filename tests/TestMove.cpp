@@ -0,0 +1,233 @@
+#include "AlgebraTest.hpp"
+
+using namespace lito;
+
+/*! testEmpty
+* The matrix is left as a matrix moved from: without storage and of size zero
+* Matrix<T> M: The matrix
+* return: If the matrix is empty
+*/
+template <typename T>
+bool testEmpty(const Matrix<T>& M)
+{
+	return M.data() == nullptr && M.getRows() == 0 && M.getColumns() == 0 && M.getStride() == 0 && M.getCapacity() == 0;
+}
+
+/*! testMoveConstruction
+* The move constructor and the move assignment take the storage and the allocator and leave the source empty,
+* a move of a matrix to itself keeps it
+*/
+void testMoveConstruction(std::mt19937& generator)
+{
+	AlignedAllocator padded(64, true);
+	Matrix<double> A(7, 5, MatrixType::ZEROS, &padded);
+
+	testRandom(A, generator);
+
+	Matrix<double> original(A);
+	const double* storage = A.data();
+	Matrix<double> moved(std::move(A));
+
+	testCheck(moved.data() == storage && moved.getAllocator() == &padded && testEmpty(A), "move constructor");
+	testCheck(testDifference(view(moved), view(original)) == 0.0, "values of the move constructor");
+
+	Matrix<double> assigned(3, 3);
+
+	assigned = std::move(moved);
+	testCheck(assigned.data() == storage && assigned.getAllocator() == &padded && testEmpty(moved), "move assignment");
+	testCheck(testDifference(view(assigned), view(original)) == 0.0, "values of the move assignment");
+
+	// A reference hides the self move from the compiler
+	Matrix<double>& alias = assigned;
+
+	assigned = std::move(alias);
+	testCheck(assigned.data() == storage && assigned.getRows() == 7 && assigned.getColumns() == 5, "move assignment to itself");
+	testCheck(testDifference(view(assigned), view(original)) == 0.0, "values of the move assignment to itself");
+
+	// An empty matrix is moved as an empty matrix
+	Matrix<double> empty;
+	Matrix<double> fromEmpty(std::move(empty));
+
+	testCheck(testEmpty(fromEmpty) && testEmpty(empty), "move of an empty matrix");
+}
+
+/*! testMoveOperators
+* Each overload of an expiring operand returns its storage with the values of the copying overload,
+* and leaves the expiring matrix empty
+*/
+void testMoveOperators(std::mt19937& generator)
+{
+	Matrix<double> A(9, 6);
+	Matrix<double> B(9, 6);
+
+	testRandom(A, generator);
+	testRandom(B, generator);
+
+	const Matrix<double> expectedSum = A + B;
+	const Matrix<double> expectedSub = A - B;
+	const Matrix<double> expectedMul = A.mul(B);
+	const Matrix<double> expectedScaled = A * 2.5;
+	const Matrix<double> expectedTranspose = A.transpose();
+
+	// Each case moves a copy of A or B and checks the result has the storage of that copy
+	auto check = [&](const char* name, const Matrix<double>& result, const double* storage, const Matrix<double>& moved, const Matrix<double>& expected)
+	{
+		testCheck(result.data() == storage && testEmpty(moved), name);
+		testCheck(testDifference(view(result), view(expected)) <= 1e-15, name, testDifference(view(result), view(expected)));
+	};
+
+	{
+		Matrix<double> X(A);
+		const double* storage = X.data();
+		Matrix<double> result = std::move(X) + B;
+		check("expiring left operand of +", result, storage, X, expectedSum);
+	}
+	{
+		Matrix<double> Y(B);
+		const double* storage = Y.data();
+		Matrix<double> result = A + std::move(Y);
+		check("expiring right operand of +", result, storage, Y, expectedSum);
+	}
+	{
+		Matrix<double> X(A);
+		Matrix<double> Y(B);
+		const double* storage = X.data();
+		Matrix<double> result = std::move(X) + std::move(Y);
+		check("both operands of + expiring", result, storage, X, expectedSum);
+	}
+	{
+		Matrix<double> X(A);
+		const double* storage = X.data();
+		Matrix<double> result = std::move(X) - B;
+		check("expiring left operand of -", result, storage, X, expectedSub);
+	}
+	{
+		Matrix<double> Y(B);
+		const double* storage = Y.data();
+		Matrix<double> result = A - std::move(Y);
+		check("expiring right operand of -", result, storage, Y, expectedSub);
+	}
+	{
+		Matrix<double> X(A);
+		Matrix<double> Y(B);
+		const double* storage = X.data();
+		Matrix<double> result = std::move(X) - std::move(Y);
+		check("both operands of - expiring", result, storage, X, expectedSub);
+	}
+	{
+		Matrix<double> X(A);
+		const double* storage = X.data();
+		Matrix<double> result = std::move(X).mul(B);
+		check("expiring matrix of mul", result, storage, X, expectedMul);
+	}
+	{
+		Matrix<double> Y(B);
+		const double* storage = Y.data();
+		Matrix<double> result = A.mul(std::move(Y));
+		check("expiring argument of mul", result, storage, Y, expectedMul);
+	}
+	{
+		Matrix<double> X(A);
+		const double* storage = X.data();
+		Matrix<double> result = std::move(X) * 2.5;
+		check("expiring matrix of * value", result, storage, X, expectedScaled);
+	}
+	{
+		Matrix<double> X(A);
+		const double* storage = X.data();
+		Matrix<double> result = 2.5 * std::move(X);
+		check("expiring matrix of value *", result, storage, X, expectedScaled);
+	}
+	{
+		Matrix<double> X(A);
+		const double* storage = X.data();
+		Matrix<double> result = std::move(X).transpose();
+		check("expiring matrix of transpose", result, storage, X, expectedTranspose);
+	}
+	{
+		// A chain of temporaries keeps the storage of the first one
+		Matrix<double> X(A);
+		const double* storage = X.data();
+		Matrix<double> result = ((std::move(X) * 2.0) + A) - B;
+		Matrix<double> expected(9, 6);
+
+		for (uint i = 0; i < 9; i++)
+			for (uint j = 0; j < 6; j++)
+				expected(i, j) = (3.0 * A(i, j)) - B(i, j);
+
+		check("chain of expiring temporaries", result, storage, X, expected);
+	}
+}
+
+/*! testMoveAliasing
+* Expiring operands that are the other operand too, each value is read before it is written
+*/
+void testMoveAliasing(std::mt19937& generator)
+{
+	Matrix<double> A(8, 11);
+
+	testRandom(A, generator);
+
+	Matrix<double> zeros(8, 11);
+	Matrix<double> doubled = A * 2.0;
+	Matrix<double> squared = A.mul(A);
+
+	{
+		Matrix<double> X(A);
+		const double* storage = X.data();
+		Matrix<double> result = X - std::move(X);
+		testCheck(result.data() == storage && testEmpty(X) && testDifference(view(result), view(zeros)) == 0.0, "X - move(X)");
+	}
+	{
+		Matrix<double> X(A);
+		const double* storage = X.data();
+		Matrix<double> result = std::move(X) - X;
+		testCheck(result.data() == storage && testEmpty(X) && testDifference(view(result), view(zeros)) == 0.0, "move(X) - X");
+	}
+	{
+		Matrix<double> X(A);
+		const double* storage = X.data();
+		Matrix<double> result = std::move(X) + X;
+		testCheck(result.data() == storage && testEmpty(X) && testDifference(view(result), view(doubled)) == 0.0, "move(X) + X");
+	}
+	{
+		Matrix<double> X(A);
+		const double* storage = X.data();
+		Matrix<double> result = X + std::move(X);
+		testCheck(result.data() == storage && testEmpty(X) && testDifference(view(result), view(doubled)) == 0.0, "X + move(X)");
+	}
+	{
+		Matrix<double> X(A);
+		const double* storage = X.data();
+		Matrix<double> result = X.mul(std::move(X));
+		testCheck(result.data() == storage && testEmpty(X) && testDifference(view(result), view(squared)) == 0.0, "X.mul(move(X))");
+	}
+	{
+		// The product takes the storage of X before X is read by +, so X is read empty and the sizes do not match,
+		// reported by the exception instead of reading the storage that was taken
+		Matrix<double> X(A);
+		bool thrown = false;
+
+		try
+		{
+			Matrix<double> result = std::move(X) * 2.0 + X;
+		}
+		catch (const MatrixException&)
+		{
+			thrown = true;
+		}
+
+		testCheck(thrown && testEmpty(X), "move(X) * 2 + X reads X after its storage was taken");
+	}
+}
+
+int main()
+{
+	std::mt19937 generator(2024);
+
+	testMoveConstruction(generator);
+	testMoveOperators(generator);
+	testMoveAliasing(generator);
+
+	return testResult("TestMove");
+}
@@ -0,0 +1,250 @@
+#include <cstdio>
+#include <chrono>
+#include <thread>
+#include "AlgebraTest.hpp"
+#include "MatrixOutOfCore.hpp"
+
+using namespace lito;
+
+/*! testTileBytes
+* Bytes of a tile of tileSize x tileSize doubles
+*/
+size_t testTileBytes(uint tileSize)
+{
+	return size_t(tileSize) * tileSize * sizeof(double);
+}
+
+/*! testBudget
+* A matrix of 5 x 4 tiles through a cache of 4 tiles: the budget is never passed, and the tiles modified
+* are written back when evicted and read again
+*/
+void testBudget(std::mt19937& generator)
+{
+	TileCache<double> cache(4 * testTileBytes(16));
+	Matrix<double> M(70, 50);
+	Matrix<double> copy(70, 50);
+
+	testRandom(M, generator);
+
+	{
+		TiledMatrix<double> tiled(cache, "TestOutOfCore_M.tiles", 70, 50, 16);
+
+		tiled.assign(view(M));
+		testCheck(cache.getUsed() <= cache.getBudget(), "budget of the cache after assign", double(cache.getUsed()));
+		testCheck(cache.getWrittenTiles() >= 16, "tiles evicted written back", double(cache.getWrittenTiles()));
+
+		tiled.copyTo(view(copy));
+		testCheck(testDifference(view(copy), view(M)) == 0.0, "values written back and read again");
+		testCheck(cache.getUsed() <= cache.getBudget() && cache.getReadTiles() >= 16, "tiles read again within the budget", double(cache.getReadTiles()));
+
+		// The tile (0, 0) was evicted by the last tiles read, it is modified and evicted again
+		{
+			TileHandle<double> tile = tiled.write(0, 0);
+
+			tile.values()(3, 5) = -7.0;
+			M(3, 5) = -7.0;
+		}
+
+		for (uint i = 1; i < tiled.getTileRows(); i++)
+			tiled.read(i, 1);
+
+		tiled.copyTo(view(copy));
+		testCheck(testDifference(view(copy), view(M)) == 0.0, "values modified by a handle");
+	}
+
+	testCheck(cache.getUsed() == 0, "tiles of a destroyed matrix dropped from the cache", double(cache.getUsed()));
+	std::remove("TestOutOfCore_M.tiles");
+}
+
+/*! testPrefetch
+* A tile prefetched is read by the cache thread, evicting a tile not modified, and not read again by read()
+* assign and flush do not read tiles, so the tiles read are only the ones asked here
+*/
+void testPrefetch(std::mt19937& generator)
+{
+	TileCache<double> cache(4 * testTileBytes(16));
+	Matrix<double> M(70, 50);
+
+	testRandom(M, generator);
+
+	{
+		TiledMatrix<double> tiled(cache, "TestOutOfCore_P.tiles", 70, 50, 16);
+
+		tiled.assign(view(M));
+		tiled.flush();
+		tiled.prefetch(0, 0);
+
+		for (uint wait = 0; wait < 1000 && cache.getReadTiles() == 0; wait++)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		testCheck(cache.getReadTiles() == 1 && cache.getUsed() <= cache.getBudget(), "tile prefetched by the cache thread", double(cache.getReadTiles()));
+
+		TileHandle<double> tile = tiled.read(0, 0);
+
+		testCheck(testDifference(tile.view(), view(M).block(0, 0, 16, 16)) == 0.0, "values of the tile prefetched");
+		testCheck(cache.getReadTiles() == 1, "tile prefetched not read again", double(cache.getReadTiles()));
+	}
+
+	std::remove("TestOutOfCore_P.tiles");
+}
+
+/*! testTooSmall
+* A cache smaller than the tiles in use, and smaller than what tiledLUFactor needs, throws INVALID_SIZE
+*/
+void testTooSmall()
+{
+	TileCache<double> cache(2 * testTileBytes(16));
+	bool thrown = false;
+
+	{
+		TiledMatrix<double> tiled(cache, "TestOutOfCore_S.tiles", 40, 40, 16);
+
+		try
+		{
+			TileHandle<double> first = tiled.read(0, 0);
+			TileHandle<double> second = tiled.read(0, 1);
+			TileHandle<double> third = tiled.read(1, 0);
+		}
+		catch (const MatrixException& exception)
+		{
+			thrown = exception.getType() == MatrixExceptionType::INVALID_SIZE;
+		}
+
+		testCheck(thrown, "more tiles in use than the budget");
+		thrown = false;
+
+		try
+		{
+			tiledLUFactor(tiled);
+		}
+		catch (const MatrixException& exception)
+		{
+			thrown = exception.getType() == MatrixExceptionType::INVALID_SIZE;
+		}
+
+		testCheck(thrown, "tiledLUFactor with a budget smaller than a panel");
+	}
+
+	std::remove("TestOutOfCore_S.tiles");
+}
+
+/*! testTiledGemm
+* C = alpha * A * B + beta * C with borders of partial tiles, through a cache smaller than the three matrices,
+* against the product in memory
+*/
+void testTiledGemm(std::mt19937& generator)
+{
+	TileCache<double> cache(6 * testTileBytes(16));
+	Matrix<double> A(70, 50);
+	Matrix<double> B(50, 45);
+	Matrix<double> C(70, 45);
+	Matrix<double> result(70, 45);
+
+	testRandom(A, generator);
+	testRandom(B, generator);
+	testRandom(C, generator);
+
+	Matrix<double> expected = testProduct(view(A), view(B));
+
+	for (uint i = 0; i < 70; i++)
+		for (uint j = 0; j < 45; j++)
+			expected(i, j) = (2.0 * expected(i, j)) - (0.5 * C(i, j));
+
+	{
+		TiledMatrix<double> tiledA(cache, "TestOutOfCore_A.tiles", 70, 50, 16);
+		TiledMatrix<double> tiledB(cache, "TestOutOfCore_B.tiles", 50, 45, 16);
+		TiledMatrix<double> tiledC(cache, "TestOutOfCore_C.tiles", 70, 45, 16);
+
+		tiledA.assign(view(A));
+		tiledB.assign(view(B));
+		tiledC.assign(view(C));
+		tiledGemm(2.0, tiledA, tiledB, -0.5, tiledC);
+		tiledC.copyTo(view(result));
+
+		testCheck(testDifference(view(result), view(expected)) <= 1e-12, "tiledGemm");
+		testCheck(cache.getUsed() <= cache.getBudget(), "budget of the cache after tiledGemm", double(cache.getUsed()));
+	}
+
+	std::remove("TestOutOfCore_A.tiles");
+	std::remove("TestOutOfCore_B.tiles");
+	std::remove("TestOutOfCore_C.tiles");
+}
+
+/*! testTiledLU
+* tiledLUFactor, solve and determinant of a matrix of 5 x 5 tiles through a cache that holds two columns of tiles,
+* against the LU in memory, of a regular and of a singular matrix
+*/
+void testTiledLU(std::mt19937& generator)
+{
+	const uint n = 70;
+	TileCache<double> cache((size_t(n) * 16 * sizeof(double)) + (8 * testTileBytes(16)));
+	Matrix<double> A(n, n);
+	Matrix<double> B(n, 3);
+
+	testRandom(A, generator);
+	testRandom(B, generator);
+
+	LUFactorization<double> lu = luFactor(A);
+
+	{
+		TiledMatrix<double> tiled(cache, "TestOutOfCore_LU.tiles", n, n, 16);
+
+		tiled.assign(view(A));
+
+		TiledLUFactorization<double> tiledLU = tiledLUFactor(tiled);
+		Matrix<double> X = tiledLU.solve(B);
+		double deter = lu.determinant();
+
+		testCheck(!tiledLU.isSingular(), "tiledLUFactor of a regular matrix");
+		testCheck(testResidual(view(A), view(X), view(B)) <= 1e-10 * n, "tiledLUFactor solve");
+		testCheck(testDifference(view(X), view(lu.solveMany(B))) <= 1e-10, "tiledLUFactor solve equals the LU in memory");
+		testCheck(std::abs(tiledLU.determinant() - deter) <= 1e-10 * std::abs(deter), "tiledLUFactor determinant", tiledLU.determinant());
+		testCheck(cache.getUsed() <= cache.getBudget(), "budget of the cache after tiledLUFactor", double(cache.getUsed()));
+	}
+
+	// A line repeated in another tile makes a pivot up to the error, the determinant is then zero as in memory
+	Matrix<double> singular(A);
+
+	std::copy(singular.row(5), singular.row(5) + n, singular.row(40));
+
+	{
+		TiledMatrix<double> tiled(cache, "TestOutOfCore_LU.tiles", n, n, 16);
+
+		tiled.assign(view(singular));
+
+		TiledLUFactorization<double> tiledLU = tiledLUFactor(tiled, 1e-12);
+		LUFactorization<double> singularLU = luFactor(singular, 1e-12);
+		bool thrown = false;
+
+		try
+		{
+			tiledLU.solve(B);
+		}
+		catch (const MatrixException& exception)
+		{
+			thrown = exception.getType() == MatrixExceptionType::SINGULAR_MATRIX;
+		}
+
+		testCheck(tiledLU.isSingular() && thrown, "tiledLUFactor of a singular matrix");
+		testCheck(tiledLU.determinant() == 0.0 && singularLU.determinant() == 0.0, "tiledLUFactor determinant of a singular matrix", tiledLU.determinant());
+	}
+
+	std::remove("TestOutOfCore_LU.tiles");
+}
+
+int main()
+{
+	std::mt19937 generator(2024);
+
+	testBudget(generator);
+	testPrefetch(generator);
+	testTooSmall();
+
+	testConfigurations([&]()
+	{
+		testTiledGemm(generator);
+		testTiledLU(generator);
+	});
+
+	return testResult("TestOutOfCore");
+}
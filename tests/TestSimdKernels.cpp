@@ -0,0 +1,78 @@
+#include <vector>
+#include "AlgebraTest.hpp"
+#include "SimdKernels.hpp"
+
+using namespace lito;
+
+/*! testVectorKernels
+* axpy, mul, scale and dot of the SIMD level in use against scalar loops, for lengths that leave a tail
+* after the vectors, and the 4x4 product and the 8x8 transposed tile
+*/
+template <typename T>
+void testVectorKernels(std::mt19937& generator, double tolerance)
+{
+	const uint lengths[] = { 0, 1, 3, 8, 17, 64, 1001 };
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+	for (uint n : lengths)
+	{
+		std::vector<T> x(n);
+		std::vector<T> y(n);
+
+		for (uint i = 0; i < n; i++)
+		{
+			x[i] = T(distribution(generator));
+			y[i] = T(distribution(generator));
+		}
+
+		std::vector<T> axpy(y);
+		std::vector<T> product(y);
+		std::vector<T> scaled(y);
+		double dot = 0.0;
+		double error = 0.0;
+
+		simdKernels<T>().axpy(n, T(0.5), x.data(), axpy.data());
+		simdKernels<T>().mul(n, x.data(), product.data());
+		simdKernels<T>().scale(n, T(-3), scaled.data());
+
+		for (uint i = 0; i < n; i++)
+		{
+			error = std::max(error, std::abs(double(axpy[i]) - (0.5 * double(x[i]) + double(y[i]))));
+			error = std::max(error, std::abs(double(product[i]) - (double(x[i]) * double(y[i]))));
+			error = std::max(error, std::abs(double(scaled[i]) + 3.0 * double(y[i])));
+			dot += double(x[i]) * double(y[i]);
+		}
+
+		testCheck(error <= tolerance, "axpy, mul and scale", n);
+		testCheck(std::abs(double(simdKernels<T>().dot(n, x.data(), y.data())) - dot) <= tolerance * (n + 1), "dot", n);
+	}
+
+	Matrix<T> a(4, 4);
+	Matrix<T> b(4, 4);
+	Matrix<T> c(4, 4);
+	Matrix<T> tile(8, 11);
+	Matrix<T> transposed(8, 9);
+
+	testRandom(a, generator);
+	testRandom(b, generator);
+	testRandom(tile, generator);
+
+	simdKernels<T>().matrix4Mul(a.data(), b.data(), c.data());
+	simdKernels<T>().transposeTile(tile.data(), tile.getStride(), transposed.data(), transposed.getStride());
+
+	testCheck(testDifference(view(c), view(testProduct(view(a), view(b)))) <= tolerance * 4, "matrix4Mul");
+	testCheck(testDifference(view(transposed).block(0, 0, 8, 8), view(tile).block(0, 0, 8, 8).transpose()) == 0.0, "transposeTile");
+}
+
+int main()
+{
+	std::mt19937 generator(2024);
+
+	testSimdLevels([&]()
+	{
+		testVectorKernels<double>(generator, 1e-15);
+		testVectorKernels<float>(generator, 1e-6);
+	});
+
+	return testResult("TestSimdKernels");
+}
@@ -0,0 +1,368 @@
+#include "AlgebraTest.hpp"
+#include "MatrixLU.hpp"
+#include "MatrixCholesky.hpp"
+#include "MatrixQR.hpp"
+#include "MatrixOperations.hpp"
+#include "MatrixRefinement.hpp"
+
+using namespace lito;
+
+/*! testLU
+* Residuals of the LU solves, the solve in the storage of B and the inverse,
+* small sizes by the unblocked and big ones by the blocked factorization
+*/
+void testLU(std::mt19937& generator)
+{
+	const uint sizes[] = { 1, 7, 64, 300 };
+
+	for (uint n : sizes)
+	{
+		Matrix<double> A(n, n);
+		Matrix<double> B(n, 5);
+
+		testRandom(A, generator);
+		testRandom(B, generator);
+
+		LUFactorization<double> lu = luFactor(A);
+		Matrix<double> X = lu.solveMany(B);
+		Matrix<double> inPlace(B);
+		const double* storage = inPlace.data();
+
+		lu.solveInPlace(inPlace);
+
+		testCheck(testResidual(view(A), view(X), view(B)) <= 1e-10 * n, "LU solveMany", n);
+		testCheck(testDifference(view(inPlace), view(X)) <= 1e-12 * n, "LU solveInPlace equals solveMany", n);
+		testCheck(inPlace.data() == storage, "LU solveInPlace keeps the storage of B", n);
+		testCheck(testResidual(view(A), view(lu.inverse()), view(Matrix<double>(n, n, MatrixType::IDENTITY))) <= 1e-10 * n, "LU inverse", n);
+	}
+}
+
+/*! testLUDeterminant
+* Determinant of a triangular matrix with two lines swapped, which the pivoting swaps back,
+* and a singular matrix, which is flagged and refused by the solves
+*/
+void testLUDeterminant(std::mt19937& generator)
+{
+	Matrix<double> A(6, 6);
+	double expected = -1.0;
+
+	for (uint i = 0; i < 6; i++)
+	{
+		for (uint j = i; j < 6; j++)
+			A(i, j) = 0.5;
+
+		A(i, i) = 8.0 - i;
+		expected *= A(i, i);
+	}
+
+	A.elementarOperationSwitchLines(0, 5);
+	testCheck(std::abs(luFactor(A).determinant() - expected) <= 1e-12 * std::abs(expected), "LU determinant", luFactor(A).determinant());
+
+	Matrix<double> singular(9, 9);
+
+	testRandom(singular, generator);
+	std::copy(singular.row(2), singular.row(2) + 9, singular.row(6));
+
+	LUFactorization<double> lu = luFactor(singular, 1e-12);
+	bool thrown = false;
+
+	try
+	{
+		lu.solve(Matrix<double>(9, 1, MatrixType::ONES));
+	}
+	catch (const MatrixException& exception)
+	{
+		thrown = exception.getType() == MatrixExceptionType::SINGULAR_MATRIX;
+	}
+
+	testCheck(lu.isSingular() && lu.determinant() == 0.0 && thrown, "LU of a singular matrix");
+}
+
+/*! testCholesky
+* Cholesky and LDLt of A * At + n * I: the residuals of the solves, A = Ut * U, the determinant against LU
+* and the rank updates against the factorization of A + X * Xt
+*/
+void testCholesky(std::mt19937& generator)
+{
+	const uint sizes[] = { 1, 9, 130, 300 };
+
+	for (uint n : sizes)
+	{
+		Matrix<double> M(n, n);
+		Matrix<double> B(n, 3);
+		Matrix<double> X(n, 2);
+
+		testRandom(M, generator);
+		testRandom(B, generator);
+		testRandom(X, generator);
+
+		Matrix<double> A = testProduct(view(M), view(M).transpose());
+
+		for (uint i = 0; i < n; i++)
+			A(i, i) += double(n);
+
+		CholeskyFactorization<double> cholesky = choleskyFactor(A);
+		LDLFactorization<double> ldl = ldlFactor(A);
+		double deter = luFactor(A).determinant();
+
+		testCheck(cholesky.isPositiveDefinite() && ldl.isPositiveDefinite(), "Cholesky of a positive-definite matrix", n);
+		testCheck(testResidual(view(cholesky.getU()).transpose(), view(cholesky.getU()), view(A)) <= 1e-12 * n, "Cholesky A = Ut * U", n);
+		testCheck(testResidual(view(A), view(cholesky.solveMany(B)), view(B)) <= 1e-10 * n, "Cholesky solveMany", n);
+		testCheck(testResidual(view(A), view(ldl.solveMany(B)), view(B)) <= 1e-10 * n, "LDLt solveMany", n);
+
+		// The determinant of the biggest size is over the range of double
+		if (std::isfinite(deter))
+		{
+			testCheck(std::abs(cholesky.determinant() - deter) <= 1e-10 * std::abs(deter), "Cholesky determinant", n);
+			testCheck(std::abs(ldl.determinant() - deter) <= 1e-10 * std::abs(deter), "LDLt determinant", n);
+		}
+
+		Matrix<double> updated = A + testProduct(view(X), view(X).transpose());
+
+		cholesky.update(X);
+		ldl.update(X);
+		testCheck(testResidual(view(updated), view(cholesky.solveMany(B)), view(B)) <= 1e-10 * n, "Cholesky update", n);
+		testCheck(testResidual(view(updated), view(ldl.solveMany(B)), view(B)) <= 1e-10 * n, "LDLt update", n);
+
+		cholesky.downdate(X);
+		ldl.downdate(X);
+		testCheck(testResidual(view(A), view(cholesky.solveMany(B)), view(B)) <= 1e-10 * n, "Cholesky downdate", n);
+		testCheck(testResidual(view(A), view(ldl.solveMany(B)), view(B)) <= 1e-10 * n, "LDLt downdate", n);
+	}
+}
+
+/*! testIndefinite
+* A symmetric matrix with a negative eigenvalue: Cholesky refuses it and LDLt solves it
+*/
+void testIndefinite(std::mt19937& generator)
+{
+	Matrix<double> A(40, 40);
+	Matrix<double> B(40, 2);
+
+	testRandom(B, generator);
+
+	for (uint i = 0; i < 40; i++)
+	{
+		for (uint j = 0; j < 40; j++)
+			A(i, j) = 1.0 / (1.0 + i + j);
+
+		A(i, i) = (i % 3 == 0) ? -4.0 : 4.0;
+	}
+
+	CholeskyFactorization<double> cholesky = choleskyFactor(A);
+	LDLFactorization<double> ldl = ldlFactor(A);
+	bool thrown = false;
+
+	try
+	{
+		cholesky.solveMany(B);
+	}
+	catch (const MatrixException& exception)
+	{
+		thrown = exception.getType() == MatrixExceptionType::NOT_POSITIVE_DEFINITE;
+	}
+
+	testCheck(!cholesky.isPositiveDefinite() && thrown, "Cholesky of an indefinite matrix");
+	testCheck(!ldl.isSingular() && !ldl.isPositiveDefinite(), "LDLt of an indefinite matrix");
+	testCheck(testResidual(view(A), view(ldl.solveMany(B)), view(B)) <= 1e-12, "LDLt solveMany of an indefinite matrix");
+}
+
+/*! testQR
+* A = Q * R with Q orthonormal and R upper triangular, Qt undone by Q, and the least squares condition
+* At * (A * x - b) = 0, for tall, square and blocked shapes
+*/
+void testQR(std::mt19937& generator)
+{
+	const uint shapes[][2] = { { 5, 3 }, { 40, 40 }, { 1000, 8 }, { 300, 70 }, { 200, 130 } };
+
+	for (const auto& shape : shapes)
+	{
+		uint m = shape[0];
+		uint n = shape[1];
+		Matrix<double> A(m, n);
+		Matrix<double> B(m, 2);
+
+		testRandom(A, generator);
+		testRandom(B, generator);
+
+		QRFactorization<double> qr = qrFactor(A);
+		Matrix<double> Q = qr.getThinQ();
+		Matrix<double> R = qr.getR();
+		Matrix<double> X = qr.leastSquares(B);
+		Matrix<double> residual = testProduct(view(A), view(X));
+		double lower = 0.0;
+
+		for (uint i = 0; i < m; i++)
+			for (uint j = 0; j < 2; j++)
+				residual(i, j) -= B(i, j);
+
+		for (uint i = 1; i < R.getRows(); i++)
+			for (uint j = 0; j < std::min(i, R.getColumns()); j++)
+				lower = std::max(lower, std::abs(R(i, j)));
+
+		Matrix<double> normal = testProduct(view(A).transpose(), view(residual));
+		Matrix<double> zeros(n, 2);
+		Matrix<double> C(B);
+
+		qr.applyQt(C);
+		qr.applyQ(C);
+
+		testCheck(testResidual(view(Q), view(R), view(A)) <= 1e-12 * m, "QR A = Q * R", m);
+		testCheck(testResidual(view(Q).transpose(), view(Q), view(Matrix<double>(n, n, MatrixType::IDENTITY))) <= 1e-12 * m, "QR Qt * Q = I", m);
+		testCheck(lower == 0.0, "QR R upper triangular", m);
+		testCheck(testDifference(view(C), view(B)) <= 1e-12 * m, "QR Q * Qt * C = C", m);
+		testCheck(testDifference(view(normal), view(zeros)) <= 1e-11 * m, "QR least squares", m);
+	}
+}
+
+/*! testGauss
+* The Gauss and Gauss Jordan solvers on upper triangular systems with negative pivots, which need column swaps,
+* and on a dense system, Gauss by reduction and by the blocked LU
+*/
+void testGauss(std::mt19937& generator)
+{
+	std::uniform_real_distribution<double> distribution(-2.0, 2.0);
+	uint tested = 0;
+
+	while (tested < 500)
+	{
+		Matrix<double> A(4, 4);
+		Matrix<double> b(4, 1);
+		bool wellConditioned = true;
+
+		for (uint i = 0; i < 4; i++)
+		{
+			for (uint j = i; j < 4; j++)
+				A(i, j) = distribution(generator);
+
+			b(i, 0) = distribution(generator);
+			wellConditioned = wellConditioned && std::abs(A(i, i)) > 0.1;
+		}
+
+		if (!wellConditioned)
+			continue;
+
+		tested++;
+		testCheck(testResidual(view(A), view(systemResoltionGauss(A, b, 1e-12)), view(b)) <= 1e-8, "systemResoltionGauss");
+		testCheck(testResidual(view(A), view(systemResoltionGaussJordan(A, b, 1e-12)), view(b)) <= 1e-8, "systemResoltionGaussJordan");
+	}
+
+	Matrix<double> A(50, 50);
+	Matrix<double> B(50, 3);
+
+	testRandom(A, generator);
+	testRandom(B, generator);
+	testCheck(testResidual(view(A), view(systemResoltionGauss(A, B, 1e-12)), view(B)) <= 1e-9, "systemResoltionGauss of a dense system");
+	testCheck(testResidual(view(A), view(systemResoltionGauss(A, B, 1e-12, GaussMethod::LU)), view(B)) <= 1e-9, "systemResoltionGauss by LU");
+	testCheck(testResidual(view(A), view(systemResoltionGaussJordan(A, B, 1e-12)), view(B)) <= 1e-9, "systemResoltionGaussJordan of a dense system");
+}
+
+/*! testBackwardError
+* Recalculate max ||b - A * x|| / (||A|| * ||x|| + ||b||) of the columns, infinity norms, by the naive product
+*/
+double testBackwardError(const Matrix<double>& A, const Matrix<double>& B, const Matrix<double>& X)
+{
+	Matrix<double> AX = testProduct(view(A), view(X));
+	double normA = 0.0;
+	double backwardError = 0.0;
+
+	for (uint i = 0; i < A.getRows(); i++)
+	{
+		double sum = 0.0;
+
+		for (uint j = 0; j < A.getColumns(); j++)
+			sum += std::abs(A(i, j));
+
+		normA = std::max(normA, sum);
+	}
+
+	for (uint j = 0; j < B.getColumns(); j++)
+	{
+		double normB = 0.0, normX = 0.0, normR = 0.0;
+
+		for (uint i = 0; i < B.getRows(); i++)
+		{
+			normB = std::max(normB, std::abs(B(i, j)));
+			normX = std::max(normX, std::abs(X(i, j)));
+			normR = std::max(normR, std::abs(B(i, j) - AX(i, j)));
+		}
+
+		backwardError = std::max(backwardError, normR / ((normA * normX) + normB));
+	}
+
+	return backwardError;
+}
+
+/*! testMixedPrecision
+* solveMixedPrecision of a well-conditioned system, refined in double from the LU in float without fallback,
+* of a Hilbert matrix, which the LU in float can not refine and falls back to the LU in double,
+* and with no refinement step allowed; and systemResoltionGauss by GaussMethod::MIXED
+*/
+void testMixedPrecision(std::mt19937& generator)
+{
+	const uint n = 200;
+	const double tolerance = std::numeric_limits<double>::epsilon() * std::sqrt(double(n));
+	Matrix<double> A(n, n);
+	Matrix<double> B(n, 3);
+	Matrix<double> X;
+
+	testRandom(A, generator);
+	testRandom(B, generator);
+
+	for (uint i = 0; i < n; i++)
+		A(i, i) += double(n);
+
+	RefinementStatistics<double> statistics = solveMixedPrecision(A, B, X);
+
+	testCheck(statistics.converged && !statistics.fallback, "mixed precision of a well-conditioned system without fallback", statistics.iterations);
+	testCheck(statistics.iterations >= 1 && statistics.iterations <= 30, "mixed precision refinement steps", statistics.iterations);
+	testCheck(statistics.backwardError <= tolerance && testBackwardError(A, B, X) <= 10.0 * tolerance, "mixed precision backward error", statistics.backwardError);
+	testCheck(testResidual(view(A), view(X), view(B)) <= 1e-12 * n, "mixed precision solve", n);
+
+	Matrix<double> mixed = systemResoltionGauss(A, B, 0.0, GaussMethod::MIXED);
+
+	testCheck(testDifference(view(mixed), view(X)) == 0.0, "systemResoltionGauss by GaussMethod::MIXED");
+
+	RefinementStatistics<double> unrefined = solveMixedPrecision(A, B, X, RefinementSettings<double>(0));
+
+	testCheck(unrefined.fallback && unrefined.iterations == 0, "mixed precision without refinement steps falls back");
+	testCheck(testDifference(view(X), view(luFactor(A).solveMany(B))) == 0.0, "mixed precision fallback solved by the LU in double");
+
+	const uint h = 12;
+	Matrix<double> hilbert(h, h);
+	Matrix<double> b(h, 1);
+
+	for (uint i = 0; i < h; i++)
+	{
+		for (uint j = 0; j < h; j++)
+			hilbert(i, j) = 1.0 / double(i + j + 1);
+
+		b(i, 0) = 1.0;
+	}
+
+	statistics = solveMixedPrecision(hilbert, b, X);
+
+	testCheck(statistics.fallback && statistics.iterations <= 30, "mixed precision of a Hilbert matrix falls back", statistics.iterations);
+	testCheck(std::abs(statistics.backwardError - testBackwardError(hilbert, b, X)) <= 1e-3 * statistics.backwardError + 1e-16, "mixed precision backward error of the fallback", statistics.backwardError);
+	testCheck(statistics.converged == (statistics.backwardError <= std::numeric_limits<double>::epsilon() * std::sqrt(double(h))), "mixed precision converged flag of the fallback");
+	testCheck(testDifference(view(X), view(luFactor(hilbert).solveMany(b))) == 0.0, "mixed precision fallback of a Hilbert matrix by the LU in double");
+	testCheck(testDifference(view(systemResoltionGauss(hilbert, b, 0.0, GaussMethod::MIXED)), view(X)) == 0.0, "systemResoltionGauss by GaussMethod::MIXED of a Hilbert matrix");
+}
+
+int main()
+{
+	std::mt19937 generator(2024);
+
+	testConfigurations([&]()
+	{
+		testLU(generator);
+		testLUDeterminant(generator);
+		testCholesky(generator);
+		testIndefinite(generator);
+		testQR(generator);
+		testGauss(generator);
+		testMixedPrecision(generator);
+	});
+
+	return testResult("TestSolvers");
+}
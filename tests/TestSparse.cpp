@@ -0,0 +1,156 @@
+#include <vector>
+#include "AlgebraTest.hpp"
+#include "SparseMatrix.hpp"
+
+using namespace lito;
+
+/*! testSparseRandom
+* Dense matrix with about a tenth of its values not zero and some empty lines and columns
+*/
+Matrix<double> testSparseRandom(uint rows, uint columns, std::mt19937& generator)
+{
+	std::uniform_real_distribution<double> distribution(0.0, 1.0);
+	Matrix<double> dense(rows, columns);
+
+	for (uint i = 0; i < rows; i++)
+		for (uint j = 0; j < columns; j++)
+			if (i % 7 != 3 && j % 5 != 2 && distribution(generator) < 0.1)
+				dense(i, j) = 2.0 * distribution(generator) - 1.0;
+
+	return dense;
+}
+
+/*! testSorted
+* Tell if the inner positions of each outer are increasing
+*/
+bool testSorted(const SparseMatrix<double>& A)
+{
+	for (size_t o = 0; o + 1 < A.getPointers().size(); o++)
+		for (size_t p = A.getPointers()[o] + 1; p < A.getPointers()[o + 1]; p++)
+			if (A.getIndices()[p - 1] >= A.getIndices()[p])
+				return false;
+
+	return true;
+}
+
+/*! testTriplets
+* Triplets in any order with repeated positions are summed into CSR and CSC
+*/
+void testTriplets(std::mt19937& generator)
+{
+	std::uniform_int_distribution<uint> lines(0, 30);
+	std::uniform_int_distribution<uint> columns(0, 20);
+	SparseTriplets<double> triplets(31, 21);
+	Matrix<double> dense(31, 21);
+	Matrix<double> used(31, 21);
+	size_t positions = 0;
+
+	for (uint k = 0; k < 400; k++)
+	{
+		uint i = lines(generator);
+		uint j = columns(generator);
+		double value = double(k % 13) - 6.0;
+
+		triplets.add(i, j, value);
+		dense(i, j) += value;
+		positions += used(i, j) == 0.0;
+		used(i, j) = 1.0;
+	}
+
+	const SparseFormat formats[] = { SparseFormat::CSR, SparseFormat::CSC };
+
+	for (SparseFormat format : formats)
+	{
+		SparseMatrix<double> A(triplets, format);
+
+		testCheck(testDifference(view(A.toMatrix()), view(dense)) == 0.0, "triplets summed", double(format == SparseFormat::CSC));
+		testCheck(A.getNonZeros() == positions, "positions of the triplets stored once", double(A.getNonZeros()));
+		testCheck(testSorted(A) && A.at(30, 20) == dense(30, 20), "positions of the triplets sorted", double(format == SparseFormat::CSC));
+	}
+}
+
+/*! testFormats
+* toFormat, transpose and toMatrix of CSR and CSC against the dense matrix
+*/
+void testFormats(std::mt19937& generator)
+{
+	Matrix<double> dense = testSparseRandom(57, 43, generator);
+	Matrix<double> transposed = dense.transpose();
+	const SparseFormat formats[] = { SparseFormat::CSR, SparseFormat::CSC };
+
+	for (SparseFormat format : formats)
+	{
+		SparseMatrix<double> A(dense, format);
+		SparseFormat other = (format == SparseFormat::CSR) ? SparseFormat::CSC : SparseFormat::CSR;
+		SparseMatrix<double> converted = A.toFormat(other);
+		SparseMatrix<double> transpose = A.transpose();
+
+		testCheck(testDifference(view(A.toMatrix()), view(dense)) == 0.0, "toMatrix", double(format == SparseFormat::CSC));
+		testCheck(converted.getFormat() == other && testSorted(converted), "toFormat sorted", double(format == SparseFormat::CSC));
+		testCheck(testDifference(view(converted.toMatrix()), view(dense)) == 0.0, "toFormat", double(format == SparseFormat::CSC));
+		testCheck(transpose.getRows() == 43 && testSorted(transpose), "transpose sorted", double(format == SparseFormat::CSC));
+		testCheck(testDifference(view(transpose.toMatrix()), view(transposed)) == 0.0, "transpose", double(format == SparseFormat::CSC));
+	}
+
+	SparseMatrix<double> dropped(dense, SparseFormat::CSR, 0.5);
+	bool small = true;
+
+	for (double value : dropped.getValues())
+		small = small && std::abs(value) > 0.5;
+
+	testCheck(small && dropped.getNonZeros() < SparseMatrix<double>(dense).getNonZeros(), "values up to the error not stored");
+}
+
+/*! testProducts
+* SpMV and SpMM of CSR and CSC against the dense product, with and without beta,
+* under the configuration in use (the CSC product sums a result per thread with the PARALLEL policy)
+*/
+void testProducts(std::mt19937& generator)
+{
+	Matrix<double> dense = testSparseRandom(300, 211, generator);
+	Matrix<double> x(211, 1);
+	Matrix<double> X(211, 5);
+	Matrix<double> Y(300, 5);
+
+	testRandom(x, generator);
+	testRandom(X, generator);
+	testRandom(Y, generator);
+
+	Matrix<double> expectedX = testProduct(view(dense), view(x));
+	Matrix<double> expectedY = testProduct(view(dense), view(X));
+
+	for (uint i = 0; i < 300; i++)
+		for (uint j = 0; j < 5; j++)
+			expectedY(i, j) = (-0.5 * expectedY(i, j)) + (2.0 * Y(i, j));
+
+	const SparseFormat formats[] = { SparseFormat::CSR, SparseFormat::CSC };
+
+	for (SparseFormat format : formats)
+	{
+		SparseMatrix<double> A(dense, format);
+		Matrix<double> y;
+		Matrix<double> result(Y);
+
+		A.apply(x, y);
+		A.multiply(X, result, -0.5, 2.0);
+
+		testCheck(testDifference(view(y), view(expectedX)) <= 1e-14, "SpMV", double(format == SparseFormat::CSC));
+		testCheck(testDifference(view(A * x), view(expectedX)) <= 1e-14, "operator * of a vector", double(format == SparseFormat::CSC));
+		testCheck(testDifference(view(result), view(expectedY)) <= 1e-14, "SpMM with alpha and beta", double(format == SparseFormat::CSC));
+	}
+}
+
+int main()
+{
+	std::mt19937 generator(2024);
+
+	testTriplets(generator);
+	testFormats(generator);
+
+	testConfigurations([&]()
+	{
+		testProducts(generator);
+	});
+
+	return testResult("TestSparse");
+}
@@ -0,0 +1,99 @@
+#include <vector>
+#include <atomic>
+#include <stdexcept>
+#include "AlgebraTest.hpp"
+
+using namespace lito;
+
+/*! testPool
+* parallelFor of the pool executes each index once and throws again the exception of a chunk,
+* invoke executes both functions
+*/
+void testPool()
+{
+	ThreadPool pool(4);
+	std::vector<std::atomic<int>> counts(10007);
+
+	for (std::atomic<int>& count : counts)
+		count = 0;
+
+	pool.parallelFor(3, 10007, 16, [&](uint from, uint to)
+	{
+		for (uint i = from; i < to; i++)
+			counts[i]++;
+	});
+
+	int wrong = 0;
+
+	for (uint i = 0; i < 10007; i++)
+		wrong += counts[i] != ((i < 3) ? 0 : 1);
+
+	testCheck(wrong == 0, "indices of parallelFor executed once", wrong);
+
+	bool thrown = false;
+
+	try
+	{
+		pool.parallelFor(0, 1000, 1, [](uint from, uint to)
+		{
+			if (from <= 500 && 500 < to)
+				throw(std::runtime_error("chunk"));
+		});
+	}
+	catch (const std::runtime_error&)
+	{
+		thrown = true;
+	}
+
+	testCheck(thrown, "exception of a chunk of parallelFor");
+
+	std::atomic<int> first(0);
+	std::atomic<int> second(0);
+
+	pool.invoke([&]() { first++; }, [&]() { second++; });
+	testCheck(first == 1 && second == 1, "functions of invoke");
+}
+
+/*! testElementwise
+* Sum, subtraction, product value to value and scale of matrices with and without the same stride,
+* under the configuration in use
+*/
+void testElementwise(std::mt19937& generator)
+{
+	Matrix<double> A(157, 93);
+	Matrix<double> B(157, 93);
+	AlignedAllocator allocator(64, true);
+	Matrix<double> padded(157, 93, MatrixType::ZEROS, &allocator);
+	Matrix<double> expected(157, 93);
+
+	testRandom(A, generator);
+	testRandom(B, generator);
+	testRandom(padded, generator);
+
+	for (uint i = 0; i < 157; i++)
+		for (uint j = 0; j < 93; j++)
+			expected(i, j) = ((A(i, j) + B(i, j) - padded(i, j)) * B(i, j)) * 0.5;
+
+	Matrix<double> C(A);
+
+	C += B;
+	C -= padded;
+	C.mulAssign(B);
+	C *= 0.5;
+
+	testCheck(testDifference(view(C), view(expected)) <= 1e-15, "elementwise operations");
+}
+
+int main()
+{
+	std::mt19937 generator(2024);
+
+	testPool();
+
+	testConfigurations([&]()
+	{
+		testElementwise(generator);
+	});
+
+	return testResult("TestThreadPool");
+}
@@ -0,0 +1,71 @@
+#include <utility>
+#include "AlgebraTest.hpp"
+
+using namespace lito;
+
+/*! testPaddingZeros
+* Tell if the padding of the rows holds zeros
+*/
+template <typename T>
+bool testPaddingZeros(const Matrix<T>& M)
+{
+	for (uint i = 0; i < M.getRows(); i++)
+		for (uint j = M.getColumns(); j < M.getStride(); j++)
+			if (M.row(i)[j] != T(0))
+				return false;
+
+	return true;
+}
+
+/*! testTransposeShapes
+* The copy and the in-place (rvalue) transpose of vectors, square and rectangular matrices,
+* with the rows padded to 64 bytes and without padding
+*/
+template <typename T>
+void testTransposeShapes(std::mt19937& generator)
+{
+	const uint shapes[][2] = { { 1, 1 }, { 1, 17 }, { 17, 1 }, { 8, 8 }, { 13, 29 }, { 64, 64 }, { 100, 100 }, { 130, 257 }, { 301, 300 } };
+	AlignedAllocator unpadded(64, false);
+	AlignedAllocator padded(64, true);
+	MatrixAllocator* allocators[] = { &unpadded, &padded };
+
+	for (MatrixAllocator* allocator : allocators)
+	{
+		for (const auto& shape : shapes)
+		{
+			uint rows = shape[0];
+			uint columns = shape[1];
+			Matrix<T> A(rows, columns, MatrixType::ZEROS, allocator);
+
+			testRandom(A, generator);
+
+			Matrix<T> copy = A.transpose();
+
+			testCheck(testDifference(view(copy), view(A).transpose()) == 0.0 && testPaddingZeros(copy), "transpose", rows * 1000.0 + columns);
+
+			Matrix<T> moved(A);
+			const T* storage = moved.data();
+			size_t capacity = moved.getCapacity();
+			uint stride = allocator->getRowPadding() ? uint(((size_t(rows) * sizeof(T) + 63) / 64) * (64 / sizeof(T))) : rows;
+			Matrix<T> inPlace = std::move(moved).transpose();
+
+			testCheck(testDifference(view(inPlace), view(A).transpose()) == 0.0, "transpose in place", rows * 1000.0 + columns);
+			testCheck(inPlace.getStride() == stride && testPaddingZeros(inPlace), "padding of the transpose in place", rows * 1000.0 + columns);
+			testCheck(inPlace.data() == storage || size_t(columns) * stride > capacity, "storage kept by the transpose in place", rows * 1000.0 + columns);
+			testCheck(inPlace.getAllocator() == allocator, "allocator kept by the transpose", rows * 1000.0 + columns);
+		}
+	}
+}
+
+int main()
+{
+	std::mt19937 generator(2024);
+
+	testConfigurations([&]()
+	{
+		testTransposeShapes<double>(generator);
+		testTransposeShapes<float>(generator);
+	});
+
+	return testResult("TestTranspose");
+}
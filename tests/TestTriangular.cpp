@@ -0,0 +1,183 @@
+#include "AlgebraTest.hpp"
+#include "MatrixTrsm.hpp"
+#include "Vector.hpp"
+
+using namespace lito;
+
+/*! testTriangle
+* Random triangular matrix with a strong diagonal, and a copy with the other triangle filled with garbage
+* uint n: Size of the matrix
+* MatrixTriangle triangle: LOWER or UPPER
+* MatrixDiagonal diagonal: With UNIT the reference has ones on the diagonal, the garbage matrix keeps random values
+* Matrix<double> garbage: Receives the matrix given to the solvers, the values outside the triangle must not be read
+* std::mt19937 generator: The random generator
+* return: The clean triangular matrix, for the reference products
+*/
+Matrix<double> testTriangle(uint n, MatrixTriangle triangle, MatrixDiagonal diagonal, Matrix<double>& garbage, std::mt19937& generator)
+{
+	Matrix<double> clean(n, n);
+
+	garbage = Matrix<double>(n, n);
+	testRandom(garbage, generator);
+
+	// Random unit triangles grow exponentially with n, the values outside the diagonal are scaled to keep A well conditioned
+	for (uint i = 0; i < n; i++)
+	{
+		for (uint j = 0; j < n; j++)
+			garbage(i, j) /= double(n);
+
+		garbage(i, i) += (garbage(i, i) < 0.0) ? -2.0 : 2.0;
+
+		for (uint j = 0; j < n; j++)
+			if ((triangle == MatrixTriangle::LOWER) ? (j <= i) : (j >= i))
+				clean(i, j) = (i == j && diagonal == MatrixDiagonal::UNIT) ? 1.0 : garbage(i, j);
+	}
+
+	return clean;
+}
+
+/*! testTrsm
+* X = alpha * A^-1 * B and X = alpha * B * A^-1 for every triangle and diagonal, also with B a block and a transposed view
+*/
+void testTrsm(std::mt19937& generator)
+{
+	const MatrixTriangle triangles[] = { MatrixTriangle::LOWER, MatrixTriangle::UPPER };
+	const MatrixDiagonal diagonals[] = { MatrixDiagonal::NON_UNIT, MatrixDiagonal::UNIT };
+	const uint sizes[] = { 1, 5, 37, 200 };
+
+	for (uint n : sizes)
+	{
+		for (MatrixTriangle triangle : triangles)
+		{
+			for (MatrixDiagonal diagonal : diagonals)
+			{
+				Matrix<double> garbage;
+				Matrix<double> A = testTriangle(n, triangle, diagonal, garbage, generator);
+				Matrix<double> B(n, 19);
+				Matrix<double> wide(19, n);
+				Matrix<double> bigger(n + 4, 30);
+
+				testRandom(B, generator);
+				testRandom(wide, generator);
+				testRandom(bigger, generator);
+
+				Matrix<double> alphaB = B * 0.5;
+				Matrix<double> alphaWide = wide * 0.5;
+				Matrix<double> X(B);
+				Matrix<double> wideX(wide);
+
+				trsm(MatrixSide::LEFT, triangle, diagonal, 0.5, view(garbage), view(X));
+				trsm(MatrixSide::RIGHT, triangle, diagonal, 0.5, view(garbage), view(wideX));
+
+				testCheck(testResidual(view(A), view(X), view(alphaB)) <= 1e-12 * n, "trsm left", n);
+				testCheck(testDifference(view(testProduct(view(wideX), view(A))), view(alphaWide)) <= 1e-12 * n, "trsm right", n);
+
+				// B as a block of a bigger matrix and as a transposed view, the values around the block are kept
+				Matrix<double> blockB(view(bigger).block(2, 3, n, 7));
+				Matrix<double> around(bigger);
+				MatrixView<double> blockX = view(bigger).block(2, 3, n, 7);
+
+				trsm(MatrixSide::LEFT, triangle, diagonal, 1.0, view(garbage), blockX);
+				testCheck(testResidual(view(A), ConstMatrixView<double>(blockX), view(blockB)) <= 1e-12 * n, "trsm into a block", n);
+
+				view(around).block(2, 3, n, 7).assign(ConstMatrixView<double>(blockX));
+				testCheck(testDifference(view(around), view(bigger)) == 0.0, "trsm keeps the values around the block", n);
+
+				Matrix<double> transposedX(7, n);
+				Matrix<double> transposedB(blockB);
+
+				view(transposedX).transpose().assign(view(transposedB));
+				trsm(MatrixSide::LEFT, triangle, diagonal, 1.0, view(garbage), view(transposedX).transpose());
+				testCheck(testResidual(view(A), view(transposedX).transpose(), view(blockB)) <= 1e-12 * n, "trsm into a transposed view", n);
+			}
+		}
+	}
+}
+
+/*! testVectorKernels
+* gemv, ger and trsv against the reference product, with the matrix as it is and transposed
+*/
+void testVectorKernels(std::mt19937& generator)
+{
+	const uint sizes[][2] = { { 1, 1 }, { 7, 3 }, { 33, 65 }, { 300, 129 } };
+
+	for (const auto& size : sizes)
+	{
+		uint m = size[0];
+		uint n = size[1];
+		Matrix<double> A(m, n);
+		Matrix<double> x(n, 1);
+		Matrix<double> y(m, 1);
+
+		testRandom(A, generator);
+		testRandom(x, generator);
+		testRandom(y, generator);
+
+		Vector<double> vectorX(x);
+		Vector<double> vectorY(y);
+		Vector<double> vectorZ(y);
+		Matrix<double> expected = testProduct(view(A), view(x));
+
+		for (uint i = 0; i < m; i++)
+			expected(i, 0) = 2.0 * expected(i, 0) - y(i, 0);
+
+		gemv(2.0, view(A), vectorX, -1.0, vectorY);
+		testCheck(testDifference(vectorY.view(), view(expected)) <= 1e-13 * n, "gemv", n);
+
+		Matrix<double> expectedTransposed = testProduct(view(A).transpose(), view(y));
+
+		gemv(1.0, view(A).transpose(), vectorZ, 0.0, vectorX);
+		testCheck(testDifference(vectorX.view(), view(expectedTransposed)) <= 1e-13 * m, "gemv of a transposed view", m);
+
+		Matrix<double> expectedUpdate(A);
+		Matrix<double> outer = testProduct(view(y), view(x).transpose());
+
+		for (uint i = 0; i < m; i++)
+			for (uint j = 0; j < n; j++)
+				expectedUpdate(i, j) += 0.5 * outer(i, j);
+
+		ger(0.5, Vector<double>(y), Vector<double>(x), view(A));
+		testCheck(testDifference(view(A), view(expectedUpdate)) <= 1e-14, "ger", m);
+	}
+
+	const MatrixTriangle triangles[] = { MatrixTriangle::LOWER, MatrixTriangle::UPPER };
+	const MatrixDiagonal diagonals[] = { MatrixDiagonal::NON_UNIT, MatrixDiagonal::UNIT };
+	const uint trsvSizes[] = { 1, 6, 71, 300 };
+
+	for (uint n : trsvSizes)
+	{
+		for (MatrixTriangle triangle : triangles)
+		{
+			for (MatrixDiagonal diagonal : diagonals)
+			{
+				Matrix<double> garbage;
+				Matrix<double> A = testTriangle(n, triangle, diagonal, garbage, generator);
+				Matrix<double> b(n, 1);
+
+				testRandom(b, generator);
+
+				Vector<double> x(b);
+				Vector<double> transposedX(b);
+
+				trsv(triangle, diagonal, view(garbage), x);
+				testCheck(testResidual(view(A), x.view(), view(b)) <= 1e-12 * n, "trsv", n);
+
+				trsv((triangle == MatrixTriangle::LOWER) ? MatrixTriangle::UPPER : MatrixTriangle::LOWER, diagonal, view(garbage).transpose(), transposedX);
+				testCheck(testResidual(view(A).transpose(), transposedX.view(), view(b)) <= 1e-12 * n, "trsv of a transposed view", n);
+			}
+		}
+	}
+}
+
+int main()
+{
+	std::mt19937 generator(2024);
+
+	testConfigurations([&]()
+	{
+		testTrsm(generator);
+		testVectorKernels(generator);
+	});
+
+	return testResult("TestTriangular");
+}
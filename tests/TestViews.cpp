@@ -0,0 +1,187 @@
+#include "AlgebraTest.hpp"
+#include "MatrixExpression.hpp"
+
+using namespace lito;
+
+/*! testGemmViews
+* Products of blocks and transposes of bigger matrices, and gemm written into a strided and a transposed C
+*/
+template <typename T>
+void testGemmViews(std::mt19937& generator, double tolerance)
+{
+	Matrix<T> A(90, 70);
+	Matrix<T> B(80, 60);
+	Matrix<T> C(100, 100);
+
+	testRandom(A, generator);
+	testRandom(B, generator);
+	testRandom(C, generator);
+
+	ConstMatrixView<T> blockA = view(A).block(3, 5, 41, 37);
+	ConstMatrixView<T> blockB = view(B).block(7, 2, 37, 29);
+	Matrix<T> product = blockA * blockB;
+
+	testCheck(testDifference(view(product), view(testProduct(blockA, blockB))) <= tolerance * 37, "gemm of blocks");
+
+	ConstMatrixView<T> transposedB = view(B).block(1, 1, 29, 37).transpose();
+	Matrix<T> productTransposed = blockA * transposedB;
+
+	testCheck(testDifference(view(productTransposed), view(testProduct(blockA, transposedB))) <= tolerance * 37, "gemm of a transposed block");
+
+	// C = 2 * A * B - C in a block of C, the values around the block are kept
+	Matrix<T> expected(C);
+	MatrixView<T> blockC = view(C).block(11, 13, 41, 29);
+	Matrix<T> reference = testProduct(blockA, blockB);
+
+	for (uint i = 0; i < 41; i++)
+		for (uint j = 0; j < 29; j++)
+			expected(11 + i, 13 + j) = T(2) * reference(i, j) - expected(11 + i, 13 + j);
+
+	gemm(T(2), blockA, blockB, T(-1), blockC);
+	testCheck(testDifference(view(C), view(expected)) <= tolerance * 74, "gemm into a block");
+
+	// A transposed C is written through C^T = B^T * A^T
+	Matrix<T> transposedC(29, 41);
+
+	gemm(T(1), blockA, blockB, T(0), view(transposedC).transpose());
+	testCheck(testDifference(view(transposedC).transpose(), view(reference)) <= tolerance * 37, "gemm into a transposed view");
+}
+
+/*! testViewValues
+* Blocks, lines, columns and transposes read the values of the matrix, and assign, fill and *= write
+* only the viewed positions
+*/
+void testViewValues(std::mt19937& generator)
+{
+	Matrix<double> A(23, 41);
+	Matrix<double> B(41, 23);
+
+	testRandom(A, generator);
+
+	ConstMatrixView<double> block = view(A).block(2, 3, 17, 30);
+	bool same = true;
+
+	for (uint i = 0; i < 17; i++)
+		for (uint j = 0; j < 30; j++)
+			same = same && block(i, j) == A(2 + i, 3 + j) && block.transpose()(j, i) == A(2 + i, 3 + j);
+
+	same = same && view(A).line(5)(0, 7) == A(5, 7) && view(A).column(9)(4, 0) == A(4, 9);
+	testCheck(same, "values of blocks, lines, columns and transposes");
+
+	view(B).assign(view(A).transpose());
+	testCheck(testDifference(view(B), view(A).transpose()) == 0.0, "assign of a transposed view");
+
+	Matrix<double> expected(B);
+
+	view(B).block(1, 1, 3, 4).fill(7.0);
+	view(B).column(0) *= 2.0;
+
+	for (uint i = 0; i < 41; i++)
+		expected(i, 0) *= 2.0;
+	for (uint i = 1; i < 4; i++)
+		for (uint j = 1; j < 5; j++)
+			expected(i, j) = 7.0;
+
+	testCheck(testDifference(view(B), view(expected)) == 0.0, "fill and *= of views");
+
+	bool thrown = false;
+
+	try
+	{
+		view(A).block(20, 0, 4, 1);
+	}
+	catch (const MatrixException& exception)
+	{
+		thrown = exception.getType() == MatrixExceptionType::INVALID_ACCESS;
+	}
+
+	testCheck(thrown, "block out of the matrix");
+}
+
+/*! testViewAliasing
+* Expressions that read the destination at other positions: a transpose of the same matrix,
+* with and without a change of the sizes, and blocks shifted over the same matrix
+*/
+void testViewAliasing(std::mt19937& generator)
+{
+	Matrix<double> M(3, 3);
+
+	testRandom(M, generator);
+
+	Matrix<double> original(M);
+	Matrix<double> expected(3, 3);
+
+	for (uint i = 0; i < 3; i++)
+		for (uint j = 0; j < 3; j++)
+			expected(i, j) = original(j, i) + original(i, j);
+
+	M = view(M).transpose() + M;
+	testCheck(testDifference(view(M), view(expected)) <= 1e-15, "M = view(M).transpose() + M");
+
+	Matrix<double> R(2, 3);
+
+	testRandom(R, generator);
+	original = R;
+	R = view(R).transpose();
+	testCheck(testDifference(view(R), view(original).transpose()) == 0.0, "R = view(R).transpose() of a 2x3 matrix");
+
+	testRandom(M, generator);
+	original = M;
+	M += view(M).transpose();
+	M -= 2.0 * view(M).transpose();
+
+	for (uint i = 0; i < 3; i++)
+		for (uint j = 0; j < 3; j++)
+			expected(i, j) = -(original(i, j) + original(j, i));
+
+	testCheck(testDifference(view(M), view(expected)) <= 1e-15, "M += and -= of view(M).transpose()");
+
+	Matrix<double> S(6, 6);
+
+	testRandom(S, generator);
+	original = S;
+	view(S).block(0, 0, 4, 4).assign(view(S).block(1, 2, 4, 4) * 2.0);
+	view(S).block(2, 2, 4, 4) += view(S).block(0, 0, 4, 4);
+	view(S).block(1, 0, 3, 3) -= -view(S).block(0, 1, 3, 3).transpose();
+
+	expected = original;
+
+	for (uint i = 0; i < 4; i++)
+		for (uint j = 0; j < 4; j++)
+			expected(i, j) = 2.0 * original(1 + i, 2 + j);
+
+	Matrix<double> step(expected);
+
+	for (uint i = 0; i < 4; i++)
+		for (uint j = 0; j < 4; j++)
+			expected(2 + i, 2 + j) = step(2 + i, 2 + j) + step(i, j);
+
+	step = expected;
+
+	for (uint i = 0; i < 3; i++)
+		for (uint j = 0; j < 3; j++)
+			expected(1 + i, j) = step(1 + i, j) + step(j, 1 + i);
+
+	testCheck(testDifference(view(S), view(expected)) <= 1e-15, "blocks shifted over the same matrix");
+
+	const double* storage = S.data();
+
+	S = lazy(S) * 3.0 - S;
+	testCheck(S.data() == storage, "expression read at the same positions evaluated in place");
+}
+
+int main()
+{
+	std::mt19937 generator(2024);
+
+	testViewValues(generator);
+	testViewAliasing(generator);
+
+	testConfigurations([&]()
+	{
+		testGemmViews<double>(generator, 1e-14);
+		testGemmViews<float>(generator, 1e-6);
+	});
+
+	return testResult("TestViews");
+}